@@ -171,6 +171,12 @@ namespace FrameTL
     cout << "precomputing all support cubes on patches..." << endl;
     all_patch_supports.resize(degrees_of_freedom);
     precompute_supports_simple<IBASIS,DIM_d,DIM_m>(this, all_patch_supports);
+    for (unsigned int k = 0; k < full_collection_levelwise.size(); k++)
+      for (unsigned int i = 0; i < full_collection_levelwise[k].size(); i++) {
+	const Support& supp = all_patch_supports[full_collection_levelwise[k][i].number()];
+	patch_support_table.insert(k, i, supp.a, supp.b);
+      }
+    patch_support_table.compress();
     cout << "done precomputing all support cubes on patches..." << endl;
     // #####################################################################################
 
@@ -332,6 +338,12 @@ namespace FrameTL
     cout << "precomputing all support cubes on patches..." << endl;
     all_patch_supports.resize(degrees_of_freedom);
     precompute_supports_simple<IBASIS,DIM_d,DIM_m>(this, all_patch_supports);
+    for (unsigned int k = 0; k < full_collection_levelwise.size(); k++)
+      for (unsigned int i = 0; i < full_collection_levelwise[k].size(); i++) {
+	const Support& supp = all_patch_supports[full_collection_levelwise[k][i].number()];
+	patch_support_table.insert(k, i, supp.a, supp.b);
+      }
+    patch_support_table.compress();
     cout << "done precomputing all support cubes on patches..." << endl;
     // #####################################################################################
   }
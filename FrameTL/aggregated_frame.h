@@ -17,6 +17,7 @@
 #include <geometry/atlas.h>
 #include <utils/fixed_array1d.h>
 #include <utils/array1d.h>
+#include <generic/support_table.h>
 #include <frame_index.h>
 #include <frame_support.h>
 
@@ -249,6 +250,12 @@ namespace FrameTL
     */
     Array1D<Support> all_patch_supports;
 
+    /*!
+      Spatial index of all_patch_supports. Level k corresponds to
+      full_collection_levelwise[k], the keys are the positions therein.
+    */
+    WaveletTL::SupportTable<DIM_d> patch_support_table;
+
 
   protected:
     //! Pointer to the underlying atlas.
@@ -242,24 +242,50 @@ namespace FrameTL
       //cout << wav_der_values_mu[i] << endl;
     }
 
+    // collect all quadrature knots (first coordinate running fastest) and
+    // evaluate the chart and the coefficients there at once
+    int n_points = 1;
+    for (unsigned int i = 0; i < DIM; i++)
+      n_points *= gauss_points[i].size();
+
     int index[DIM]; // current multiindex for the point values
     for (unsigned int i = 0; i < DIM; i++)
       index[i] = 0;
 
-    Point<DIM> x;
-    Point<DIM> x_patch;
-
-    // now we perform the quadrature
-    // loop over all quadrature knots
-    while (true) {
+    Array1D<Point<DIM> > x(n_points), x_patch;
+    for (int m = 0; m < n_points; m++) {
       for (unsigned int i = 0; i < DIM; i++)
-	x[i] = gauss_points[i][index[i]];
+	x[m][i] = gauss_points[i][index[i]];
+
+      // "++index"
+      for (unsigned int i = 0; i < DIM; i++) {
+	if (index[i] == (int)gauss_points[i].size()-1)
+	  index[i] = 0;
+	else {
+	  index[i]++;
+	  break;
+	}
+      }
+    }
 
-      chart->map_point(x,x_patch);
-      double sq_gram = chart->Gram_factor(x);
+    Array1D<double> sq_gram, a_values, q_values;
+    FixedArray1D<Array1D<double>,DIM> gram_d;
+    FixedArray1D<FixedArray1D<Array1D<double>,DIM>,DIM> dkappa_inv;
+    chart->map_points(x, x_patch);
+    chart->Gram_factor_values(x, sq_gram);
+    for (unsigned int s = 0; s < DIM; s++) {
+      chart->Gram_D_factor_values(s, x, gram_d[s]);
+      for (unsigned int i1 = 0; i1 < DIM; i1++)
+	chart->Dkappa_inv_values(s, i1, x, dkappa_inv[s][i1]);
+    }
+    ell_bvp_->a_values(x_patch, a_values);
+    ell_bvp_->q_values(x_patch, q_values);
 
-      Vector<double> values1(DIM);
-      Vector<double> values2(DIM);
+    // now we perform the quadrature
+    // loop over all quadrature knots
+    Vector<double> values1(DIM);
+    Vector<double> values2(DIM);
+    for (int m = 0; m < n_points; m++) {
       double weights=1., psi_lambda=1., psi_mu=1.;
 
       for (unsigned int i = 0; i < DIM; i++) {
@@ -269,6 +295,7 @@ namespace FrameTL
       }
       
       if ( !(psi_lambda == 0. || psi_mu == 0.) ) {
+	const double g = sq_gram[m];
 
 	for (unsigned int s = 0; s < DIM; s++) {
 	  double psi_der_lambda=1., psi_der_mu=1.;
@@ -276,11 +303,11 @@ namespace FrameTL
 	  psi_der_mu = (psi_mu / wav_values_mu[s][index[s]]) * wav_der_values_mu[s][index[s]];
 
 	  // for first part of the integral: \int_\Omega <a \Nabla u,\Nabla v> dx
-	  double tmp = chart->Gram_D_factor(s,x);
-	  values1[s] = ell_bvp_->a(x_patch) *
-	    (psi_der_lambda*sq_gram - (psi_lambda*tmp)) / (sq_gram*sq_gram);
+	  double tmp = gram_d[s][m];
+	  values1[s] = a_values[m] *
+	    (psi_der_lambda*g - (psi_lambda*tmp)) / (g*g);
 	  values2[s] =
-	    (psi_der_mu*sq_gram - (psi_mu*tmp)) / (sq_gram*sq_gram);
+	    (psi_der_mu*g - (psi_mu*tmp)) / (g*g);
 
 	}//end for s
 	
@@ -289,31 +316,27 @@ namespace FrameTL
 	  double d1 = 0.;
 	  double d2 = 0.;
 	  for (unsigned int i2 = 0; i2 < DIM; i2++) {
-	    double tmp = chart->Dkappa_inv(i2, i1, x);
+	    double tmp = dkappa_inv[i2][i1][m];
 	    d1 += values1[i2]*tmp;
 	    d2 += values2[i2]*tmp;
 	  }
 	  t += d1 * d2;
 
 	}
-	r += (t * (sq_gram*sq_gram) + ell_bvp_->q(x_patch) * psi_lambda * psi_mu)
+	r += (t * (g*g) + q_values[m] * psi_lambda * psi_mu)
 	  * weights;
 	
       }
       // "++index"
-      bool exit = false;
       for (unsigned int i = 0; i < DIM; i++) {
-	if (index[i] == N_Gauss*(supp_intersect.b[i]-supp_intersect.a[i])-1) {
+	if (index[i] == (int)gauss_points[i].size()-1)
 	  index[i] = 0;
-	  exit = (i == DIM-1);
-	} else {
+	else {
 	  index[i]++;
 	  break;
 	}
       }
-      if (exit) break;
-	
-    }//end while
+    }
 
     return r;
   }
@@ -609,39 +632,45 @@ namespace FrameTL
 			  gauss_points[i], v_values[i]);
     }
 
-    // iterate over all points and sum up the integral shares
+    // collect all quadrature knots (first coordinate running fastest) and
+    // evaluate the chart and the right-hand side there at once
+    int n_points = 1;
+    for (unsigned int i = 0; i < DIM; i++)
+      n_points *= gauss_points[i].size();
+
     int index[DIM]; // current multiindex for the point values
     for (unsigned int i = 0; i < DIM; i++)
       index[i] = 0;
-    
-    Point<DIM> x;
-    Point<DIM> x_patch;
-    
-    while (true) {
-      for (unsigned int i = 0; i < DIM; i++)
-	x[i] = gauss_points[i][index[i]];
-
-      chart->map_point(x,x_patch);
 
-      double share = ell_bvp_->f(x_patch) * chart->Gram_factor(x);
-      for (unsigned int i = 0; i < DIM; i++)
-	share *= gauss_weights[i][index[i]] * v_values[i][index[i]];
-      r += share;
+    Array1D<Point<DIM> > x(n_points), x_patch;
+    Array1D<double> weights(n_points);
+    for (int m = 0; m < n_points; m++) {
+      weights[m] = 1.0;
+      for (unsigned int i = 0; i < DIM; i++) {
+	x[m][i] = gauss_points[i][index[i]];
+	weights[m] *= gauss_weights[i][index[i]] * v_values[i][index[i]];
+      }
 
       // "++index"
-      bool exit = false;
       for (unsigned int i = 0; i < DIM; i++) {
-	if (index[i] == N_Gauss*(supp.b[i]-supp.a[i])-1) {
+	if (index[i] == N_Gauss*(supp.b[i]-supp.a[i])-1)
 	  index[i] = 0;
-	  exit = (i == DIM-1);
-	} else {
+	else {
 	  index[i]++;
 	  break;
 	}
       }
-      if (exit) break;
     }
 
+    Array1D<double> f_values, sq_gram;
+    chart->map_points(x, x_patch);
+    chart->Gram_factor_values(x, sq_gram);
+    ell_bvp_->f_values(x_patch, f_values);
+
+    // sum up the integral shares
+    for (int m = 0; m < n_points; m++)
+      r += f_values[m] * sq_gram[m] * weights[m];
+
 
 // #####################################################################################
 // Attention! This is a bad hack! It is assumed that in case macro ONE_D is defined,
@@ -5,6 +5,8 @@
 #include <typeinfo>
 #include <cube/cube_support.h>
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <time.h>
 #include <math.h>
 #include <iostream>
@@ -811,6 +813,14 @@ namespace FrameTL
     }
     std::list<typename Frame::Index> intersect_diff;
 
+    // positions of all elements on the level k whose supports intersect the one of lambda,
+    // looked up in the precomputed spatial index (ascending order)
+    std::vector<int> hits;
+    frame.patch_support_table.intersecting(k,
+					   frame.all_patch_supports[lambda.number()].a,
+					   frame.all_patch_supports[lambda.number()].b,
+					   hits);
+
 
     if (! generators) {
       unsigned int p = lambda.p();
@@ -866,12 +876,9 @@ namespace FrameTL
 	        tmp *= ((frame.bases()[pp])->bases())[i]->Nablasize(j);
 	    }
             // fügt die Indizes aus diesen Patches ein falls sie sich überlappen
-            for (unsigned int i = result; i < result + tmp; i++) {
-              const Index* ind = &((*full_collection_levelwise)[k][i]);
-              if ( intersect_supports_simple(frame, lambda, *ind) ){
-	        intersecting.push_back(*ind);
-              }
-            } 
+            for (std::vector<int>::const_iterator it(std::lower_bound(hits.begin(), hits.end(), (int)result));
+                 it != hits.end() && *it < (int)(result + tmp); ++it)
+              intersecting.push_back((*full_collection_levelwise)[k][*it]);
             result += tmp;
 	  }
 
@@ -999,12 +1006,9 @@ namespace FrameTL
 	    }
 
             // fügt die Indizes aus diesen Patches ein falls sie sich überlappen
-            for (unsigned int i = result; i < result + tmp; i++) {
-               const Index* ind = &((*full_collection_levelwise)[k][i]);
-               if ( intersect_supports_simple(frame, lambda, *ind) ){
-	          intersecting.push_back(*ind);
-                }
-             }
+            for (std::vector<int>::const_iterator it(std::lower_bound(hits.begin(), hits.end(), (int)result));
+                 it != hits.end() && *it < (int)(result + tmp); ++it)
+              intersecting.push_back((*full_collection_levelwise)[k][*it]);
 	    result += tmp;
 	  }
 
@@ -1044,12 +1048,8 @@ namespace FrameTL
 
     const Array1D<Array1D<Index> >* full_collection_levelwise = frame.get_full_collection_levelwise();
 
-    for (unsigned int i = 0; i < (*full_collection_levelwise)[k].size(); i++) {
-      const Index* ind = &((*full_collection_levelwise)[k][i]);
-      if ( intersect_supports_simple(frame, lambda, *ind) ){
-	intersecting.push_back(*ind);
-      }
-    }
+    for (std::vector<int>::const_iterator it(hits.begin()); it != hits.end(); ++it)
+      intersecting.push_back((*full_collection_levelwise)[k][*it]);
     } //end else
 #else
 
@@ -1132,6 +1132,14 @@ namespace FrameTL
     }
     std::list<typename Frame::Index> intersect_diff;
 
+    // positions of all elements on the level k whose supports intersect the one of lambda,
+    // looked up in the precomputed spatial index (ascending order)
+    std::vector<int> hits;
+    frame.patch_support_table.intersecting(k,
+					   frame.all_patch_supports[lambda.number()].a,
+					   frame.all_patch_supports[lambda.number()].b,
+					   hits);
+
 
     if (! generators) {
       if(p == lambda.p()){
@@ -1367,12 +1375,9 @@ namespace FrameTL
 	    }
       
       // fügt die Indizes aus diesem Patch ein falls sie sich überlappen
-      for (unsigned int i = result; i < result + tmp; i++) {
-        const Index* ind = &((*full_collection_levelwise)[k][i]);
-        if ( intersect_supports_simple(frame, lambda, *ind) ){
-	  intersecting.push_back(*ind);
-        }
-      }
+      for (std::vector<int>::const_iterator it(std::lower_bound(hits.begin(), hits.end(), (int)result));
+           it != hits.end() && *it < (int)(result + tmp); ++it)
+        intersecting.push_back((*full_collection_levelwise)[k][*it]);
 
       // berechnet wie viele Indizes von dem jeweiligen Typ in Patches nach p liegen     
       result += tmp;
@@ -1421,13 +1426,9 @@ namespace FrameTL
     std::list<typename Frame::Index> intersect_diff;
 
     const Array1D<Array1D<Index> >* full_collection_levelwise = frame.get_full_collection_levelwise();
-    for (unsigned int i = 0; i < (*full_collection_levelwise)[k].size(); i++) {
-      const Index* ind = &((*full_collection_levelwise)[k][i]);
-      if ( (ind->p() == p) && 
-	   intersect_supports_simple(frame, lambda, *ind) ){
-	intersecting.push_back(*ind);
-      }
-    }
+    for (std::vector<int>::const_iterator it(hits.begin()); it != hits.end(); ++it)
+      if ((*full_collection_levelwise)[k][*it].p() == p)
+	intersecting.push_back((*full_collection_levelwise)[k][*it]);
     } //end else
 #else
 
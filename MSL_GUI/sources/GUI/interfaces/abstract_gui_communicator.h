@@ -28,6 +28,7 @@
 #define ABSTRACT_GUI_COMMUNICATOR_H
 
 #include <QObject>
+#include <QVector>
 
 #include "computation_state_enums.h"
 
@@ -41,38 +42,55 @@ class AbstractGuiCommunicator : public QObject
 public:
     virtual ~AbstractGuiCommunicator() {}
 
-    virtual bool gotAbortRequest() const = 0;
+    virtual bool gotAbortRequest(int computationNo) const = 0;
+
+    /*
+     * count > 1 switches to the service mode: up to count coefficient or plot computations
+     * run concurrently on a thread pool, and solution plots are delivered progressively
+     * at increasing resolution. count <= 1 restores the sequential mode, in which the
+     * computations are run one after another in the thread of the communicator.
+     */
+    virtual void setMaxConcurrentComputations(int count) = 0;
 
 signals:
     virtual void coeffComputationEnded(int computationNo, CoeffComputationState::Enum endState) const = 0;
     virtual void plotComputationEnded(int computationNo, PlotComputationState::Enum endState, int resolution) const = 0;
 
-    virtual void convergencePlotDataPairComputed(double supportsize, double error) const = 0;
-    virtual void convergenceTimePlotDataPairComputed(double seconds, double error) const = 0;
+    virtual void convergencePlotDataPairComputed(int computationNo, double supportsize, double error) const = 0;
+    virtual void convergenceTimePlotDataPairComputed(int computationNo, double seconds, double error) const = 0;
 
     virtual void solutionSaved(int computationNo, const QStringList& availableOptionalLogs) const = 0;
 
     virtual void matrixNormsComputed(int computationNo, double norm_A, double norm_Ainv) const = 0;
 
     /*
-     * xValues and yValues are C-arrays which hold the x- and y-Values of a solution plot part on a single patch.
-     * samplingPointCount is the number of (x,y)-data pairs, hence the length of the C-arrays xValues and yValues.
+     * xValues and yValues hold the x- and y-Values of a solution plot part on a single patch,
+     * their common length is the number of (x,y)-data pairs.
      * newPlot indicates wether the data belongs to (the first patch of) a new solution plot for the given
      * computation number or to a plot for that number which in parts has already been delivered to the GUI.
+     * The data is passed by value (QVector is implicitly shared), so the plugin may overwrite
+     * its own plot data while the GUI is still processing it.
      */
-    virtual void dataFor1DSolutionPlotComputed(int computationNo, const double* xValues,
-                                               const double* yValues, int samplingPointCount, bool newPlot) const = 0;
+    virtual void dataFor1DSolutionPlotComputed(int computationNo, const QVector<double>& xValues,
+                                               const QVector<double>& yValues, bool newPlot) const = 0;
     /*
      * Data for a 2D solution plot patch is supposed to be laid out on a rectangular grid.
-     * Then xValues, yValues and zValues are C-arrays which hold the x-, y- and z-Values
+     * Then xValues, yValues and zValues hold the x-, y- and z-Values
      * in column major ordering on that grid (rows run in x-direction, columns in y-direction).
      * sampleCountX and sampleCountY are the numbers of different(!) x-values and y-Values on the grid,
      * hence sampleCountX is the number of columns and sampleCountY is the number of rows of that grid.
      * newPlot indicates wether the data belongs to (the first patch of) a new solution plot for the given
      * computation number or to a plot for that number which in parts has already been delivered to the GUI.
      */
-    virtual void dataFor2DSolutionPlotComputed(int computationNo, const double* xValues, const double* yValues,
-                                               const double* zValues, int sampleCountX, int sampleCountY, bool newPlot) const = 0;
+    virtual void dataFor2DSolutionPlotComputed(int computationNo, const QVector<double>& xValues,
+                                               const QVector<double>& yValues, const QVector<double>& zValues,
+                                               int sampleCountX, int sampleCountY, bool newPlot) const = 0;
+
+    /*
+     * In service mode, a solution plot is first delivered at coarser resolutions. This signal is
+     * emitted after all patches of such a preliminary plot have been delivered.
+     */
+    virtual void solutionPlotRefined(int computationNo, int resolution) const = 0;
 
     virtual void statusMessageGenerated(const QString& str) const = 0;
     virtual void errorOccured(const QString& errorMessage) const = 0;
@@ -53,7 +53,7 @@ public:
 };
 
 
-#define MslGuiPluginInterface_iid "MslGui.PluginInterface/1.0"
+#define MslGuiPluginInterface_iid "MslGui.PluginInterface/1.1"
 
 Q_DECLARE_INTERFACE(MslGuiPluginInterface, MslGuiPluginInterface_iid)
 
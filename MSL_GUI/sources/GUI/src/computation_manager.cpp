@@ -137,7 +137,7 @@ int ComputationManager::getSelectedComputationNumber() const
 
 
 
-QList<int> ComputationManager::getComputationNumbers(int& runningComputationNo) const
+QList<int> ComputationManager::getComputationNumbers(QList<int>& runningComputationNos) const
 {
     QList<int> list;
     for (const auto& pair : computationLogs_)
@@ -145,13 +145,22 @@ QList<int> ComputationManager::getComputationNumbers(int& runningComputationNo)
         list.append(pair.first);
         if ((pair.second.coeffState == CoeffComputationState::RUNNING)
              || (pair.second.plotState == PlotComputationState::RUNNING))
-            runningComputationNo = pair.first;
+            runningComputationNos.append(pair.first);
     }
     return list;
 }
 
 
 
+bool ComputationManager::hasRunningComputations() const
+{
+    QList<int> runningComputationNos;
+    getComputationNumbers(runningComputationNos);
+    return !runningComputationNos.isEmpty();
+}
+
+
+
 void ComputationManager::handleEndOfCoeffComputation(int computationNo, CoeffComputationState::Enum endState)
 {
     QString statusTableEntry;
@@ -197,7 +206,7 @@ void ComputationManager::handleEndOfCoeffComputation(int computationNo, CoeffCom
     }
     else
     {
-        progressBar_->setVisible(false);
+        progressBar_->setVisible(hasRunningComputations());
         statusBar_->showMessage(coeffEndState, 8000);
         emit computationEnded();
     }
@@ -236,7 +245,7 @@ void ComputationManager::handleEndOfPlotComputation(int computationNo, PlotCompu
     computationTable_->setPlotEntry(computationNo, plotTableEntry);
     statusBox_->showPlotComputingEnded(plotEndState);
 
-    progressBar_->setVisible(false);
+    progressBar_->setVisible(hasRunningComputations());
     statusBar_->showMessage(plotEndState, 8000);
     emit computationEnded();
 }
@@ -67,7 +67,8 @@ public:
     void deleteComputation(int computationNo);
     int getSelectedComputationNumber() const;
 
-    QList<int> getComputationNumbers(int& runningComputationNo) const;
+    QList<int> getComputationNumbers(QList<int>& runningComputationNos) const;
+    bool hasRunningComputations() const;
 
 signals:
     void coeffComputationRequested(AbstractProblemTypeModule* problemType, const GuiInputData& input) const;
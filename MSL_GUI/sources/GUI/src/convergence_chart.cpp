@@ -58,7 +58,6 @@ ConvergenceChart::ConvergenceChart(const QString& title, const QString& xAxisTit
 
 void ConvergenceChart::addNewSeries(int computationNo, const QString& calloutText, const QColor& color)
 {
-    currentComputationNo_ = computationNo;
     QLineSeries* newSeries = new QLineSeries();
     newSeries->setName(QString("Computation %1").arg(computationNo));
     newSeries->setColor(color);
@@ -138,24 +137,24 @@ void ConvergenceChart::adjustAxesRangesToVisibleSeries()
 
 
 
-void ConvergenceChart::addDataToCurrentSeries(double x, double y)
+void ConvergenceChart::addDataToSeries(int computationNo, double x, double y)
 {
-    if (x <= 0.0 || y <= 0.0)
+    if (x <= 0.0 || y <= 0.0 || convPlots_.count(computationNo) == 0)
         return;
 
-    ConvergencePlot& currentPlot = convPlots_.at(currentComputationNo_);
-    currentPlot.series->append(x, y);
+    ConvergencePlot& plot = convPlots_.at(computationNo);
+    plot.series->append(x, y);
 
-    if (x < currentPlot.xMin)
-        currentPlot.xMin = x;
-    if (x > currentPlot.xMax)
-        currentPlot.xMax = x;
-    if (y < currentPlot.yMin)
-        currentPlot.yMin = y;
-    if (y > currentPlot.yMax)
-        currentPlot.yMax = y;
+    if (x < plot.xMin)
+        plot.xMin = x;
+    if (x > plot.xMax)
+        plot.xMax = x;
+    if (y < plot.yMin)
+        plot.yMin = y;
+    if (y > plot.yMax)
+        plot.yMax = y;
 
-    if (currentPlot.series->isVisible())
+    if (plot.series->isVisible())
     {
         if (x < axisX_->min())
             axisX_->setMin(x);
@@ -47,7 +47,7 @@ public:
     void adjustAxesRangesToVisibleSeries();
 
 public slots:
-    void addDataToCurrentSeries(double x, double y);
+    void addDataToSeries(int computationNo, double x, double y);
 
 protected:
     void mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event) override;
@@ -64,7 +64,6 @@ private:
     };
 
     std::map<int, ConvergencePlot> convPlots_;    // maps computation numbers to convergence plots
-    int currentComputationNo_;
     //const qreal xMinDefault_, xMaxDefault_, yMinDefault_, yMaxDefault_;
 
 
@@ -54,6 +54,7 @@ MainWindow::MainWindow(QWidget* parent) :
     infoAboutDialog_(nullptr),
     computationNumber_(1),
     computationIsRunning_(false),
+    concurrentComputations_(false),
     selectedComputation_(nullptr)
 {
     if (!loadPlugin())
@@ -91,6 +92,7 @@ MainWindow::MainWindow(QWidget* parent) :
     qRegisterMetaType<CoeffComputationState::Enum>("CoeffComputationState::Enum");
     qRegisterMetaType<PlotComputationState::Enum>("PlotComputationState::Enum");
     qRegisterMetaType<GuiInputData>("GuiInputData");
+    qRegisterMetaType< QVector<double> >("QVector<double>");
     setupAdditionalConnections();
 
     plugin_->initProblemTypeModules();
@@ -204,11 +206,11 @@ void MainWindow::setupAdditionalConnections()
     && connect(computationManager_, &ComputationManager::computationEnded,
                this, &MainWindow::handleEndOfComputation)
 
-    && connect(guiCommunicator_, SIGNAL(convergencePlotDataPairComputed(double,double)),
-               plotManager_, SLOT(addToCurrentConvPlot(double,double)))
+    && connect(guiCommunicator_, SIGNAL(convergencePlotDataPairComputed(int,double,double)),
+               plotManager_, SLOT(addToConvPlot(int,double,double)))
 
-    && connect(guiCommunicator_, SIGNAL(convergenceTimePlotDataPairComputed(double,double)),
-               plotManager_, SLOT(addToCurrentConvTimePlot(double,double)))
+    && connect(guiCommunicator_, SIGNAL(convergenceTimePlotDataPairComputed(int,double,double)),
+               plotManager_, SLOT(addToConvTimePlot(int,double,double)))
 
     && connect(ui_->computationTable, &ComputationTable::checkboxToogled,
                plotManager_, &PlotManager::toggleConvPlotsVisibility)
@@ -219,11 +221,14 @@ void MainWindow::setupAdditionalConnections()
     && connect(guiCommunicator_, SIGNAL(statusMessageGenerated(const QString&)),
             this, SLOT(showStatusMessage(const QString&)))
 
-    && connect(guiCommunicator_, SIGNAL(dataFor1DSolutionPlotComputed(int,const double*,const double*,int,bool)),
-               plotManager_, SLOT(setup1DsolutionPlotPatch(int,const double*,const double*,int,bool)))
+    && connect(guiCommunicator_, SIGNAL(dataFor1DSolutionPlotComputed(int,QVector<double>,QVector<double>,bool)),
+               plotManager_, SLOT(setup1DsolutionPlotPatch(int,QVector<double>,QVector<double>,bool)))
 
-    && connect(guiCommunicator_, SIGNAL(dataFor2DSolutionPlotComputed(int,const double*,const double*,const double*,int,int,bool)),
-               plotManager_, SLOT(setup2DsolutionPlotPatch(int,const double*,const double*,const double*,int,int,bool)))
+    && connect(guiCommunicator_, SIGNAL(dataFor2DSolutionPlotComputed(int,QVector<double>,QVector<double>,QVector<double>,int,int,bool)),
+               plotManager_, SLOT(setup2DsolutionPlotPatch(int,QVector<double>,QVector<double>,QVector<double>,int,int,bool)))
+
+    && connect(guiCommunicator_, SIGNAL(solutionPlotRefined(int,int)),
+               this, SLOT(handleSolutionPlotRefined(int,int)))
 
     && connect(ui_->pushButton_addProblem, &QPushButton::clicked,
                problemDefinitionManager_, &ProblemDefinitionManager::handleAddNewProblemDefinitionClicked)
@@ -449,8 +454,8 @@ void MainWindow::handleNoProblemSelected()
 
 void MainWindow::handleEndOfComputation()
 {
-    ui_->pushButton_start->setEnabled(true);
-    computationIsRunning_ = false;
+    computationIsRunning_ = computationManager_->hasRunningComputations();
+    ui_->pushButton_start->setEnabled(concurrentComputations_ || !computationIsRunning_);
     adaptToSelectedComputation();
 }
 
@@ -464,6 +469,18 @@ void MainWindow::handleComputationSelected(const ComputationLogData* log)
 
 
 
+void MainWindow::handleSolutionPlotRefined(int computationNo, int resolution)
+{
+    if (selectedComputation_ && selectedComputation_->input.computationNumber == computationNo)
+    {
+        plotManager_->showSolutionPlot(computationNo);
+    }
+    showStatusMessage(QStringLiteral("Computation %1: preliminary solution plot (resolution %2) "
+                                     "available, refining...").arg(computationNo).arg(resolution));
+}
+
+
+
 void MainWindow::adaptToSelectedComputation()
 {
     if (selectedComputation_)
@@ -478,7 +495,10 @@ void MainWindow::adaptToSelectedComputation()
             ui_->pushButton_deleteComputationEntry->setEnabled(true);
         }
 
-        if (computationIsRunning_ || selectedComputation_->coeffState == CoeffComputationState::ERROR_PROBLEM_CREATION
+        if ((computationIsRunning_ && !concurrentComputations_)
+            || selectedComputation_->coeffState == CoeffComputationState::RUNNING
+            || selectedComputation_->plotState == PlotComputationState::RUNNING
+            || selectedComputation_->coeffState == CoeffComputationState::ERROR_PROBLEM_CREATION
             || selectedComputation_->coeffState == CoeffComputationState::ERROR_NO_SOLUTION_CREATED)
         {
             ui_->pushButton_computeSolutionPlotSamples->setEnabled(false);
@@ -602,10 +622,11 @@ void MainWindow::on_pushButton_start_clicked()
         }
     }
 
-    ui_->pushButton_start->setEnabled(false);
+    ui_->pushButton_start->setEnabled(concurrentComputations_);
     ui_->pushButton_computeSolutionPlotSamples->setEnabled(false);
+    if (!computationIsRunning_)
+        ui_->textEdit_runningComputationTextLog->clear();
     computationIsRunning_ = true;
-    ui_->textEdit_runningComputationTextLog->clear();
     ui_->textEdit_runningComputationTextLog->append(QString("<span style=\" font-style:italic; text-decoration: underline;\">Computation %1</span><br>").arg(computationNumber_));
 
 
@@ -719,7 +740,7 @@ void MainWindow::on_pushButton_computeSolutionPlotSamples_clicked()
                                           "Plot sampling resolution:", defaultResolution, 1, 21, 1, &ok);
     if (ok)
     {
-        ui_->pushButton_start->setEnabled(false);
+        ui_->pushButton_start->setEnabled(concurrentComputations_);
         computationIsRunning_ = true;
         computationManager_->startNewPlotComputation(selectedComputation_->input.computationNumber,
                                                      resolution, false);
@@ -804,8 +825,8 @@ void MainWindow::on_checkBox_plotSolution_toggled(bool checked)
 
 void MainWindow::on_actionClear_computation_history_triggered()
 {
-    int runningComputationNo = -1;
-    QList<int> computationNoList = computationManager_->getComputationNumbers(runningComputationNo);
+    QList<int> runningComputationNos;
+    QList<int> computationNoList = computationManager_->getComputationNumbers(runningComputationNos);
 
     if (computationNoList.isEmpty())
         return;
@@ -816,7 +837,7 @@ void MainWindow::on_actionClear_computation_history_triggered()
 
     if (computationIsRunning_)
         question = QStringLiteral("Do you really want to delete all computation "
-                                  "entries (except for the running computation)?");
+                                  "entries (except for the running computations)?");
     else
         question = QStringLiteral("Do you really want to delete all computation "
                                   "entries?");
@@ -828,7 +849,7 @@ void MainWindow::on_actionClear_computation_history_triggered()
 
     for (int computationNo : computationNoList)
     {
-        if (computationNo != runningComputationNo)
+        if (!runningComputationNos.contains(computationNo))
         {
             plotManager_->removeConvergencePlots(computationNo);
             plotManager_->removeSolutionPlot(computationNo);
@@ -840,6 +861,20 @@ void MainWindow::on_actionClear_computation_history_triggered()
 
 
 
+void MainWindow::on_actionConcurrent_computations_toggled(bool checked)
+{
+    concurrentComputations_ = checked;
+
+    // In service mode, the plugin runs up to one computation per core at once and
+    // shares the wavelet systems between computations on the same discretization.
+    guiCommunicator_->setMaxConcurrentComputations(checked ? std::max(2, QThread::idealThreadCount()) : 1);
+
+    ui_->pushButton_start->setEnabled(concurrentComputations_ || !computationIsRunning_);
+    adaptToSelectedComputation();
+}
+
+
+
 void MainWindow::on_actionDefining_custom_problems_triggered()
 {
     if (!infoDefiningDialog_)
@@ -70,6 +70,8 @@ private slots:
 
     void handleComputationSelected(const ComputationLogData* log);
 
+    void handleSolutionPlotRefined(int computationNo, int resolution);
+
     void adaptToSelectedComputation();
 
     void showErrorMessage(const QString& message);
@@ -98,6 +100,8 @@ private slots:
 
     void on_actionClear_computation_history_triggered();
 
+    void on_actionConcurrent_computations_toggled(bool checked);
+
     void on_actionDefining_custom_problems_triggered();
 
     void on_actionControls_triggered();
@@ -133,6 +137,7 @@ private:
     QThread workerThread_;
 
     bool computationIsRunning_;
+    bool concurrentComputations_;   // service mode of the plugin
     const ComputationLogData* selectedComputation_;
 };
 
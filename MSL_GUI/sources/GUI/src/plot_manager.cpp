@@ -117,16 +117,16 @@ void PlotManager::removeSolutionPlot(int computationNo)
 
 
 
-void PlotManager::addToCurrentConvPlot(double x, double y)
+void PlotManager::addToConvPlot(int computationNo, double x, double y)
 {
-    convergenceChart_->addDataToCurrentSeries(x, y);
+    convergenceChart_->addDataToSeries(computationNo, x, y);
 }
 
 
 
-void PlotManager::addToCurrentConvTimePlot(double x, double y)
+void PlotManager::addToConvTimePlot(int computationNo, double x, double y)
 {
-    convergenceTimeChart_->addDataToCurrentSeries(x, y);
+    convergenceTimeChart_->addDataToSeries(computationNo, x, y);
 }
 
 
@@ -139,9 +139,11 @@ void PlotManager::toggleConvPlotsVisibility(int computationNo)
 
 
 
-void PlotManager::setup1DsolutionPlotPatch(int computationNo, const double* xValues, const double* yValues,
-                                           int samplingPointCount, bool newPlot)
+void PlotManager::setup1DsolutionPlotPatch(int computationNo, const QVector<double>& xValues,
+                                           const QVector<double>& yValues, bool newPlot)
 {
+    int samplingPointCount = xValues.size();
+
     QLineSeries* solPlotPatch = new QLineSeries();
     solPlotPatch->setColor(ComputationTable::getColorForComputation(computationNo));
     QPen pen = solPlotPatch->pen();
@@ -212,8 +214,8 @@ void PlotManager::setup1DsolutionPlotPatch(int computationNo, const double* xVal
 
 
 
-void PlotManager::setup2DsolutionPlotPatch(int computationNo, const double* xValues, const double* yValues,
-                                           const double* zValues, int sampleCountX, int sampleCountY, bool newPlot)
+void PlotManager::setup2DsolutionPlotPatch(int computationNo, const QVector<double>& xValues, const QVector<double>& yValues,
+                                           const QVector<double>& zValues, int sampleCountX, int sampleCountY, bool newPlot)
 {
     QSurface3DSeries* solPlotPatch = new QSurface3DSeries();
 
@@ -53,16 +53,16 @@ public:
 signals:
 
 public slots:
-    void addToCurrentConvPlot(double x, double y);
-    void addToCurrentConvTimePlot(double x, double y);
+    void addToConvPlot(int computationNo, double x, double y);
+    void addToConvTimePlot(int computationNo, double x, double y);
 
     void toggleConvPlotsVisibility(int computationNo);
 
-    void setup1DsolutionPlotPatch(int computationNo, const double* xValues, const double* yValues,
-                                  int samplingPointCount, bool newPlot);
+    void setup1DsolutionPlotPatch(int computationNo, const QVector<double>& xValues,
+                                  const QVector<double>& yValues, bool newPlot);
 
-    void setup2DsolutionPlotPatch(int computationNo, const double* xValues, const double* yValues,
-                                  const double* zValues, int sampleCountX, int sampleCountY, bool newPlot);
+    void setup2DsolutionPlotPatch(int computationNo, const QVector<double>& xValues, const QVector<double>& yValues,
+                                  const QVector<double>& zValues, int sampleCountX, int sampleCountY, bool newPlot);
 
     void showSolutionPlot(int computationNo);
 
@@ -31,6 +31,7 @@
 
 #include "misc/typelist.h"
 #include "abstract_discretized_problem.h"
+#include "shared_wavelet_systems.h"
 #include "solution/abstract_solution.h"
 #include "solution/solution_tools.h"
 #include "GUI/interfaces/gui_inputdata.h"
@@ -153,7 +154,7 @@ computeSolution(const QString& method, double epsilon, int jmax, const AbstractG
     bool aborted = false;
     bool errorOccured = false;
 
-    GuiConvergenceLogger* logger = new GuiConvergenceLogger(communicator);
+    GuiConvergenceLogger* logger = new GuiConvergenceLogger(communicator, lastInput_.computationNumber);
 
     try
     {
@@ -259,7 +260,9 @@ setupProblem(const GuiInputData& input, const RAW_PROBLEM& rawProblem)
 {
     lastInput_ = input;
 
-    wsystem_.reset(createWaveletSystem(input.jmax));
+    // problems on the same discretization share their wavelet system:
+    wsystem_ = SharedWaveletSystems::get<WaveletSystem>(input, [this, &input]()
+                                                        { return createWaveletSystem(input.jmax); });
 
     EQUATION* equation = createDiscretizedEquation(rawProblem, *wsystem_);
 
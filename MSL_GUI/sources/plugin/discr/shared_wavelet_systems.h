@@ -0,0 +1,175 @@
+/*  -*- c++ -*-
+
+   +-----------------------------------------------------------------------+
+   | MSL GUI - A Graphical User Interface for the Marburg Software Library |
+   |                                                                       |
+   | Copyright (C) 2018 Henning Zickermann                                 |
+   | Contact: <zickermann@mathematik.uni-marburg.de>                       |
+   +-----------------------------------------------------------------------+
+
+     This file is part of MSL GUI.
+
+     MSL GUI is free software: you can redistribute it and/or modify
+     it under the terms of the GNU General Public License as published by
+     the Free Software Foundation, either version 3 of the License, or
+     (at your option) any later version.
+
+     MSL GUI is distributed in the hope that it will be useful,
+     but WITHOUT ANY WARRANTY; without even the implied warranty of
+     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+     GNU General Public License for more details.
+
+     You should have received a copy of the GNU General Public License
+     along with MSL GUI.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SHARED_WAVELET_SYSTEMS_H
+#define SHARED_WAVELET_SYSTEMS_H
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "GUI/interfaces/gui_inputdata.h"
+
+
+namespace WaveletTL {
+
+template <int d, int dT>
+class PBasis;
+
+template <class IBASIS, unsigned int DIM>
+class CubeBasis;
+
+}
+
+namespace FrameTL {
+
+template <class IBASIS, unsigned int DIM_d, unsigned int DIM_m>
+class AggregatedFrame;
+
+}
+
+
+/*
+ * Registry of the wavelet systems (bases, quarklet frames, aggregated frames) which are in use
+ * by discretized problems or solutions. Discretized problems on the same discretization
+ * (same domain, problem type, wavelet system type, 1D basis, jmax, pmax and overlap) share
+ * one wavelet system instead of setting up their own one. This also holds for computations
+ * running concurrently, hence the wavelet systems must only be used read-only after their setup.
+ * Parts of a wavelet system which are set up lazily on first use (the piecewise polynomial
+ * expansions of PBasis, if switched on) are therefore completed before the wavelet system
+ * is handed out, see completeSetup().
+ *
+ * The registry holds weak references only, so a wavelet system is destroyed as soon as the
+ * last problem or solution using it has been deleted.
+ */
+class SharedWaveletSystems
+{
+public:
+
+    /* Returns the wavelet system of type WSYSTEM for the discretization given by "input".
+     * If there is none yet, it is created by calling "create()". Setups are serialized,
+     * so that a wavelet system requested by several computations at once is created only once. */
+    template <class WSYSTEM, class FACTORY>
+    static std::shared_ptr<WSYSTEM> get(const GuiInputData& input, FACTORY create)
+    {
+        const std::string key = std::string(typeid(WSYSTEM).name()) + '|' + discretizationKey(input);
+
+        QMutexLocker locker(&mutex());
+
+        std::weak_ptr<void>& entry = registry()[key];
+        std::shared_ptr<WSYSTEM> wsystem = std::static_pointer_cast<WSYSTEM>(entry.lock());
+
+        if (!wsystem)
+        {
+            wsystem.reset(create());
+            completeSetup(*wsystem, input.jmax);
+            entry = wsystem;
+        }
+
+        removeExpiredEntries();
+
+        return wsystem;
+    }
+
+private:
+
+    /* Completes the lazy parts of the setup of a wavelet system up to level jmax.
+     * Wavelet systems without such parts need nothing to be done. */
+    template <class WSYSTEM>
+    static void completeSetup(const WSYSTEM&, int)
+    {
+    }
+
+    template <int d, int dT>
+    static void completeSetup(const WaveletTL::PBasis<d,dT>& basis, int jmax)
+    {
+        if (basis.get_evaluate_with_pre_computation())
+        {
+            const int jlast = std::min(jmax, (int)basis.wavelets.size()-1);
+            for (int j = basis.j0(); j <= jlast; j++)
+                basis.wavelets_on_level(j);
+        }
+    }
+
+    template <class IBASIS, unsigned int DIM>
+    static void completeSetup(const WaveletTL::CubeBasis<IBASIS,DIM>& basis, int jmax)
+    {
+        // jmax bounds the level in each coordinate direction
+        for (unsigned int i = 0; i < DIM; i++)
+            completeSetup(*basis.bases()[i], jmax);
+    }
+
+    template <class IBASIS, unsigned int DIM_d, unsigned int DIM_m>
+    static void completeSetup(const FrameTL::AggregatedFrame<IBASIS,DIM_d,DIM_m>& frame, int jmax)
+    {
+        // the patches are MappedCubeBasis objects, set up as cube bases
+        for (unsigned int p = 0; p < frame.bases().size(); p++)
+            completeSetup(static_cast<const WaveletTL::CubeBasis<IBASIS,DIM_d>&>(*frame.bases()[p]), jmax);
+    }
+
+    static std::string discretizationKey(const GuiInputData& input)
+    {
+        QString key = QString("%1|%2|%3|%4|%5|%6|%7").arg(input.domain, input.problemType)
+                                                     .arg(input.discretizationTypeIndex)
+                                                     .arg(input.basis1D)
+                                                     .arg(input.jmax)
+                                                     .arg(input.pmax)
+                                                     .arg(input.overlap);
+        return key.toStdString();
+    }
+
+    static void removeExpiredEntries()
+    {
+        auto it = registry().begin();
+        while (it != registry().end())
+        {
+            if (it->second.expired())
+                it = registry().erase(it);
+            else
+                ++it;
+        }
+    }
+
+    static std::map<std::string, std::weak_ptr<void> >& registry()
+    {
+        static std::map<std::string, std::weak_ptr<void> > wsystems;
+        return wsystems;
+    }
+
+    static QMutex& mutex()
+    {
+        static QMutex registryMutex;
+        return registryMutex;
+    }
+};
+
+
+#endif // SHARED_WAVELET_SYSTEMS_H
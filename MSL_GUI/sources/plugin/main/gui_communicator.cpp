@@ -24,6 +24,12 @@
 */
 
 
+#include <algorithm>
+#include <functional>
+
+#include <QMutexLocker>
+#include <QRunnable>
+
 #include "gui_communicator.h"
 #include "GUI/interfaces/abstract_problemtype_module.h"
 #include "GUI/interfaces/gui_inputdata.h"
@@ -31,34 +37,75 @@
 
 
 
+namespace
+{
+
+// A coefficient or plot computation executed by the thread pool in service mode
+class ComputationTask : public QRunnable
+{
+public:
+    explicit ComputationTask(const std::function<void()>& computation)
+        : computation_(computation) { }
+
+    void run() override
+    {
+        computation_();
+    }
+
+private:
+    std::function<void()> computation_;
+};
+
+
+
+QVector<double> copyToQVector(const double* values, int count)
+{
+    QVector<double> vector(count);
+    std::copy(values, values + count, vector.begin());
+    return vector;
+}
+
+}
+
+
+
 GuiCommunicator::GuiCommunicator() :
-    abortRequested_(false),
-    lastDiscretizedProblem_()
+    maxConcurrentComputations_(1)
 {
+    servicePool_.setMaxThreadCount(1);
+}
+
+
 
+GuiCommunicator::~GuiCommunicator()
+{
+    requestAbort();
+    servicePool_.waitForDone();
 }
 
 
 
 void GuiCommunicator::sendPlotDataToGui(const MathTL::SampledMapping<1>& plotData, int computationNo, bool newPlot) const
 {
-    const double* xValues = plotData.points().begin();
-    const double* yValues = plotData.values().begin();
     int sampleCount = int (plotData.size());
 
-    emit dataFor1DSolutionPlotComputed(computationNo, xValues, yValues, sampleCount, newPlot);
+    QVector<double> xValues = copyToQVector(plotData.points().begin(), sampleCount);
+    QVector<double> yValues = copyToQVector(plotData.values().begin(), sampleCount);
+
+    emit dataFor1DSolutionPlotComputed(computationNo, xValues, yValues, newPlot);
 }
 
 
 
 void GuiCommunicator::sendPlotDataToGui(const MathTL::SampledMapping<2>& plotData, int computationNo, bool newPlot) const
 {
-    const double* xValues = plotData.gridx().entries_vector().begin();
-    const double* yValues = plotData.gridy().entries_vector().begin();
-    const double* zValues = plotData.values().entries_vector().begin();
-
     int sampleCountX = int (plotData.gridx().column_dimension());
     int sampleCountY = int (plotData.gridx().row_dimension());
+    int sampleCount = sampleCountX*sampleCountY;
+
+    QVector<double> xValues = copyToQVector(plotData.gridx().entries_vector().begin(), sampleCount);
+    QVector<double> yValues = copyToQVector(plotData.gridy().entries_vector().begin(), sampleCount);
+    QVector<double> zValues = copyToQVector(plotData.values().entries_vector().begin(), sampleCount);
 
     emit dataFor2DSolutionPlotComputed(computationNo, xValues, yValues, zValues, sampleCountX, sampleCountY, newPlot);
 
@@ -94,9 +141,24 @@ void GuiCommunicator::sendPlotDataToGui(const MathTL::Array1D< MathTL::SampledMa
 
 
 
-bool GuiCommunicator::gotAbortRequest() const
+bool GuiCommunicator::gotAbortRequest(int computationNo) const
 {
-    return abortRequested_;
+    QMutexLocker locker(&mutex_);
+    return abortRequests_.count(computationNo) > 0;
+}
+
+
+
+void GuiCommunicator::setMaxConcurrentComputations(int count)
+{
+    count = std::max(count, 1);
+
+    maxConcurrentComputations_ = count;
+    servicePool_.setMaxThreadCount(count);
+
+    QMutexLocker locker(&mutex_);
+    while (int (idleProblems_.size()) > count)
+        idleProblems_.pop_back();
 }
 
 
@@ -104,78 +166,76 @@ bool GuiCommunicator::gotAbortRequest() const
 void GuiCommunicator::computeSolutionCoeffs(AbstractProblemTypeModule* problemType,
                                             const GuiInputData& input)
 {
-    abortRequested_ = false;
+    if (maxConcurrentComputations_ > 1)
+    {
+        servicePool_.start(new ComputationTask([this, problemType, input]()
+                                               { runCoeffComputation(problemType, input); }));
+    }
+    else
+    {
+        runCoeffComputation(problemType, input);
+    }
+}
 
-    bool canReuseLastProblem = input.reuse_if_possible &&
-                               (lastDiscretizedProblem_ != nullptr) &&
-                               lastDiscretizedProblem_->canBeReusedFor(input);
 
-    if (canReuseLastProblem) {
-        try
-        {
-            lastDiscretizedProblem_->updateTo(input);
-            emit statusMessageGenerated("Reusing last discretized problem.");
-        }
-        catch(const std::exception& theException)
-        {
-            QString errorMessage("Error while trying to update last "
-                                 "discretized problem to new input:\n");
-            errorMessage.append(QString(theException.what()));
-            emit statusMessageGenerated(errorMessage);
-            lastDiscretizedProblem_.reset();
-            canReuseLastProblem = false;
-        }
-        catch(...)
-        {
-            QString errorMessage("Unknown error while trying to update last "
-                                 "discretized problem to new input.");
-            emit statusMessageGenerated(errorMessage);
-            lastDiscretizedProblem_.reset();
-            canReuseLastProblem = false;
-        }
+
+void GuiCommunicator::requestAbort()
+{
+    QMutexLocker locker(&mutex_);
+    abortRequests_ = runningComputations_;
+}
+
+
+
+void GuiCommunicator::computeSolutionPlot(int computationNo, int resolution)
+{
+    if (maxConcurrentComputations_ > 1)
+    {
+        servicePool_.start(new ComputationTask([this, computationNo, resolution]()
+                                               { runPlotComputation(computationNo, resolution, true); }));
+    }
+    else
+    {
+        runPlotComputation(computationNo, resolution, false);
     }
+}
 
-    if (!canReuseLastProblem) {
 
-        AbstractDiscretizedProblem* newProblem;
 
-        try
-        {
-            newProblem = problemType->createDiscretizedProblem(input);
-        }
-        catch(const std::exception& theException)
-        {
-            QString errorMessage("Error during creation of discretized problem:\n\n");
-            errorMessage.append(QString(theException.what()));
-            emit errorOccured(errorMessage);
-            emit coeffComputationEnded(input.computationNumber, CoeffComputationState::ERROR_PROBLEM_CREATION);
-            return;
-        }
-        catch(...)
-        {
-            QString errorMessage("Unknown error during creation of discretized problem.");
-            emit errorOccured(errorMessage);
-            emit coeffComputationEnded(input.computationNumber, CoeffComputationState::ERROR_PROBLEM_CREATION);
-            return;
-        }
+void GuiCommunicator::runCoeffComputation(AbstractProblemTypeModule* problemType,
+                                          const GuiInputData& input)
+{
+    beginComputation(input.computationNumber);
+
+    std::unique_ptr<AbstractDiscretizedProblem> problem = acquireDiscretizedProblem(problemType, input);
 
-        lastDiscretizedProblem_.reset(newProblem);
+    if (!problem)
+    {
+        endComputation(input.computationNumber);
+        emit coeffComputationEnded(input.computationNumber, CoeffComputationState::ERROR_PROBLEM_CREATION);
+        return;
     }
 
     AbstractSolution* newSolution;
     try
     {
-        newSolution = lastDiscretizedProblem_->computeSolution(input.method, input.epsilon, input.jmax, this);
+        newSolution = problem->computeSolution(input.method, input.epsilon, input.jmax, this);
     }
     catch(...)
     {
+        releaseDiscretizedProblem(std::move(problem));
+        endComputation(input.computationNumber);
+
         QString errorMessage("Error: Could not create solution object!");
         emit errorOccured(errorMessage);
         emit coeffComputationEnded(input.computationNumber, CoeffComputationState::ERROR_NO_SOLUTION_CREATED);
         return;
     }
 
-    solutions_[input.computationNumber] = std::unique_ptr<AbstractSolution>(newSolution);
+    {
+        QMutexLocker locker(&mutex_);
+        solutions_[input.computationNumber] = std::shared_ptr<AbstractSolution>(newSolution);
+    }
     emit solutionSaved(input.computationNumber, newSolution->getOptionalLogNames());
 
     CoeffComputationState::Enum endState;
@@ -195,35 +255,57 @@ void GuiCommunicator::computeSolutionCoeffs(AbstractProblemTypeModule* problemTy
             endState = CoeffComputationState::COMPLETE;
             if (!input.normEstimatesProvided)
             {
-                double norm_A = lastDiscretizedProblem_->norm_A();
-                double norm_Ainv = lastDiscretizedProblem_->norm_Ainv();
+                double norm_A = problem->norm_A();
+                double norm_Ainv = problem->norm_Ainv();
 
                 emit matrixNormsComputed(input.computationNumber, norm_A, norm_Ainv);
             }
         }
     }
 
+    releaseDiscretizedProblem(std::move(problem));
+    endComputation(input.computationNumber);
+
     emit coeffComputationEnded(input.computationNumber, endState);
 }
 
 
 
-void GuiCommunicator::requestAbort()
+void GuiCommunicator::runPlotComputation(int computationNo, int resolution, bool progressive)
 {
-    abortRequested_ = true;
-}
-
+    beginComputation(computationNo);
 
-
-void GuiCommunicator::computeSolutionPlot(int computationNo, int resolution)
-{
-    abortRequested_ = false;
+    std::shared_ptr<AbstractSolution> solution;
     try
     {
-        solutions_.at(computationNo)->computePlotData(resolution);
+        solution = getSolution(computationNo);
+
+        // preliminary plots at coarser resolutions, each one replacing the previous one:
+        int steps = 0;
+        if (progressive)
+            steps = progressivePlotSteps;
+
+        for (int step = steps; step > 0; step--)
+        {
+            int coarseResolution = resolution - 2*step;
+            if (coarseResolution < 1)
+                continue;
+
+            solution->computePlotData(coarseResolution);
+            if (gotAbortRequest(computationNo))
+                break;
+
+            solution->sendPlotDataToGuiVia(*this);
+            emit solutionPlotRefined(computationNo, coarseResolution);
+        }
+
+        if (!gotAbortRequest(computationNo))
+            solution->computePlotData(resolution);
     }
     catch(const std::exception& theException)
     {
+        endComputation(computationNo);
+
         QString errorMessage("Error during computation of plot data:\n\n");
         errorMessage.append(QString(theException.what()));
         emit errorOccured(errorMessage);
@@ -232,28 +314,137 @@ void GuiCommunicator::computeSolutionPlot(int computationNo, int resolution)
     }
     catch(...)
     {
+        endComputation(computationNo);
+
         QString errorMessage("Unknown error during computation of plot data.");
         emit errorOccured(errorMessage);
         emit plotComputationEnded(computationNo, PlotComputationState::ERROR, -1);
         return;
     }
 
-    if (gotAbortRequest()) {
+    bool aborted = gotAbortRequest(computationNo);
+    endComputation(computationNo);
+
+    if (aborted) {
         emit plotComputationEnded(computationNo, PlotComputationState::ABORTED, -1);
     }
     else {
-        solutions_.at(computationNo)->sendPlotDataToGuiVia(*this);
+        solution->sendPlotDataToGuiVia(*this);
         emit plotComputationEnded(computationNo, PlotComputationState::COMPLETE, resolution);
     }
 }
 
 
 
+void GuiCommunicator::beginComputation(int computationNo)
+{
+    QMutexLocker locker(&mutex_);
+    runningComputations_.insert(computationNo);
+    abortRequests_.erase(computationNo);
+}
+
+
+
+void GuiCommunicator::endComputation(int computationNo)
+{
+    QMutexLocker locker(&mutex_);
+    runningComputations_.erase(computationNo);
+    abortRequests_.erase(computationNo);
+}
+
+
+
+std::unique_ptr<AbstractDiscretizedProblem>
+GuiCommunicator::acquireDiscretizedProblem(AbstractProblemTypeModule* problemType, const GuiInputData& input)
+{
+    std::unique_ptr<AbstractDiscretizedProblem> problem;
+
+    if (input.reuse_if_possible)
+    {
+        QMutexLocker locker(&mutex_);
+        for (auto it = idleProblems_.begin(); it != idleProblems_.end(); ++it)
+        {
+            if ((*it)->canBeReusedFor(input))
+            {
+                problem = std::move(*it);
+                idleProblems_.erase(it);
+                break;
+            }
+        }
+    }
+
+    if (problem) {
+        try
+        {
+            problem->updateTo(input);
+            emit statusMessageGenerated("Reusing last discretized problem.");
+            return problem;
+        }
+        catch(const std::exception& theException)
+        {
+            QString errorMessage("Error while trying to update last "
+                                 "discretized problem to new input:\n");
+            errorMessage.append(QString(theException.what()));
+            emit statusMessageGenerated(errorMessage);
+            problem.reset();
+        }
+        catch(...)
+        {
+            QString errorMessage("Unknown error while trying to update last "
+                                 "discretized problem to new input.");
+            emit statusMessageGenerated(errorMessage);
+            problem.reset();
+        }
+    }
+
+    QMutexLocker locker(&setupMutex_);
+
+    try
+    {
+        problem.reset(problemType->createDiscretizedProblem(input));
+    }
+    catch(const std::exception& theException)
+    {
+        QString errorMessage("Error during creation of discretized problem:\n\n");
+        errorMessage.append(QString(theException.what()));
+        emit errorOccured(errorMessage);
+        problem.reset();
+    }
+    catch(...)
+    {
+        QString errorMessage("Unknown error during creation of discretized problem.");
+        emit errorOccured(errorMessage);
+        problem.reset();
+    }
+
+    return problem;
+}
+
+
+
+void GuiCommunicator::releaseDiscretizedProblem(std::unique_ptr<AbstractDiscretizedProblem> problem)
+{
+    QMutexLocker locker(&mutex_);
+    idleProblems_.push_front(std::move(problem));
+    while (int (idleProblems_.size()) > maxConcurrentComputations_)
+        idleProblems_.pop_back();
+}
+
+
+
+std::shared_ptr<AbstractSolution> GuiCommunicator::getSolution(int computationNo) const
+{
+    QMutexLocker locker(&mutex_);
+    return solutions_.at(computationNo);
+}
+
+
+
 void GuiCommunicator::exportSolutionPlotToMatlabFile(int computationNo, const QString& filename) const
 {
     try
     {
-        solutions_.at(computationNo)->writeSolutionPlotToMatlabFile(cStringFromQString(filename));
+        getSolution(computationNo)->writeSolutionPlotToMatlabFile(cStringFromQString(filename));
     }
     catch(const std::exception& theException)
     {
@@ -281,7 +472,7 @@ void GuiCommunicator::exportIndexPlotToMatlabFile(int computationNo, const QStri
 {
     try
     {
-        solutions_.at(computationNo)->writeIndexPlotToMatlabFile(cStringFromQString(filename));
+        getSolution(computationNo)->writeIndexPlotToMatlabFile(cStringFromQString(filename));
     }
     catch(const std::exception& theException)
     {
@@ -310,7 +501,7 @@ void GuiCommunicator::exportConvergenceLogsToMatlabFile(int computationNo, const
 {
     try
     {
-        solutions_.at(computationNo)->writeConvergenceLogsToMatlabFile(cStringFromQString(filename));
+        getSolution(computationNo)->writeConvergenceLogsToMatlabFile(cStringFromQString(filename));
     }
     catch(const std::exception& theException)
     {
@@ -340,7 +531,7 @@ void GuiCommunicator::exportOptionalLogToMatlabFile(int computationNo, int logIn
 {
     try
     {
-        solutions_.at(computationNo)->writeOptionalLogToMatlabFile(logIndex, cStringFromQString(filename));
+        getSolution(computationNo)->writeOptionalLogToMatlabFile(logIndex, cStringFromQString(filename));
     }
     catch(const std::exception& theException)
     {
@@ -367,5 +558,6 @@ void GuiCommunicator::exportOptionalLogToMatlabFile(int computationNo, int logIn
 
 void GuiCommunicator::deleteSolution(int computationNo)
 {
+    QMutexLocker locker(&mutex_);
     solutions_.erase(computationNo);
 }
@@ -27,7 +27,14 @@
 #ifndef GUI_COMMUNICATOR_H
 #define GUI_COMMUNICATOR_H
 
+#include <atomic>
+#include <list>
+#include <map>
 #include <memory>
+#include <set>
+
+#include <QMutex>
+#include <QThreadPool>
 
 #include "GUI/interfaces/abstract_gui_communicator.h"
 #include "MathTL/geometry/sampled_mapping.h"
@@ -43,6 +50,7 @@ class GuiCommunicator : public AbstractGuiCommunicator
     Q_OBJECT
 public:
     GuiCommunicator();
+    ~GuiCommunicator() override;
 
     void sendPlotDataToGui(const MathTL::SampledMapping<1>& plotData, int computationNo, bool newPlot = true) const;
     void sendPlotDataToGui(const MathTL::SampledMapping<2>& plotData, int computationNo, bool newPlot = true) const;
@@ -51,23 +59,28 @@ public:
 
 // Prescribed by AbstractGuiCommunicator:
 
-    bool gotAbortRequest() const override;
+    bool gotAbortRequest(int computationNo) const override;
+
+    void setMaxConcurrentComputations(int count) override;
 
 signals:
     void coeffComputationEnded(int computationNo, CoeffComputationState::Enum endState) const override;
     void plotComputationEnded(int computationNo, PlotComputationState::Enum endState, int resolution) const override;
 
-    void convergencePlotDataPairComputed(double supportsize, double error) const override;
-    void convergenceTimePlotDataPairComputed(double seconds, double error) const override;
+    void convergencePlotDataPairComputed(int computationNo, double supportsize, double error) const override;
+    void convergenceTimePlotDataPairComputed(int computationNo, double seconds, double error) const override;
 
     void solutionSaved(int computationNo, const QStringList& availableOptionalLogs) const override;
 
     void matrixNormsComputed(int computationNo, double norm_A, double norm_Ainv) const override;
 
-    void dataFor1DSolutionPlotComputed(int computationNo, const double* xValues, const double* yValues,
-                                       int sampleCount, bool newPlot) const override;
-    void dataFor2DSolutionPlotComputed(int computationNo, const double* xValues, const double* yValues,
-                                       const double* zValues, int sampleCountX, int sampleCountY, bool newPlot) const override;
+    void dataFor1DSolutionPlotComputed(int computationNo, const QVector<double>& xValues,
+                                       const QVector<double>& yValues, bool newPlot) const override;
+    void dataFor2DSolutionPlotComputed(int computationNo, const QVector<double>& xValues,
+                                       const QVector<double>& yValues, const QVector<double>& zValues,
+                                       int sampleCountX, int sampleCountY, bool newPlot) const override;
+
+    void solutionPlotRefined(int computationNo, int resolution) const override;
 
     void statusMessageGenerated(const QString& str) const override;
     void errorOccured(const QString& errorMessage) const override;
@@ -86,10 +99,37 @@ public slots:
     void deleteSolution(int computationNo) override;
 
 private:
-    bool abortRequested_;
+    void runCoeffComputation(AbstractProblemTypeModule* problemType, const GuiInputData& input);
+    void runPlotComputation(int computationNo, int resolution, bool progressive);
+
+    void beginComputation(int computationNo);
+    void endComputation(int computationNo);
+
+    /* Takes an idle discretized problem which can be reused for "input" out of the pool,
+     * or creates a new one. Returns nullptr (after signalling the error) if the creation failed. */
+    std::unique_ptr<AbstractDiscretizedProblem> acquireDiscretizedProblem(AbstractProblemTypeModule* problemType,
+                                                                          const GuiInputData& input);
+    void releaseDiscretizedProblem(std::unique_ptr<AbstractDiscretizedProblem> problem);
+
+    std::shared_ptr<AbstractSolution> getSolution(int computationNo) const;
+
+    // in service mode, preliminary plots are computed at resolution-2*k, k = progressivePlotSteps,...,1
+    static const int progressivePlotSteps = 2;
+
+    std::atomic<int> maxConcurrentComputations_;
+    QThreadPool servicePool_;
+
+    QMutex setupMutex_;     // serializes the creation of discretized problems
+    mutable QMutex mutex_;  // guards the following members
+
+    std::set<int> runningComputations_;
+    std::set<int> abortRequests_;
+
+    // idle discretized problems (with warm caches) for reuse, most recently used first;
+    // there are at most as many as computations can run concurrently
+    std::list< std::unique_ptr<AbstractDiscretizedProblem> > idleProblems_;
 
-    std::unique_ptr<AbstractDiscretizedProblem> lastDiscretizedProblem_;
-    std::map<int, std::unique_ptr<AbstractSolution> > solutions_;   // mapped by computationNumber
+    std::map<int, std::shared_ptr<AbstractSolution> > solutions_;   // mapped by computationNumber
 };
 
 #endif // GUI_COMMUNICATOR_H
@@ -28,9 +28,10 @@
 #include "GUI/interfaces/abstract_gui_communicator.h"
 
 
-GuiConvergenceLogger::GuiConvergenceLogger(const AbstractGuiCommunicator* communicator)
+GuiConvergenceLogger::GuiConvergenceLogger(const AbstractGuiCommunicator* communicator, int computationNo)
     : MathTL::ConvergenceLogger(true, true, true, true),
-      communicator_(communicator)
+      communicator_(communicator),
+      computationNo_(computationNo)
 {
 
 }
@@ -46,15 +47,15 @@ void GuiConvergenceLogger::logConvergenceData(double degrees_of_freedom, double
     lastApproxError_ = approx_error;
     iterations_++;
 
-    emit communicator_->convergencePlotDataPairComputed(degrees_of_freedom, approx_error);
-    emit communicator_->convergenceTimePlotDataPairComputed(elapsedSeconds, approx_error);
+    emit communicator_->convergencePlotDataPairComputed(computationNo_, degrees_of_freedom, approx_error);
+    emit communicator_->convergenceTimePlotDataPairComputed(computationNo_, elapsedSeconds, approx_error);
 }
 
 
 
 void GuiConvergenceLogger::checkAbortConditions()
 {
-    if (communicator_->gotAbortRequest())
+    if (communicator_->gotAbortRequest(computationNo_))
     {
         logMessage("\nComputation aborted by request!\n");
         throw abort_request();
@@ -36,7 +36,7 @@ class QString;
 class GuiConvergenceLogger : public MathTL::ConvergenceLogger
 {
 public:
-    GuiConvergenceLogger(const AbstractGuiCommunicator* communicator);
+    GuiConvergenceLogger(const AbstractGuiCommunicator* communicator, int computationNo);
 
     void logConvergenceData(double degrees_of_freedom, double approx_error) override;
     void checkAbortConditions() override;
@@ -46,6 +46,7 @@ public:
 
 private:
     const AbstractGuiCommunicator* communicator_;
+    const int computationNo_;
 };
 
 
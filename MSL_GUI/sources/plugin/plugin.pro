@@ -94,6 +94,7 @@ HEADERS  += discr/abstract_discretized_problem.h \
     discr/discretization_module_base.h \
     discr/discretization_module_guidata.h \
     discr/generic_discretized_problem.h \
+    discr/shared_wavelet_systems.h \
     discr/generic_basis_discretization_module.h \
     main/generic_problemtype_module.h \
     main/gui_communicator.h \
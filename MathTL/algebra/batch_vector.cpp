@@ -0,0 +1,212 @@
+// implementation for batch_vector.h
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+namespace MathTL
+{
+  template <unsigned int DIM>
+  BatchVector<DIM>::BatchVector(const size_type N)
+    : N_(N), values_(DIM*N)
+  {
+    operator = (0.0);
+  }
+
+  template <unsigned int DIM>
+  BatchVector<DIM>::BatchVector(const BatchVector<DIM>& v)
+    : N_(v.N_), values_(v.values_)
+  {
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchVector<DIM>::resize(const size_type N)
+  {
+    N_ = N;
+    values_.resize(DIM*N);
+    operator = (0.0);
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchVector<DIM>::get_system(const size_type s, Point<DIM>& x) const
+  {
+    assert(s < N_);
+    for (unsigned int i = 0; i < DIM; i++)
+      x[i] = values_[i*N_+s];
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchVector<DIM>::set_system(const size_type s, const Point<DIM>& x)
+  {
+    assert(s < N_);
+    for (unsigned int i = 0; i < DIM; i++)
+      values_[i*N_+s] = x[i];
+  }
+
+  template <unsigned int DIM>
+  BatchVector<DIM>&
+  BatchVector<DIM>::operator = (const double c)
+  {
+    double* x = values_.begin();
+    const size_type n = size();
+    for (size_type k = 0; k < n; k++)
+      x[k] = c;
+    return *this;
+  }
+
+  template <unsigned int DIM>
+  BatchVector<DIM>&
+  BatchVector<DIM>::operator = (const BatchVector<DIM>& v)
+  {
+    if (this != &v) {
+      N_ = v.N_;
+      values_.resize(v.size()); // reallocates only if the size changes
+      std::copy(v.begin(), v.end(), values_.begin());
+    }
+    return *this;
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchVector<DIM>::add(const BatchVector<DIM>& v)
+  {
+    assert(size() == v.size());
+    double* x = values_.begin();
+    const double* y = v.begin();
+    const size_type n = size();
+    for (size_type k = 0; k < n; k++)
+      x[k] += y[k];
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchVector<DIM>::add(const double s, const BatchVector<DIM>& v)
+  {
+    assert(size() == v.size());
+    double* x = values_.begin();
+    const double* y = v.begin();
+    const size_type n = size();
+    for (size_type k = 0; k < n; k++)
+      x[k] += s * y[k];
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchVector<DIM>::scale(const double s)
+  {
+    double* x = values_.begin();
+    const size_type n = size();
+    for (size_type k = 0; k < n; k++)
+      x[k] *= s;
+  }
+
+  template <unsigned int DIM>
+  inline
+  BatchVector<DIM>&
+  BatchVector<DIM>::operator += (const BatchVector<DIM>& v)
+  {
+    add(v);
+    return *this;
+  }
+
+  template <unsigned int DIM>
+  inline
+  BatchVector<DIM>&
+  BatchVector<DIM>::operator -= (const BatchVector<DIM>& v)
+  {
+    add(-1.0, v);
+    return *this;
+  }
+
+  template <unsigned int DIM>
+  inline
+  BatchVector<DIM>&
+  BatchVector<DIM>::operator *= (const double s)
+  {
+    scale(s);
+    return *this;
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchVector<DIM>::wrmsqr_norms(const double atol, const double rtol,
+				 const BatchVector<DIM>& v, const BatchVector<DIM>& w,
+				 Array1D<double>& norms) const
+  {
+    assert(v.size() == size() && w.size() == size());
+
+    norms.resize(N_);
+    for (size_type s = 0; s < N_; s++)
+      norms[s] = 0;
+
+    // accumulate componentwise, the inner loops run over the systems
+    for (unsigned int i = 0; i < DIM; i++) {
+      const double* x = component(i);
+      const double* vi = v.component(i);
+      const double* wi = w.component(i);
+      for (size_type s = 0; s < N_; s++) {
+	const double help = x[s] / (atol + rtol * std::max(fabs(vi[s]), fabs(wi[s])));
+	norms[s] += help * help;
+      }
+    }
+
+    for (size_type s = 0; s < N_; s++)
+      norms[s] = sqrt(norms[s]/DIM);
+  }
+
+  template <unsigned int DIM>
+  double
+  BatchVector<DIM>::wrmsqr_norm(const double atol, const double rtol,
+				const BatchVector<DIM>& v, const BatchVector<DIM>& w) const
+  {
+    Array1D<double> norms;
+    wrmsqr_norms(atol, rtol, v, w, norms);
+
+    double result = 0;
+    for (size_type s = 0; s < N_; s++)
+      result = std::max(result, norms[s]);
+
+    return result;
+  }
+
+  template <unsigned int DIM>
+  BatchVector<DIM> operator + (const BatchVector<DIM>& v, const BatchVector<DIM>& w)
+  {
+    BatchVector<DIM> r(v);
+    r.add(w);
+    return r;
+  }
+
+  template <unsigned int DIM>
+  BatchVector<DIM> operator - (const BatchVector<DIM>& v, const BatchVector<DIM>& w)
+  {
+    BatchVector<DIM> r(v);
+    r.add(-1.0, w);
+    return r;
+  }
+
+  template <unsigned int DIM>
+  BatchVector<DIM> operator * (const double s, const BatchVector<DIM>& v)
+  {
+    BatchVector<DIM> r(v);
+    r.scale(s);
+    return r;
+  }
+
+  template <unsigned int DIM>
+  std::ostream& operator << (std::ostream& os, const BatchVector<DIM>& v)
+  {
+    for (unsigned int s = 0; s < v.systems(); s++) {
+      os << "[";
+      for (unsigned int i = 0; i < DIM; i++) {
+	if (i > 0) os << " ";
+	os << v(i, s);
+      }
+      os << "]" << std::endl;
+    }
+    return os;
+  }
+}
@@ -0,0 +1,202 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of MathTL - the Mathematical Template Library    |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _MATHTL_BATCH_VECTOR_H
+#define _MATHTL_BATCH_VECTOR_H
+
+#include <iostream>
+#include <utils/array1d.h>
+#include <geometry/point.h>
+
+// external functionality, for convenience:
+#include <algebra/vector_norms.h>
+
+namespace MathTL
+{
+  /*!
+    The states of N independent systems with DIM components each,
+    stored componentwise ("structure of arrays"):
+
+      x = (x_0^{(0)}, ..., x_0^{(N-1)}, x_1^{(0)}, ..., x_{DIM-1}^{(N-1)})
+
+    So the i-th component of all systems forms one contiguous array,
+    and the loops over the systems within the methods below (and within
+    the right-hand sides of a BatchedIVP) can be vectorized by the compiler.
+
+    BatchVector<DIM> provides the signature of the VECTOR classes expected
+    by the one-step schemes (ExplicitRungeKuttaScheme, ROWMethod, WMethod)
+    and by ExtrapolationTable. Then all N systems are advanced in lockstep.
+  */
+  template <unsigned int DIM>
+  class BatchVector
+  {
+  public:
+    //! value type (cf. STL containers)
+    typedef double value_type;
+
+    //! iterator type (cf. STL containers)
+    typedef double* iterator;
+
+    //! const iterator type (cf. STL containers)
+    typedef const double* const_iterator;
+
+    //! size type (cf. STL containers)
+    typedef unsigned int size_type;
+
+    /*!
+      default constructor, yields a zero batch of N systems
+      (not explicit, so that Vector<BatchVector<DIM> >, e.g., in a LowerTriangularMatrix,
+      can be initialized by 0)
+    */
+    BatchVector(const size_type N = 0);
+
+    /*!
+      copy constructor
+    */
+    BatchVector(const BatchVector<DIM>& v);
+
+    /*!
+      number of systems
+    */
+    const size_type systems() const { return N_; }
+
+    /*!
+      overall number of entries DIM*N
+    */
+    const size_type size() const { return values_.size(); }
+
+    /*!
+      resize to N systems, the entries are set to zero
+    */
+    void resize(const size_type N);
+
+    /*!
+      read/write access to the i-th component of all systems
+    */
+    double* component(const unsigned int i) { return values_.begin() + i*N_; }
+    const double* component(const unsigned int i) const { return values_.begin() + i*N_; }
+
+    /*!
+      read/write access to the i-th component of the system s
+    */
+    const double operator () (const unsigned int i, const size_type s) const
+    {
+      return values_[i*N_+s];
+    }
+    double& operator () (const unsigned int i, const size_type s)
+    {
+      return values_[i*N_+s];
+    }
+
+    /*!
+      copy the state of the system s from/into a point
+    */
+    void get_system(const size_type s, Point<DIM>& x) const;
+    void set_system(const size_type s, const Point<DIM>& x);
+
+    //! iterators over all entries
+    iterator begin() { return values_.begin(); }
+    const_iterator begin() const { return values_.begin(); }
+    iterator end() { return values_.end(); }
+    const_iterator end() const { return values_.end(); }
+
+    /*!
+      set all entries to c
+    */
+    BatchVector<DIM>& operator = (const double c);
+
+    /*!
+      assignment, resizes if necessary
+    */
+    BatchVector<DIM>& operator = (const BatchVector<DIM>& v);
+
+    /*!
+      *this += v
+    */
+    void add(const BatchVector<DIM>& v);
+
+    /*!
+      *this += s*v
+    */
+    void add(const double s, const BatchVector<DIM>& v);
+
+    /*!
+      *this *= s
+    */
+    void scale(const double s);
+
+    //! *this += v
+    BatchVector<DIM>& operator += (const BatchVector<DIM>& v);
+
+    //! *this -= v
+    BatchVector<DIM>& operator -= (const BatchVector<DIM>& v);
+
+    //! *this *= s
+    BatchVector<DIM>& operator *= (const double s);
+
+    /*!
+      weighted root mean square norm of each system
+
+        ||x^{(s)}||_s = sqrt(1/DIM * sum_i (x_i^{(s)}/(atol+rtol*max(|v_i^{(s)}|,|w_i^{(s)}|)))^2)
+
+      (the error measure of solve_IVP())
+    */
+    void wrmsqr_norms(const double atol, const double rtol,
+		      const BatchVector<DIM>& v, const BatchVector<DIM>& w,
+		      Array1D<double>& norms) const;
+
+    /*!
+      the maximum of the weighted root mean square norms of all systems,
+      so that a common time step accepted by solve_IVP() meets the tolerances
+      of each single system (the mean over the whole batch would not)
+    */
+    double wrmsqr_norm(const double atol, const double rtol,
+		       const BatchVector<DIM>& v, const BatchVector<DIM>& w) const;
+
+  protected:
+    //! number of systems
+    size_type N_;
+
+    //! the entries, componentwise
+    Array1D<double> values_;
+  };
+
+  /*!
+    sum of two batches
+    (you should avoid using this operator, since it requires one batch
+    to be copied. Use += or add() instead!)
+  */
+  template <unsigned int DIM>
+  BatchVector<DIM> operator + (const BatchVector<DIM>& v, const BatchVector<DIM>& w);
+
+  /*!
+    difference of two batches
+    (you should avoid using this operator, since it requires one batch
+    to be copied. Use -= or add() instead!)
+  */
+  template <unsigned int DIM>
+  BatchVector<DIM> operator - (const BatchVector<DIM>& v, const BatchVector<DIM>& w);
+
+  /*!
+    scalar multiple of a batch
+  */
+  template <unsigned int DIM>
+  BatchVector<DIM> operator * (const double s, const BatchVector<DIM>& v);
+
+  /*!
+    stream output, one system per line
+  */
+  template <unsigned int DIM>
+  std::ostream& operator << (std::ostream& os, const BatchVector<DIM>& v);
+}
+
+// include implementation of inline functions
+#include <algebra/batch_vector.cpp>
+
+#endif
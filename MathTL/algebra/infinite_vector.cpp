@@ -88,6 +88,13 @@ namespace MathTL
     }
   }
 
+  template <class C, class I>
+  inline
+  void InfiniteVector<C,I>::push_back(const I& index, const C value)
+  {
+    std::map<I,C>::insert(std::map<I,C>::end(), typename std::map<I,C>::value_type(index, value));
+  }
+
   template <class C, class I>
   void InfiniteVector<C,I>::add_coefficient(const I& index, const C increment)
   {
@@ -797,7 +804,7 @@ namespace MathTL
   const C*
   InfiniteVector<C,I>::const_reverse_iterator::operator -> () const
   {
-    return &(std::reverse_iterator<typename std::map<I,C>::const_iterator>::operator *).second;
+    return &(std::reverse_iterator<typename std::map<I,C>::const_iterator>::operator *()).second;
   }
 
   template <class C, class I>
@@ -253,6 +253,12 @@ namespace MathTL
     */
     void set_coefficient(const I& index, const C value);
 
+    /*!
+      append an entry whose index is larger than all stored indices
+      (amortized constant time)
+    */
+    void push_back(const I& index, const C value);
+
     /*!
       number of nonzero entries
     */
@@ -0,0 +1,129 @@
+// implementation for numbered_vector.h
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+namespace MathTL
+{
+  template <class C>
+  inline
+  void
+  NumberedVector<C>::push_back(const int number, const C value)
+  {
+    assert(numbers_.empty() || numbers_.back() < number);
+    numbers_.push_back(number);
+    values_.push_back(value);
+  }
+
+  template <class C>
+  C
+  NumberedVector<C>::get_coefficient(const int number) const
+  {
+    std::vector<int>::const_iterator it(std::lower_bound(numbers_.begin(), numbers_.end(), number));
+    if (it != numbers_.end() && *it == number)
+      return values_[it-numbers_.begin()];
+    return C(0);
+  }
+
+  template <class C>
+  void
+  NumberedVector<C>::scale(const C s)
+  {
+    for (size_type n = 0; n < values_.size(); n++)
+      values_[n] *= s;
+  }
+
+  template <class C>
+  double
+  NumberedVector<C>::l2_norm_sqr() const
+  {
+    double r(0);
+    for (size_type n = 0; n < values_.size(); n++)
+      r += values_[n]*values_[n];
+    return r;
+  }
+
+  template <class C>
+  double
+  NumberedVector<C>::linfty_norm() const
+  {
+    double r(0);
+    for (size_type n = 0; n < values_.size(); n++)
+      r = std::max(r, (double)fabs(values_[n]));
+    return r;
+  }
+
+  template <class C>
+  void
+  NumberedVector<C>::add_to(Vector<C>& w, const C s) const
+  {
+    for (size_type n = 0; n < numbers_.size(); n++)
+      w[numbers_[n]] += s*values_[n];
+  }
+
+  template <class C>
+  DenseAccumulator<C>::DenseAccumulator(const size_type n)
+    : values_(n, C(0)), touched_flags_(n, 0), touched_()
+  {
+  }
+
+  template <class C>
+  void
+  DenseAccumulator<C>::resize(const size_type n)
+  {
+    if (n == values_.size()) {
+      clear();
+      return;
+    }
+    values_.assign(n, C(0));
+    touched_flags_.assign(n, 0);
+    touched_.clear();
+  }
+
+  template <class C>
+  void
+  DenseAccumulator<C>::add(const C s, const NumberedVector<C>& v)
+  {
+    for (typename NumberedVector<C>::size_type n = 0; n < v.size(); n++)
+      (*this)[v.number(n)] += s*v.value(n);
+  }
+
+  template <class C>
+  void
+  DenseAccumulator<C>::extract(NumberedVector<C>& v)
+  {
+    std::sort(touched_.begin(), touched_.end());
+    v.clear();
+    v.reserve(touched_.size());
+    for (std::vector<int>::const_iterator it(touched_.begin()); it != touched_.end(); ++it) {
+      if (values_[*it] != C(0))
+	v.push_back(*it, values_[*it]);
+      values_[*it] = C(0);
+      touched_flags_[*it] = 0;
+    }
+    touched_.clear();
+  }
+
+  template <class C>
+  void
+  DenseAccumulator<C>::clear()
+  {
+    for (std::vector<int>::const_iterator it(touched_.begin()); it != touched_.end(); ++it) {
+      values_[*it] = C(0);
+      touched_flags_[*it] = 0;
+    }
+    touched_.clear();
+  }
+
+  template <class C>
+  std::ostream& operator << (std::ostream& os, const NumberedVector<C>& v)
+  {
+    if (v.size() == 0)
+      os << "0" << std::endl;
+    else
+      for (typename NumberedVector<C>::size_type n = 0; n < v.size(); n++)
+	os << v.number(n) << ": " << v.value(n) << std::endl;
+    return os;
+  }
+}
@@ -0,0 +1,185 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of MathTL - the Mathematical Template Library    |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _MATHTL_NUMBERED_VECTOR_H
+#define _MATHTL_NUMBERED_VECTOR_H
+
+#include <vector>
+#include <iostream>
+#include <algebra/vector.h>
+
+namespace MathTL
+{
+  /*!
+    A sparse vector over the index set {0,1,2,...}, stored as the sorted list
+    of its entry numbers together with the values.
+
+    In contrast to InfiniteVector<C,int>, which is based on std::map, a
+    NumberedVector can only be filled in increasing order of the numbers
+    (e.g., by DenseAccumulator::extract()), but it is traversed and scattered
+    into dense arrays without any tree overhead. It is intended for the
+    inner loops of adaptive algorithms, where wavelet indices are represented
+    by their numbers.
+  */
+  template <class C>
+  class NumberedVector
+  {
+  public:
+    //! value type (cf. STL containers)
+    typedef C value_type;
+
+    //! size type (cf. STL containers)
+    typedef typename std::vector<int>::size_type size_type;
+
+    //! default constructor: yields a zero vector
+    NumberedVector() {}
+
+    //! number of stored entries
+    size_type size() const { return numbers_.size(); }
+
+    //! reserve memory for n entries
+    void reserve(const size_type n) { numbers_.reserve(n); values_.reserve(n); }
+
+    //! set the vector to zero
+    void clear() { numbers_.clear(); values_.clear(); }
+
+    //! swap the contents with another vector
+    void swap(NumberedVector<C>& v) { numbers_.swap(v.numbers_); values_.swap(v.values_); }
+
+    /*!
+      append an entry; the number has to be larger than all stored numbers
+    */
+    void push_back(const int number, const C value);
+
+    //! number of the n-th stored entry
+    int number(const size_type n) const { return numbers_[n]; }
+
+    //! value of the n-th stored entry
+    const C& value(const size_type n) const { return values_[n]; }
+
+    //! value of the n-th stored entry (read-write)
+    C& value(const size_type n) { return values_[n]; }
+
+    /*!
+      value of the entry with the given number (zero if not present),
+      by binary search
+    */
+    C get_coefficient(const int number) const;
+
+    //! the stored numbers
+    const std::vector<int>& numbers() const { return numbers_; }
+
+    //! the stored values
+    const std::vector<C>& values() const { return values_; }
+
+    //! multiply all entries by s
+    void scale(const C s);
+
+    //! squared l_2 norm
+    double l2_norm_sqr() const;
+
+    //! l_infinity norm
+    double linfty_norm() const;
+
+    /*!
+      add s times the entries to a dense vector of sufficient size
+    */
+    void add_to(Vector<C>& w, const C s = C(1)) const;
+
+  protected:
+    //! the entry numbers, in increasing order
+    std::vector<int> numbers_;
+
+    //! the entry values
+    std::vector<C> values_;
+  };
+
+  /*!
+    A dense accumulator for sums of sparse vectors over {0,...,n-1},
+    which keeps track of the entries that have been written to.
+
+    The (non-const) access w[i] has the same signature as for Vector<C>, so
+    that routines which add to a dense vector (like the add_level() or
+    add_ball() routines of the cached problems) also work on a
+    DenseAccumulator when they are templated over the vector type.
+    Each write access marks the entry as touched, and extract() collects the
+    touched entries into a NumberedVector, resetting them to zero at the same
+    time. So after the (one time) allocation, accumulating and extracting
+    costs O(number of touched entries) instead of O(n), and the
+    accumulator can be reused without clearing the whole array.
+  */
+  template <class C>
+  class DenseAccumulator
+  {
+  public:
+    //! value type (cf. STL containers)
+    typedef C value_type;
+
+    //! size type (cf. STL containers)
+    typedef size_t size_type;
+
+    //! constructor from the dimension, all entries are zero
+    explicit DenseAccumulator(const size_type n = 0);
+
+    //! dimension
+    size_type size() const { return values_.size(); }
+
+    /*!
+      change the dimension; the touched entries are discarded
+    */
+    void resize(const size_type n);
+
+    //! read-only access to an entry
+    const C operator [] (const size_type i) const { return values_[i]; }
+
+    //! read-write access to an entry, marks it as touched
+    C& operator [] (const size_type i)
+    {
+      if (!touched_flags_[i]) {
+	touched_flags_[i] = 1;
+	touched_.push_back(i);
+      }
+      return values_[i];
+    }
+
+    //! number of touched entries
+    size_type touched() const { return touched_.size(); }
+
+    //! w += s*v, costs O(v.size())
+    void add(const C s, const NumberedVector<C>& v);
+
+    /*!
+      move the nontrivial touched entries to v (sorted by number)
+      and reset the accumulator to zero;
+      costs O(t log t) for t touched entries
+    */
+    void extract(NumberedVector<C>& v);
+
+    //! reset the touched entries to zero
+    void clear();
+
+  protected:
+    //! the dense values
+    std::vector<C> values_;
+
+    //! touched flags
+    std::vector<char> touched_flags_;
+
+    //! numbers of the touched entries, in the order of their first access
+    std::vector<int> touched_;
+  };
+
+  //! stream output for NumberedVector
+  template <class C>
+  std::ostream& operator << (std::ostream& os, const NumberedVector<C>& v);
+}
+
+#include <algebra/numbered_vector.cpp>
+
+#endif
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <algebra/vector.h>
 #include <algebra/matrix.h>
+#include <utils/task_scheduler.h>
 
 namespace MathTL
 {
@@ -624,36 +625,26 @@ namespace MathTL
   void SparseMatrix<C>::apply(const VECTOR& x, VECTOR& Mx) const
   {
     assert(Mx.size() == rowdim_);
+    ApplyRows<VECTOR> rows(*this, x, Mx);
 #if PARALLEL==1
-    //cout<<"parallel apply"<<endl;
-#pragma omp parallel for
-#endif    
-    for (size_type i=0; i < rowdim_; i++) {
-      C help(0);
-      if (indices_[i]) {
-	for (size_type j(1); j <= indices_[i][0]; j++)
-	  help += entries_[i][j-1] * x[indices_[i][j]];
-      }
-      Mx[i] = help;
-    }
+    parallel_for(0, rowdim_, rows, 256);
+#else
+    for (size_type i=0; i < rowdim_; i++)
+      rows(i);
+#endif
   }
 
   template <class C>
   void SparseMatrix<C>::apply(const Vector<C>& x, Vector<C>& Mx) const
   {
     assert(Mx.size() == rowdim_);
+    ApplyRows<Vector<C> > rows(*this, x, Mx);
 #if PARALLEL==1
-    //cout<<"parallel apply"<<endl;
-#pragma omp parallel for
+    parallel_for(0, rowdim_, rows, 256);
+#else
+    for (size_type i=0; i < rowdim_; i++)
+      rows(i);
 #endif
-    for (size_type i=0; i < rowdim_; i++) {
-      C help(0);
-      if (indices_[i]) {
-	for (size_type j(1); j <= indices_[i][0]; j++)
-	  help += entries_[i][j-1] * x[indices_[i][j]];
-      }
-      Mx[i] = help;
-    }
   }
 
   template <class C>
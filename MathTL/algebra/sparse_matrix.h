@@ -260,6 +260,33 @@ namespace MathTL
       deallocate all memory
     */
     void kill();
+
+    /*!
+      the row loop of apply(), Mx[i] = sum_j (*this)(i,j)*x[j],
+      as a body for parallel_for()
+    */
+    template <class VECTOR>
+    class ApplyRows
+    {
+    public:
+      ApplyRows(const SparseMatrix<C>& M, const VECTOR& x, VECTOR& Mx)
+	: M_(M), x_(x), Mx_(Mx) {}
+
+      void operator () (const size_type i)
+      {
+	C help(0);
+	if (M_.indices_[i]) {
+	  for (size_type j(1); j <= M_.indices_[i][0]; j++)
+	    help += M_.entries_[i][j-1] * x_[M_.indices_[i][j]];
+	}
+	Mx_[i] = help;
+      }
+
+    protected:
+      const SparseMatrix<C>& M_;
+      const VECTOR& x_;
+      VECTOR& Mx_;
+    };
   };
 
   /*!
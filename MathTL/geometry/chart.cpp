@@ -19,6 +19,49 @@ namespace MathTL
     return s;
   }
 
+  template <unsigned int DIM_d, unsigned int DIM_m>
+  void
+  Chart<DIM_d,DIM_m>::map_points(const Array1D<Point<DIM_d> >& x,
+				 Array1D<Point<DIM_m> >& y) const
+  {
+    y.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      map_point(x[m], y[m]);
+  }
+
+  template <unsigned int DIM_d, unsigned int DIM_m>
+  void
+  Chart<DIM_d,DIM_m>::Gram_factor_values(const Array1D<Point<DIM_d> >& x,
+					 Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = Gram_factor(x[m]);
+  }
+
+  template <unsigned int DIM_d, unsigned int DIM_m>
+  void
+  Chart<DIM_d,DIM_m>::Gram_D_factor_values(const unsigned int i,
+					   const Array1D<Point<DIM_d> >& x,
+					   Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = Gram_D_factor(i, x[m]);
+  }
+
+  template <unsigned int DIM_d, unsigned int DIM_m>
+  void
+  Chart<DIM_d,DIM_m>::Dkappa_inv_values(const unsigned int i,
+					const unsigned int j,
+					const Array1D<Point<DIM_d> >& x,
+					Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = Dkappa_inv(i, j, x[m]);
+  }
+
   template <unsigned int DIM>
   AffineLinearMapping<DIM>::AffineLinearMapping()
     : A_(DIM, DIM), A_inv(DIM, DIM), det_A(1.0), b_()
@@ -119,6 +162,59 @@ namespace MathTL
     return true;
   }
 
+  template <unsigned int DIM>
+  void
+  AffineLinearMapping<DIM>::map_points(const Array1D<Point<DIM> >& x,
+				       Array1D<Point<DIM> >& y) const
+  {
+    double A[DIM][DIM];
+    for (unsigned int r = 0; r < DIM; r++)
+      for (unsigned int s = 0; s < DIM; s++)
+	A[r][s] = A_(r, s);
+
+    y.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      for (unsigned int r = 0; r < DIM; r++) {
+	double yr = b_[r];
+	for (unsigned int s = 0; s < DIM; s++)
+	  yr += A[r][s] * x[m][s];
+	y[m][r] = yr;
+      }
+  }
+
+  template <unsigned int DIM>
+  void
+  AffineLinearMapping<DIM>::Gram_factor_values(const Array1D<Point<DIM> >& x,
+					       Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = square_root_of_abs_det_A;
+  }
+
+  template <unsigned int DIM>
+  void
+  AffineLinearMapping<DIM>::Gram_D_factor_values(const unsigned int i,
+						 const Array1D<Point<DIM> >& x,
+						 Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = 0.0;
+  }
+
+  template <unsigned int DIM>
+  void
+  AffineLinearMapping<DIM>::Dkappa_inv_values(const unsigned int i, const unsigned int j,
+					      const Array1D<Point<DIM> >& x,
+					      Array1D<double>& values) const
+  {
+    const double value = A_inv(i, j);
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = value;
+  }
+
   template <unsigned int DIM>
   const string
   AffineLinearMapping<DIM>::to_string() const {
@@ -209,6 +305,50 @@ namespace MathTL
     return true;
   }
 
+  template <unsigned int DIM>
+  void
+  SimpleAffineLinearMapping<DIM>::map_points(const Array1D<Point<DIM> >& x,
+					     Array1D<Point<DIM> >& y) const
+  {
+    y.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      for (unsigned int i = 0; i < DIM; i++)
+	y[m][i] = A_[i] * x[m][i] + b_[i];
+  }
+
+  template <unsigned int DIM>
+  void
+  SimpleAffineLinearMapping<DIM>::Gram_factor_values(const Array1D<Point<DIM> >& x,
+						     Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = square_root_of_abs_det_A;
+  }
+
+  template <unsigned int DIM>
+  void
+  SimpleAffineLinearMapping<DIM>::Gram_D_factor_values(const unsigned int i,
+						       const Array1D<Point<DIM> >& x,
+						       Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = 0.0;
+  }
+
+  template <unsigned int DIM>
+  void
+  SimpleAffineLinearMapping<DIM>::Dkappa_inv_values(const unsigned int i, const unsigned int j,
+						    const Array1D<Point<DIM> >& x,
+						    Array1D<double>& values) const
+  {
+    const double value = (i == j ? A_inv[i] : 0.);
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = value;
+  }
+
   template <unsigned int DIM>
   const string
   SimpleAffineLinearMapping<DIM>::to_string() const {
@@ -656,6 +796,75 @@ namespace MathTL
     return true;;
   }
   
+  inline
+  void LinearBezierMapping::map_points(const Array1D<Point<2> >& x,
+				       Array1D<Point<2> >& y) const
+  {
+    y.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++) {
+      const double s = x[m][0], t = x[m][1];
+      const double t3 = (1-s)*(1-t), t4 = s*(1-t), t5 = (1-s)*t, t1 = s*t;
+      y[m][0] = t3*b_00[0] + t4*b_10[0] + t5*b_01[0] + t1*b_11[0];
+      y[m][1] = t3*b_00[1] + t4*b_10[1] + t5*b_01[1] + t1*b_11[1];
+    }
+  }
+
+  inline
+  void LinearBezierMapping::Gram_factor_values(const Array1D<Point<2> >& x,
+					       Array1D<double>& values) const
+  {
+    const double d0 = d_ds_d_dt_kappa_r[0], d1 = d_ds_d_dt_kappa_r[1];
+    const double e10_0 = min_b00_plus_b10[0], e10_1 = min_b00_plus_b10[1];
+    const double e01_0 = min_b00_plus_b01[0], e01_1 = min_b00_plus_b01[1];
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++) {
+      const double det = (x[m][1]*d0 + e10_0) * (x[m][0]*d1 + e01_1)
+	- (x[m][1]*d1 + e10_1) * (x[m][0]*d0 + e01_0);
+      values[m] = sqrt(fabs(det));
+    }
+  }
+
+  inline
+  void LinearBezierMapping::Gram_D_factor_values(const unsigned int i,
+						 const Array1D<Point<2> >& x,
+						 Array1D<double>& values) const
+  {
+    Gram_factor_values(x, values);
+    const double d0 = d_ds_d_dt_kappa_r[0], d1 = d_ds_d_dt_kappa_r[1];
+    const double e10_0 = min_b00_plus_b10[0], e10_1 = min_b00_plus_b10[1];
+    const double e01_0 = min_b00_plus_b01[0], e01_1 = min_b00_plus_b01[1];
+    for (unsigned int m = 0; m < x.size(); m++) {
+      double partial_i_det_DKappa = 0.0;
+      if (i == 0)
+	partial_i_det_DKappa = (x[m][1]*d0 + e10_0) * d1 - (x[m][1]*d1 + e10_1) * d0;
+      else if (i == 1)
+	partial_i_det_DKappa = d0 * (x[m][0]*d1 + e01_1) - d1 * (x[m][0]*d0 + e01_0);
+      values[m] = 0.5 * (1.0 / values[m]) * sgn_det_D * partial_i_det_DKappa;
+    }
+  }
+
+  inline
+  void LinearBezierMapping::Dkappa_inv_values(const unsigned int i, const unsigned int j,
+					      const Array1D<Point<2> >& x,
+					      Array1D<double>& values) const
+  {
+    // (D kappa^{-1})(x) = (D kappa(x))^{-1}, i.e., the (i,j)-th entry is
+    // (-1)^{i+j} * partial_{1-i} Kappa_{1-j} / det D kappa, see Dkappa_inv()
+    const double sign = (i == j) ? 1.0 : -1.0;
+    const unsigned int k = 1-i, l = 1-j;
+    const double d0 = d_ds_d_dt_kappa_r[0], d1 = d_ds_d_dt_kappa_r[1];
+    const double e10_0 = min_b00_plus_b10[0], e10_1 = min_b00_plus_b10[1];
+    const double e01_0 = min_b00_plus_b01[0], e01_1 = min_b00_plus_b01[1];
+    const double dl = d_ds_d_dt_kappa_r[l];
+    const double el = (k == 1) ? min_b00_plus_b01[l] : min_b00_plus_b10[l];
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++) {
+      const double det = (x[m][1]*d0 + e10_0) * (x[m][0]*d1 + e01_1)
+	- (x[m][1]*d1 + e10_1) * (x[m][0]*d0 + e01_0);
+      values[m] = sign * ((k == 1 ? x[m][0] : x[m][1]) * dl + el) / det;
+    }
+  }
+
   inline
   const string LinearBezierMapping::to_string() const
   {   
@@ -15,6 +15,7 @@
 #include <algebra/matrix.h>
 #include <algebra/vector.h>
 #include <geometry/point.h>
+#include <utils/array1d.h>
 #include <utils/fixed_array1d.h>
 
 using std::string;
@@ -80,6 +81,25 @@ namespace MathTL
       TODO: shift this virtual method into a subclass of Chart
     */
     virtual const double a_i(const int i) const = 0;
+
+    /*!
+      Batch versions of map_point(), Gram_factor(), Gram_D_factor() and
+      Dkappa_inv() for a whole array of points x (e.g., all knots of a
+      quadrature rule), the results are resized to x.size().
+      The default implementations call the pointwise versions, charts with
+      a closed form override them with plain loops which can be vectorized.
+    */
+    virtual void map_points(const Array1D<Point<DIM_d> >& x,
+			    Array1D<Point<DIM_m> >& y) const;
+    virtual void Gram_factor_values(const Array1D<Point<DIM_d> >& x,
+				    Array1D<double>& values) const;
+    virtual void Gram_D_factor_values(const unsigned int i,
+				      const Array1D<Point<DIM_d> >& x,
+				      Array1D<double>& values) const;
+    virtual void Dkappa_inv_values(const unsigned int i,
+				   const unsigned int j,
+				   const Array1D<Point<DIM_d> >& x,
+				   Array1D<double>& values) const;
     
     /*!
       checks whether a special point x lies in the patch represented by this
@@ -128,6 +148,13 @@ namespace MathTL
 			    const Point<DIM>& x) const;
     const bool in_patch(const Point<DIM>& x) const;
     
+    void map_points(const Array1D<Point<DIM> >& x, Array1D<Point<DIM> >& y) const;
+    void Gram_factor_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+    void Gram_D_factor_values(const unsigned int i, const Array1D<Point<DIM> >& x,
+			      Array1D<double>& values) const;
+    void Dkappa_inv_values(const unsigned int i, const unsigned int j,
+			   const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+
     const double a_i(const int i) const { return A_(i,i); };
 
 
@@ -179,6 +206,13 @@ namespace MathTL
 			    const Point<DIM>& x) const;
     const bool in_patch(const Point<DIM>& x) const;
 
+    void map_points(const Array1D<Point<DIM> >& x, Array1D<Point<DIM> >& y) const;
+    void Gram_factor_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+    void Gram_D_factor_values(const unsigned int i, const Array1D<Point<DIM> >& x,
+			      Array1D<double>& values) const;
+    void Dkappa_inv_values(const unsigned int i, const unsigned int j,
+			   const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+
     const double a_i(const int i) const { return A_[i]; };
 
     const string to_string() const;
@@ -272,6 +306,13 @@ namespace MathTL
 			    const Point<2>& x) const;
     const bool in_patch(const Point<2>& x) const;
 
+    void map_points(const Array1D<Point<2> >& x, Array1D<Point<2> >& y) const;
+    void Gram_factor_values(const Array1D<Point<2> >& x, Array1D<double>& values) const;
+    void Gram_D_factor_values(const unsigned int i, const Array1D<Point<2> >& x,
+			      Array1D<double>& values) const;
+    void Dkappa_inv_values(const unsigned int i, const unsigned int j,
+			   const Array1D<Point<2> >& x, Array1D<double>& values) const;
+
     const double a_i(const int i) const { return 0.; };
     
     const string to_string() const;
@@ -75,6 +75,60 @@ namespace MathTL
     return true;
   }
 
+  void
+  RingChart::map_points(const Array1D<Point<2> >& x, Array1D<Point<2> >& y) const
+  {
+    y.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++) {
+      const double arg = 2*M_PI*x[m][0];
+      const double rofs = r0_+x[m][1]*(r1_-r0_);
+      y[m][0] = rofs*cos(arg);
+      y[m][1] = rofs*sin(arg);
+    }
+  }
+
+  void
+  RingChart::Gram_factor_values(const Array1D<Point<2> >& x, Array1D<double>& values) const
+  {
+    const double factor = 2*M_PI*(r1_-r0_);
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = sqrt(factor*(r0_+x[m][1]*(r1_-r0_)));
+  }
+
+  void
+  RingChart::Gram_D_factor_values(const unsigned int i, const Array1D<Point<2> >& x,
+				  Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    if (i != 1) {
+      for (unsigned int m = 0; m < x.size(); m++)
+	values[m] = 0;
+      return;
+    }
+    const double factor = pow(r1_-r0_,1.5)/M_2_SQRTPI;
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = factor/sqrt(r0_+x[m][1]*(r1_-r0_));
+  }
+
+  void
+  RingChart::Dkappa_inv_values(const unsigned int i, const unsigned int j,
+			       const Array1D<Point<2> >& x, Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    if (i == 0) {
+      // angular part: (-x_2, x_1)/(2*pi*|x|^2)
+      const double factor = (j == 0 ? -1. : 1.)/(2*M_PI);
+      for (unsigned int m = 0; m < x.size(); m++)
+	values[m] = factor*x[m][1-j]/(x[m][0]*x[m][0]+x[m][1]*x[m][1]);
+    } else {
+      // radial part: x/((r_1-r_0)*|x|)
+      const double factor = 1./(r1_-r0_);
+      for (unsigned int m = 0; m < x.size(); m++)
+	values[m] = factor*x[m][j]/sqrt(x[m][0]*x[m][0]+x[m][1]*x[m][1]);
+    }
+  }
+
   const string
   RingChart::to_string() const
   {
@@ -68,6 +68,14 @@ namespace MathTL
     //! checks whether a special point x lies in the patch represented by this parametrization
     const bool in_patch(const Point<2>& x) const;
 
+    //! batch versions of the pointwise routines, see Chart
+    void map_points(const Array1D<Point<2> >& x, Array1D<Point<2> >& y) const;
+    void Gram_factor_values(const Array1D<Point<2> >& x, Array1D<double>& values) const;
+    void Gram_D_factor_values(const unsigned int i, const Array1D<Point<2> >& x,
+			      Array1D<double>& values) const;
+    void Dkappa_inv_values(const unsigned int i, const unsigned int j,
+			   const Array1D<Point<2> >& x, Array1D<double>& values) const;
+
     //! dummy
     const double a_i(const int i) const { return 1.0; };    
 
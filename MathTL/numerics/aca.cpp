@@ -0,0 +1,100 @@
+// implementation for aca.h
+
+#include <cmath>
+#include <list>
+#include <vector>
+
+namespace MathTL
+{
+  template <class GENERATOR>
+  unsigned int ACA(const GENERATOR& M, const double tol, const unsigned int maxrank,
+		   Matrix<double>& U, Matrix<double>& V)
+  {
+    const unsigned int m = M.row_dimension(), n = M.column_dimension();
+
+    std::list<Vector<double> > us, vs;
+    std::vector<bool> used(m, false);
+    double frobenius_sqr = 0;
+    unsigned int pivot_row = 0, rank = 0, remaining = m;
+
+    while (rank < maxrank && remaining > 0) {
+      used[pivot_row] = true;
+      remaining--;
+
+      // residual of the pivot row
+      Vector<double> v(n);
+      for (unsigned int j = 0; j < n; j++)
+	v[j] = M(pivot_row, j);
+      {
+	std::list<Vector<double> >::const_iterator uit(us.begin());
+	for (std::list<Vector<double> >::const_iterator vit(vs.begin());
+	     vit != vs.end(); ++uit, ++vit)
+	  v.add(-(*uit)[pivot_row], *vit);
+      }
+
+      // pivot column
+      unsigned int pivot_column = 0;
+      for (unsigned int j = 1; j < n; j++)
+	if (fabs(v[j]) > fabs(v[pivot_column]))
+	  pivot_column = j;
+
+      if (v[pivot_column] == 0) {
+	// the row is reproduced exactly, try the next unused one
+	unsigned int i = 0;
+	while (i < m && used[i]) i++;
+	pivot_row = i;
+	continue;
+      }
+      v.scale(1.0/v[pivot_column]);
+
+      // residual of the pivot column
+      Vector<double> u(m);
+      for (unsigned int i = 0; i < m; i++)
+	u[i] = M(i, pivot_column);
+      {
+	std::list<Vector<double> >::const_iterator uit(us.begin());
+	for (std::list<Vector<double> >::const_iterator vit(vs.begin());
+	     vit != vs.end(); ++uit, ++vit)
+	  u.add(-(*vit)[pivot_column], *uit);
+      }
+
+      // update the Frobenius norm of U*V^T,
+      // ||S_r||^2 = ||S_{r-1}||^2 + 2 \sum_{k<r} (u_k*u)(v_k*v) + ||u||^2 ||v||^2
+      const double unorm_sqr = u*u, vnorm_sqr = v*v;
+      {
+	std::list<Vector<double> >::const_iterator uit(us.begin());
+	for (std::list<Vector<double> >::const_iterator vit(vs.begin());
+	     vit != vs.end(); ++uit, ++vit)
+	  frobenius_sqr += 2 * (*uit * u) * (*vit * v);
+      }
+      frobenius_sqr += unorm_sqr * vnorm_sqr;
+
+      us.push_back(u);
+      vs.push_back(v);
+      rank++;
+
+      if (unorm_sqr * vnorm_sqr <= tol * tol * frobenius_sqr)
+	break;
+
+      // next pivot row: largest entry of u among the unused rows
+      pivot_row = m;
+      for (unsigned int i = 0; i < m; i++)
+	if (!used[i] && (pivot_row == m || fabs(u[i]) > fabs(u[pivot_row])))
+	  pivot_row = i;
+    }
+
+    U.resize(m, rank);
+    V.resize(n, rank);
+    unsigned int k = 0;
+    std::list<Vector<double> >::const_iterator uit(us.begin());
+    for (std::list<Vector<double> >::const_iterator vit(vs.begin());
+	 vit != vs.end(); ++uit, ++vit, ++k) {
+      for (unsigned int i = 0; i < m; i++)
+	U(i, k) = (*uit)[i];
+      for (unsigned int j = 0; j < n; j++)
+	V(j, k) = (*vit)[j];
+    }
+
+    return rank;
+  }
+}
@@ -0,0 +1,45 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of MathTL - the Mathematical Template Library    |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _MATHTL_ACA_H
+#define _MATHTL_ACA_H
+
+#include <algebra/vector.h>
+#include <algebra/matrix.h>
+
+namespace MathTL
+{
+  /*!
+    adaptive cross approximation with partial pivoting of a matrix M (m x n),
+
+      M \approx U*V^T,  U: m x r, V: n x r,
+
+    which only accesses r rows and r columns of M
+    (cf. Bebendorf, Approximation of boundary element matrices, Numer. Math. 86 (2000)).
+    This is efficient for blocks of asymptotically smooth kernel functions
+    on well-separated point sets.
+
+    The entries of M are generated on demand by the class GENERATOR, which has to provide
+      - double operator () (const unsigned int row, const unsigned int column) const
+      - unsigned int row_dimension() const
+      - unsigned int column_dimension() const
+
+    The iteration stops if the last cross u_r v_r^T is smaller than
+    tol times the (estimated) Frobenius norm of U*V^T, or if the rank maxrank is reached.
+    \return the rank r
+  */
+  template <class GENERATOR>
+  unsigned int ACA(const GENERATOR& M, const double tol, const unsigned int maxrank,
+		   Matrix<double>& U, Matrix<double>& V);
+}
+
+// include implementation
+#include <numerics/aca.cpp>
+
+#endif
@@ -0,0 +1,138 @@
+// implementation for batched_ivp.h
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+namespace MathTL
+{
+  template <unsigned int DIM>
+  BatchedIVP<DIM>::BatchedIVP()
+    : jacobian_t_(0)
+  {
+  }
+
+  template <unsigned int DIM>
+  BatchedIVP<DIM>::~BatchedIVP()
+  {
+  }
+
+  template <unsigned int DIM>
+  const BatchVector<DIM*DIM>&
+  BatchedIVP<DIM>::jacobian(const double t, const BatchVector<DIM>& v) const
+  {
+    if (jacobian_v_.systems() == 0 || jacobian_v_.systems() != v.systems() || jacobian_t_ != t
+	|| !std::equal(v.begin(), v.end(), jacobian_v_.begin())) {
+      evaluate_jacobian(t, v, jacobian_);
+      jacobian_t_ = t;
+      jacobian_v_ = v;
+    }
+    return jacobian_;
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchedIVP<DIM>::evaluate_jacobian(const double t,
+				     const BatchVector<DIM>& v,
+				     BatchVector<DIM*DIM>& J) const
+  {
+    const unsigned int N = v.systems();
+    J.resize(N);
+
+    BatchVector<DIM> f0(N), w(N), fw(N);
+    this->evaluate_f(t, v, 0, f0);
+
+    // forward differences, column by column for all systems at once
+    const double eps = 1.4901161193847656e-08; // sqrt(machine epsilon)
+    Array1D<double> h(N);
+    for (unsigned int j = 0; j < DIM; j++) {
+      w = v;
+      double* wj = w.component(j);
+      for (unsigned int s = 0; s < N; s++) {
+	h[s] = eps * std::max(1.0, fabs(wj[s]));
+	wj[s] += h[s];
+      }
+      this->evaluate_f(t, w, 0, fw);
+      for (unsigned int i = 0; i < DIM; i++) {
+	double* Jij = J.component(i*DIM+j);
+	const double* fwi = fw.component(i);
+	const double* f0i = f0.component(i);
+	for (unsigned int s = 0; s < N; s++)
+	  Jij[s] = (fwi[s] - f0i[s]) / h[s];
+      }
+    }
+  }
+
+  template <unsigned int DIM>
+  void
+  BatchedIVP<DIM>::solve_ROW_stage_equation(const double t,
+					    const BatchVector<DIM>& v,
+					    const double alpha,
+					    const BatchVector<DIM>& y,
+					    const double tolerance,
+					    BatchVector<DIM>& result) const
+  {
+    const unsigned int N = v.systems();
+
+    // setup M = alpha*I-J
+    BatchVector<DIM*DIM> M(jacobian(t, v));
+    M.scale(-1.0);
+    for (unsigned int i = 0; i < DIM; i++) {
+      double* Mii = M.component(i*DIM+i);
+      for (unsigned int s = 0; s < N; s++)
+	Mii[s] += alpha;
+    }
+
+    result = y;
+
+    // Gaussian elimination with partial pivoting; the pivot rows are chosen
+    // for each system, the elimination steps are the same for all systems
+    Array1D<double> l(N);
+    for (unsigned int k = 0; k < DIM; k++) {
+      for (unsigned int s = 0; s < N; s++) {
+	unsigned int p = k;
+	for (unsigned int i = k+1; i < DIM; i++)
+	  if (fabs(M(i*DIM+k, s)) > fabs(M(p*DIM+k, s)))
+	    p = i;
+	if (p != k) {
+	  for (unsigned int j = k; j < DIM; j++)
+	    std::swap(M(k*DIM+j, s), M(p*DIM+j, s));
+	  std::swap(result(k, s), result(p, s));
+	}
+      }
+
+      const double* Mkk = M.component(k*DIM+k);
+      for (unsigned int i = k+1; i < DIM; i++) {
+	double* Mik = M.component(i*DIM+k);
+	for (unsigned int s = 0; s < N; s++) {
+	  assert(Mkk[s] != 0);
+	  l[s] = Mik[s] / Mkk[s];
+	}
+	for (unsigned int j = k+1; j < DIM; j++) {
+	  double* Mij = M.component(i*DIM+j);
+	  const double* Mkj = M.component(k*DIM+j);
+	  for (unsigned int s = 0; s < N; s++)
+	    Mij[s] -= l[s] * Mkj[s];
+	}
+	double* xi = result.component(i);
+	const double* xk = result.component(k);
+	for (unsigned int s = 0; s < N; s++)
+	  xi[s] -= l[s] * xk[s];
+      }
+    }
+
+    // back substitution
+    for (int i = DIM-1; i >= 0; i--) {
+      double* xi = result.component(i);
+      for (unsigned int j = i+1; j < DIM; j++) {
+	const double* Mij = M.component(i*DIM+j);
+	const double* xj = result.component(j);
+	for (unsigned int s = 0; s < N; s++)
+	  xi[s] -= Mij[s] * xj[s];
+      }
+      const double* Mii = M.component(i*DIM+i);
+      for (unsigned int s = 0; s < N; s++)
+	xi[s] /= Mii[s];
+    }
+  }
+}
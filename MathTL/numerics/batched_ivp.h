@@ -0,0 +1,109 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of MathTL - the Mathematical Template Library    |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _MATHTL_BATCHED_IVP_H
+#define _MATHTL_BATCHED_IVP_H
+
+#include <algebra/batch_vector.h>
+#include <numerics/ivp.h>
+
+namespace MathTL
+{
+  /*!
+    abstract base class for N independent initial value problems
+
+      u_s'(t) = f_s(t, u_s(t)),   0 < t <= T
+      u_s(0) = u_{0,s},           s = 0,...,N-1
+
+    with u_s:[0,T]->\mathbb R^d, e.g., the members of a parameter study
+    or the shooting problems of a boundary value problem.
+
+    The states of all systems are stored in one BatchVector<DIM>, and each
+    call of the right-hand side or of the stage equation solver handles the
+    whole batch. So, compared to N instances of IVP<DIM>, there is one virtual
+    call per stage instead of N, and the implementations can loop over the
+    systems in the innermost loop (which the compiler vectorizes).
+
+    Since BatchedIVP<DIM> is an AbstractIVP<BatchVector<DIM> >, the batch can be
+    integrated by any OneStepScheme (ExplicitRungeKuttaScheme, ROWMethod, WMethod),
+    with solve_IVP() controlling one common step size for all systems.
+
+    Derived classes have to implement evaluate_f() and evaluate_ft().
+    For linearly implicit schemes, solve_ROW_stage_equation() solves the
+    small systems by Gaussian elimination in lockstep, using the Jacobians
+    from evaluate_jacobian(). The default evaluate_jacobian() uses forward
+    differences, it should be overridden if the Jacobians are known.
+    Since all stages of a step use the Jacobians at the same (t,v), they are
+    only evaluated once per step.
+  */
+  template <unsigned int DIM>
+  class BatchedIVP
+    : public AbstractIVP<BatchVector<DIM> >
+  {
+  public:
+    /*!
+      default constructor
+    */
+    BatchedIVP();
+
+    /*!
+      virtual destructor
+    */
+    virtual ~BatchedIVP();
+
+    /*!
+      number of systems (as given by u0)
+    */
+    const unsigned int systems() const { return this->u0.systems(); }
+
+    /*!
+      Evaluate the Jacobians J_s = \partial_v f_s(t,v_s) of all systems,
+      the entry (i,j) of J_s is stored as J(i*DIM+j,s).
+    */
+    virtual void evaluate_jacobian(const double t,
+				   const BatchVector<DIM>& v,
+				   BatchVector<DIM*DIM>& J) const;
+
+    /*!
+      solve the DIM x DIM systems
+
+        (alpha*I-J_s)x_s = y_s,   s = 0,...,N-1,
+
+      where J_s = \partial_v f_s(t,v_s).
+      The elimination uses partial pivoting, chosen for each system separately.
+      The Jacobians are reused as long as t and v do not change.
+    */
+    virtual void solve_ROW_stage_equation(const double t,
+					  const BatchVector<DIM>& v,
+					  const double alpha,
+					  const BatchVector<DIM>& y,
+					  const double tolerance,
+					  BatchVector<DIM>& result) const;
+
+    /*!
+      forget the stored Jacobians, e.g., after the parameters of f have changed
+    */
+    void reset_jacobian() const { jacobian_v_.resize(0); }
+
+  protected:
+    /*!
+      the Jacobians at (t,v), evaluated only if (t,v) differs from the last call
+    */
+    const BatchVector<DIM*DIM>& jacobian(const double t, const BatchVector<DIM>& v) const;
+
+    //! the last Jacobians and their arguments (t,v), invalid if jacobian_v_ is empty
+    mutable double jacobian_t_;
+    mutable BatchVector<DIM> jacobian_v_;
+    mutable BatchVector<DIM*DIM> jacobian_;
+  };
+}
+
+#include <numerics/batched_ivp.cpp>
+
+#endif
@@ -24,12 +24,58 @@ namespace MathTL
   }
 
 
+  template <unsigned int DIM>
+  void
+  EllipticBVP<DIM>::a_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = a(x[m]);
+  }
+
+  template <unsigned int DIM>
+  void
+  EllipticBVP<DIM>::q_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = q(x[m]);
+  }
+
+  template <unsigned int DIM>
+  void
+  EllipticBVP<DIM>::f_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = f(x[m]);
+  }
+
+
   template <unsigned int DIM>
   PoissonBVP<DIM>::PoissonBVP(const Function<DIM>* f)
     : EllipticBVP<DIM>(f, f, f)
   {
   }
 
+  template <unsigned int DIM>
+  void
+  PoissonBVP<DIM>::a_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = 1.0;
+  }
+
+  template <unsigned int DIM>
+  void
+  PoissonBVP<DIM>::q_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = 0.0;
+  }
+
   template <unsigned int DIM>
   PoissonBVP_Coeff<DIM>::PoissonBVP_Coeff(const Function<DIM>* a, const Function<DIM>* f)
     : EllipticBVP<DIM>(a, f, f)
@@ -57,6 +103,24 @@ namespace MathTL
   {
   }
 
+  template <unsigned int DIM>
+  void
+  IdentityBVP<DIM>::a_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = 0.0;
+  }
+
+  template <unsigned int DIM>
+  void
+  IdentityBVP<DIM>::q_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const
+  {
+    values.resize(x.size());
+    for (unsigned int m = 0; m < x.size(); m++)
+      values[m] = 1.0;
+  }
+
   template <unsigned int DIM>
   BiharmonicBVP<DIM>::BiharmonicBVP(const Function<DIM>* f)
     :f_(f)
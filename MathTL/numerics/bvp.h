@@ -117,6 +117,17 @@ namespace MathTL
       return f_->value(x);
     }
 
+    /*!
+      Batch versions of a(), q() and f() for a whole array of points x
+      (e.g., all mapped knots of a quadrature rule), the results are resized
+      to x.size(). The default implementations call the pointwise versions,
+      problems with constant coefficients override them without any
+      virtual call per point.
+    */
+    virtual void a_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+    virtual void q_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+    virtual void f_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+
     /*!
       set the right-hand side to another function
     */
@@ -161,6 +172,10 @@ namespace MathTL
       flag for constant coefficients
     */
     const bool constant_coefficients() const { return true; }
+
+    //! batch versions of a() and q()
+    void a_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+    void q_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
   };
   
   
@@ -246,6 +261,10 @@ namespace MathTL
       flag for constant coefficients
     */
     const bool constant_coefficients() const { return true; }
+
+    //! batch versions of a() and q()
+    void a_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
+    void q_values(const Array1D<Point<DIM> >& x, Array1D<double>& values) const;
   };
 
 
@@ -39,6 +39,20 @@ namespace MathTL
     double knot(const int k) const { return k; }
   };
 
+  /*!
+    the cardinal knots t_k = k as a (non-virtual) knot class
+    for the batch evaluation routine evaluate_Bsplines()
+  */
+  class CardinalKnots
+  {
+  public:
+    //! compute the k-th knot
+    double knot(const int k) const { return k; }
+
+    //! knot interval [t_l,t_{l+1}) containing x
+    int interval(const double x) const { return (int)floor(x); }
+  };
+
   /*!
     evaluate a cardinal B-spline N_d(x) via recursion
     (fastest possible variant)
@@ -9,6 +9,7 @@
 #include <utils/tiny_tools.h>
 #include <utils/random.h>
 #include <utils/array1d.h>
+#include <utils/task_scheduler.h>
 
 namespace MathTL
 {
@@ -84,6 +85,24 @@ namespace MathTL
     return lambdak;
   }
 
+  /*
+    copy the i-th row of A into B, as a body for parallel_for()
+  */
+  template <class MATRIX, class MATRIX2>
+  class CopyRows
+  {
+  public:
+    CopyRows(const MATRIX& A, MATRIX2& B) : A_(A), B_(B) {}
+    void operator () (const int i)
+    {
+      for (typename MATRIX::size_type j(0); j < A_.column_dimension(); j++)
+	B_(i,j) = A_.get_entry(i,j);
+    }
+  protected:
+    const MATRIX& A_;
+    MATRIX2& B_;
+  };
+
   template <class VECTOR, class MATRIX, class MATRIX2>
   void SymmEigenvalues(const MATRIX& A, VECTOR& evals, MATRIX2& evecs)
   {
@@ -97,12 +116,13 @@ namespace MathTL
 
     // use evecs as working copy of A
     evecs.resize(n,n);
+    CopyRows<MATRIX,MATRIX2> copy_rows(A, evecs);
 #if PARALLEL==1
-#pragma omp parallel for
-#endif
+    parallel_for(0, n, copy_rows);
+#else
     for (size_type i=0; i < n; i++)
-      for (size_type j(0); j < n; j++)
-	evecs(i,j) = A.get_entry(i,j);
+      copy_rows(i);
+#endif
     
     // transform A to tridiagonal form via symmetric Householder reduction
     for (size_type j(0); j < n; j++)
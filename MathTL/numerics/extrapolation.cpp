@@ -2,12 +2,13 @@
 
 #include <cassert>
 #include <cmath>
+#include <utils/task_scheduler.h>
 
 namespace MathTL
 {
   template <class ALGORITHM, class RESULT, class SEQUENCE>
   ExtrapolationTable<ALGORITHM,RESULT,SEQUENCE>::ExtrapolationTable
-  (const ALGORITHM& T, const unsigned int size, const int p)
+  (const ALGORITHM& T, const unsigned int size, const int p, const bool parallel)
     : table_(size, size)
   {
     assert(size >= 2);
@@ -15,8 +16,13 @@ namespace MathTL
     SEQUENCE s;
 
     // fill first column of the extrapolation table
-    for (unsigned int j = 1; j <= size; j++)
-      T.approximate(s.n(j), table_(j-1, 0));
+    if (parallel) {
+      FirstColumn body(T, table_);
+      parallel_for(1, size+1, body);
+    } else {
+      for (unsigned int j = 1; j <= size; j++)
+	T.approximate(s.n(j), table_(j-1, 0));
+    }
     
     // compute right half of the extrapolation table (Aitken-Neville)
     for (unsigned int k = 2; k <= size; k++)
@@ -69,6 +69,11 @@ namespace MathTL
 
     The template parameter RESULT should be a number or vector class,
     since the entries of the extrapolation table are of this type.
+    With RESULT=BatchVector<DIM>, one table serves many independent systems.
+
+    If approximate() is thread-safe, the approximations of the first column
+    can be computed in parallel on the common TaskScheduler (they are
+    independent of each other, only the Aitken-Neville steps are sequential).
    */
   template <class ALGORITHM, class RESULT = double, class SEQUENCE = RombergSequence>
   class ExtrapolationTable
@@ -79,7 +84,8 @@ namespace MathTL
     */
     ExtrapolationTable(const ALGORITHM& T,
 		       const unsigned int size,
-		       const int p = 1);
+		       const int p = 1,
+		       const bool parallel = false);
 
     /*!
       read access to the extrapolation table
@@ -89,6 +95,19 @@ namespace MathTL
   protected:
     //! the extrapolation table
     LowerTriangularMatrix<RESULT> table_;
+
+    // the body of parallel_for() over the first column
+    class FirstColumn
+    {
+    public:
+      FirstColumn(const ALGORITHM& T, LowerTriangularMatrix<RESULT>& table)
+	: T_(T), table_(table) {}
+      void operator () (const int j) { T_.approximate(s_.n(j), table_(j-1, 0)); }
+    protected:
+      const ALGORITHM& T_;
+      LowerTriangularMatrix<RESULT>& table_;
+      SEQUENCE s_;
+    };
   };
 
 }
@@ -0,0 +1,70 @@
+// implementation for fft.h
+
+#include <cassert>
+#include <cmath>
+
+namespace MathTL
+{
+  template <class C>
+  void fft(Array1D<std::complex<C> >& x, const bool inverse)
+  {
+    const unsigned int n(x.size());
+    assert((n & (n-1)) == 0); // n has to be a power of 2
+    if (n <= 1) return;
+
+    // bit reversal permutation
+    for (unsigned int i(1), j(0); i < n; i++) {
+      unsigned int bit(n >> 1);
+      for (; j & bit; bit >>= 1)
+	j ^= bit;
+      j ^= bit;
+      if (i < j)
+	std::swap(x[i], x[j]);
+    }
+
+    // butterflies of length 2, 4, ..., n
+    for (unsigned int len(2); len <= n; len <<= 1) {
+      const C angle((inverse ? 2 : -2) * M_PI / len);
+      const std::complex<C> wlen(cos(angle), sin(angle));
+      for (unsigned int i(0); i < n; i += len) {
+	std::complex<C> w(1);
+	for (unsigned int k(0); k < len/2; k++) {
+	  const std::complex<C> u(x[i+k]), v(x[i+k+len/2] * w);
+	  x[i+k] = u + v;
+	  x[i+k+len/2] = u - v;
+	  w *= wlen;
+	}
+      }
+    }
+
+    if (inverse)
+      for (unsigned int i(0); i < n; i++)
+	x[i] /= (C)n;
+  }
+
+  template <class C>
+  void circular_convolution(const Vector<C>& x, const Vector<C>& y, Vector<C>& z)
+  {
+    assert(x.size() == y.size());
+    const unsigned int n(x.size());
+
+    // transform both real vectors at once, as real and imaginary part of one complex vector
+    Array1D<std::complex<C> > h(n);
+    for (unsigned int i(0); i < n; i++)
+      h[i] = std::complex<C>(x[i], y[i]);
+    fft(h);
+
+    // with X_k = (H_k + conj(H_{n-k}))/2 and Y_k = (H_k - conj(H_{n-k}))/(2i),
+    // the product X_k*Y_k is
+    Array1D<std::complex<C> > p(n);
+    for (unsigned int k(0); k < n; k++) {
+      const std::complex<C> hk(h[k]), hnk(std::conj(h[(n-k) & (n-1)]));
+      p[k] = (hk + hnk) * (hk - hnk) / std::complex<C>(0, 4);
+    }
+    fft(p, true);
+
+    z.resize(n, false);
+    for (unsigned int i(0); i < n; i++)
+      z[i] = p[i].real();
+  }
+}
@@ -0,0 +1,44 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of MathTL - the Mathematical Template Library    |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _MATHTL_FFT_H
+#define _MATHTL_FFT_H
+
+#include <complex>
+#include <utils/array1d.h>
+#include <algebra/vector.h>
+
+namespace MathTL
+{
+  /*!
+    in-place discrete Fourier transform of a complex vector x of length n=2^m,
+
+      x_k <- \sum_{l=0}^{n-1} x_l e^{-2\pi ikl/n},
+
+    by the iterative radix-2 Cooley-Tukey algorithm (O(n log n) operations).
+    For inverse == true, the inverse transform (with the factor 1/n) is computed.
+  */
+  template <class C>
+  void fft(Array1D<std::complex<C> >& x, const bool inverse = false);
+
+  /*!
+    circular convolution of two real vectors of length n=2^m,
+
+      z_k = \sum_{l=0}^{n-1} x_l y_{(k-l) mod n},
+
+    computed via FFT
+  */
+  template <class C>
+  void circular_convolution(const Vector<C>& x, const Vector<C>& y, Vector<C>& z);
+}
+
+// include implementation
+#include <numerics/fft.cpp>
+
+#endif
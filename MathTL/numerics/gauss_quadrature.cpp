@@ -15,15 +15,16 @@ namespace MathTL
   inline
   GaussLegendreRule::GaussLegendreRule(const unsigned int N)
   {
-    assert(N <= 10);
+    const Array1D<double>& gauss_points(GaussLegendreTable::points(N));
+    const Array1D<double>& gauss_weights(GaussLegendreTable::weights(N));
 
     points_.resize(N);
     weights_.resize(N);
     for (unsigned int n(0); n < N; n++)
       {
 	// the precomputed values live on [-1,1]
-	points_[n]  = 0.5 + 0.5 * GaussPoints[N-1][n];
-	weights_[n] = GaussWeights[N-1][n];
+	points_[n]  = 0.5 + 0.5 * gauss_points[n];
+	weights_[n] = gauss_weights[n];
       }
   }
 
@@ -90,4 +91,199 @@ namespace MathTL
 	weights_[n] = evecs(0, n) * evecs(0, n);
       }
   }
+
+  inline
+  const std::pair<Array1D<double>,Array1D<double> >&
+  GaussLegendreTable::rule(const unsigned int N)
+  {
+    assert(N >= 1);
+
+    const std::pair<Array1D<double>,Array1D<double> >* result(0);
+#ifdef _OPENMP
+#pragma omp critical(MathTL_GaussLegendreTable)
+#endif
+    {
+      Table::iterator it(table().lower_bound(N));
+      if (it == table().end() || it->first != N) {
+	Array1D<double> points(N), weights(N);
+	if (N <= 10) {
+	  for (unsigned int n(0); n < N; n++) {
+	    points[n]  = GaussPoints[N-1][n];
+	    weights[n] = GaussWeights[N-1][n];
+	  }
+	} else {
+	  // Newton's method for the zeros of the Legendre polynomial P_N,
+	  // starting from the asymptotic approximations; by symmetry,
+	  // only the positive zeros have to be computed
+	  for (unsigned int i(0); i < (N+1)/2; i++) {
+	    double x(cos(M_PI*(i+0.75)/(N+0.5))), dp(0), dx(1);
+	    for (int iter(0); iter < 100 && fabs(dx) > 1e-15; iter++) {
+	      // three-term recursion for P_N(x) and P_{N-1}(x)
+	      double p0(1), p1(x);
+	      for (unsigned int k(2); k <= N; k++) {
+		const double p2(((2*k-1)*x*p1 - (k-1)*p0)/k);
+		p0 = p1;
+		p1 = p2;
+	      }
+	      dp = N*(x*p1-p0)/(x*x-1);
+	      dx = p1/dp;
+	      x -= dx;
+	    }
+	    points[N-1-i] = x;
+	    points[i] = -x;
+	    // the weights on [-1,1] are 2/((1-x^2)P_N'(x)^2), normalize them to sum 1
+	    weights[i] = weights[N-1-i] = 1.0/((1-x*x)*dp*dp);
+	  }
+	  if (N%2 == 1)
+	    points[N/2] = 0.0;
+	}
+	it = table().insert(it, Table::value_type(N, std::make_pair(points, weights)));
+      }
+      result = &it->second;
+    }
+    return *result;
+  }
+
+  inline
+  const Array1D<double>&
+  GaussLegendreTable::points(const unsigned int N)
+  {
+    return rule(N).first;
+  }
+
+  inline
+  const Array1D<double>&
+  GaussLegendreTable::weights(const unsigned int N)
+  {
+    return rule(N).second;
+  }
+
+  inline
+  DyadicGaussRule::DyadicGaussRule()
+    : j_(0), a_(0), b_(0), N_(0)
+  {
+  }
+
+  inline
+  void
+  DyadicGaussRule::setup(const int j, const int a, const int b, const unsigned int N)
+  {
+    if (j == j_ && a == a_ && b == b_ && N == N_)
+      return;
+
+    const Array1D<double>& gauss_points(GaussLegendreTable::points(N));
+    const Array1D<double>& gauss_weights(GaussLegendreTable::weights(N));
+
+    const double h(ldexp(1.0, -j));
+    points_.resize(N*(b-a));
+    weights_.resize(N*(b-a));
+    for (int patch(a), id(0); patch < b; patch++)
+      for (unsigned int n(0); n < N; n++, id++) {
+	points_[id]  = h*(2*patch+1+gauss_points[n])/2.;
+	weights_[id] = h*gauss_weights[n];
+      }
+
+    j_ = j;
+    a_ = a;
+    b_ = b;
+    N_ = N;
+  }
+
+  /*
+    tensor product Gauss rule on the box [a,b]
+  */
+  template <unsigned int DIM>
+  double
+  tensor_gauss_integral(const Function<DIM>& f,
+			const Point<DIM>& a, const Point<DIM>& b,
+			const Array1D<double>& gauss_points,
+			const Array1D<double>& gauss_weights)
+  {
+    const unsigned int N(gauss_points.size());
+    double r(0);
+    Point<DIM> x;
+    unsigned int index[DIM];
+    for (unsigned int i(0); i < DIM; i++)
+      index[i] = 0;
+    while (true) {
+      double weight(1);
+      for (unsigned int i(0); i < DIM; i++) {
+	x[i] = a[i] + (b[i]-a[i])*(1+gauss_points[index[i]])/2;
+	weight *= (b[i]-a[i])*gauss_weights[index[i]];
+      }
+      r += weight * f.value(x);
+
+      // "++index"
+      bool exit(false);
+      for (unsigned int i(0); i < DIM; i++) {
+	if (index[i] == N-1) {
+	  index[i] = 0;
+	  exit = (i == DIM-1);
+	} else {
+	  index[i]++;
+	  break;
+	}
+      }
+      if (exit) break;
+    }
+    return r;
+  }
+
+  /*
+    recursive part of adaptive_gauss_integral(),
+    coarse is the Gauss rule on [a,b]
+  */
+  template <unsigned int DIM>
+  double
+  adaptive_gauss_integral(const Function<DIM>& f,
+			  const Point<DIM>& a, const Point<DIM>& b,
+			  const Array1D<double>& gauss_points,
+			  const Array1D<double>& gauss_weights,
+			  const double coarse,
+			  const double tol,
+			  const int depth)
+  {
+    const unsigned int nchildren(1<<DIM);
+    Array1D<Point<DIM> > ca(nchildren), cb(nchildren);
+    Array1D<double> children(nchildren);
+    double fine(0);
+    for (unsigned int c(0); c < nchildren; c++) {
+      for (unsigned int i(0); i < DIM; i++) {
+	const double m((a[i]+b[i])/2);
+	if ((c >> i) & 1) {
+	  ca[c][i] = m;
+	  cb[c][i] = b[i];
+	} else {
+	  ca[c][i] = a[i];
+	  cb[c][i] = m;
+	}
+      }
+      children[c] = tensor_gauss_integral(f, ca[c], cb[c], gauss_points, gauss_weights);
+      fine += children[c];
+    }
+
+    if (depth <= 0 || fabs(fine-coarse) <= tol)
+      return fine;
+
+    double r(0);
+    for (unsigned int c(0); c < nchildren; c++)
+      r += adaptive_gauss_integral(f, ca[c], cb[c], gauss_points, gauss_weights,
+				   children[c], tol/nchildren, depth-1);
+    return r;
+  }
+
+  template <unsigned int DIM>
+  double
+  adaptive_gauss_integral(const Function<DIM>& f,
+			  const Point<DIM>& a, const Point<DIM>& b,
+			  const unsigned int N,
+			  const double tol,
+			  const int max_depth)
+  {
+    const Array1D<double>& gauss_points(GaussLegendreTable::points(N));
+    const Array1D<double>& gauss_weights(GaussLegendreTable::weights(N));
+    return adaptive_gauss_integral(f, a, b, gauss_points, gauss_weights,
+				   tensor_gauss_integral(f, a, b, gauss_points, gauss_weights),
+				   tol, max_depth);
+  }
 }
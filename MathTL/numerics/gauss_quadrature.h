@@ -10,7 +10,10 @@
 #ifndef _MATHTL_GAUSS_QUADRATURE_H
 #define _MATHTL_GAUSS_QUADRATURE_H
 
+#include <map>
 #include <utils/array1d.h>
+#include <utils/function.h>
+#include <geometry/point.h>
 #include <numerics/quadrature.h>
 #include <numerics/ortho_poly.h>
 
@@ -18,7 +21,8 @@ namespace MathTL
 {
   /*!
     N-point 1D Gauss-Legendre quadrature rule on [0,1]
-    (uses precomputed points and weights for 1<=N<=10
+    (uses the points and weights of GaussLegendreTable, i.e.,
+    precomputed ones for 1<=N<=10)
   */
   class GaussLegendreRule
     : public QuadratureRule<1>
@@ -88,6 +92,84 @@ namespace MathTL
 	      const double a, const double b,
 	      const unsigned int N);
   };
+
+  /*!
+    Gauss-Legendre points and weights of arbitrary order N>=1 on [-1,1],
+    in the same format as GaussPoints[N-1] and GaussWeights[N-1] from
+    gauss_data.h (ascending points, the weights sum up to 1).
+    For N<=10, the tabulated values are used, higher orders are computed
+    once by Newton's method on the Legendre polynomials and kept for the
+    lifetime of the program. The lookup is thread-safe.
+  */
+  class GaussLegendreTable
+  {
+  public:
+    //! the N Gauss points in [-1,1]
+    static const Array1D<double>& points(const unsigned int N);
+
+    //! the N Gauss weights, normalized to sum 1
+    static const Array1D<double>& weights(const unsigned int N);
+
+  protected:
+    typedef std::map<unsigned int, std::pair<Array1D<double>,Array1D<double> > > Table;
+
+    //! the rules computed so far (std::map references stay valid under insertion)
+    static Table& table() { static Table t; return t; }
+
+    //! lookup the N-point rule, compute it if necessary
+    static const std::pair<Array1D<double>,Array1D<double> >& rule(const unsigned int N);
+  };
+
+  /*!
+    N-point composite Gauss-Legendre rule on the dyadic cells
+      2^{-j}[k,k+1],  a <= k < b,
+    with the points ordered cell by cell.
+
+    The point and weight arrays are kept between calls of setup(), they are
+    only reallocated when the number of points changes, and setup() does
+    nothing if the rule does not change. So an object can be reused for
+    many integrals (e.g., one per thread in an assembly loop) without heap
+    traffic.
+  */
+  class DyadicGaussRule
+  {
+  public:
+    //! default constructor, yields an empty rule
+    DyadicGaussRule();
+
+    //! set up the rule for the cells a<=k<b on level j
+    void setup(const int j, const int a, const int b, const unsigned int N);
+
+    //! read access to the points
+    const Array1D<double>& points() const { return points_; }
+
+    //! read access to the weights
+    const Array1D<double>& weights() const { return weights_; }
+
+    //! number of points
+    unsigned int size() const { return points_.size(); }
+
+  protected:
+    int j_, a_, b_;
+    unsigned int N_;
+    Array1D<double> points_, weights_;
+  };
+
+  /*!
+    Adaptive composite N-point Gauss-Legendre quadrature of f over the box [a,b]
+    (in the tensor product sense). A box is bisected in all directions as
+    long as the Gauss rule on the box and the sum of the Gauss rules on its 2^DIM
+    children differ by more than the local tolerance, which is split
+    equally among the children, but at most max_depth times.
+    This is meant for nonsmooth integrands like CornerSingularity, where a
+    fixed Gauss rule converges only slowly.
+  */
+  template <unsigned int DIM>
+  double adaptive_gauss_integral(const Function<DIM>& f,
+				 const Point<DIM>& a, const Point<DIM>& b,
+				 const unsigned int N,
+				 const double tol,
+				 const int max_depth = 10);
 }
 
 // include implementation of inline functions
@@ -313,4 +313,74 @@ namespace MathTL
 
     return (iterations <= maxiter);
   }
+
+  template <class VECTOR, class MATRIX, class PREC>
+  bool MultiShiftPCG(const MATRIX &A, const VECTOR &b, const PREC& P,
+		     const Array1D<double>& shifts, Array1D<VECTOR>& xs,
+		     const double tol, const unsigned int maxiter, unsigned int& iterations)
+  {
+    const unsigned int n = A.row_dimension(), nshifts = shifts.size();
+
+    // seed residual r_k = b-A*x_k (x_0 = 0), shifted residuals are zeta_k^s*r_k
+    VECTOR rk(b), zk(n, false), pk(n, false), Apk(n, false);
+    P.apply_preconditioner(rk, zk);
+    pk = zk;
+    double rhok = rk * zk;
+    const double normr0 = l2_norm_sqr(rk);
+
+    // the shifted systems, zeta_{k-1}^s, zeta_k^s and the search directions p_k^s
+    xs.resize(nshifts);
+    Array1D<VECTOR> ps(nshifts);
+    Array1D<double> zetas(nshifts), oldzetas(nshifts);
+    std::set<unsigned int> active;
+    for (unsigned int s = 0; s < nshifts; s++) {
+      xs[s].resize(n);
+      ps[s] = zk;
+      zetas[s] = oldzetas[s] = 1.0;
+      if (normr0 > 0) active.insert(s);
+    }
+
+    double oldalpha = 1.0, oldbeta = 0.0;
+    for (iterations = 1; !active.empty() && iterations <= maxiter; iterations++)
+      {
+	A.apply(pk, Apk);
+	const double alpha = rhok/(pk*Apk);
+
+	// zeta_{k+1}^s from the coefficients of the seed system
+	Array1D<double> newzetas(nshifts);
+	for (std::set<unsigned int>::const_iterator it(active.begin()); it != active.end(); ++it) {
+	  const unsigned int s = *it;
+	  newzetas[s] = zetas[s]*oldzetas[s]*oldalpha
+	    / (alpha*oldbeta*(oldzetas[s]-zetas[s])
+	       + oldzetas[s]*oldalpha*(1.0+shifts[s]*alpha));
+	  xs[s].add(alpha*newzetas[s]/zetas[s], ps[s]);
+	}
+
+	rk.add(-alpha, Apk);
+	const double normrk = l2_norm_sqr(rk);
+	P.apply_preconditioner(rk, zk);
+	const double newrhok = rk * zk;
+	const double beta = newrhok/rhok;
+
+	for (std::set<unsigned int>::iterator it(active.begin()); it != active.end();) {
+	  const unsigned int s = *it;
+	  const double ratio = newzetas[s]/zetas[s];
+	  ps[s].scale(beta*ratio*ratio);
+	  ps[s].add(newzetas[s], zk);
+	  oldzetas[s] = zetas[s];
+	  zetas[s] = newzetas[s];
+	  if (zetas[s]*zetas[s]*normrk <= tol*tol*normr0)
+	    active.erase(it++); // converged, x_s is not updated any longer
+	  else
+	    ++it;
+	}
+
+	pk.sadd(beta, zk);
+	oldalpha = alpha;
+	oldbeta = beta;
+	rhok = newrhok;
+      }
+
+    return active.empty();
+  }
 }
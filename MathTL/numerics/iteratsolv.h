@@ -10,6 +10,8 @@
 #ifndef _MATHTL_ITERATSOLV_H
 #define _MATHTL_ITERATSOLV_H
 
+#include <utils/array1d.h>
+
 // A collection of template-based iterative solvers for linear systems.
 // 
 // VECTOR: arbitrary vector class, should implement the operators +, -, * (scalar mult.)
@@ -130,6 +132,30 @@ namespace FLAT
   template <class VECTOR, class MATRIX, class PREC>
   bool PCG(const MATRIX &A, const VECTOR &b, const PREC& P, VECTOR &xk,
 	   const double tol, const unsigned int maxiter, unsigned int& iterations);
+
+  //! multi-shift preconditioned conjugate gradient iteration
+  /*!
+    preconditioned conjugate gradient iteration for the family of shifted systems
+      (A + sigma_s * M) x_s = b,  s = 0,...,shifts.size()-1,
+    where P.apply_preconditioner() applies M^{-1} (M = I for IdentityPreconditioner).
+    Since the Krylov spaces of M^{-1}A and M^{-1}(A + sigma*M) = M^{-1}A + sigma*I
+    coincide, all systems are solved with the matrix-vector products of the seed
+    system A only; the shifted residuals are collinear to the seed residual
+    (cf. Jegerlehner, Krylov space solvers for shifted linear systems, 1996).
+    The starting vectors are always zero.
+    \param A s.p.d. seed matrix
+    \param b right-hand side vector
+    \param P (left, s.p.d.) preconditioner, applying M^{-1}
+    \param shifts shifts sigma_s, such that the A + sigma_s * M are s.p.d.
+    \param xs solutions
+    \param tol stopping tolerance (relative residual of each shifted system)
+    \param iterations number of cg iterations
+    \return convergence of all systems within <maxiter> iterations
+  */
+  template <class VECTOR, class MATRIX, class PREC>
+  bool MultiShiftPCG(const MATRIX &A, const VECTOR &b, const PREC& P,
+		     const MathTL::Array1D<double>& shifts, MathTL::Array1D<VECTOR>& xs,
+		     const double tol, const unsigned int maxiter, unsigned int& iterations);
 }
 
 #include <numerics/iteratsolv.cpp>
@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <time.h>
 
 using std::cout;
 using std::endl;
@@ -308,4 +309,136 @@ namespace MathTL
       }
 #endif
   }
+
+  template <class VECTOR, class IVP>
+  void solve_IVP_balanced(IVP* ivp,
+			  OneStepScheme<VECTOR, IVP>* scheme,
+			  const double T,
+			  const TimeSpaceControl& control,
+			  IVPSolution<VECTOR>& result,
+			  std::list<TimeStepInfo>* protocol)
+  {
+    result.t.clear();
+    result.u.clear();
+    if (protocol) protocol->clear();
+
+    double t_m = 0;
+    VECTOR u_m(ivp->u0);
+    result.t.push_back(t_m);
+    result.u.push_back(u_m);
+
+    const double rho = 0.8; // overall safety factor
+    const double fac1 = 5.0, fac2 = 1./control.q;
+    const int order = scheme->order();
+
+    // guess the initial time stepsize (cf. Hairer/Wanner, p. 169)
+    double u0_norm = linfty_norm(ivp->u0);
+    VECTOR yp0(ivp->u0);
+    ivp->evaluate_f(0, ivp->u0, control.theta*control.atol, yp0); // initial slope
+    double ft0u0_norm = linfty_norm(yp0);
+    double tau0 = (u0_norm < 1e-5 || ft0u0_norm < 1e-5)
+      ? 1e-6 : 1e-2*u0_norm/ft0u0_norm;
+    double tau_m = std::min(control.tau_max, 100*tau0);
+
+    double theta = control.theta;
+    double hacc = 0, erracc = 0; // data of the last accepted step (Gustafsson)
+    double tau_rejected = 0, errest_rejected = 0; // data of the last rejected trial step
+    unsigned int m = 1;
+
+    VECTOR u_mplus1, error_estimate;
+    bool done = false;
+    while (!done)
+      {
+	// jump to T if within 10% of T-t_m
+	if (1.1*tau_m >= fabs(T-t_m) || t_m+tau_m >= T)
+	  {
+	    tau_m = T-t_m;
+	    done = true; // we would be "done" if the step is accepted
+	  }
+
+	// try to advance one step
+	const double tolerance = theta * (control.atol + control.rtol*l2_norm(u_m));
+	const clock_t tstart = clock();
+	scheme->increment(ivp, t_m, u_m, tau_m, u_mplus1, error_estimate, tolerance);
+	const double cpu_time = (double)(clock()-tstart)/CLOCKS_PER_SEC;
+
+	const double errest = error_estimate.wrmsqr_norm(control.atol, control.rtol, u_m, u_mplus1);
+
+	if (protocol) {
+	  TimeStepInfo info;
+	  info.t = t_m;
+	  info.tau = tau_m;
+	  info.tolerance = tolerance;
+	  info.errest = errest;
+	  info.cpu_time = cpu_time;
+	  info.accepted = (errest <= 1);
+	  protocol->push_back(info);
+	}
+
+	// estimate new stepsize
+	double fac = std::max(fac2, std::min(fac1, pow(errest, 1./order) / rho));
+	double tau_new = tau_m / fac;
+
+	if (errest <= 1)
+	  {
+	    // accept the time step
+
+#if _MATHTL_ONESTEPSCHEME_VERBOSITY >= 1
+	    cout << "t_{" << m << "}=" << t_m+tau_m << " accepted!"
+		 << " (errest=" << errest << ", tolerance=" << tolerance << ")" << endl;
+#endif
+
+	    t_m += tau_m;
+	    result.t.push_back(t_m);
+	    u_m.swap(u_mplus1);
+	    result.u.push_back(u_m);
+
+	    // predictive controller of Gustafsson
+	    if (m >= 2) {
+	      double facgus = (hacc/tau_m) * pow(errest*errest/erracc, 1./order) / rho;
+	      facgus = std::max(fac2, std::min(fac1, facgus));
+	      fac = std::max(fac, facgus);
+	      tau_new = tau_m / fac;
+	    }
+	    hacc = tau_m;
+	    erracc = std::max(1e-2, errest);
+
+	    tau_m = std::min(control.tau_max, tau_new);
+	    tau_rejected = 0;
+	    // increase theta only if the error estimate stays below the level
+	    // rho^{order} which keeps the step size, even if it is made up of spatial
+	    // errors (otherwise, theta would oscillate and the step sizes decay)
+	    if (2*errest <= pow(rho, (double)order))
+	      theta = std::min(control.theta, 2*theta);
+
+	    m++;
+	  }
+	else
+	  {
+	    // reject the time step, u_m is kept
+
+#if _MATHTL_ONESTEPSCHEME_VERBOSITY >= 1
+	    cout << "t_{" << m << "}=" << t_m+tau_m << " rejected!"
+		 << " (errest=" << errest << ", tolerance=" << tolerance << ")" << endl;
+#endif
+
+	    // the estimate of the temporal error should have decreased like tau^{order}
+	    // since the last rejection, otherwise the spatial errors dominate
+	    if (tau_rejected > 0
+		&& errest > 2 * errest_rejected * pow(tau_m/tau_rejected, (double)order))
+	      theta = std::max(control.theta_min, theta/4);
+	    tau_rejected = tau_m;
+	    errest_rejected = errest;
+
+	    tau_m = tau_new;
+	    done = false;
+
+	    if (tau_m < control.tau_min) {
+	      cout << "solve_IVP_balanced(): step size " << tau_m << " too small at t=" << t_m
+		   << ", giving up!" << endl;
+	      return;
+	    }
+	  }
+      }
+  }
 }
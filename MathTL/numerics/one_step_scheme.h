@@ -89,6 +89,72 @@ namespace MathTL
 		 const double q,
 		 const double tau_max,
 		 IVPSolution<VECTOR>& result);
+
+  /*!
+    parameters of solve_IVP_balanced()
+  */
+  struct TimeSpaceControl
+  {
+    //! default parameters
+    TimeSpaceControl(const double atol = 1e-4, const double rtol = 1e-4,
+		     const double tau_max = 1.0, const double theta = 0.1)
+      : atol(atol), rtol(rtol), q(5.0), tau_max(tau_max), tau_min(1e-12),
+	theta(theta), theta_min(1e-4) {}
+
+    //! absolute and relative tolerance for the local (temporal) error
+    double atol, rtol;
+
+    //! bound for the increase of the step size, tau_{m+1} <= q*tau_m
+    double q;
+
+    //! maximal and minimal step size (the integration is stopped below tau_min)
+    double tau_max, tau_min;
+
+    /*!
+      share of the local tolerance atol+rtol*||u^{(m)}|| which is passed to the
+      increment function as spatial tolerance, and its lower bound for the
+      automatic adjustment
+    */
+    double theta, theta_min;
+  };
+
+  /*!
+    protocol entry for one (accepted or rejected) trial step of solve_IVP_balanced()
+  */
+  struct TimeStepInfo
+  {
+    double t;          //!< start of the step
+    double tau;        //!< step size
+    double tolerance;  //!< spatial tolerance passed to the increment function
+    double errest;     //!< scaled error estimate (<= 1 for accepted steps)
+    double cpu_time;   //!< time spent in the increment function (seconds)
+    bool accepted;
+  };
+
+  /*!
+    Solve a given initial value problem on [0,T] adaptively with a given one-step scheme,
+    where also the tolerance for the evaluations within the increment function
+    (i.e., for the adaptive solution of the stage equations) is chosen automatically.
+
+    The step size is controlled as in solve_IVP(). The spatial tolerance of each step
+    is theta*(atol+rtol*||u^{(m)}||_2), i.e., the inexact stage solves may consume a fixed
+    share of the local tolerance; so steps with small local errors are not solved more
+    accurately than necessary. If a step size reduction after a rejected step does not
+    reduce the error estimate appropriately, the error estimate is dominated by the
+    spatial errors, and theta is reduced; after accepted steps with small error estimates,
+    it is increased again up to control.theta.
+    A rejected step only discards the trial values, u^{(m)} and the (possibly expensive)
+    setup of ivp and scheme are kept.
+
+    If a protocol is given, each trial step is logged there.
+  */
+  template <class VECTOR, class IVP>
+  void solve_IVP_balanced(IVP* ivp,
+			  OneStepScheme<VECTOR, IVP>* scheme,
+			  const double T,
+			  const TimeSpaceControl& control,
+			  IVPSolution<VECTOR>& result,
+			  std::list<TimeStepInfo>* protocol = 0);
 }
 
 #include <numerics/one_step_scheme.cpp>
@@ -182,7 +182,7 @@ namespace MathTL
   
   template <class VECTOR>
   void
-  ExplicitRungeKuttaScheme<VECTOR>::increment(const AbstractIVP<VECTOR>* ivp,
+  ExplicitRungeKuttaScheme<VECTOR>::increment(AbstractIVP<VECTOR>* ivp,
 					      const double t_m, const VECTOR& u_m,
 					      const double tau,
 					      VECTOR& u_mplus1,
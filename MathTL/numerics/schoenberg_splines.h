@@ -11,6 +11,7 @@
 #define _MATHTL_SCHOENBERG_SPLINES_H
 
 #include <cmath>
+#include <algorithm>
 #include <utils/function.h>
 #include <numerics/splines.h>
 #include <numerics/cardinal_splines.h>
@@ -43,6 +44,43 @@ namespace MathTL
     double knot(const int k) const { return std::max(0,k); }
   };
   
+  /*!
+    the Schoenberg knots t_k = max(0,k) as a (non-virtual) knot class
+    for the batch evaluation routine evaluate_Bsplines()
+  */
+  class SchoenbergKnots
+  {
+  public:
+    //! compute the k-th knot
+    double knot(const int k) const { return std::max(0,k); }
+
+    //! knot interval [t_l,t_{l+1}) containing x >= 0 (truncation suffices, x < 0 is not in the span)
+    int interval(const double x) const { return std::max(0, (int)x); }
+  };
+
+  /*!
+    the knots t_k = min(max(0,k),n), i.e., the Schoenberg knot sequence
+    with a d-fold knot at both x=0 and x=n (as a knot class for evaluate_Bsplines()).
+    The B-splines N_{k,d}, k=-d+1,...,n-1, w.r.t. this knot sequence coincide
+    with the Schoenberg B-splines near x=0 and with their reflections
+    at x=n/2 near x=n.
+  */
+  class SchoenbergIntervalKnots
+  {
+  public:
+    //! constructor from the number of knot intervals
+    SchoenbergIntervalKnots(const int n) : n_(n) {}
+
+    //! compute the k-th knot
+    double knot(const int k) const { return std::min(std::max(0,k),n_); }
+
+    //! knot interval [t_l,t_{l+1}) containing x in [0,n] (x=n belongs to the last one)
+    int interval(const double x) const { return std::min(std::max(0, (int)x), n_-1); }
+
+  protected:
+    int n_;
+  };
+
   /*!
     evaluate an arbitrary Schoenberg B-spline N_{k,d}(x)
   */
@@ -1,5 +1,6 @@
 // implementation for splines.h
 
+#include <algorithm>
 #include <algebra/triangular_matrix.h>
 
 namespace MathTL
@@ -27,4 +28,101 @@ namespace MathTL
 
     M = Matrix<double>(B2Inv) * B1;
   }
+
+  template <int d, class KNOTS>
+  void
+  evaluate_Bsplines(const KNOTS& knots, const unsigned int derivatives,
+		    const Array1D<double>& points,
+		    Array1D<int>& intervals, Array1D<double>& values)
+  {
+    const unsigned int n = points.size();
+    intervals.resize(n);
+    values.resize((derivatives+1)*d*n);
+    if (n == 0) return;
+
+    const double* x = &points[0];
+    int* l = &intervals[0];
+    double* v = &values[0];
+    for (unsigned int m = 0; m < n; m++)
+      l[m] = knots.interval(x[m]);
+    for (unsigned int id = d*n*std::min((unsigned int)d, derivatives+1); id < values.size(); id++)
+      v[id] = 0; // derivatives of order >= d
+
+    // The points are processed in chunks, so that the knot distances
+    //   deltar[q][m] = t_{l+1+q}-x_m, deltal[q][m] = x_m-t_{l-q}, q=0,...,d-2
+    // (see BSPLVB in [deBoor]) can live on the stack.
+    // The triangle of B-spline values of the orders 1,...,d is built up in the
+    // block of the 0-th derivative. Whenever the order d-s is reached, it is
+    // copied into the block of the s-th derivative, where it is differentiated
+    // s times.
+    const unsigned int chunk = 64;
+    double deltar[d][chunk], deltal[d][chunk], saved[chunk];
+    for (unsigned int m0 = 0; m0 < n; m0 += chunk) {
+      const unsigned int mm = std::min(n-m0, chunk);
+      const double* xc = x+m0;
+      const int* lc = l+m0;
+      for (int q = 0; q < d-1; q++)
+	for (unsigned int m = 0; m < mm; m++) {
+	  deltar[q][m] = knots.knot(lc[m]+1+q) - xc[m];
+	  deltal[q][m] = xc[m] - knots.knot(lc[m]-q);
+	}
+
+      double* b = v+m0;
+      for (unsigned int m = 0; m < mm; m++)
+	b[m] = 1.0; // N_{l,1}
+      for (int r = 1; r <= d; r++) {
+	// b[i*n+m] = N_{l-r+1+i,r}(x_m), i = 0,...,r-1
+	const int s = d-r;
+	if (s > 0 && s <= (int)derivatives) {
+	  double* bs = b + s*d*n;
+	  for (int i = 0; i < r; i++)
+	    for (unsigned int m = 0; m < mm; m++)
+	      bs[i*n+m] = b[i*n+m];
+	  // raise the order from rr-1 to rr by the derivative formula
+	  //   N_{k,rr}' = (rr-1)*(N_{k,rr-1}/(t_{k+rr-1}-t_k) - N_{k+1,rr-1}/(t_{k+rr}-t_{k+1}))
+	  for (int rr = r+1; rr <= d; rr++) {
+	    for (unsigned int m = 0; m < mm; m++)
+	      saved[m] = 0;
+	    for (int i = 0; i < rr-1; i++) {
+	      double* bsi = bs + i*n;
+	      const double* dr = deltar[i];
+	      const double* dl = deltal[rr-2-i];
+	      for (unsigned int m = 0; m < mm; m++) {
+		const double q = (rr-1) * bsi[m] / (dr[m] + dl[m]);
+		bsi[m] = saved[m] - q;
+		saved[m] = q;
+	      }
+	    }
+	    for (unsigned int m = 0; m < mm; m++)
+	      bs[(rr-1)*n+m] = saved[m];
+	  }
+	}
+	if (r == d) break;
+
+	// raise the order from r to r+1 by the recursion
+	//   N_{k,r+1}(x) = (x-t_k)/(t_{k+r}-t_k) N_{k,r}(x) + (t_{k+r+1}-x)/(t_{k+r+1}-t_{k+1}) N_{k+1,r}(x)
+	for (unsigned int m = 0; m < mm; m++)
+	  saved[m] = 0;
+	for (int i = 0; i < r; i++) {
+	  double* bi = b + i*n;
+	  const double* dr = deltar[i];
+	  const double* dl = deltal[r-1-i];
+	  for (unsigned int m = 0; m < mm; m++) {
+	    const double term = bi[m] / (dr[m] + dl[m]);
+	    bi[m] = saved[m] + dr[m] * term;
+	    saved[m] = dl[m] * term;
+	  }
+	}
+	for (unsigned int m = 0; m < mm; m++)
+	  b[r*n+m] = saved[m];
+      }
+    }
+
+    // points outside of the knot interval
+    for (unsigned int m = 0; m < n; m++)
+      if (x[m] < knots.knot(l[m]) || x[m] > knots.knot(l[m]+1))
+	for (unsigned int s = 0; s <= derivatives; s++)
+	  for (int i = 0; i < d; i++)
+	    v[(s*d+i)*n+m] = 0;
+  }
 }
@@ -116,6 +116,32 @@ namespace MathTL
     return (x >= knots[j] && x < knots[j+1] ? 1.0 : 0.0);
   }
 
+  /*!
+    evaluate the d B-splines N_{l-d+1,d},...,N_{l,d} of order d which do not
+    vanish on a knot interval [t_l,t_{l+1}), together with their derivatives
+    up to the given order, at a batch of points x_m, using de Boor's triangular
+    scheme (see [deBoor], BSPLVB/BSPLVD). The values are stored as
+
+      values[(s*d+i)*points.size()+m] = N_{intervals[m]-d+1+i,d}^{(s)}(x_m),
+
+    s = 0,...,derivatives, i = 0,...,d-1, where intervals[m] is the knot
+    interval containing x_m. Points outside of the span of the knot sequence
+    get zero values.
+
+    In contrast to the recursive evaluate_Bspline(), this costs O(d^2) operations
+    per point for all d B-splines. The loops over the points are the innermost
+    ones and do not branch, so that they can be vectorized.
+
+    KNOTS is a class with the non-virtual members
+      double knot(const int k) const;     (the k-th knot t_k)
+      int interval(const double x) const; (some l with t_l < t_{l+1}, t_l <= x < t_{l+1} if possible)
+    see, e.g., SchoenbergKnots in schoenberg_splines.h.
+  */
+  template <int d, class KNOTS>
+  void evaluate_Bsplines(const KNOTS& knots, const unsigned int derivatives,
+			 const Array1D<double>& points,
+			 Array1D<int>& intervals, Array1D<double>& values);
+
   /*!
     This class models (compactly supported) splines of order d
       f(x) = sum_{j=0}^n alpha_j N_{j,d}(x)
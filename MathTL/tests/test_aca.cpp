@@ -0,0 +1,76 @@
+#include <iostream>
+#include <cmath>
+#include <algebra/vector.h>
+#include <algebra/matrix.h>
+#include <numerics/aca.h>
+
+using std::cout;
+using std::endl;
+using namespace MathTL;
+
+/*
+  the kernel 1/|x-y| on the point sets x_i = i/m and y_j = d+j/n,
+  well-separated for d > 1
+*/
+class KernelBlock
+{
+public:
+  KernelBlock(const unsigned int m, const unsigned int n, const double d)
+    : m_(m), n_(n), d_(d) {}
+  double operator () (const unsigned int row, const unsigned int column) const {
+    return 1.0/fabs(row/(double)m_ - d_ - column/(double)n_);
+  }
+  unsigned int row_dimension() const { return m_; }
+  unsigned int column_dimension() const { return n_; }
+protected:
+  unsigned int m_, n_;
+  double d_;
+};
+
+/*
+  a matrix of rank 2, x_i*y_j + 1
+*/
+class RankTwoBlock
+{
+public:
+  double operator () (const unsigned int row, const unsigned int column) const {
+    return row*(column+1.0) + 1.0;
+  }
+  unsigned int row_dimension() const { return 20; }
+  unsigned int column_dimension() const { return 30; }
+};
+
+template <class GENERATOR>
+void check(const GENERATOR& M, const double tol)
+{
+  Matrix<double> U, V;
+  const unsigned int rank = ACA(M, tol, 100, U, V);
+
+  double err(0), norm(0);
+  for (unsigned int i = 0; i < M.row_dimension(); i++)
+    for (unsigned int j = 0; j < M.column_dimension(); j++) {
+      double entry = M(i, j);
+      norm += entry*entry;
+      for (unsigned int k = 0; k < rank; k++)
+	entry -= U(i, k) * V(j, k);
+      err += entry*entry;
+    }
+  cout << "  tol=" << tol << ", rank " << rank
+       << ", relative error in the Frobenius norm: "
+       << (sqrt(err) <= 10*tol*sqrt(norm) ? "<= 10*tol" : "too large") << endl;
+}
+
+int main()
+{
+  cout << "Testing the adaptive cross approximation ..." << endl;
+
+  cout << "* a rank-2 matrix:" << endl;
+  check(RankTwoBlock(), 1e-12);
+
+  cout << "* the kernel 1/|x-y| on well-separated point sets:" << endl;
+  KernelBlock K(200, 100, 2.0);
+  for (double tol = 1e-2; tol >= 1e-10; tol *= 1e-4)
+    check(K, tol);
+
+  return 0;
+}
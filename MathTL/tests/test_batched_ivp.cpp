@@ -0,0 +1,275 @@
+#include <iostream>
+#include <cmath>
+#include <time.h>
+#include <algebra/vector.h>
+#include <algebra/batch_vector.h>
+#include <numerics/ivp.h>
+#include <numerics/batched_ivp.h>
+#include <numerics/runge_kutta.h>
+#include <numerics/row_method.h>
+#include <numerics/one_step_scheme.h>
+#include <numerics/extrapolation.h>
+
+using std::cout;
+using std::endl;
+using namespace MathTL;
+
+/*
+  a single damped oscillator
+    u_0' = u_1, u_1' = -k*u_0 - c*u_1,  u(0) = (1,0)
+*/
+class Oscillator
+  : public AbstractIVP<Vector<double> >
+{
+public:
+  Oscillator(const double k, const double c)
+    : k_(k), c_(c)
+  {
+    u0.resize(2);
+    u0[0] = 1;
+  }
+
+  void evaluate_f(const double t, const Vector<double>& v,
+		  const double tolerance, Vector<double>& result) const
+  {
+    result.resize(2, false);
+    result[0] = v[1];
+    result[1] = -k_*v[0] - c_*v[1];
+  }
+
+  void evaluate_ft(const double t, const Vector<double>& v,
+		   const double tolerance, Vector<double>& result) const
+  {
+    result.resize(2);
+  }
+
+  void solve_ROW_stage_equation(const double t, const Vector<double>& v,
+				const double alpha, const Vector<double>& y,
+				const double tolerance, Vector<double>& result) const
+  {
+    // (alpha*I-J) = [alpha -1; k alpha+c]
+    const double det = alpha*(alpha+c_) + k_;
+    result.resize(2, false);
+    result[0] = ((alpha+c_)*y[0] + y[1]) / det;
+    result[1] = (-k_*y[0] + alpha*y[1]) / det;
+  }
+
+protected:
+  double k_, c_;
+};
+
+/*
+  the same oscillators with parameters k_s, c_s, s=0,...,N-1, as one batch
+*/
+class OscillatorBatch
+  : public BatchedIVP<2>
+{
+public:
+  OscillatorBatch(const Array1D<double>& k, const Array1D<double>& c,
+		  const bool exact_jacobian = true)
+    : jacobians(0), k_(k), c_(c), exact_jacobian_(exact_jacobian)
+  {
+    u0.resize(k.size());
+    for (unsigned int s = 0; s < k.size(); s++)
+      u0(0, s) = 1;
+  }
+
+  void evaluate_f(const double t, const BatchVector<2>& v,
+		  const double tolerance, BatchVector<2>& result) const
+  {
+    const unsigned int N = v.systems();
+    if (result.systems() != N) result.resize(N);
+    const double* v0 = v.component(0);
+    const double* v1 = v.component(1);
+    double* r0 = result.component(0);
+    double* r1 = result.component(1);
+    const double* k = k_.begin();
+    const double* c = c_.begin();
+    for (unsigned int s = 0; s < N; s++) {
+      r0[s] = v1[s];
+      r1[s] = -k[s]*v0[s] - c[s]*v1[s];
+    }
+  }
+
+  void evaluate_ft(const double t, const BatchVector<2>& v,
+		   const double tolerance, BatchVector<2>& result) const
+  {
+    result.resize(v.systems());
+  }
+
+  void evaluate_jacobian(const double t, const BatchVector<2>& v,
+			 BatchVector<4>& J) const
+  {
+    jacobians++;
+    if (!exact_jacobian_) {
+      BatchedIVP<2>::evaluate_jacobian(t, v, J);
+      return;
+    }
+    J.resize(v.systems());
+    for (unsigned int s = 0; s < v.systems(); s++) {
+      J(1, s) = 1;
+      J(2, s) = -k_[s];
+      J(3, s) = -c_[s];
+    }
+  }
+
+  //! exact solution of the system s (underdamped case c^2 < 4k)
+  double exact_solution(const double t, const unsigned int s) const
+  {
+    const double omega = sqrt(k_[s] - c_[s]*c_[s]/4);
+    return exp(-c_[s]*t/2) * (cos(omega*t) + c_[s]/(2*omega) * sin(omega*t));
+  }
+
+  //! number of evaluate_jacobian() calls
+  mutable unsigned int jacobians;
+
+protected:
+  Array1D<double> k_, c_;
+  bool exact_jacobian_;
+};
+
+/*
+  extrapolated explicit Euler scheme for the batch, n steps of size H/n
+*/
+class BatchEuler
+{
+public:
+  BatchEuler(const OscillatorBatch& ivp, const double H) : ivp_(ivp), H_(H) {}
+  void approximate(const unsigned int n, BatchVector<2>& r) const
+  {
+    r = ivp_.u0;
+    BatchVector<2> f(r.systems());
+    for (unsigned int i = 0; i < n; i++) {
+      ivp_.evaluate_f(i*H_/n, r, 0, f);
+      r.add(H_/n, f);
+    }
+  }
+protected:
+  const OscillatorBatch& ivp_;
+  double H_;
+};
+
+int main()
+{
+  cout << "Testing batched initial value problems ..." << endl;
+
+  const unsigned int N = 4000;
+  Array1D<double> k(N), c(N);
+  for (unsigned int s = 0; s < N; s++) {
+    k[s] = 1 + 99.0*s/N;
+    c[s] = 0.1 + 1.9*s/N;
+  }
+  OscillatorBatch batch(k, c);
+
+  // fixed steps of an explicit Runge-Kutta scheme, batch vs. one system at a time
+  const double tau = 1e-3;
+  const unsigned int steps = 200;
+  {
+    ExplicitRungeKuttaScheme<BatchVector<2> > scheme_batch(ExplicitRungeKuttaScheme<BatchVector<2> >::DoPri45);
+    ExplicitRungeKuttaScheme<Vector<double> > scheme_single(ExplicitRungeKuttaScheme<Vector<double> >::DoPri45);
+
+    clock_t tstart = clock();
+    BatchVector<2> u(batch.u0), unew, errest;
+    for (unsigned int m = 0; m < steps; m++) {
+      scheme_batch.increment(&batch, m*tau, u, tau, unew, errest);
+      u = unew;
+    }
+    const double time_batch = double(clock() - tstart) / CLOCKS_PER_SEC;
+
+    tstart = clock();
+    double deviation = 0;
+    for (unsigned int s = 0; s < N; s++) {
+      Oscillator single(k[s], c[s]);
+      Vector<double> v(single.u0), vnew, verrest;
+      for (unsigned int m = 0; m < steps; m++) {
+	scheme_single.increment(&single, m*tau, v, tau, vnew, verrest);
+	v = vnew;
+      }
+      deviation = std::max(deviation, std::max(fabs(v[0]-u(0,s)), fabs(v[1]-u(1,s))));
+    }
+    const double time_single = double(clock() - tstart) / CLOCKS_PER_SEC;
+
+    cout << "* DoPri45 with " << steps << " fixed steps for " << N << " oscillators:" << endl
+	 << "  max. deviation batch vs. single systems: " << deviation
+	 << (deviation < 1e-12 ? " (ok)" : " (too large)") << endl
+	 << "  (batch: " << time_batch << "s, one system at a time: " << time_single << "s)" << endl;
+  }
+
+  // adaptive linearly implicit scheme, one common step size for the batch
+  {
+    ROWMethod<BatchVector<2> > scheme(WMethod<BatchVector<2> >::RODAS3);
+    IVPSolution<BatchVector<2> > result;
+    AbstractIVP<BatchVector<2> >* ivp(&batch);
+    const double T = 1.0;
+    solve_IVP(ivp, &scheme, T, 1e-6, 1e-6, 10, 0.1, result);
+
+    double err = 0;
+    for (unsigned int s = 0; s < N; s++)
+      err = std::max(err, fabs(result.u.back()(0, s) - batch.exact_solution(T, s)));
+    cout << "* RODAS3 with step size control on the batch: "
+	 << result.t.size()-1 << " steps, max. error at T: " << err
+	 << (err < 1e-4 ? " (ok)" : " (too large)") << endl;
+
+    // the same with difference quotients for the Jacobians
+    OscillatorBatch batch_fd(k, c, false);
+    IVPSolution<BatchVector<2> > result_fd;
+    ivp = &batch_fd;
+    solve_IVP(ivp, &scheme, T, 1e-6, 1e-6, 10, 0.1, result_fd);
+    err = 0;
+    for (unsigned int s = 0; s < N; s++)
+      err = std::max(err, fabs(result_fd.u.back()(0, s) - batch.exact_solution(T, s)));
+    cout << "  with forward difference Jacobians: "
+	 << result_fd.t.size()-1 << " steps, max. error at T: " << err
+	 << (err < 1e-4 ? " (ok)" : " (too large)") << endl;
+  }
+
+  // stage equations (alpha*I-J)x=y: for alpha=0, the first pivot of the
+  // oscillators vanishes, and the Jacobians are reused for the same (t,v)
+  {
+    OscillatorBatch batch_fd(k, c, false);
+    BatchVector<2> y(N), x;
+    for (unsigned int s = 0; s < N; s++) {
+      y(0, s) = 1;
+      y(1, s) = s;
+    }
+    double residual = 0;
+    const double alphas[3] = {0.0, 1.0, 1000.0};
+    for (unsigned int a = 0; a < 3; a++) {
+      batch_fd.solve_ROW_stage_equation(0, batch_fd.u0, alphas[a], y, 0, x);
+      for (unsigned int s = 0; s < N; s++) {
+	// (alpha*I-J)x = (alpha*x0-x1, k*x0+(alpha+c)*x1)
+	residual = std::max(residual, fabs(alphas[a]*x(0, s)-x(1, s)-y(0, s)));
+	residual = std::max(residual, fabs(k[s]*x(0, s)+(alphas[a]+c[s])*x(1, s)-y(1, s))/(1+s));
+      }
+    }
+    const unsigned int jacobians_same = batch_fd.jacobians;
+    batch_fd.solve_ROW_stage_equation(0.1, batch_fd.u0, 1.0, y, 0, x);
+    cout << "* stage equations with pivoting, max. relative residual: " << residual
+	 << (residual < 1e-6 ? " (ok)" : " (too large)") << endl
+	 << "  Jacobian evaluations for three solves at the same (t,v): " << jacobians_same
+	 << ", after changing t: " << batch_fd.jacobians
+	 << (jacobians_same == 1 && batch_fd.jacobians == 2 ? " (ok)" : " (wrong)") << endl;
+  }
+
+  // extrapolated Euler scheme for all systems at once
+  {
+    const double H = 0.1;
+    BatchEuler euler(batch, H);
+    ExtrapolationTable<BatchEuler,BatchVector<2> > E(euler, 8, 1);
+    ExtrapolationTable<BatchEuler,BatchVector<2> > Epar(euler, 8, 1, true);
+
+    double err = 0, err_euler = 0, deviation = 0;
+    for (unsigned int s = 0; s < N; s++) {
+      err = std::max(err, fabs(E.table()(7,7)(0, s) - batch.exact_solution(H, s)));
+      err_euler = std::max(err_euler, fabs(E.table()(7,0)(0, s) - batch.exact_solution(H, s)));
+      deviation = std::max(deviation, fabs(E.table()(7,7)(0, s) - Epar.table()(7,7)(0, s)));
+    }
+    cout << "* extrapolated Euler scheme on the batch, max. error at H=" << H << ":" << endl
+	 << "  first column: " << err_euler << ", extrapolated: " << err
+	 << (err < 1e-6 ? " (ok)" : " (too large)") << endl
+	 << "  parallel vs. sequential first column: "
+	 << (deviation == 0 ? "identical" : "different") << endl;
+  }
+
+  return 0;
+}
@@ -5,12 +5,41 @@
 #include <geometry/point.h>
 #include <algebra/matrix.h>
 #include <algebra/vector.h>
+#include <utils/array1d.h>
 
 using std::cout;
 using std::endl;
 
 using namespace MathTL;
 
+// maximal deviation of the batch routines of a 2D chart from the pointwise ones
+double check_batch(const Chart<2>& kappa, const Array1D<Point<2> >& x)
+{
+  double dev = 0;
+  Array1D<Point<2> > y;
+  Array1D<double> values;
+  kappa.map_points(x, y);
+  for (unsigned int m = 0; m < x.size(); m++) {
+    Point<2> ym;
+    kappa.map_point(x[m], ym);
+    dev = std::max(dev, std::max(fabs(ym[0]-y[m][0]), fabs(ym[1]-y[m][1])));
+  }
+  kappa.Gram_factor_values(x, values);
+  for (unsigned int m = 0; m < x.size(); m++)
+    dev = std::max(dev, fabs(values[m]-kappa.Gram_factor(x[m])));
+  for (unsigned int i = 0; i < 2; i++) {
+    kappa.Gram_D_factor_values(i, x, values);
+    for (unsigned int m = 0; m < x.size(); m++)
+      dev = std::max(dev, fabs(values[m]-kappa.Gram_D_factor(i, x[m])));
+    for (unsigned int j = 0; j < 2; j++) {
+      kappa.Dkappa_inv_values(i, j, x, values);
+      for (unsigned int m = 0; m < x.size(); m++)
+	dev = std::max(dev, fabs(values[m]-kappa.Dkappa_inv(i, j, x[m])));
+    }
+  }
+  return dev;
+}
+
 int main()
 {
   cout << "Testing some charts:" << endl;
@@ -144,5 +173,21 @@ int main()
 
   cout << k_1 << endl;
 
+  cout << "Testing the batch versions of the chart routines..." << endl;
+  Array1D<Point<2> > points(100);
+  for (unsigned int m = 0; m < points.size(); m++)
+    points[m] = Point<2>(0.05+0.1*(m%10), 0.05+0.1*(m/10));
+  FixedArray1D<double,2> A2;
+  A2[0] = 2.0; A2[1] = 0.5;
+  SimpleAffineLinearMapping<2> kappa_3(A2, b);
+  cout << "* maximal deviation for the affine linear map: "
+       << check_batch(kappa_1, points) << endl;
+  cout << "* maximal deviation for the simple affine linear map: "
+       << check_batch(kappa_3, points) << endl;
+  cout << "* maximal deviation for the LinearBezierMapping: "
+       << check_batch(k_1, points) << endl;
+  cout << "* maximal deviation for the RingChart: "
+       << check_batch(rc, points) << endl;
+
   return 0;
 }
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <algebra/vector.h>
+#include <utils/array1d.h>
+#include <numerics/fft.h>
+
+using std::cout;
+using std::endl;
+using namespace MathTL;
+
+int main()
+{
+  cout << "Testing the FFT ..." << endl;
+
+  for (unsigned int n = 1; n <= 64; n *= 4) {
+    cout << "* n=" << n << endl;
+
+    Array1D<std::complex<double> > x(n), xhat(n);
+    for (unsigned int i = 0; i < n; i++)
+      x[i] = std::complex<double>(cos(1.0+i), sin(2.0*i*i));
+
+    // naive DFT
+    double err(0);
+    xhat = x;
+    fft(xhat);
+    for (unsigned int k = 0; k < n; k++) {
+      std::complex<double> sum(0);
+      for (unsigned int l = 0; l < n; l++)
+	sum += x[l] * std::polar(1.0, -2*M_PI*k*l/n);
+      err = std::max(err, std::abs(sum-xhat[k]));
+    }
+    cout << "- error of the forward transform: " << (err < 1e-12 ? "< 1e-12" : "too large") << endl;
+
+    // inverse transform
+    err = 0;
+    fft(xhat, true);
+    for (unsigned int i = 0; i < n; i++)
+      err = std::max(err, std::abs(x[i]-xhat[i]));
+    cout << "- error of the inverse transform: " << (err < 1e-12 ? "< 1e-12" : "too large") << endl;
+
+    // circular convolution
+    Vector<double> a(n), b(n), c;
+    for (unsigned int i = 0; i < n; i++) {
+      a[i] = 1.0/(1+i);
+      b[i] = (i%3)-1.0;
+    }
+    circular_convolution(a, b, c);
+    err = 0;
+    for (unsigned int k = 0; k < n; k++) {
+      double sum(0);
+      for (unsigned int l = 0; l < n; l++)
+	sum += a[l] * b[(k+n-l)%n];
+      err = std::max(err, fabs(sum-c[k]));
+    }
+    cout << "- error of the circular convolution: " << (err < 1e-12 ? "< 1e-12" : "too large") << endl;
+  }
+
+  return 0;
+}
@@ -8,6 +8,7 @@
 #include <utils/array1d.h>
 #include <numerics/cardinal_splines.h>
 #include <numerics/quarks.h>
+#include <numerics/corner_singularity.h>
 
 using std::cout;
 using std::endl;
@@ -34,6 +35,24 @@ public:
   }
 };
 
+// f(x) = |x-1/3|^{1/2}, nonsmooth at x=1/3
+class RootFunction : public Function<1>
+{
+public:
+  double value(const Point<1>& p,
+	       const unsigned int component = 0) const
+  {
+    return sqrt(fabs(p[0]-1./3.));
+  }
+  
+  void vector_value(const Point<1> &p,
+		    Vector<double>& values) const
+  {
+    values.resize(1, false);
+    values[0] = value(p);
+  }
+};
+
 
 
 
@@ -128,5 +147,46 @@ int main()
       }
   }
 
+  cout << "Testing GaussLegendreTable for higher orders ..." << endl;
+  for (unsigned int N(8); N <= 40; N += 4) {
+    // the N-point rule integrates x^{2N-2} exactly, \int_{-1}^1 x^{2N-2}dx/2 = 1/(2N-1)
+    const Array1D<double>& points(GaussLegendreTable::points(N));
+    const Array1D<double>& weights(GaussLegendreTable::weights(N));
+    double integral(0), sum(0);
+    for (unsigned int n(0); n < N; n++) {
+      integral += weights[n] * pow(points[n], 2.0*N-2);
+      sum += weights[n];
+    }
+    cout << "* N=" << N << ": error for x^" << 2*N-2 << ": "
+	 << (fabs(integral-1./(2*N-1)) < 1e-13 ? "< 1e-13" : "too large")
+	 << ", sum of weights - 1: " << (fabs(sum-1) < 1e-13 ? "< 1e-13" : "too large") << endl;
+  }
+  cout << "Testing DyadicGaussRule ..." << endl;
+  {
+    DyadicGaussRule rule;
+    rule.setup(3, 2, 5, 12);
+    double integral(0);
+    for (unsigned int n(0); n < rule.size(); n++)
+      integral += rule.weights()[n] * pow(rule.points()[n], 20);
+    const double exact((pow(5./8., 21) - pow(2./8., 21)) / 21);
+    cout << "* 12-point rule on [2/8,5/8], error for x^20: "
+	 << (fabs(integral-exact) < 1e-15 ? "< 1e-15" : "too large") << endl;
+  }
+
+  cout << "Testing adaptive_gauss_integral ..." << endl;
+  {
+    RootFunction f;
+    const double exact(2./3.*(pow(1./3., 1.5) + pow(2./3., 1.5)));
+    for (double tol(1e-4); tol >= 1e-10; tol /= 100)
+      cout << "* tol=" << tol << ", error for |x-1/3|^{1/2}: "
+	   << fabs(adaptive_gauss_integral(f, Point<1>(0.0), Point<1>(1.0), 3, tol, 40) - exact) << endl;
+
+    CornerSingularity s(Point<2>(0,0), 0.5, 1.5);
+    const double reference(adaptive_gauss_integral(s, Point<2>(-1,-1), Point<2>(0,0), 5, 1e-12, 30));
+    for (double tol(1e-2); tol >= 1e-8; tol /= 100)
+      cout << "* tol=" << tol << ", corner singularity on [-1,0]^2, deviation from the tol=1e-12 value: "
+	   << fabs(adaptive_gauss_integral(s, Point<2>(-1,-1), Point<2>(0,0), 5, tol, 30) - reference) << endl;
+  }
+
   return 0;
 }
@@ -123,6 +123,21 @@ int main()
        << xk << endl
        << "  with \\|A*xk-b\\|_\\infty=" << linfty_norm(err)
        << " after " << iterations << " iterations." << endl;
+
+  cout << "- multi-shift PCG iteration for (A+sigma*diag(A))x=b ..." << endl;
+  Array1D<double> shifts(3);
+  shifts[0] = 0; shifts[1] = 0.5; shifts[2] = 2;
+  Array1D<Vector<double> > xs;
+  MultiShiftPCG(A, b, P, shifts, xs, 1e-8, maxiter, iterations);
+  cout << "  ... done after " << iterations << " iterations:" << endl;
+  for (unsigned int s(0); s < shifts.size(); s++) {
+    A.apply(xs[s], err);
+    for (unsigned int i(0); i < banddim; i++)
+      err(i) += shifts[s] * A(i, i) * xs[s](i);
+    err -= b;
+    cout << "  sigma=" << shifts[s]
+	 << ", \\|(A+sigma*diag(A))*xs-b\\|_\\infty=" << linfty_norm(err) << endl;
+  }
   
   return 0;
 }
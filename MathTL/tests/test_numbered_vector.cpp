@@ -0,0 +1,53 @@
+#include <iostream>
+#include <algebra/vector.h>
+#include <algebra/numbered_vector.h>
+
+using std::cout;
+using std::endl;
+using namespace MathTL;
+
+int main()
+{
+  cout << "Testing the NumberedVector and DenseAccumulator classes ..." << endl;
+
+  NumberedVector<double> v;
+  cout << "- a zero vector:" << endl
+       << v;
+
+  v.push_back(2, 1.0);
+  v.push_back(5, -2.0);
+  v.push_back(11, 3.0);
+  cout << "- a vector with 3 entries:" << endl
+       << v;
+  cout << "- coefficients with numbers 5 and 6: "
+       << v.get_coefficient(5) << ", " << v.get_coefficient(6) << endl;
+  cout << "- squared l_2 norm: " << v.l2_norm_sqr()
+       << ", l_infinity norm: " << v.linfty_norm() << endl;
+
+  DenseAccumulator<double> ww(16);
+  cout << "- accumulating 2*v into a dense accumulator of size " << ww.size() << endl;
+  ww.add(2.0, v);
+  cout << "- adding entries 0 and 5 by write access" << endl;
+  ww[0] += 4.0;
+  ww[5] += 4.0;
+  cout << "  (touched entries: " << ww.touched() << ")" << endl;
+
+  NumberedVector<double> w;
+  ww.extract(w);
+  cout << "- extracted nontrivial entries:" << endl
+       << w;
+  cout << "  (touched entries after extraction: " << ww.touched() << ")" << endl;
+
+  ww.add(1.0, w);
+  ww.clear();
+  ww.extract(w);
+  cout << "- extraction after clear():" << endl
+       << w;
+
+  Vector<double> x(16);
+  v.add_to(x, 0.5);
+  cout << "- adding v/2 to a dense vector:" << endl
+       << x << endl;
+
+  return 0;
+}
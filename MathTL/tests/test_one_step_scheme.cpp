@@ -0,0 +1,152 @@
+#include <iostream>
+#include <cmath>
+#include <list>
+#include <algebra/vector.h>
+#include <algebra/sparse_matrix.h>
+#include <numerics/ivp.h>
+#include <numerics/iteratsolv.h>
+#include <numerics/row_method.h>
+#include <numerics/one_step_scheme.h>
+
+using std::cout;
+using std::endl;
+using namespace MathTL;
+
+/*
+  method of lines for the heat equation
+    u_t = u_xx on (0,1), u(0,t) = u(1,t) = 0,
+  with finite differences on n interior points,
+  the stage equations are solved iteratively (CG) up to the given tolerance;
+  for inexact solves, the whole tolerance is used up by an additional error
+*/
+class HeatEquation
+  : public AbstractIVP<Vector<double> >
+{
+public:
+  HeatEquation(const unsigned int n, const bool inexact = false)
+    : n_(n), h_(1.0/(n+1)), J_(n), inexact_(inexact), cg_iterations(0), stage_solves(0)
+  {
+    for (unsigned int i = 0; i < n; i++) {
+      J_.set_entry(i, i, -2/(h_*h_));
+      if (i > 0) J_.set_entry(i, i-1, 1/(h_*h_));
+      if (i < n-1) J_.set_entry(i, i+1, 1/(h_*h_));
+    }
+    u0.resize(n);
+    for (unsigned int i = 0; i < n; i++)
+      u0[i] = sin(M_PI*(i+1)*h_) + sin(16*M_PI*(i+1)*h_);
+  }
+
+  void evaluate_f(const double t, const Vector<double>& v,
+		  const double tolerance, Vector<double>& result) const
+  {
+    result.resize(n_, false);
+    J_.apply(v, result);
+  }
+
+  void evaluate_ft(const double t, const Vector<double>& v,
+		   const double tolerance, Vector<double>& result) const
+  {
+    result.resize(n_); // no t-dependence
+  }
+
+  void solve_ROW_stage_equation(const double t, const Vector<double>& v,
+				const double alpha, const Vector<double>& y,
+				const double tolerance, Vector<double>& result) const
+  {
+    SparseMatrix<double> A(J_);
+    A.scale(-1.0);
+    for (unsigned int i = 0; i < n_; i++)
+      A.set_entry(i, i, alpha + 2/(h_*h_));
+    result = y;
+    result.scale(1.0/alpha);
+    unsigned int iterations;
+    CG(A, y, result, tolerance, 10000, iterations);
+    cg_iterations += iterations;
+    stage_solves++;
+
+    // an oscillating error of l2 norm tolerance, with alternating signs
+    if (inexact_) {
+      const double c = (stage_solves % 2 ? 1 : -1) * tolerance * sqrt(2*h_);
+      for (unsigned int i = 0; i < n_; i++)
+	result[i] += c * sin(8*M_PI*(i+1)*h_);
+    }
+  }
+
+  //! exact solution of the semidiscrete problem
+  void exact_solution(const double t, Vector<double>& u) const
+  {
+    u.resize(n_);
+    const int modes[2] = {1, 16};
+    for (int m = 0; m < 2; m++) {
+      const double lambda = -4/(h_*h_) * sin(modes[m]*M_PI*h_/2) * sin(modes[m]*M_PI*h_/2);
+      for (unsigned int i = 0; i < n_; i++)
+	u[i] += exp(lambda*t) * sin(modes[m]*M_PI*(i+1)*h_);
+    }
+  }
+
+protected:
+  unsigned int n_;
+  double h_;
+  SparseMatrix<double> J_;
+  bool inexact_;
+
+public:
+  mutable unsigned int cg_iterations, stage_solves;
+};
+
+int main()
+{
+  cout << "Testing solve_IVP_balanced() ..." << endl;
+
+  const double T = 0.1;
+  ROWMethod<Vector<double> > scheme(WMethod<Vector<double> >::RODAS3);
+
+  // the last run has too inexact stage solves, so that theta has to be reduced
+  const double thetas[3] = {0.1, 1e-8, 10};
+  for (int run = 0; run < 3; run++) {
+    HeatEquation problem(127, run == 2);
+    TimeSpaceControl control(1e-5, 1e-5, 0.05, thetas[run]);
+    control.theta_min = std::min(control.theta_min, thetas[run]);
+
+    IVPSolution<Vector<double> > result;
+    std::list<TimeStepInfo> protocol;
+    AbstractIVP<Vector<double> >* ivp(&problem);
+    solve_IVP_balanced(ivp, &scheme, T, control, result, &protocol);
+
+    int accepted = 0, rejected = 0;
+    for (std::list<TimeStepInfo>::const_iterator it(protocol.begin()); it != protocol.end(); ++it)
+      if (it->accepted) accepted++; else rejected++;
+
+    Vector<double> uT;
+    problem.exact_solution(result.t.back(), uT);
+    uT -= result.u.back();
+
+    cout << "* theta=" << thetas[run] << ": t_end=" << result.t.back()
+	 << ", " << accepted << " accepted and " << rejected << " rejected steps" << endl
+	 << "  error at T: " << linfty_norm(uT)
+	 << (linfty_norm(uT) < 1e-4 ? " (ok)" : " (too large)") << endl
+	 << "  CG iterations for the stage equations: " << problem.cg_iterations << endl
+	 << "  first step: tau=" << protocol.front().tau
+	 << ", tolerance=" << protocol.front().tolerance << endl
+	 << "  last step: tau=" << protocol.back().tau
+	 << ", tolerance=" << protocol.back().tolerance << endl;
+
+    if (run == 2) {
+      // the theta of each trial step, from its tolerance and the norm of u^{(m)}
+      double theta_accepted = control.theta;
+      std::list<double>::const_iterator itt(result.t.begin());
+      std::list<Vector<double> >::const_iterator itu(result.u.begin());
+      for (std::list<TimeStepInfo>::const_iterator it(protocol.begin()); it != protocol.end(); ++it) {
+	while (*itt < it->t) { ++itt; ++itu; }
+	const double theta = it->tolerance / (control.atol + control.rtol*l2_norm(*itu));
+	if (it->accepted)
+	  theta_accepted = std::min(theta_accepted, theta);
+      }
+      cout << "  smallest theta of an accepted step: " << theta_accepted
+	   << (theta_accepted < control.theta && fabs(result.t.back()-T) < 1e-12 ? " (ok)" : " (not reduced or T not reached)")
+	   << endl;
+    }
+  }
+
+  return 0;
+}
@@ -64,5 +64,34 @@ int main()
     time = (double)(toc-tic);
     cout << "Time taken: " << (time/CLOCKS_PER_SEC) << " s\n"<<endl;
     
+    cout << "testing the batch evaluation of all B-splines by de Boor's scheme" << endl;
+    for(int h = 0; h < 400; h++)
+        points[h]=(double) h/100 - 0.005;
+    Array1D<int> intervals;
+    Array1D<double> bvalues;
+    tic = clock();
+    evaluate_Bsplines<d>(SchoenbergKnots(), 2, points, intervals, bvalues);
+    toc = clock();
+    double err = 0;
+    for(int h = 0; h < 400; h++)
+        for(int i = 0; i < d; i++){
+            const int kk = intervals[h]-d+1+i;
+            err = max(err, fabs(bvalues[(0*d+i)*400+h]-EvaluateSchoenbergBSpline<d>(kk, points[h])));
+            err = max(err, fabs(bvalues[(1*d+i)*400+h]-EvaluateSchoenbergBSpline_x<d>(kk, points[h])));
+            err = max(err, fabs(bvalues[(2*d+i)*400+h]-EvaluateSchoenbergBSpline_xx<d>(kk, points[h])));
+        }
+    cout << "maximal deviation from the pointwise evaluation (values, 1st and 2nd derivatives): " << err << endl;
+    cout << "Time taken: " << ((double)(toc-tic)/CLOCKS_PER_SEC) << " s\n"<<endl;
+
+    evaluate_Bsplines<d>(CardinalKnots(), 1, points, intervals, bvalues);
+    err = 0;
+    for(int h = 0; h < 400; h++)
+        for(int i = 0; i < d; i++){
+            const int kk = intervals[h]-d+1+i;
+            err = max(err, fabs(bvalues[(0*d+i)*400+h]-EvaluateCardinalBSpline<d>(kk, points[h])));
+            err = max(err, fabs(bvalues[(1*d+i)*400+h]-EvaluateCardinalBSpline_x<d>(kk, points[h])));
+        }
+    cout << "maximal deviation for cardinal B-splines (values and 1st derivatives): " << err << endl;
+
     return 0;
 }
\ No newline at end of file
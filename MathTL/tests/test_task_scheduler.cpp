@@ -0,0 +1,118 @@
+#include <iostream>
+#include <vector>
+#include <algebra/vector.h>
+#include <utils/task_scheduler.h>
+
+using std::cout;
+using std::endl;
+using namespace MathTL;
+
+// fills x[i] = i*i
+class Squares
+{
+public:
+  Squares(Vector<double>& x) : x_(x) {}
+  void operator () (const int i) { x_[i] = i*i; }
+protected:
+  Vector<double>& x_;
+};
+
+// sums up i for i in a range
+class Sum
+{
+public:
+  Sum() : sum(0) {}
+  Sum(Sum& s, TaskScheduler::Split) : sum(0) {}
+  void operator () (const int i) { sum += i; }
+  void join(Sum& s) { sum += s.sum; }
+  long sum;
+};
+
+// a task which itself performs a parallel reduction
+class NestedSum
+{
+public:
+  NestedSum() : n(0), result(0) {}
+  void operator () ()
+  {
+    Sum s;
+    parallel_reduce(0, n, s, 100);
+    result = s.sum;
+  }
+  int n;
+  long result;
+};
+
+// several concurrent tasks with nested parallel loops
+class Driver
+{
+public:
+  Driver(std::vector<NestedSum>& tasks) : tasks_(tasks) {}
+  void operator () ()
+  {
+    TaskGroup group;
+    for (unsigned int k = 0; k < tasks_.size(); k++)
+      group.run(tasks_[k]);
+    group.wait();
+  }
+protected:
+  std::vector<NestedSum>& tasks_;
+};
+
+// counts the calls per worker
+class Count
+{
+public:
+  Count(ThreadLocal<long>& counts) : counts_(counts) {}
+  void operator () (const int i) { counts_.local()++; }
+protected:
+  ThreadLocal<long>& counts_;
+};
+
+int main()
+{
+  cout << "Testing the TaskScheduler ..." << endl;
+
+  for (int threads = 1; threads <= 4; threads *= 2) {
+    TaskScheduler::set_num_threads(threads);
+    cout << "* requested number of threads: " << threads << endl;
+
+    Vector<double> x(10000);
+    Squares squares(x);
+    parallel_for(0, x.size(), squares, 16);
+    double err(0);
+    for (unsigned int i = 0; i < x.size(); i++)
+      err += x[i] - (double)i*i;
+    cout << "- parallel_for, error: " << err << endl;
+
+    Sum s;
+    parallel_reduce(0, 100000, s);
+    cout << "- parallel_reduce, sum_{i<100000} i = " << s.sum << endl;
+
+    std::vector<NestedSum> tasks(5);
+    for (unsigned int k = 0; k < tasks.size(); k++)
+      tasks[k].n = 1000*(k+1);
+    Driver driver(tasks);
+    TaskScheduler::run(driver);
+    cout << "- concurrent tasks with nested reductions:";
+    for (unsigned int k = 0; k < tasks.size(); k++)
+      cout << " " << tasks[k].result;
+    cout << endl;
+  }
+
+  // a ThreadLocal constructed for one worker, the pool is enlarged afterwards
+  TaskScheduler::set_num_threads(1);
+  ThreadLocal<long> counts;
+  TaskScheduler::set_num_threads(4);
+  Count count(counts);
+  parallel_for(0, 10000, count, 16);
+  long calls = counts.local();
+#ifdef _OPENMP
+#pragma omp parallel num_threads(4) reduction(+:calls)
+  if (omp_get_thread_num() > 0)
+    calls += counts.local();
+#endif
+  cout << "* ThreadLocal, pool enlarged after construction, calls: " << calls << endl;
+
+  return 0;
+}
@@ -139,6 +139,7 @@ namespace MathTL
   void Array1D<C>::swap(Array1D<C>& a)
   {
     std::swap(data_, a.data_);
+    std::swap(size_, a.size_);
   }
 
   template <class C>
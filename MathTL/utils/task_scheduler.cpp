@@ -0,0 +1,218 @@
+// implementation for task_scheduler.h
+
+#include <algorithm>
+
+namespace MathTL
+{
+  inline
+  int
+  TaskScheduler::num_threads()
+  {
+#ifdef _OPENMP
+    return num_threads_() > 0 ? num_threads_() : omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  inline
+  bool
+  TaskScheduler::in_pool()
+  {
+#ifdef _OPENMP
+    return omp_get_level() > 0;
+#else
+    return false;
+#endif
+  }
+
+  template <class TASK>
+  void
+  TaskScheduler::run(TASK& task)
+  {
+    const int n(num_threads());
+    if (n == 1 || in_pool()) {
+      task();
+      return;
+    }
+
+#ifdef _OPENMP
+    // the other workers execute the spawned tasks at the implicit barrier of 'single'
+    if (binding()) {
+#pragma omp parallel num_threads(n) proc_bind(close)
+#pragma omp single
+      task();
+    } else {
+#pragma omp parallel num_threads(n)
+#pragma omp single
+      task();
+    }
+#endif
+  }
+
+  template <class TASK>
+  void
+  TaskGroup::run(TASK& task)
+  {
+    TASK* t(&task);
+#ifdef _OPENMP
+#pragma omp task firstprivate(t)
+#endif
+    (*t)();
+  }
+
+  inline
+  void
+  TaskGroup::wait()
+  {
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+  }
+
+  /*
+    chunk length for a range of n indices, aiming at a few chunks per worker
+  */
+  inline
+  int
+  task_chunk_length(const int n, const int grain)
+  {
+    const int chunks(4*TaskScheduler::num_threads());
+    return std::max(std::max(grain, 1), (n+chunks-1)/chunks);
+  }
+
+  /*
+    root task of parallel_for(): spawn one task per chunk and wait for them
+  */
+  template <class BODY>
+  struct ParallelForTask
+  {
+    ParallelForTask(const int begin, const int end, const int chunk, BODY& body)
+      : begin_(begin), end_(end), chunk_(chunk), body_(&body) {}
+
+    void operator () ()
+    {
+      BODY* body(body_);
+#ifdef _OPENMP
+#pragma omp taskgroup
+#endif
+      {
+	for (int b(begin_); b < end_; b += chunk_) {
+	  const int e(std::min(b+chunk_, end_));
+#ifdef _OPENMP
+#pragma omp task firstprivate(b, e, body)
+#endif
+	  for (int i(b); i < e; i++)
+	    (*body)(i);
+	}
+      }
+    }
+
+    const int begin_, end_, chunk_;
+    BODY* body_;
+  };
+
+  template <class BODY>
+  void parallel_for(const int begin, const int end, BODY& body, const int grain)
+  {
+    const int chunk(task_chunk_length(end-begin, grain));
+    if (end-begin <= chunk || TaskScheduler::num_threads() == 1) {
+      for (int i(begin); i < end; i++)
+	body(i);
+      return;
+    }
+
+    ParallelForTask<BODY> root(begin, end, chunk, body);
+    TaskScheduler::run(root);
+  }
+
+  /*
+    root task of parallel_reduce(): spawn one task per chunk, each of them
+    accumulating into the body copy of the executing worker, and join the copies
+  */
+  template <class BODY>
+  struct ParallelReduceTask
+  {
+    ParallelReduceTask(const int begin, const int end, const int chunk, BODY& body)
+      : begin_(begin), end_(end), chunk_(chunk), body_(&body) {}
+
+    void operator () ()
+    {
+#ifdef _OPENMP
+      // Tied tasks do not start a sibling chunk on a worker that is suspended
+      // within a chunk, so a worker never uses its copy re-entrantly.
+      std::vector<BODY*> partial(omp_get_num_threads(), (BODY*)0);
+      BODY* body(body_);
+      BODY** slots(&partial[0]);
+#pragma omp taskgroup
+      {
+	for (int b(begin_); b < end_; b += chunk_) {
+	  const int e(std::min(b+chunk_, end_));
+#pragma omp task firstprivate(b, e, body, slots)
+	  {
+	    BODY*& local(slots[omp_get_thread_num()]);
+	    if (local == 0)
+	      local = new BODY(*body, TaskScheduler::Split());
+	    for (int i(b); i < e; i++)
+	      (*local)(i);
+	  }
+	}
+      }
+      for (unsigned int t(0); t < partial.size(); t++)
+	if (partial[t]) {
+	  body_->join(*partial[t]);
+	  delete partial[t];
+	}
+#else
+      for (int i(begin_); i < end_; i++)
+	(*body_)(i);
+#endif
+    }
+
+    const int begin_, end_, chunk_;
+    BODY* body_;
+  };
+
+  template <class BODY>
+  void parallel_reduce(const int begin, const int end, BODY& body, const int grain)
+  {
+    const int chunk(task_chunk_length(end-begin, grain));
+    if (end-begin <= chunk || TaskScheduler::num_threads() == 1) {
+      for (int i(begin); i < end; i++)
+	body(i);
+      return;
+    }
+
+    ParallelReduceTask<BODY> root(begin, end, chunk, body);
+    TaskScheduler::run(root);
+  }
+
+  template <class T>
+  ThreadLocal<T>::ThreadLocal()
+  {
+#ifdef _OPENMP
+    instances_.resize(std::max(TaskScheduler::num_threads(), omp_get_max_threads()));
+#else
+    instances_.resize(1);
+#endif
+  }
+
+  template <class T>
+  inline
+  T&
+  ThreadLocal<T>::local()
+  {
+#ifdef _OPENMP
+    const unsigned int t(omp_get_thread_num());
+    if (t < instances_.size())
+      return instances_[t];
+    // the references to the elements of a map stay valid under insertion
+    T* instance;
+#pragma omp critical (mathtl_threadlocal_overflow)
+    instance = &overflow_[t];
+    return *instance;
+#else
+    return instances_[0];
+#endif
+  }
+}
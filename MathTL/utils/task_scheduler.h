@@ -0,0 +1,181 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of MathTL - the Mathematical Template Library    |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _MATHTL_TASK_SCHEDULER_H
+#define _MATHTL_TASK_SCHEDULER_H
+
+#include <vector>
+#include <map>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace MathTL
+{
+  /*!
+    The common execution context for all parallel code paths of the library.
+
+    The worker threads form one persistent pool (the OpenMP thread team,
+    which is kept alive by the runtime between parallel regions). Work is
+    submitted as tasks, either explicitly by a TaskGroup or by the loop
+    primitives parallel_for() and parallel_reduce(). Idle workers take over
+    pending tasks of the other workers, in particular of the ones waiting
+    for their own subtasks.
+
+    A parallel primitive called from outside of the pool enters the pool and
+    blocks until its work is done. Called from inside of the pool (i.e., by a
+    task), it only spawns further tasks for the existing workers. So nested
+    parallelism composes (a parallel APPLY inside of one of several
+    concurrent solves uses the same threads), and the number of active
+    threads never exceeds num_threads().
+
+    Without OpenMP support (no -fopenmp), all primitives run sequentially in
+    the calling thread.
+  */
+  class TaskScheduler
+  {
+  public:
+    /*!
+      tag type for the splitting constructor of the bodies
+      passed to parallel_reduce()
+    */
+    struct Split {};
+
+    /*!
+      set the number of worker threads of the pool;
+      n <= 0 restores the OpenMP default (OMP_NUM_THREADS or the number of cores)
+    */
+    static void set_num_threads(const int n) { num_threads_() = n; }
+
+    //! number of worker threads of the pool
+    static int num_threads();
+
+    /*!
+      enable/disable pinning of the worker threads to consecutive cores
+      (proc_bind(close), the places can be configured via OMP_PLACES)
+    */
+    static void set_binding(const bool bind) { binding_() = bind; }
+
+    //! are the worker threads pinned?
+    static bool binding() { return binding_(); }
+
+    //! is the calling thread a worker of an active pool?
+    static bool in_pool();
+
+    /*!
+      Execute task() within the pool. If the calling thread is not a worker,
+      the pool is entered and run() returns when task() and all its subtasks
+      are done. Inside of the pool, task() is just called.
+    */
+    template <class TASK>
+    static void run(TASK& task);
+
+  protected:
+    //! storage for the thread count
+    static int& num_threads_() { static int n(0); return n; }
+
+    //! storage for the binding flag
+    static bool& binding_() { static bool b(false); return b; }
+  };
+
+  /*!
+    A group of tasks, which are executed concurrently by the pool.
+
+    The task objects are only referenced, they have to stay alive until
+    wait() has returned. Outside of the pool, run() executes the task
+    immediately, so a group of concurrent tasks should be set up from within
+    TaskScheduler::run().
+  */
+  class TaskGroup
+  {
+  public:
+    //! default constructor
+    TaskGroup() {}
+
+    //! destructor, waits for the pending tasks
+    ~TaskGroup() { wait(); }
+
+    /*!
+      spawn a task calling task()
+    */
+    template <class TASK>
+    void run(TASK& task);
+
+    /*!
+      wait for the completion of all tasks that have been spawned by the
+      calling task (including the ones of this group); in the meantime,
+      the calling worker executes pending tasks
+    */
+    void wait();
+  };
+
+  /*!
+    Call body(i) for all i in [begin,end), distributed among the workers.
+    The range is cut into chunks of at least grain indices; body(i) has to
+    be thread-safe for different i.
+  */
+  template <class BODY>
+  void parallel_for(const int begin, const int end, BODY& body, const int grain = 1);
+
+  /*!
+    Reduction over the range [begin,end). The body has to provide
+
+      BODY(BODY& b, TaskScheduler::Split)  (a new body with an empty partial result)
+      void operator () (const int i)       (accumulate the contribution of i)
+      void join(BODY& b)                   (add the partial result of b)
+
+    Each worker accumulates into its own copy of the body (created on demand
+    by the splitting constructor), the copies are joined into body afterwards.
+    So the partial results (e.g. dense accumulators) are allocated at most
+    once per worker, not per chunk.
+    If only one worker is available, body is called directly.
+  */
+  template <class BODY>
+  void parallel_reduce(const int begin, const int end, BODY& body, const int grain = 1);
+
+  /*!
+    One instance of T per worker of the pool, e.g. a workspace of a const
+    method which may be called concurrently. local() returns the instance of
+    the calling worker (or of the calling thread outside of the pool).
+    The instances are created by the constructor, according to the number of
+    threads the pool may use at that time. Workers beyond that number (e.g.,
+    if the pool has been enlarged by set_num_threads() afterwards) get their
+    instance on their first call of local(), which is then serialized.
+    The code using local() must not suspend (e.g., wait for subtasks) while it
+    holds the reference, otherwise the worker might reenter it.
+    The instances are keyed by omp_get_thread_num() only, so a ThreadLocal may
+    only be used from one team of workers at a time, e.g. within the body of
+    parallel_for() or parallel_reduce(). Threads which are not OpenMP workers
+    (e.g., of a Qt thread pool) all get the instance of thread 0, as do the
+    workers of different nested or concurrent teams with the same number.
+    Objects which may be used by such threads should keep their buffers on
+    the stack instead.
+  */
+  template <class T>
+  class ThreadLocal
+  {
+  public:
+    //! constructor, default constructs the instances
+    ThreadLocal();
+
+    //! the instance of the calling worker
+    T& local();
+
+  protected:
+    std::vector<T> instances_;
+
+    //! the instances of the workers beyond instances_.size(), created on demand
+    std::map<unsigned int, T> overflow_;
+  };
+}
+
+#include <utils/task_scheduler.cpp>
+
+#endif
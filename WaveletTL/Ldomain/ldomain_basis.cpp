@@ -11,11 +11,9 @@ namespace WaveletTL
 {
   template <class IBASIS>
   LDomainBasis<IBASIS>::LDomainBasis()
-    : basis1d_(false, false)
+    : jmax_(-1), basis1d_(false, false)
   {
 #if _WAVELETTL_LDOMAINBASIS_VERBOSITY >= 1
-    supp_hits = 0;
-    supp_misses = 0;
     Mj1_hits = 0;
     Mj1_misses = 0;
 #endif
@@ -23,11 +21,9 @@ namespace WaveletTL
 
   template <class IBASIS>
   LDomainBasis<IBASIS>::LDomainBasis(const IntervalBasis& basis1d)
-    : basis1d_(basis1d)
+    : jmax_(-1), basis1d_(basis1d)
   {
 #if _WAVELETTL_LDOMAINBASIS_VERBOSITY >= 1
-    supp_hits = 0;
-    supp_misses = 0;
     Mj1_hits = 0;
     Mj1_misses = 0;
 #endif
@@ -152,15 +148,19 @@ namespace WaveletTL
   void
   LDomainBasis<IBASIS>::support(const Index& lambda, Support& supp) const
   {
-    // check whether the supp(psi_lambda) already exists in the cache
-    typename SupportCache::iterator supp_lb(supp_cache.lower_bound(lambda));
-    typename SupportCache::iterator supp_it(supp_lb);
-    if (supp_lb == supp_cache.end() ||
-	supp_cache.key_comp()(lambda, supp_lb->first))
-      {
-	// compute supp(psi_lambda) and insert it into the cache
-	typedef typename SupportCache::value_type value_type;
+    // the supports of all wavelets up to jmax are precomputed by set_jmax(),
+    // the table is only read here, so concurrent calls are safe
+    if (lambda.j() <= jmax_ && all_supports_.size() > 0
+	&& (lambda.j() == j0() || lambda.e()[0]+lambda.e()[1] > 0))
+      supp = all_supports_[lambda.number()];
+    else
+      compute_support(lambda, supp);
+  }
 
+  template <class IBASIS>
+  void
+  LDomainBasis<IBASIS>::compute_support(const Index& lambda, Support& supp) const
+  {
 	const int ecode = lambda.e()[0]+2*lambda.e()[1];
 	const int lambdaj = lambda.j();
 	
@@ -346,50 +346,6 @@ namespace WaveletTL
 	      }
 	    }
 	}
-	
-	supp_it = supp_cache.insert(supp_lb, value_type(lambda, supp));
-
-#if _WAVELETTL_LDOMAINBASIS_VERBOSITY >= 1
-	supp_misses++;
-	if ((supp_hits+supp_misses)%1000000 == 0)
-	  {
-	    cout << "[LdomainBasis support cache (hits/misses/total/hit ratio): ("
-		 << supp_hits << "/"
-		 << supp_misses << "/"
-		 << supp_hits+supp_misses << "/"
-		 << (double) supp_hits/(supp_hits+supp_misses)
-		 << ")"
-		 << "]"
-		 << endl;
-	  }
-#endif
-      }
-    else
-      {
-	// cache hit, copy the precomputed support
-  	supp.j = supp_it->second.j;
-  	for (unsigned int i = 0; i < 3; i++) {
-  	  supp.xmin[i] = supp_it->second.xmin[i];
-  	  supp.xmax[i] = supp_it->second.xmax[i];
-  	  supp.ymin[i] = supp_it->second.ymin[i];
-  	  supp.ymax[i] = supp_it->second.ymax[i];
-  	}
-	
-#if _WAVELETTL_LDOMAINBASIS_VERBOSITY >= 1
-	supp_hits++;
-	if ((supp_hits+supp_misses)%1000000 == 0)
-	  {
-	    cout << "[LdomainBasis support cache (hits/misses/total/hit ratio): ("
-		 << supp_hits << "/"
-		 << supp_misses << "/"
-		 << supp_hits+supp_misses << "/"
-		 << (double) supp_hits/(supp_hits+supp_misses)
-		 << ")"
-		 << "]"
-		 << endl;
-	  }
-#endif
-      }  
   }
   
   template <class IBASIS>
@@ -1079,6 +1035,10 @@ namespace WaveletTL
     }
     cout << "done setting up collection of wavelet indices..." << endl;
 
+    // precompute the supports, numbered like full_collection
+    all_supports_.resize(degrees_of_freedom);
+    for (k = 0; k < degrees_of_freedom; k++)
+      compute_support(full_collection[k], all_supports_[k]);
   }
 
 //   template <int d, int dT>
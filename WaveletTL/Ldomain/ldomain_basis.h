@@ -17,6 +17,7 @@
 #include <algebra/sparse_matrix.h>
 #include <algebra/block_matrix.h>
 #include <geometry/sampled_mapping.h>
+#include <generic/tensor_sampler.h>
 #include <utils/fixed_array1d.h>
 #include <utils/multiindex.h>
 
@@ -73,7 +74,10 @@ namespace WaveletTL
       int ymax[3];
     } Support;
 
-    //! compute the support of psi_lambda, using the internal cache
+    /*!
+      compute the support of psi_lambda; up to jmax, it is read from the
+      table set up by set_jmax(), so that concurrent calls are safe
+    */
     void support(const Index& lambda, Support& supp) const;
     
     //! critical Sobolev regularity for the primal generators/wavelets
@@ -154,7 +158,10 @@ namespace WaveletTL
     
     /*!
       Evaluate an arbitrary linear combination of primal/dual wavelets
-      on a dyadic subgrid of the L-shaped domain
+      on a dyadic subgrid of the L-shaped domain.
+      The coefficients are first reconstructed (level by level) to generators
+      on the finest level, whose patchwise tensor product factors are then
+      sampled only once and summed up locally (see TensorSampler).
     */
     Array1D<SampledMapping<2> >
     evaluate
@@ -174,6 +181,11 @@ namespace WaveletTL
     //! number of wavelets between coarsest and finest level
     const int degrees_of_freedom() const { return full_collection.size(); };
 
+    //! get the support of the wavelet with a specified number
+    const inline Support& get_support (const int number) const {
+      return all_supports_[number];
+    }
+
 
   protected:
 
@@ -189,6 +201,10 @@ namespace WaveletTL
     //! the interval 1d wavelet basis
     IntervalBasis basis1d_;
 
+    //! sampled 1D generator phi_{j,k} on a dyadic subgrid of [0,1], using the given cache
+    const SampledFactor& sampled_generator(const int j, const int k, const int resolution,
+					   SampledFactorCache& cache) const;
+
     //! caches for the diverse refinement matrices
     typedef std::map<int,BlockMatrix<double> > MatrixCache;
     mutable MatrixCache Mj0_cache, Mj0T_cache,
@@ -201,12 +217,11 @@ namespace WaveletTL
     mutable Mj1Cache Mj1_cache;
     mutable unsigned long Mj1_hits, Mj1_misses;
 
-    //! support cache
-    typedef std::map<Index,Support> SupportCache;
-    mutable SupportCache supp_cache;
-#if _WAVELETTL_LDOMAINBASIS_VERBOSITY >= 1
-    mutable unsigned long supp_hits, supp_misses;
-#endif
+    //! supports of all wavelets in full_collection
+    Array1D<Support> all_supports_;
+
+    //! compute the support of psi_lambda from the 1D supports
+    void compute_support(const Index& lambda, Support& supp) const;
   };
 
 //   //! template specialization for the case IBASIS==SplineBasis<d,dT,DS_construction>
@@ -320,34 +320,119 @@ namespace WaveletTL
 //     return r;
 //   }
 
+  template <class IBASIS>
+  const SampledFactor&
+  LDomainBasis<IBASIS>::sampled_generator(const int j, const int k, const int resolution,
+					  SampledFactorCache& cache) const
+  {
+    const std::pair<int,std::pair<int,int> > key(j, std::make_pair(0, k));
+    typename SampledFactorCache::iterator it(cache.lower_bound(key));
+    if (it == cache.end() || cache.key_comp()(key, it->first)) {
+      it = cache.insert(it, std::make_pair(key, SampledFactor()));
+      set_sampled_factor(basis1d().evaluate(typename IBASIS::Index(j, 0, k, &basis1d()),
+					    resolution).values(),
+			 it->second);
+    }
+    return it->second;
+  }
+
   template <class IBASIS>
   Array1D<SampledMapping<2> >
   LDomainBasis<IBASIS>::evaluate
   (const InfiniteVector<double, typename LDomainBasis<IBASIS>::Index>& coeffs,
    const int resolution) const
   {
-    // first prepare a plot of the zero function
-    FixedArray1D<Array1D<double>,2> values;
-    values[0].resize((1<<resolution)+1);
-    values[1].resize((1<<resolution)+1);
-    for (int i = 0; i <= 1<<resolution; i++) {
-      values[0][i] = values[1][i] = 0;
-    }
-    Array1D<SampledMapping<2> > result(3);
-    result[0] = SampledMapping<2>(Point<2>(-1, 0), Point<2>(0,1), values);
-    result[1] = SampledMapping<2>(Point<2>(-1,-1), Point<2>(0,0), values);
-    result[2] = SampledMapping<2>(Point<2>( 0,-1), Point<2>(1,0), values);
-          
-    // add all plots of the single functions
     typedef typename LDomainBasis<IBASIS>::Index Index;
+    typename Index::type_type zero;
+
+    // reconstruct the expansion to generators on the finest level J with the
+    // pyramid scheme, using the same splitting of Mj1 as reconstruct_1():
+    //   c_{j+1} = Mj0*(c_j - Mj0T^T*Mj1c*d_j) + Mj1c*d_j
+    int J = j0();
     for (typename InfiniteVector<double,Index>::const_iterator it(coeffs.begin()),
- 	   itend(coeffs.end()); it != itend; ++it) {
-      Array1D<SampledMapping<2> > temp(evaluate(it.index(), resolution));
-      result[0].add(*it, temp[0]);
-      result[1].add(*it, temp[1]);
-      result[2].add(*it, temp[2]);
+	   itend(coeffs.end()); it != itend; ++it)
+      J = std::max(J, it.index().e() == zero ? it.index().j() : it.index().j()+1);
+
+    const typename Index::type_type e01(0, 1), e10(1, 0), e11(1, 1);
+    Vector<double> gcoeffs(Deltasize(j0()));
+    for (int j = j0(); j <= J; j++) {
+      Vector<double> d01(j < J ? Nabla01size(j) : 0),
+	d10(j < J ? Nabla10size(j) : 0),
+	d11(j < J ? Nabla11size(j) : 0);
+      const int first_gen(first_generator(j).number());
+      const int first01(first_wavelet(j, e01).number()),
+	first10(first_wavelet(j, e10).number()),
+	first11(first_wavelet(j, e11).number());
+      for (typename InfiniteVector<double,Index>::const_iterator it(coeffs.begin()),
+	     itend(coeffs.end()); it != itend; ++it) {
+	const Index& lambda = it.index();
+	if (lambda.j() != j) continue;
+	if (lambda.e() == zero)
+	  gcoeffs[lambda.number()-first_gen] += *it;
+	else if (lambda.e() == e01)
+	  d01[lambda.number()-first01] = *it;
+	else if (lambda.e() == e10)
+	  d10[lambda.number()-first10] = *it;
+	else
+	  d11[lambda.number()-first11] = *it;
+      }
+      if (j == J) break;
+
+      Vector<double> finer(Deltasize(j+1)), help(Deltasize(j+1)), coarse(Deltasize(j));
+      get_Mj1c_01(j).apply(d01, finer);
+      get_Mj1c_10(j).apply(d10, help);
+      finer += help;
+      get_Mj1c_11(j).apply(d11, help);
+      finer += help;
+      get_Mj0T(j).apply_transposed(finer, coarse);
+      gcoeffs -= coarse;
+      get_Mj0(j).apply(gcoeffs, help);
+      finer += help;
+      gcoeffs.swap(finer);
     }
-    
+
+    // per patch, each generator is a (weighted) tensor product of 1D generators,
+    // see evaluate(lambda, resolution)
+    std::vector<TensorSampler<2> > samplers(3, TensorSampler<2>(resolution));
+    SampledFactorCache cache;
+    FixedArray1D<const SampledFactor*,2> factors;
+    const int kL = basis1d().DeltaLmin(), kR = basis1d().DeltaRmax(J);
+    unsigned int id = 0;
+    for (Index lambda(first_generator(J)); id < gcoeffs.size(); id++, ++lambda) {
+      const double coeff = gcoeffs[id];
+      if (coeff == 0) continue;
+      switch (lambda.p()) {
+      case 0:
+      case 1:
+      case 2:
+	factors[0] = &sampled_generator(J, lambda.k()[0], resolution, cache);
+	factors[1] = &sampled_generator(J, lambda.k()[1], resolution, cache);
+	samplers[lambda.p()].add(coeff, factors);
+	break;
+      case 3:
+	// patches 0 and 1
+	factors[0] = &sampled_generator(J, lambda.k()[0], resolution, cache);
+	factors[1] = &sampled_generator(J, kL, resolution, cache);
+	samplers[0].add(coeff * M_SQRT1_2, factors);
+	factors[1] = &sampled_generator(J, kR, resolution, cache);
+	samplers[1].add(coeff * M_SQRT1_2, factors);
+	break;
+      case 4:
+	// patches 1 and 2
+	factors[1] = &sampled_generator(J, lambda.k()[1], resolution, cache);
+	factors[0] = &sampled_generator(J, kR, resolution, cache);
+	samplers[1].add(coeff * M_SQRT1_2, factors);
+	factors[0] = &sampled_generator(J, kL, resolution, cache);
+	samplers[2].add(coeff * M_SQRT1_2, factors);
+	break;
+      }
+    }
+
+    Array1D<SampledMapping<2> > result(3);
+    result[0] = samplers[0].sampled_mapping(Point<2>(-1, 0), Point<2>(0,1));
+    result[1] = samplers[1].sampled_mapping(Point<2>(-1,-1), Point<2>(0,0));
+    result[2] = samplers[2].sampled_mapping(Point<2>( 0,-1), Point<2>(1,0));
+
     return result;
   }
 
@@ -0,0 +1,73 @@
+// implementation for dyadic_values_cache.h
+
+namespace WaveletTL
+{
+  template <class KEY, class VALUES>
+  std::map<KEY, typename DyadicValuesCache<KEY,VALUES>::Levels>&
+  DyadicValuesCache<KEY,VALUES>::cache()
+  {
+    static std::map<KEY,Levels> values;
+    return values;
+  }
+
+  template <class KEY, class VALUES>
+  bool
+  DyadicValuesCache<KEY,VALUES>::lookup(const KEY& key, const int resolution,
+					int& cached_resolution, VALUES& values)
+  {
+    bool found(false);
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_DyadicValuesCache)
+#endif
+    {
+      typename std::map<KEY,Levels>::const_iterator it(cache().find(key));
+      if (it != cache().end()) {
+	// finest cached resolution <= resolution
+	typename Levels::const_iterator levelit(it->second.upper_bound(resolution));
+	if (levelit != it->second.begin()) {
+	  --levelit;
+	  cached_resolution = levelit->first;
+	  values = levelit->second;
+	  found = true;
+	}
+      }
+    }
+    return found;
+  }
+
+  template <class KEY, class VALUES>
+  void
+  DyadicValuesCache<KEY,VALUES>::insert(const KEY& key, const int resolution, const VALUES& values)
+  {
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_DyadicValuesCache)
+#endif
+    {
+      // another thread may have computed the same values in the meantime,
+      // they are identical then, so we keep the first ones
+      cache()[key].insert(std::make_pair(resolution, values));
+    }
+  }
+
+  template <class KEY, class VALUES>
+  unsigned int
+  DyadicValuesCache<KEY,VALUES>::size()
+  {
+    unsigned int r(0);
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_DyadicValuesCache)
+#endif
+    r = cache().size();
+    return r;
+  }
+
+  template <class KEY, class VALUES>
+  void
+  DyadicValuesCache<KEY,VALUES>::clear()
+  {
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_DyadicValuesCache)
+#endif
+    cache().clear();
+  }
+}
@@ -0,0 +1,71 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_DYADIC_VALUES_CACHE_H
+#define _WAVELETTL_DYADIC_VALUES_CACHE_H
+
+#include <map>
+#include <utility>
+
+namespace WaveletTL
+{
+  /*!
+    Process-wide cache of the point values of refinable functions
+    (and their derivatives) on dyadic grids 2^{-resolution}\mathbb Z^d.
+
+    The values are stored per key (typically the mask coefficients and the
+    derivative order) and per resolution. Since the values on a finer grid are
+    obtained from the coarser ones by the cascade algorithm, a lookup also
+    reports the finest cached resolution below the requested one, so that
+    clients only have to run the remaining refinement steps.
+
+    The cache stores copies of the values; they live until clear() is called
+    or the process terminates.
+
+    All methods are safe to be called concurrently from OpenMP threads.
+  */
+  template <class KEY, class VALUES>
+  class DyadicValuesCache
+  {
+  public:
+    /*!
+      Look up the values for the given key on the finest cached grid
+      2^{-cached_resolution}\mathbb Z^d with cached_resolution <= resolution.
+      Returns false (and leaves the arguments untouched) if there is none.
+    */
+    static bool lookup(const KEY& key, const int resolution,
+		       int& cached_resolution, VALUES& values);
+
+    /*!
+      store the values for the given key on the grid 2^{-resolution}\mathbb Z^d
+    */
+    static void insert(const KEY& key, const int resolution, const VALUES& values);
+
+    /*!
+      number of cached keys
+    */
+    static unsigned int size();
+
+    /*!
+      remove all cached values
+    */
+    static void clear();
+
+  protected:
+    //! values of one function, per resolution
+    typedef std::map<int,VALUES> Levels;
+
+    //! the storage, a function-local static to avoid static initialization order problems
+    static std::map<KEY,Levels>& cache();
+  };
+}
+
+#include <Rd/dyadic_values_cache.cpp>
+
+#endif
@@ -26,14 +26,19 @@ namespace WaveletTL
     
     InfiniteVector<double, int> r;
     
-    // First we calculate the values on Z
-
     // abbreviate begin and end of the support of phi
     int suppleft  = begin();
     int suppright = end();
     
-    // exclude the special case of \chi_{[0,1)}
-    if (suppleft == suppright-1) {
+    // look for the values on the finest cached grid
+    const ValuesCacheKey key(std::make_pair(BEGIN, mu),
+			     std::vector<double>(coeffs_.begin(), coeffs_.end()));
+    int cached_resolution(-1);
+    if (ValuesCache::lookup(key, resolution, cached_resolution, r)) {
+      // the values on 2^{-cached_resolution}\mathbb Z are already known
+    } else if (suppleft == suppright-1) {
+      // First we calculate the values on Z,
+      // excluding the special case of \chi_{[0,1)}
       r.set_coefficient(0, 1);
     } else {
       // In the following, we set up the eigenvalue problem for the values
@@ -77,10 +82,14 @@ namespace WaveletTL
       for (int n = 0; n < suppright-suppleft-1; n++)
  	r.set_coefficient(suppleft+1+n, x[n]);
     }
+    if (cached_resolution < 0) {
+      cached_resolution = 0;
+      ValuesCache::insert(key, 0, r);
+    }
 
     // For the remaining non-integer points we use the refinement relation of phi
-    if (resolution > 0) {
-      for (int newres(1); newres <= resolution; newres++) {
+    if (resolution > cached_resolution) {
+      for (int newres(cached_resolution+1); newres <= resolution; newres++) {
 	// copy the coarse values \phi(2^{-j}m) = \phi(2^{-(j+1)}2m), newres=j+1
 	InfiniteVector<double, int> coarse;
 	coarse.swap(r);
@@ -98,6 +107,8 @@ namespace WaveletTL
 	  for (int k = begin(); k <= end(); k++)
 	    r[m] += a(k) * coarse.get_coefficient(m - (1<<(newres-1))*k);
 	}
+
+	ValuesCache::insert(key, newres, r);
       }   
     }
     
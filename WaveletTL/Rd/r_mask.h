@@ -11,9 +11,12 @@
 #define _WAVELETTL_R_MASK_H
 
 #include <iostream>
+#include <utility>
+#include <vector>
 #include <utils/fixed_array1d.h>
 #include <algebra/infinite_vector.h>
 #include <geometry/sampled_mapping.h>
+#include <Rd/dyadic_values_cache.h>
 
 using MathTL::FixedArray1D;
 using MathTL::InfiniteVector;
@@ -70,6 +73,10 @@ namespace WaveletTL
       Evaluate the mu-th derivative of the refinable function \phi
       on the dyadic grid 2^{-resolution}\mathbb Z.
       We assume that the derivative of \phi is zero at the boundary of its support (!).
+
+      The values are kept in a process-wide cache, shared by all masks with the
+      same offset and coefficients. Finer grids are computed from the finest
+      cached one by the remaining cascade steps.
     */
     InfiniteVector<double, int>
     evaluate(const int mu, const int resolution) const;
@@ -97,9 +104,20 @@ namespace WaveletTL
     */
     const double moment(const unsigned int k) const;
 
+    /*!
+      remove all cached point values (of all 1D masks)
+    */
+    static void clear_values_cache() { ValuesCache::clear(); }
+
   protected:
     //! refinement coefficients
     FixedArray1D<double,L> coeffs_;
+
+    //! cache key: offset and derivative order, refinement coefficients
+    typedef std::pair<std::pair<int,int>, std::vector<double> > ValuesCacheKey;
+
+    //! cache of the point values on dyadic grids
+    typedef DyadicValuesCache<ValuesCacheKey, InfiniteVector<double, int> > ValuesCache;
   };
   
 }
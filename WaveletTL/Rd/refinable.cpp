@@ -35,11 +35,11 @@ namespace WaveletTL
 
     InfiniteVector<double, MultiIndex<int, DIMENSION> > r;
     
-    // First we calculate the values on \mathbb Z^d
-
-    // compute a support cube
+    // compute a support cube and collect the mask coefficients for the cache lookup
     int suppleft(MultivariateLaurentPolynomial<double, DIMENSION>::begin().index()[0]);
     int suppright(suppleft);
+    ValuesCacheKey key;
+    key.first = mu;
     
     for (typename MASK::const_iterator it(MultivariateLaurentPolynomial<double, DIMENSION>::begin());
 	 it != MultivariateLaurentPolynomial<double, DIMENSION>::end(); ++it) {
@@ -47,10 +47,16 @@ namespace WaveletTL
 	suppleft = std::min(suppleft, it.index()[i]);
 	suppright = std::max(suppright, it.index()[i]);
       }
+      key.second.push_back(std::make_pair(it.index(), *it));
     }
     
-    // exclude the special case of \chi_{[0,1)^d}
-    if (suppleft == suppright-1) {
+    // look for the values on the finest cached grid
+    int cached_resolution(-1);
+    if (ValuesCache::lookup(key, resolution, cached_resolution, r)) {
+      // the values on 2^{-cached_resolution}\mathbb Z^d are already known
+    } else if (suppleft == suppright-1) {
+      // First we calculate the values on \mathbb Z^d,
+      // excluding the special case of \chi_{[0,1)^d}
       r.set_coefficient(MultiIndex<int, DIMENSION>(), 1);
     } else {
       // for convenience, collect all integer points from the interior of the support cube
@@ -126,10 +132,14 @@ namespace WaveletTL
 	r.set_coefficient(*colit, x[n]);
 	
     }   
+    if (cached_resolution < 0) {
+      cached_resolution = 0;
+      ValuesCache::insert(key, 0, r);
+    }
 
     // For the remaining points we use the refinement relation of phi
-    if (resolution > 0) {
-      for (int newres(1); newres <= resolution; newres++) {
+    if (resolution > cached_resolution) {
+      for (int newres(cached_resolution+1); newres <= resolution; newres++) {
 	// copy the coarse values \phi(2^{-j}m) = \phi(2^{-(j+1)}2m)
 	InfiniteVector<double, MultiIndex<int, DIMENSION> > coarse(r);
 	r.clear();
@@ -165,6 +175,8 @@ namespace WaveletTL
 	      r[m] += *maskit * coarse.get_coefficient(l);
 	    }
 	  }
+
+	ValuesCache::insert(key, newres, r);
       }
     }
 
@@ -11,11 +11,14 @@
 #define _WAVELETTL_REFINABLE_H
 
 #include <iostream>
+#include <utility>
+#include <vector>
 #include <utils/multiindex.h>
 #include <algebra/infinite_vector.h>
 #include <geometry/point.h>
 #include <geometry/sampled_mapping.h>
 #include <Rd/r_mask.h>
+#include <Rd/dyadic_values_cache.h>
 
 using namespace MathTL;
 
@@ -57,6 +60,10 @@ namespace WaveletTL
       Evaluate the mu-th (partial) derivative of the refinable function \phi
       on the grid 2^{-resolution}\mathbb Z^d.
       We assume that the derivative of \phi is zero at the boundary of its support (!)
+
+      The values are kept in a process-wide cache, shared by all refinable functions
+      with the same mask. Finer grids are computed from the finest cached one
+      by the remaining cascade steps.
     */
     InfiniteVector<double, MultiIndex<int, DIMENSION> >
     evaluate(const MultiIndex<int, DIMENSION>& mu,
@@ -90,6 +97,20 @@ namespace WaveletTL
              Some Remarks on Quadrature Formulae for Refinable Functions and Wavelets
     */
     double moment(const MultiIndex<int, DIMENSION>& alpha) const;
+
+    /*!
+      remove all cached point values (of all masks in dimension DIMENSION)
+    */
+    static void clear_values_cache() { ValuesCache::clear(); }
+
+  protected:
+    //! cache key: derivative, nontrivial mask coefficients
+    typedef std::pair<MultiIndex<int, DIMENSION>,
+		      std::vector<std::pair<MultiIndex<int, DIMENSION>, double> > > ValuesCacheKey;
+
+    //! cache of the point values on dyadic grids
+    typedef DyadicValuesCache<ValuesCacheKey,
+			      InfiniteVector<double, MultiIndex<int, DIMENSION> > > ValuesCache;
   };
 }
 
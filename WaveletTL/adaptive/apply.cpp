@@ -1,12 +1,16 @@
 // implementation for APPLY
 
 #include <utils/array1d.h>
+#include <utils/task_scheduler.h>
 #include <list>
 #include <map>
+#include <vector>
 
 
 
 using MathTL::Array1D;
+using MathTL::TaskScheduler;
+using MathTL::parallel_reduce;
 
 namespace WaveletTL
 {
@@ -116,7 +120,8 @@ namespace WaveletTL
       InfiniteVector<double, typename PROBLEM::Index> w_old;
       InfiniteVector<double, typename PROBLEM::Index> w_new;
 
-      Vector<double> ww(P.basis().degrees_of_freedom());
+      DenseAccumulator<double> ww(P.basis().degrees_of_freedom());
+      NumberedVector<double> wn;
       
 
       J = ell;
@@ -134,18 +139,14 @@ namespace WaveletTL
 	}
       }
       
-      for (unsigned int i = 0; i < ww.size(); i++) {
-	if (ww[i] != 0.) {
-	  w_old.set_coefficient(*(P.basis().get_wavelet(i)), ww[i]);
-	}
-      }
+      ww.extract(wn);
+      for (NumberedVector<double>::size_type n = 0; n < wn.size(); n++)
+	w_old.push_back(*(P.basis().get_wavelet(wn.number(n))), wn.value(n));
       
 
       cout << "size = " << w_old.size() << endl;
-      ww.resize(ww.size());
       while ( tol >  eta ) {
 	w_new.clear();
-	ww.resize(ww.size());
 	J++;
 	cout << "J = " << J << endl;
 	k = 0;
@@ -159,11 +160,9 @@ namespace WaveletTL
 	  }
 	}
 	
-	for (unsigned int i = 0; i < ww.size(); i++) {
-	  if (ww[i] != 0.) {
-	    w_new.set_coefficient(*(P.basis().get_wavelet(i)), ww[i]);
-	  }
-	}
+	ww.extract(wn);
+	for (NumberedVector<double>::size_type n = 0; n < wn.size(); n++)
+	  w_new.push_back(*(P.basis().get_wavelet(wn.number(n))), wn.value(n));
 
 	cout << "size = " << w_new.size() << endl;
 	
@@ -354,6 +353,88 @@ namespace WaveletTL
   }  
 
 
+  /*
+    Binary binning of the entries of v and setup of the segments
+    v_{[0]},...,v_{[\ell]}, cf. [S],[B]. The entries are given as (key,value) pairs,
+    KEY being either the index type or the number of the index.
+    Returns the maximal compression level J.
+  */
+  template <class PROBLEM, class KEY>
+  unsigned int APPLY_binning(const PROBLEM& P,
+			     const std::vector<std::pair<KEY, double> >& v,
+			     const double eta,
+			     std::list<std::list<std::pair<KEY, double> > >& vks)
+  {
+    // compute the number of bins V_0,...,V_q
+    double norm_v_sqr = 0;
+    for (typename std::vector<std::pair<KEY, double> >::const_iterator it(v.begin());
+	 it != v.end(); ++it)
+      norm_v_sqr += it->second * it->second;
+    const double norm_v = sqrt(norm_v_sqr);
+    const double norm_A = P.norm_A();
+
+    const unsigned int q = (unsigned int) std::max(ceil(log(sqrt((double)v.size())*norm_v*norm_A*2/eta)/M_LN2), 0.);
+    // Setup the bins: The i-th bin contains the entries of v with modulus in the interval
+    // (2^{-(i+1)}||v||,2^{-i}||v||], 0 <= i <= q-1, the remaining elements (with even smaller modulus)
+    // are collected in the q-th bin.
+    Array1D<std::list<std::pair<KEY, double> > > bins(q+1);
+    for (typename std::vector<std::pair<KEY, double> >::const_iterator it(v.begin());
+	 it != v.end(); ++it) {
+      const unsigned int i = std::min(q, (unsigned int)floor(-log(fabs(it->second)/norm_v)/M_LN2));
+      bins[i].push_back(*it);
+    }
+
+    // glue all the bins together
+    Array1D<std::pair<KEY, double> > v_binned(v.size());
+    for (unsigned int bin = 0, id = 0; bin <= q; bin++)
+      for (typename std::list<std::pair<KEY, double> >::const_iterator it(bins[bin].begin());
+	   it != bins[bin].end(); ++it, ++id)
+	v_binned[id] = *it;
+
+    const double theta = 0.5;
+    // setup the segments v_{[0]},...,v_{[\ell]},
+    // \ell being the smallest number such that
+    //   ||A||*||v-\sum_{k=0}^\ell v_{[k]}|| <= theta * eta
+    // i.e.
+    //   ||v-\sum_{k=0}^\ell v_{[k]}||^2 <= eta^2 * theta^2 / ||A||^2
+    // see [S, (3.9)]
+    const double threshold = eta*eta*theta*theta/(norm_A*norm_A);
+    unsigned int id = 0, k = 0;
+    double error_sqr = norm_v_sqr;
+    vks.clear();
+    std::list<double> vks_norm;
+    while (true) {
+      // setup the k-th segment v_{[k]}
+      std::list<std::pair<KEY, double> > vk;
+      double vk_norm_sqr = 0;
+      for (unsigned int n = 1; error_sqr > threshold && id < v.size() && n <= ldexp(1.0, k)-floor(ldexp(1.0, k-1)); n++, id++) {
+	vk.push_back(v_binned[id]);
+	const double help = v_binned[id].second * v_binned[id].second;
+	error_sqr -= help;
+	vk_norm_sqr += help;
+      }
+      vks.push_back(vk);
+      vks_norm.push_back(sqrt(vk_norm_sqr));
+      if (error_sqr <= threshold || id >= v.size()) break; // in this case, ell=k
+      k++;
+    }
+    const unsigned int ell = k;
+    // compute the smallest J >= ell, such that
+    //   \sum_{k=0}^{\ell} alpha_{J-k}*2^{-s(J-k)}*||v_{[k]}|| <= (1-theta) * eta
+    unsigned int J = ell;
+    const double s = P.s_star();
+    while (true) {
+      double check = 0.0;
+      unsigned int k = 0;
+      for (std::list<double>::const_iterator it(vks_norm.begin()); k <= ell; ++it, ++k)
+	check += P.alphak(J-k) * pow(ldexp(1.0,J-k),-s) * (*it);
+      if (check <= (1-theta)*eta) break;
+      J++;
+    }
+
+    return J;
+  }
+
   template <class PROBLEM>
   void APPLY(const PROBLEM& P,
 	     const InfiniteVector<double, typename PROBLEM::Index>& v,
@@ -362,132 +443,219 @@ namespace WaveletTL
 	     const int jmax,
 	     const CompressionStrategy strategy)
   {
-      //cout << "AUSGEFÜHRT!: " << P.basis().degrees_of_freedom() << endl; @PHK
     typedef typename PROBLEM::Index Index;
-    
-    //cout << "bin drin" << endl;
 
     w.clear();
     // Binary Binning variant of APPLY from [S],[B]
     // Remark: it is possible to perform binary binning without actually assembling
     // the bins, however, in this first version we do setup the bins to avoid
     // unnecessary difficulties
-    //cout << "entering apply..." << endl;
-
-    //cout << "size = " << v.size() << endl;
     if (v.size() > 0) {
-//        cout << "v größer 0" << endl;
-      
-      // compute the number of bins V_0,...,V_q
-      const double norm_v_sqr = l2_norm_sqr(v);
-      const double norm_v = sqrt(norm_v_sqr);
-      const double norm_A = P.norm_A();
-      
-      const unsigned int q = (unsigned int) std::max(ceil(log(sqrt((double)v.size())*norm_v*norm_A*2/eta)/M_LN2), 0.);
-      // Setup the bins: The i-th bin contains the entries of v with modulus in the interval
-      // (2^{-(i+1)}||v||,2^{-i}||v||], 0 <= i <= q-1, the remaining elements (with even smaller modulus)
-      // are collected in the q-th bin.
-      Array1D<std::list<std::pair<Index, double> > > bins(q+1);
+      std::vector<std::pair<Index, double> > entries;
+      entries.reserve(v.size());
       for (typename InfiniteVector<double,Index>::const_iterator it(v.begin());
- 	   it != v.end(); ++it) {
- 	const unsigned int i = std::min(q, (unsigned int)floor(-log(fabs(*it)/norm_v)/M_LN2));
-	bins[i].push_back(std::make_pair(it.index(), *it));
-        //cout << i << ", " << it.index() << ", " << *it << endl;
-      }
-      
-      // glue all the bins together
-      Array1D<std::pair<Index, double> > v_binned(v.size());
-      for (unsigned int bin = 0, id = 0; bin <= q; bin++)
-	for (typename std::list<std::pair<Index, double> >::const_iterator it(bins[bin].begin());
-	     it != bins[bin].end(); ++it, ++id)
-	  v_binned[id] = *it;
+	   it != v.end(); ++it)
+	entries.push_back(std::make_pair(it.index(), *it));
 
-      const double theta = 0.5;
-      // setup the segments v_{[0]},...,v_{[\ell]},
-      // \ell being the smallest number such that
-      //   ||A||*||v-\sum_{k=0}^\ell v_{[k]}|| <= theta * eta
-      // i.e.
-      //   ||v-\sum_{k=0}^\ell v_{[k]}||^2 <= eta^2 * theta^2 / ||A||^2
-      // see [S, (3.9)]
-      const double threshold = eta*eta*theta*theta/(norm_A*norm_A);
-      unsigned int id = 0, k = 0;
-      double error_sqr = norm_v_sqr;
-      typename std::list<std::list<std::pair<Index, double> > > vks;
-      typename std::list<double> vks_norm;
-      while (true) {
-	// setup the k-th segment v_{[k]}
-	std::list<std::pair<Index, double> > vk;
-	double vk_norm_sqr = 0;
-	for (unsigned int n = 1; error_sqr > threshold && id < v.size() && n <= ldexp(1.0, k)-floor(ldexp(1.0, k-1)); n++, id++) {
-	  vk.push_back(v_binned[id]);
-	  const double help = v_binned[id].second * v_binned[id].second;
-	  error_sqr -= help;
-	  vk_norm_sqr += help;
-	}
-	vks.push_back(vk);
-	vks_norm.push_back(sqrt(vk_norm_sqr));
-	if (error_sqr <= threshold || id >= v.size()) break; // in this case, ell=k
-	k++;
-      }
-      const unsigned int ell = k;
-      // compute the smallest J >= ell, such that
-      //   \sum_{k=0}^{\ell} alpha_{J-k}*2^{-s(J-k)}*||v_{[k]}|| <= (1-theta) * eta
-      unsigned int J = ell;
-      const double s = P.s_star();
-      while (true) {
-	double check = 0.0;
-	unsigned int k = 0;
-	for (std::list<double>::const_iterator it(vks_norm.begin()); k <= ell; ++it, ++k)
-	  check += P.alphak(J-k) * pow(ldexp(1.0,J-k),-s) * (*it);
-	if (check <= (1-theta)*eta) break;
-	J++;
+      std::list<std::list<std::pair<Index, double> > > vks;
+      const unsigned int J = APPLY_binning(P, entries, eta, vks);
+
+      // 'add_compressed_column' and 'add_level' in cached_problem.cpp/.h work on
+      // dense vectors, since the call of 'w.add_coefficient();' in 'add_level' is
+      // inefficient. The accumulator remembers the touched entries, so that
+      // copying them into the sparse vector w does not cost O(degrees_of_freedom()).
+      DenseAccumulator<double> ww(P.basis().degrees_of_freedom());
+
+      // compute w = \sum_{k=0}^\ell A_{J-k}v_{[k]}
+      unsigned int k = 0;
+      for (typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
+	   it != vks.end(); ++it, ++k) {
+	for (typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
+	     itk != it->end(); ++itk)
+	  add_compressed_column(P, itk->second, itk->first, J-k, ww, jmax, strategy, true);
       }
 
-//      cout << ell << endl;
-//      cout << "J = " << J << endl;
- //     cout << 1 << endl;
+      // copy ww into w
+      NumberedVector<double> wn;
+      ww.extract(wn);
+      for (typename NumberedVector<double>::size_type n = 0; n < wn.size(); n++)
+	w.push_back(*(P.basis().get_wavelet(wn.number(n))), wn.value(n));
+    }
+  }
 
-      // hack: We let 'add_compressed_column' and 'add_level'
-      // in cached_problem.cpp/.h work on full vectors. We do this because the call of 
-      // 'w.add_coefficient();' in 'add_level' is inefficient. 
-      // Below we will then copy ww into the sparse vector w.
-      // Probably this will be handled in a more elegant way in the near future.
+  template <class PROBLEM>
+  void APPLY(const PROBLEM& P,
+	     const NumberedVector<double>& v,
+	     const double eta,
+	     NumberedVector<double>& w,
+	     DenseAccumulator<double>& ww,
+	     const int jmax,
+	     const CompressionStrategy strategy)
+  {
+    w.clear();
+    if (v.size() > 0) {
+      std::vector<std::pair<int, double> > entries;
+      entries.reserve(v.size());
+      for (typename NumberedVector<double>::size_type n = 0; n < v.size(); n++)
+	entries.push_back(std::make_pair(v.number(n), v.value(n)));
 
-      //cout << "done binning in apply..." << endl;
+      std::list<std::list<std::pair<int, double> > > vks;
+      const unsigned int J = APPLY_binning(P, entries, eta, vks);
+
+      if (ww.size() != (size_t)P.basis().degrees_of_freedom())
+	ww.resize(P.basis().degrees_of_freedom());
+      else
+	ww.clear();
 
-      Vector<double> ww(P.basis().degrees_of_freedom());
- //     cout << "AUSGEFÜHRT PART2: " << P.basis().degrees_of_freedom() << endl;//HIER WEITERMACHEN @PHK
-      //cout << *(P.basis().get_wavelet(4000)) << endl;
       // compute w = \sum_{k=0}^\ell A_{J-k}v_{[k]}
-      k = 0;
-      unsigned int z = 0;
+      unsigned int k = 0;
+      for (std::list<std::list<std::pair<int, double> > >::const_iterator it(vks.begin());
+	   it != vks.end(); ++it, ++k) {
+	for (std::list<std::pair<int, double> >::const_iterator itk(it->begin());
+	     itk != it->end(); ++itk)
+	  add_compressed_column(P, itk->second, *(P.basis().get_wavelet(itk->first)), J-k, ww, jmax, strategy, true);
+      }
+
+      ww.extract(w);
+    }
+  }
+
+  template <class PROBLEM>
+  void APPLY(const PROBLEM& P,
+	     const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+	     const std::vector<double>& eta,
+	     std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	     const int jmax,
+	     const CompressionStrategy strategy)
+  {
+    std::vector<DenseAccumulator<double> > ww;
+    APPLY(P, v, eta, w, ww, jmax, strategy);
+  }
+
+  template <class PROBLEM>
+  void APPLY(const PROBLEM& P,
+	     const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+	     const std::vector<double>& eta,
+	     std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	     std::vector<DenseAccumulator<double> >& ww,
+	     const int jmax,
+	     const CompressionStrategy strategy)
+  {
+    typedef typename PROBLEM::Index Index;
+
+    // for each column of A: the maximal compression level requested by the
+    // vectors and the pairs (i,v[i]_lambda) of the segments it is applied to
+    typedef std::pair<int, std::vector<std::pair<unsigned int, double> > > Column;
+    std::map<Index, Column> columns;
+
+    const unsigned int k = v.size();
+    w.resize(k);
+    for (unsigned int i = 0; i < k; i++) {
+      w[i].clear();
+      if (v[i].size() == 0) continue;
+
+      std::vector<std::pair<Index, double> > entries;
+      entries.reserve(v[i].size());
+      for (typename InfiniteVector<double,Index>::const_iterator it(v[i].begin());
+	   it != v[i].end(); ++it)
+	entries.push_back(std::make_pair(it.index(), *it));
+
+      std::list<std::list<std::pair<Index, double> > > vks;
+      const unsigned int J = APPLY_binning(P, entries, eta[i], vks);
+
+      unsigned int l = 0;
       for (typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
-	   k <= ell; ++it, ++k) {
+	   it != vks.end(); ++it, ++l) {
 	for (typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
 	     itk != it->end(); ++itk) {
-	  //add_compressed_column(P, itk->second, itk->first, J-k, ww, jmax, strategy);
-	  //cout << "J-k = " << J-k << endl;
- //           cout << "addcompressed wird ausgeführt" << endl;
-//            cout << itk->second << ", " << itk->first << endl;
-            //cout << "Beginn cc" << endl;
-	  
-            add_compressed_column(P, itk->second, itk->first, J-k, ww, jmax, strategy, true);
- //         cout << "Ende cc" << endl;
-//          //cout << ww << endl;
-	  z++;
+	  Column& column(columns.insert(std::make_pair(itk->first, Column(-1, std::vector<std::pair<unsigned int, double> >()))).first->second);
+	  column.first = std::max(column.first, (int)(J-l));
+	  column.second.push_back(std::make_pair(i, itk->second));
 	}
       }
-//      cout << "copying vector" << endl;
-      // copy ww into w
-      for (unsigned int i = 0; i < ww.size(); i++) {
-	if (ww[i] != 0.) {
-	  w.set_coefficient(*(P.basis().get_wavelet(i)), ww[i]);
-	}
+    }
+
+    if (columns.empty()) return;
+
+    // compute each column once and scatter it into the products
+    // w[i] = \sum_{l=0}^{\ell_i} A_{J_i-l}v[i]_{[l]}
+    // (resize() only clears the touched entries if the size is already correct)
+    if (ww.size() < k+1)
+      ww.resize(k+1);
+    for (unsigned int i = 0; i <= k; i++)
+      ww[i].resize(P.basis().degrees_of_freedom());
+    DenseAccumulator<double>& cc(ww[k]);
+    NumberedVector<double> c;
+    for (typename std::map<Index, Column>::const_iterator it(columns.begin());
+	 it != columns.end(); ++it) {
+      const std::vector<std::pair<unsigned int, double> >& factors(it->second.second);
+      if (factors.size() == 1) {
+	add_compressed_column(P, factors[0].second, it->first, it->second.first, ww[factors[0].first], jmax, strategy, true);
+	continue;
       }
+      add_compressed_column(P, 1.0, it->first, it->second.first, cc, jmax, strategy, true);
+      cc.extract(c);
+      for (unsigned int m = 0; m < factors.size(); m++)
+	ww[factors[m].first].add(factors[m].second, c);
+    }
+
+    NumberedVector<double> wn;
+    for (unsigned int i = 0; i < k; i++) {
+      ww[i].extract(wn);
+      for (typename NumberedVector<double>::size_type n = 0; n < wn.size(); n++)
+	w[i].push_back(*(P.basis().get_wavelet(wn.number(n))), wn.value(n));
     }
-//    cout << "bin raus" << endl;
   }
 
+  /*
+    The sum w = \sum_{k=0}^\ell A_{J-k}v_{[k]} in APPLY_QUARKLET, as a body for
+    parallel_reduce(): the i-th column is compressed with level levels[i].
+    Each worker accumulates into its own dense vector ww.
+  */
+  template <class PROBLEM>
+  class CompressedQuarkletColumns
+  {
+  public:
+    typedef typename PROBLEM::Index Index;
+
+    CompressedQuarkletColumns(const PROBLEM& P,
+			      const Array1D<std::pair<Index, double> >& columns,
+			      const Array1D<int>& levels,
+			      const int jmax,
+			      const CompressionStrategy strategy,
+			      const int pmax,
+			      const double a,
+			      const double b)
+      : ww(P.frame().degrees_of_freedom()),
+	P_(P), columns_(columns), levels_(levels), jmax_(jmax), strategy_(strategy),
+	pmax_(pmax), a_(a), b_(b) {}
+
+    CompressedQuarkletColumns(CompressedQuarkletColumns& c, TaskScheduler::Split)
+      : ww(c.ww.size()),
+	P_(c.P_), columns_(c.columns_), levels_(c.levels_), jmax_(c.jmax_), strategy_(c.strategy_),
+	pmax_(c.pmax_), a_(c.a_), b_(c.b_) {}
+
+    void operator () (const int i)
+    {
+      add_compressed_column_quarklet(P_, columns_[i].second, columns_[i].first, levels_[i],
+				     ww, jmax_, strategy_, true, pmax_, a_, b_);
+    }
+
+    void join(CompressedQuarkletColumns& c) { ww.add(c.ww); }
+
+    //! the accumulated result
+    Vector<double> ww;
+
+  protected:
+    const PROBLEM& P_;
+    const Array1D<std::pair<Index, double> >& columns_;
+    const Array1D<int>& levels_;
+    const int jmax_;
+    const CompressionStrategy strategy_;
+    const int pmax_;
+    const double a_, b_;
+  };
+
   template <class PROBLEM>
   void APPLY_QUARKLET(const PROBLEM& P,
 	     const InfiniteVector<double, typename PROBLEM::Index>& v,
@@ -609,87 +777,31 @@ namespace WaveletTL
       // compute w = \sum_{k=0}^\ell A_{J-k}v_{[k]}
 //      for(int i=0;i<vksize.size();i++) cout<<vksize[i]<<endl;
 #if PARALLEL==1
-      //outer loop parallelization
-//#pragma omp parallel
-//{       
-//          if(omp_get_thread_num()==0)
-//            cout<<"number of threads: "<<omp_get_num_threads()<<endl;
-//          Vector<double> wwprivate(P.frame().degrees_of_freedom());        
-//          #pragma omp for
-//      for(k=0;k<ell;k++){
-//          typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
-//          advance(it, k); 
-//          unsigned int z = 0;
-//            for (typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
-//	     itk != it->end(); ++itk,++z) {
-          
-          //inner loop parallelization
-          k = 0;
-          for (typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
-	      k <= ell; ++it, ++k) {
-//              cout <<vksize[k]<<endl;
-//              int my_num_threads = (vksize[k]>=64) ? 8 : 1;
-#pragma omp parallel //num_threads(my_num_threads)
-{
-//            if(omp_get_thread_num()==0)
-//                cout<<"number of threads: "<<omp_get_num_threads()<<endl;
-            Vector<double> wwprivate(P.frame().degrees_of_freedom()); 
-            unsigned int z = 0;
-#pragma omp for
-            for(int z=0;z<vksize[k];z++){
-              typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
-              advance(itk,z);          
-              
-            //collapse parallelization
-//#pragma omp parallel
-//{
-//            Vector<double> wwprivate(P.frame().degrees_of_freedom()); 
-//#pragma omp for collapse(2)
-//            for(int k=0;k<ell;k++){
-//                typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
-//                advance(it, k);
-//                for(int z=0;z<vksize[k];z++){
-//                    typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
-//                    advance(itk,z);
+      // flatten the segments v_{[k]}, each column is compressed with level J-k
+      Array1D<std::pair<Index, double> > columns(id);
+      Array1D<int> levels(id);
+      k = 0;
+      unsigned int n = 0;
+      for (typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
+	   k <= ell; ++it, ++k)
+	for (typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
+	     itk != it->end(); ++itk, ++n) {
+	  columns[n] = *itk;
+	  levels[n] = J-k;
+	}
+      CompressedQuarkletColumns<PROBLEM> columns_sum(P, columns, levels, jmax, strategy, pmax, a, b);
+      parallel_reduce(0, id, columns_sum);
+      ww.swap(columns_sum.ww);
 #else
       k = 0;
       for (typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
 	   k <= ell; ++it, ++k) {
-           unsigned int z = 0;
-            for (typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
-	     itk != it->end(); ++itk,++z) {
-#endif
-          //  Vector<double> wwhelp(P.frame().degrees_of_freedom());
-	  //add_compressed_column(P, itk->second, itk->first, J-k, ww, jmax, strategy);
-//            cout << "J-k = " << J-k << endl;
-//            cout << "addcompressed wird ausgeführt" << endl;
-//            cout << itk->second << ", " << itk->first << endl;
-            //cout << "Beginn cc" << endl;
-           // add_compressed_column_quarklet(P, itk->second, itk->first, J-k, ww, jmax, strategy, true, pmax, a, b);
-           //Vector<double> wwhelp(P.frame().degrees_of_freedom());
-#if PARALLEL==1
-            add_compressed_column_quarklet(P, itk->second, itk->first, J-k, wwprivate, jmax, strategy, true);
-#else
-            add_compressed_column_quarklet(P, itk->second, itk->first, J-k, ww, jmax, strategy, true, pmax, a, b);
-#endif
-//          cout << "Ende cc" << endl;
-          //cout << ww << endl;
-	  //z++;
+	for (typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
+	     itk != it->end(); ++itk) {
+	  add_compressed_column_quarklet(P, itk->second, itk->first, J-k, ww, jmax, strategy, true, pmax, a, b);
 	}
-//        cout<<"z="<<z<<":"<<vksize[k]<<endl;
-           //outer loop or collapse parallelization
-//      }
-#if PARALLEL==1
-#pragma omp critical
-{
-        for(int i=0;i<ww.size();i++){
-            ww(i)+=wwprivate(i);
-        }
-}
-} 
+      }
 #endif
-      //inner loop parallelization
-       }
 //      cout<<"k= "<<k<<endl;
 //          cout<<"vksize="<<vksize<<endl;
 //      cout << "copying vector" << endl;
@@ -825,87 +937,32 @@ namespace WaveletTL
       // compute w = \sum_{k=0}^\ell A_{J-k}v_{[k]}
 //      for(int i=0;i<vksize.size();i++) cout<<vksize[i]<<endl;
 #if PARALLEL==1
-      //outer loop parallelization
-//#pragma omp parallel
-//{       
-//          if(omp_get_thread_num()==0)
-//            cout<<"number of threads: "<<omp_get_num_threads()<<endl;
-//          Vector<double> wwprivate(P.frame().degrees_of_freedom());        
-//          #pragma omp for
-//      for(k=0;k<ell;k++){
-//          typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
-//          advance(it, k); 
-//          unsigned int z = 0;
-//            for (typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
-//	     itk != it->end(); ++itk,++z) {
-          
-          //inner loop parallelization
-          k = 0;
-          for (typename std::list<std::list<std::pair<int, double> > >::const_iterator it(vks.begin());
-	      k <= ell; ++it, ++k) {
-//              cout <<vksize[k]<<endl;
-//              int my_num_threads = (vksize[k]>=64) ? 8 : 1;
-#pragma omp parallel //num_threads(my_num_threads)
-{
-//            if(omp_get_thread_num()==0)
-//                cout<<"number of threads: "<<omp_get_num_threads()<<endl;
-            Vector<double> wwprivate(P.frame().degrees_of_freedom()); 
-            unsigned int z = 0;
-#pragma omp for
-            for(int z=0;z<vksize[k];z++){
-              typename std::list<std::pair<int, double> >::const_iterator itk(it->begin());
-              advance(itk,z);          
-              
-            //collapse parallelization
-//#pragma omp parallel
-//{
-//            Vector<double> wwprivate(P.frame().degrees_of_freedom()); 
-//#pragma omp for collapse(2)
-//            for(int k=0;k<ell;k++){
-//                typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
-//                advance(it, k);
-//                for(int z=0;z<vksize[k];z++){
-//                    typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
-//                    advance(itk,z);
+      typedef typename PROBLEM::Index Index;
+      // flatten the segments v_{[k]}, each column is compressed with level J-k
+      Array1D<std::pair<Index, double> > columns(id);
+      Array1D<int> levels(id);
+      k = 0;
+      unsigned int n = 0;
+      for (typename std::list<std::list<std::pair<int, double> > >::const_iterator it(vks.begin());
+	   k <= ell; ++it, ++k)
+	for (typename std::list<std::pair<int, double> >::const_iterator itk(it->begin());
+	     itk != it->end(); ++itk, ++n) {
+	  columns[n] = std::make_pair(*(P.frame().get_quarklet(itk->first)), itk->second);
+	  levels[n] = J-k;
+	}
+      CompressedQuarkletColumns<PROBLEM> columns_sum(P, columns, levels, jmax, strategy, pmax, a, b);
+      parallel_reduce(0, id, columns_sum);
+      ww.swap(columns_sum.ww);
 #else
       k = 0;
       for (typename std::list<std::list<std::pair<int, double> > >::const_iterator it(vks.begin());
 	   k <= ell; ++it, ++k) {
-           unsigned int z = 0;
-            for (typename std::list<std::pair<int, double> >::const_iterator itk(it->begin());
-	     itk != it->end(); ++itk,++z) {
-#endif
-          //  Vector<double> wwhelp(P.frame().degrees_of_freedom());
-	  //add_compressed_column(P, itk->second, itk->first, J-k, ww, jmax, strategy);
-//            cout << "J-k = " << J-k << endl;
-//            cout << "addcompressed wird ausgeführt" << endl;
-//            cout << itk->second << ", " << itk->first << endl;
-            //cout << "Beginn cc" << endl;
-           // add_compressed_column_quarklet(P, itk->second, itk->first, J-k, ww, jmax, strategy, true, pmax, a, b);
-           //Vector<double> wwhelp(P.frame().degrees_of_freedom());
-#if PARALLEL==1
-            add_compressed_column_quarklet(P, itk->second, itk->first, J-k, wwprivate, jmax, strategy, true);
-#else
-            add_compressed_column_quarklet(P, itk->second, *(P.frame().get_quarklet(itk->first)), J-k, ww, jmax, strategy, true, pmax, a, b);
-#endif
-//          cout << "Ende cc" << endl;
-          //cout << ww << endl;
-	  //z++;
+	for (typename std::list<std::pair<int, double> >::const_iterator itk(it->begin());
+	     itk != it->end(); ++itk) {
+	  add_compressed_column_quarklet(P, itk->second, *(P.frame().get_quarklet(itk->first)), J-k, ww, jmax, strategy, true, pmax, a, b);
 	}
-//        cout<<"z="<<z<<":"<<vksize[k]<<endl;
-           //outer loop or collapse parallelization
-//      }
-#if PARALLEL==1
-#pragma omp critical
-{
-        for(int i=0;i<ww.size();i++){
-            ww(i)+=wwprivate(i);
-        }
-}
-} 
+      }
 #endif
-      //inner loop parallelization
-       }
 //      cout<<"k= "<<k<<endl;
 //          cout<<"vksize="<<vksize<<endl;
 //      cout << "copying vector" << endl;
@@ -1561,6 +1618,74 @@ namespace WaveletTL
     while ( (nu > epsilon) && (zeta > delta*l2n) );
     
   }
+
+  template <class PROBLEM>
+  void RES(const PROBLEM& P,
+	   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+	   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	   const std::vector<double>& xi,
+	   const double delta,
+	   const double epsilon,
+	   const int jmax,
+	   std::vector<InfiniteVector<double, typename PROBLEM::Index> >& tilde_r,
+	   std::vector<double>& nu,
+	   unsigned int& niter,
+	   const CompressionStrategy strategy)
+  {
+    std::vector<DenseAccumulator<double> > ww;
+    RES(P, F, w, xi, delta, epsilon, jmax, tilde_r, nu, niter, ww, strategy);
+  }
+
+  template <class PROBLEM>
+  void RES(const PROBLEM& P,
+	   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+	   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	   const std::vector<double>& xi,
+	   const double delta,
+	   const double epsilon,
+	   const int jmax,
+	   std::vector<InfiniteVector<double, typename PROBLEM::Index> >& tilde_r,
+	   std::vector<double>& nu,
+	   unsigned int& niter,
+	   std::vector<DenseAccumulator<double> >& ww,
+	   const CompressionStrategy strategy)
+  {
+    const unsigned int k = w.size();
+    tilde_r.resize(k);
+    nu.resize(k);
+    std::vector<double> zeta(k);
+    std::vector<unsigned int> open; // the i for which the loop of RES is not finished
+    for (unsigned int i = 0; i < k; i++) {
+      zeta[i] = 2.*xi[i];
+      open.push_back(i);
+    }
+
+    std::vector<InfiniteVector<double, typename PROBLEM::Index> > v, help;
+    std::vector<double> eta;
+    while (!open.empty()) {
+      v.resize(open.size());
+      eta.resize(open.size());
+      for (unsigned int m = 0; m < open.size(); m++) {
+	zeta[open[m]] /= 2.;
+	v[m] = w[open[m]];
+	eta[m] = zeta[open[m]]/2.;
+      }
+      APPLY(P, v, eta, help, ww, jmax, strategy);
+      ++niter;
+
+      std::vector<unsigned int> still_open;
+      for (unsigned int m = 0; m < open.size(); m++) {
+	const unsigned int i = open[m];
+	F[i].COARSE(zeta[i]/2., tilde_r[i]);
+	tilde_r[i] -= help[m];
+	const double l2n = l2_norm(tilde_r[i]);
+	nu[i] = l2n + zeta[i];
+	if ( (nu[i] > epsilon) && (zeta[i] > delta*l2n) )
+	  still_open.push_back(i);
+      }
+      open.swap(still_open);
+    }
+  }
   
   template <class PROBLEM>
   void RES_QUARKLET(const PROBLEM& P,
@@ -10,7 +10,9 @@
 #ifndef _WAVELETTL_APPLY_H
 #define _WAVELETTL_APPLY_H
 
+#include <vector>
 #include <algebra/infinite_vector.h>
+#include <algebra/numbered_vector.h>
 #include <adaptive/compression.h>
 
 
@@ -18,6 +20,8 @@
 namespace WaveletTL
 {
     using MathTL::InfiniteVector;
+    using MathTL::NumberedVector;
+    using MathTL::DenseAccumulator;
 
   /*!
     Apply the stiffness matrix A of an infinite-dimensional equation
@@ -61,7 +65,77 @@ namespace WaveletTL
 	     InfiniteVector<double, typename PROBLEM::Index>& w,
 	     const int jmax = 99,
 	     const CompressionStrategy strategy = St04a);
-  
+
+  /*!
+    APPLY for vectors given by the numbers of the indices.
+
+    The result is accumulated in the dense accumulator ww, which is (re)sized to
+    P.basis().degrees_of_freedom() if necessary. Passing the same accumulator
+    to subsequent calls avoids the O(degrees_of_freedom()) allocation, all
+    other work is proportional to the number of entries touched by the
+    compressed columns.
+  */
+  template <class PROBLEM>
+  void APPLY(const PROBLEM& P,
+	     const NumberedVector<double>& v,
+	     const double eta,
+	     NumberedVector<double>& w,
+	     DenseAccumulator<double>& ww,
+	     const int jmax = 99,
+	     const CompressionStrategy strategy = St04a);
+
+  /*!
+    Blocked APPLY for k vectors v[0],...,v[k-1] at once, e.g., for several
+    right-hand sides of the same equation, such that
+
+      ||w[i]-Av[i]|| <= eta[i], 0 <= i < k.
+
+    Each vector is binned separately as in the single vector version. Then
+    each column of A that is needed by at least one of the vectors is compressed
+    and computed only once, namely with the largest compression level
+    requested for it, and added to all products w[i] it contributes to.
+    The finer compression for the other vectors only increases their accuracy.
+    For k identical vectors, the result coincides with the one of the single
+    vector version (up to rounding errors).
+  */
+  template <class PROBLEM>
+  void APPLY(const PROBLEM& P,
+	     const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+	     const std::vector<double>& eta,
+	     std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	     const int jmax = 99,
+	     const CompressionStrategy strategy = St04a);
+
+  /*!
+    Blocked APPLY with the k+1 dense accumulators ww (k for the products and
+    one for the columns shared by several vectors), which are (re)sized to
+    P.basis().degrees_of_freedom() if necessary. Passing the same accumulators
+    to subsequent calls, e.g., in the loops of RES or of the solvers, avoids
+    their O(k*degrees_of_freedom()) allocation.
+  */
+  template <class PROBLEM>
+  void APPLY(const PROBLEM& P,
+	     const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+	     const std::vector<double>& eta,
+	     std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	     std::vector<DenseAccumulator<double> >& ww,
+	     const int jmax = 99,
+	     const CompressionStrategy strategy = St04a);
+
+  /*!
+    blocked APPLY with the same accuracy eta for all vectors
+  */
+  template <class PROBLEM>
+  void APPLY(const PROBLEM& P,
+	     const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+	     const double eta,
+	     std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	     const int jmax = 99,
+	     const CompressionStrategy strategy = St04a)
+  {
+    APPLY(P, v, std::vector<double>(v.size(), eta), w, jmax, strategy);
+  }
+
   
   template <class PROBLEM>
   void APPLY_QUARKLET(const PROBLEM& P,
@@ -220,6 +294,44 @@ namespace WaveletTL
            const bool apply_coarse = true
 	   );
 
+  /*!
+    RES for k right-hand sides at once, given by their coefficient vectors F[i]
+    (cf. P.RHS(), the approximations of the right-hand sides are computed by
+    COARSE), and the approximations w[i] to the corresponding solutions.
+    The loop of RES is run for each i separately, with the parameters xi[i],
+    but the APPLY calls for all unfinished i in a sweep are blocked.
+    niter is increased by the number of sweeps.
+  */
+  template <class PROBLEM>
+  void RES(const PROBLEM& P,
+	   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+	   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	   const std::vector<double>& xi,
+	   const double delta,
+	   const double epsilon,
+	   const int jmax,
+	   std::vector<InfiniteVector<double, typename PROBLEM::Index> >& tilde_r,
+	   std::vector<double>& nu,
+	   unsigned int& niter,
+	   const CompressionStrategy strategy = St04a);
+
+  /*!
+    blocked RES with the dense accumulators ww for the blocked APPLY calls
+  */
+  template <class PROBLEM>
+  void RES(const PROBLEM& P,
+	   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+	   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& w,
+	   const std::vector<double>& xi,
+	   const double delta,
+	   const double epsilon,
+	   const int jmax,
+	   std::vector<InfiniteVector<double, typename PROBLEM::Index> >& tilde_r,
+	   std::vector<double>& nu,
+	   unsigned int& niter,
+	   std::vector<DenseAccumulator<double> >& ww,
+	   const CompressionStrategy strategy = St04a);
+
 
 
 template <class PROBLEM>
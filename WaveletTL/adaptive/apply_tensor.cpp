@@ -2,6 +2,69 @@
 
 namespace WaveletTL
 {
+    /*
+      The sum w = \sum_{p=0}^{\ell-1} A^{(jp)}v_{[p]} in APPLY_TENSOR, as a body for
+      parallel_reduce(): the column with number columns[i].first is added with the
+      radius jp_tilde[p] of its bin p. Each worker accumulates into its own dense vector ww.
+    */
+    template <class PROBLEM>
+    class TensorBallColumns
+    {
+    public:
+        TensorBallColumns(PROBLEM& P,
+                const Array1D<std::pair<int,double> >& columns,
+                const Array1D<int>& jp_tilde,
+                const unsigned int ell,
+                const double norm_v,
+                const int jmax,
+                const CompressionStrategy strategy,
+                const bool preconditioning)
+        : ww(P.basis()->degrees_of_freedom()),
+          P_(P), columns_(columns), jp_tilde_(jp_tilde), ell_(ell), norm_v_(norm_v),
+          jmax_(jmax), strategy_(strategy), preconditioning_(preconditioning) {}
+
+        TensorBallColumns(TensorBallColumns& c, TaskScheduler::Split)
+        : ww(c.ww.size()),
+          P_(c.P_), columns_(c.columns_), jp_tilde_(c.jp_tilde_), ell_(c.ell_), norm_v_(c.norm_v_),
+          jmax_(c.jmax_), strategy_(c.strategy_), preconditioning_(c.preconditioning_) {}
+
+        void operator () (const int i)
+        {
+            const unsigned int column_bin = (unsigned int)floor(2*log(norm_v_/fabs(columns_[i].second))/M_LN2);
+            if ( column_bin < ell_ )
+            {
+                P_.add_ball(columns_[i].first, ww, jp_tilde_[column_bin], columns_[i].second, jmax_, strategy_, preconditioning_);
+            }
+        }
+
+        void join(TensorBallColumns& c) { ww.add(c.ww); }
+
+        //! the accumulated result
+        Vector<double> ww;
+
+    protected:
+        PROBLEM& P_;
+        const Array1D<std::pair<int,double> >& columns_;
+        const Array1D<int>& jp_tilde_;
+        const unsigned int ell_;
+        const double norm_v_;
+        const int jmax_;
+        const CompressionStrategy strategy_;
+        const bool preconditioning_;
+    };
+
+    template <class PROBLEM, class VECTOR>
+    bool add_level_sweep(const PROBLEM& P,
+            const typename PROBLEM::Index::level_type& j,
+            const Vector<double>& x,
+            VECTOR& w,
+            const int radius,
+            const int maxlevel,
+            const bool preconditioning)
+    {
+        return false;
+    }
+
     template <class PROBLEM>
     void APPLY_TENSOR(PROBLEM& P,
             const InfiniteVector<double, typename PROBLEM::Index>& v,
@@ -9,7 +72,8 @@ namespace WaveletTL
             InfiniteVector<double, typename PROBLEM::Index>& w,
             const int jmax,
             const CompressionStrategy strategy,
-            const bool preconditioning)
+            const bool preconditioning,
+            const bool sweep)
     {
         // Remark: Remark from APPLY applies here as well, since binary binning part is the similar.
         // linfty norm is used, resulting in the Factor 2 for p.
@@ -64,7 +128,8 @@ namespace WaveletTL
 #if _APPLY_TENSOR_DEBUGMODE == 1
                     assert (std::min(q, 2*floor(log2(floor(norm_v/fabs(*it)))) ) = std::min(q, (unsigned int)floor(-2*log(fabs(*it)/norm_v)/M_LN2)));
 #endif
-                    temp_i = 2*log2(floor(norm_v/fabs(*it))) -1; // bins: 1,...,q but observe temp_i: 0,...,q-1
+                    // the former formula 2*log2(floor(norm_v/fabs(*it)))-1 sent the largest entries to the bin -1
+                    temp_i = (unsigned int)floor(2*log(norm_v/fabs(*it))/M_LN2); // bins: 1,...,q but observe temp_i: 0,...,q-1
                     if (temp_i < q)
                     {
                         //bins[i].push_back(std::make_pair(it.index(), *it));
@@ -178,37 +243,86 @@ namespace WaveletTL
             for (unsigned int i = 0; i < ell; ++i)
             {
                 //jp_tilde[i] = ceil (log(sqrt(bin_norm_sqr[i])*num_of_relevant_entries*P.alphak(i)/(bin_size[i]*(eta-delta)))/M_LN2 ); 
-                jp_tilde[i] = ceil (log2(ceil (sqrt(bin_norm_sqr[i]) * num_of_relevant_entries * P.alphak(i) / (bin_size[i]*(eta-delta))))  );
+                if (bin_size[i] > 0)
+                {
+                    jp_tilde[i] = ceil (log2(ceil (sqrt(bin_norm_sqr[i]) * num_of_relevant_entries * P.alphak(i) / (bin_size[i]*(eta-delta))))  );
 #if _APPLY_TENSOR_DEBUGMODE == 1
-                assert (jp_tilde[i] ==  ceil (log(sqrt(bin_norm_sqr[i])*num_of_relevant_entries*P.alphak(i)/(bin_size[i]*(eta-delta)))/M_LN2 ) );
+                    assert (jp_tilde[i] ==  ceil (log(sqrt(bin_norm_sqr[i])*num_of_relevant_entries*P.alphak(i)/(bin_size[i]*(eta-delta)))/M_LN2 ) );
 #endif
+                }
+                else
+                {
+                    jp_tilde[i] = 0;
+                }
             }
             // hack: We work with full vectors (of size degrees_of_freedom).
             // We do this because adding sparse vectors seems to be inefficient.
-            // Below we will then copy ww into the sparse vector w.
-            // Probably this will be handled in a more elegant way someday.
+            // The accumulator remembers the touched entries, so that copying them
+            // into the sparse vector w below does not cost O(degrees_of_freedom()).
             // ww should be of a similar structure to the cache in P
-            Vector<double> ww(P.basis().degrees_of_freedom());
+            DenseAccumulator<double> ww(P.basis().degrees_of_freedom());
             //cout << *(P.basis().get_wavelet(4000)) << endl;
             // compute w = \sum_{k=0}^\ell A_{J-k}v_{[k]}
-            for (typename InfiniteVector<double,Index>::const_iterator it(v.begin()), itend(v.end());it != itend; ++it)
+            if (sweep)
             {
-#if _APPLY_TENSOR_DEBUGMODE == 1
-                assert ( (2*log2(floor(norm_v/fabs(*it))) -1) >= 0 );
-                assert ( (2*log2(floor(norm_v/fabs(*it))) -1) < ell );
-#endif
-                //temp_i = 2*log2(floor(norm_v/fabs(*it))) -1
-                //add_compressed_column_tensor(P, *it, it, jp_tilde[2*log2(floor(norm_v/fabs(*it))) -1], ww, jmax, strategy, preconditioning);
-                P.add_ball(it.index(),ww,jp_tilde[2*log2(floor(norm_v/fabs(*it))) -1],*it,jmax,strategy,preconditioning);
+                // the entries of v on one level are consecutive, and the numbers of
+                // the indices on a level are consecutive as well
+                typename InfiniteVector<double,Index>::const_iterator it(v.begin()), itend(v.end());
+                while (it != itend)
+                {
+                    const typename Index::level_type level(it.index().j());
+                    typename InfiniteVector<double,Index>::const_iterator itlevel(it);
+                    int entries(0), radius(-1);
+                    for (; itlevel != itend && itlevel.index().j() == level; ++itlevel, ++entries)
+                    {
+                        const unsigned int bin = (unsigned int)floor(2*log(norm_v/fabs(*itlevel))/M_LN2);
+                        if (bin < ell)
+                            radius = std::max(radius, jp_tilde[bin]);
+                    }
+                    const int first = (level == P.basis().j0()) ? 0 : P.basis().first_wavelet(level).number();
+                    bool swept = false;
+                    if (radius >= 0 && entries == (int)P.basis().last_wavelet(level).number()-first+1)
+                    {
+                        // fully populated level block, entries in discarded bins are ignored
+                        Vector<double> x(entries);
+                        int m(0);
+                        for (typename InfiniteVector<double,Index>::const_iterator it2(it); it2 != itlevel; ++it2, ++m)
+                        {
+                            if ((unsigned int)floor(2*log(norm_v/fabs(*it2))/M_LN2) < ell)
+                                x[m] = *it2;
+                        }
+                        swept = add_level_sweep(P, level, x, ww, radius, jmax, preconditioning);
+                    }
+                    if (!swept)
+                    {
+                        for (; it != itlevel; ++it)
+                        {
+                            const unsigned int bin = (unsigned int)floor(2*log(norm_v/fabs(*it))/M_LN2);
+                            if (bin < ell)
+                                P.add_ball(it.index(),ww,jp_tilde[bin],*it,jmax,strategy,preconditioning);
+                        }
+                    }
+                    it = itlevel;
+                }
             }
-            // copy ww into w
-            for (unsigned int i = 0; i < ww.size(); i++) 
+            else
             {
-                if (ww[i] != 0.)
+                for (typename InfiniteVector<double,Index>::const_iterator it(v.begin()), itend(v.end());it != itend; ++it)
                 {
-                    w.set_coefficient(*(P.basis().get_wavelet(i)), ww[i]);
+                    //temp_i = 2*log2(floor(norm_v/fabs(*it))) -1
+                    //add_compressed_column_tensor(P, *it, it, jp_tilde[2*log2(floor(norm_v/fabs(*it))) -1], ww, jmax, strategy, preconditioning);
+                    const unsigned int bin = (unsigned int)floor(2*log(norm_v/fabs(*it))/M_LN2);
+                    if (bin < ell)
+                    {
+                        P.add_ball(it.index(),ww,jp_tilde[bin],*it,jmax,strategy,preconditioning);
+                    }
                 }
             }
+            // copy ww into w, the indices are appended in increasing order
+            NumberedVector<double> wn;
+            ww.extract(wn);
+            for (typename NumberedVector<double>::size_type n = 0; n < wn.size(); n++)
+                w.push_back(*(P.basis().get_wavelet(wn.number(n))), wn.value(n));
         }
     }
     
@@ -456,6 +570,19 @@ namespace WaveletTL
             // ww should be of a similar structure to the cache in P
             Vector<double> ww(P.basis()->degrees_of_freedom());
             // compute w = \sum_{k=0}^(\ell-1) A_{J-k}v_{[k]}
+#if PARALLEL==1
+            // distribute the columns among the workers, each of them accumulates into its own
+            // copy of ww (add_ball of CachedQTProblem may be called concurrently)
+            Array1D<std::pair<int,double> > columns(v.size());
+            {
+                unsigned int id(0);
+                for (typename InfiniteVector<double,int>::const_iterator it(v.begin()), itend(v.end());it != itend; ++it, ++id)
+                    columns[id] = std::pair<int,double>(it.index(), *it);
+            }
+            TensorBallColumns<PROBLEM> columns_sum(P, columns, jp_tilde, ell, norm_v, jmax, strategy, preconditioning);
+            parallel_reduce(0, columns.size(), columns_sum);
+            ww.swap(columns_sum.ww);
+#else
             for (typename InfiniteVector<double,int>::const_iterator it(v.begin()), itend(v.end());it != itend; ++it)
             {
 #if _APPLY_TENSOR_DEBUGMODE == 1
@@ -480,6 +607,7 @@ namespace WaveletTL
                     P.add_ball(it.index() ,ww,jp_tilde[temp_i],*it   ,jmax,strategy,preconditioning);
                 }
             }
+#endif
             // copy ww into w
             for (unsigned int i = 0; i < ww.size(); i++) 
             {
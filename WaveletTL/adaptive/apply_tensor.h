@@ -11,9 +11,11 @@
 #define	_WAVELETTL_APPLY_TENSOR_H
 
 #include <algebra/infinite_vector.h>
+#include <algebra/numbered_vector.h>
 #include <adaptive/compression.h>
 #include <utils/array1d.h>
 #include <utils/tiny_tools.h>
+#include <utils/task_scheduler.h>
 
 #include <iostream>
 #include <list>
@@ -22,6 +24,8 @@
 #include <algorithm>
 
 using MathTL::Array1D;
+using MathTL::TaskScheduler;
+using MathTL::parallel_reduce;
 
 
 namespace WaveletTL
@@ -76,6 +80,14 @@ namespace WaveletTL
    * This may lead to an overestimate and thus too high computational effort.
    * 
    * In a previous version of the code the optimal effort was computed by a costly minimization problem (-> commented code)
+   *
+   * Sweep mode (sweep == true): level blocks of v that are fully populated (as it happens for
+   * nearly full index sets Lambda) are not added column by column, but with add_level_sweep()
+   * (see below), which applies the stiffness matrix blockwise using its Kronecker structure
+   * on dense arrays. For such a block the largest jp over its entries is used,
+   * so the result is at least as accurate as in the columnwise version.
+   * Blocks that are not fully populated, or problems without Kronecker structure
+   * (add_level_sweep() returns false), are handled columnwise as usual.
    */
   template <class PROBLEM>
   void APPLY_TENSOR(PROBLEM& P,
@@ -84,7 +96,25 @@ namespace WaveletTL
           InfiniteVector<double, typename PROBLEM::Index>& w,
           const int jmax = 99,
           const CompressionStrategy strategy = tensor_simple,
-          const bool preconditioning = true);
+          const bool preconditioning = true,
+          const bool sweep = false);
+
+  /*
+   * Sweep mode hook of APPLY_TENSOR: add D^{-1}A_{j',j}D^{-1}x to w for all levels j'
+   * with ||j'-j||_1 <= radius and |j'| <= maxlevel, where x contains the coefficients
+   * of the fully populated level block j (ordered by number).
+   * The generic version does nothing and returns false, i.e., the level block is added
+   * columnwise. Problems with Kronecker structure provide an overload,
+   * cf. CachedTProblem::add_level_sweep().
+   */
+  template <class PROBLEM, class VECTOR>
+  bool add_level_sweep(const PROBLEM& P,
+          const typename PROBLEM::Index::level_type& j,
+          const Vector<double>& x,
+          VECTOR& w,
+          const int radius,
+          const int maxlevel,
+          const bool preconditioning);
   
   template <class PROBLEM>
   void APPLY_TENSOR(PROBLEM& P,
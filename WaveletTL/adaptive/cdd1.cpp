@@ -1,6 +1,340 @@
 // implementation for cdd1.h
 namespace WaveletTL
 {
+    /*
+      entry of the preconditioned right-hand side,
+      cf. the two variants of setup_righthand_side() in galerkin_utils.h
+    */
+    template <class PROBLEM, typename INDEX>
+    inline double CDD1_rhs_entry(PROBLEM& P, const INDEX& lambda)
+    {
+        return P.f(lambda)/P.D(lambda);
+    }
+
+    template <class PROBLEM>
+    inline double CDD1_rhs_entry(PROBLEM& P, const int& lambda)
+    {
+        return P.f(lambda);
+    }
+
+
+    /*
+      the APPLY call of NRESIDUAL, w ~ Av with ||w-Av||_2 <= eta
+    */
+    template <class PROBLEM>
+    inline void CDD1_residual_apply(PROBLEM& P,
+                                    const InfiniteVector<double, typename PROBLEM::WaveletBasis::Index>& v,
+                                    const double eta,
+                                    InfiniteVector<double, typename PROBLEM::WaveletBasis::Index>& w,
+                                    const int jmax,
+                                    const CompressionStrategy strategy)
+    {
+#if _WAVELETTL_USE_TBASIS == 1
+//        APPLY_TENSOR(P,v,eta,w,jmax,strategy);
+        APPLY(P, v, eta, w, jmax, tensor_simple);
+#else
+        APPLY(P, v, eta, w, jmax, strategy);
+#endif
+    }
+
+    template <class PROBLEM>
+    inline void CDD1_residual_apply(PROBLEM& P,
+                                    const InfiniteVector<double, int>& v,
+                                    const double eta,
+                                    InfiniteVector<double, int>& w,
+                                    const int jmax,
+                                    const CompressionStrategy strategy)
+    {
+#if _WAVELETTL_USE_TBASIS == 1
+        APPLY_TENSOR(P, v, eta, w, jmax, strategy, true);
+#else
+        APPLY(P, v, eta, w, jmax, strategy);
+#endif
+    }
+
+
+    inline void CDD1_INIT(const double c1, const double c2, const double F,
+                          CDD1Parameters& params)
+    {
+        // INIT, cf. [BB+] 
+        params.c1 = c1;
+        params.c2 = c2;
+        params.kappa = params.c2/params.c1;
+        params.gamma = 0.8;
+        params.F = F;
+        // determination of q=q1=q2=q3,q4 according to [CDD1, (7.23)ff]
+        params.q4 = 1. / (20. * params.kappa);
+        const double A = params.c1 / (20. * (3. + params.c1 / params.c2));
+        const double B = params.c2 * (0.1 - params.q4 * sqrt(params.kappa));
+        const double C = params.q4 / (1 / params.c2 + 6. * (params.gamma + 1.) / (params.gamma * params.c1));
+        params.q1 = params.q2 = params.q3 = std::min(A, std::min(B, C));
+        params.q0 = sqrt(params.kappa) + params.q3/params.c2;
+        params.theta = sqrt(1 - params.c1 * params.gamma * params.gamma / (4. * params.c2));
+        params.theta_bar = 1 - 1. / (6. * params.kappa);
+        params.K = (unsigned int) floor(log(20 * params.kappa) / fabs(log(params.theta))) + 1;
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+        cout << "CDD1_SOLVE parameters:" << endl;
+        cout << "c1=" << params.c1 << ", c2=" << params.c2 << ", kappa=" << params.kappa << endl;
+        cout << "gamma=" << params.gamma << endl;
+        cout << "F=" << params.F << endl;
+        cout << "q0=" << params.q0 << ", q1=" << params.q1 << ", q2=" << params.q2
+                << ", q3=" << params.q3 << ", q4=" << params.q4 << endl;
+        cout << "theta=" << params.theta << ", theta_bar=" << params.theta_bar << endl;
+        cout << "K=" << params.K << endl;
+#endif
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    CDD1Workspace<PROBLEM,INDEX>::CDD1Workspace(PROBLEM& P)
+      : P_(&P), F_coeffs_(0), F_coarse_eta_(-1)
+    {
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    CDD1Workspace<PROBLEM,INDEX>::CDD1Workspace(PROBLEM& P, const InfiniteVector<double, INDEX>& F)
+      : P_(&P), F_coeffs_(&F), F_coarse_eta_(-1)
+    {
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    void
+    CDD1Workspace<PROBLEM,INDEX>::set_index_set(const set<INDEX>& Lambda)
+    {
+        const size_type none = indices_.size()+Lambda.size();
+
+        // merge Lambda with the sorted array of the current indices
+        std::vector<std::pair<INDEX, size_type> > sorted;
+        sorted.reserve(Lambda.size());
+        std::vector<size_type> new_row(indices_.size(), none);
+        size_type kept = 0, added = 0;
+        typename std::vector<std::pair<INDEX, size_type> >::const_iterator it2(sorted_.begin()), itend2(sorted_.end());
+        for (typename set<INDEX>::const_iterator it(Lambda.begin()), itend(Lambda.end());
+                it != itend; ++it)
+        {
+            while (it2 != itend2 && it2->first < *it)
+                ++it2; // index removed from the active set
+            if (it2 != itend2 && !(*it < it2->first))
+            {
+                new_row[it2->second] = kept++;
+                sorted.push_back(*it2);
+                ++it2;
+            }
+            else
+            {
+                sorted.push_back(std::make_pair(*it, none));
+                added++;
+            }
+        }
+
+        if (kept < indices_.size())
+        {
+            // drop the rows and columns of the removed indices, keeping the order of the other rows
+            for (size_type m = 0, row = 0; m < new_row.size(); m++)
+                if (new_row[m] != none)
+                    new_row[m] = row++;
+            for (size_type m = 0; m < new_row.size(); m++)
+            {
+                const size_type row = new_row[m];
+                if (row == none)
+                    continue;
+                std::vector<size_type> columns;
+                std::vector<double> entries;
+                for (size_type n = 0; n < columns_[m].size(); n++)
+                    if (new_row[columns_[m][n]] != none)
+                    {
+                        columns.push_back(new_row[columns_[m][n]]);
+                        entries.push_back(entries_[m][n]);
+                    }
+                columns_[row].swap(columns);
+                entries_[row].swap(entries);
+                indices_[row] = indices_[m];
+                diagonal_[row] = diagonal_[m];
+                D_[row] = D_[m];
+                F_[row] = F_[m];
+            }
+            indices_.resize(kept);
+            columns_.resize(kept);
+            entries_.resize(kept);
+            diagonal_.resize(kept);
+            D_.resize(kept);
+            F_.resize(kept);
+        }
+        else
+        {
+            for (size_type m = 0; m < new_row.size(); m++)
+                new_row[m] = m;
+        }
+
+        // append the new indices
+        indices_.reserve(kept+added);
+        columns_.reserve(kept+added);
+        entries_.reserve(kept+added);
+        for (typename std::vector<std::pair<INDEX, size_type> >::iterator it(sorted.begin()), itend(sorted.end());
+                it != itend; ++it)
+        {
+            if (it->second == none)
+            {
+                it->second = indices_.size();
+                add_index(it->first);
+            }
+            else
+                it->second = new_row[it->second];
+        }
+        sorted_.swap(sorted);
+        increment_.clear();
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    void
+    CDD1Workspace<PROBLEM,INDEX>::set_increment(const InfiniteVector<double, INDEX>& r)
+    {
+        // r and the sorted array are traversed simultaneously
+        increment_.clear();
+        typename std::vector<std::pair<INDEX, size_type> >::const_iterator it2(sorted_.begin()), itend2(sorted_.end());
+        for (typename InfiniteVector<double, INDEX>::const_iterator it(r.begin()), itend(r.end());
+                it != itend; ++it)
+        {
+            while (it2 != itend2 && it2->first < it.index())
+                ++it2;
+            if (it2 == itend2 || it.index() < it2->first)
+                increment_.push_back(it.index());
+        }
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    void
+    CDD1Workspace<PROBLEM,INDEX>::extend_index_set()
+    {
+        const size_type n = sorted_.size();
+        indices_.reserve(n+increment_.size());
+        columns_.reserve(n+increment_.size());
+        entries_.reserve(n+increment_.size());
+        sorted_.reserve(n+increment_.size());
+        for (typename std::vector<INDEX>::const_iterator it(increment_.begin()), itend(increment_.end());
+                it != itend; ++it)
+        {
+            sorted_.push_back(std::make_pair(*it, indices_.size()));
+            add_index(*it);
+        }
+        std::inplace_merge(sorted_.begin(), sorted_.begin()+n, sorted_.end());
+        increment_.clear();
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    const InfiniteVector<double, INDEX>&
+    CDD1Workspace<PROBLEM,INDEX>::coarse_rhs(const InfiniteVector<double, INDEX>& F,
+                                             const double eta)
+    {
+        if (F_coarse_eta_ != eta)
+        {
+            F.COARSE(eta, F_coarse_);
+            F_coarse_eta_ = eta;
+        }
+        return F_coarse_;
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    void
+    CDD1Workspace<PROBLEM,INDEX>::add_index(const INDEX& lambda)
+    {
+        const size_type row = indices_.size();
+        const double d1 = P_->D(lambda);
+        indices_.push_back(lambda);
+        D_.push_back(d1);
+        F_.push_back(F_coeffs_ ? F_coeffs_->get_coefficient(lambda) : CDD1_rhs_entry(*P_, lambda));
+        columns_.push_back(std::vector<size_type>());
+        entries_.push_back(std::vector<double>());
+        diagonal_.push_back(0.0);
+        for (size_type column = 0; column <= row; column++)
+        {
+            const double entry = P_->a(indices_[column], lambda);
+            if (fabs(entry) > 1e-15)
+            {
+                const double value = entry / (d1 * D_[column]);
+                columns_[row].push_back(column);
+                entries_[row].push_back(value);
+                if (column < row)
+                {
+                    columns_[column].push_back(row);
+                    entries_[column].push_back(value);
+                }
+                else
+                    diagonal_[row] = value;
+            }
+        }
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    const double
+    CDD1Workspace<PROBLEM,INDEX>::get_entry(const size_type row, const size_type column) const
+    {
+        if (row == column)
+            return diagonal_[row];
+        for (size_type n = 0; n < columns_[row].size(); n++)
+            if (columns_[row][n] == column)
+                return entries_[row][n];
+        return 0.0;
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    void
+    CDD1Workspace<PROBLEM,INDEX>::apply(const Vector<double>& x, Vector<double>& Mx) const
+    {
+        assert(Mx.size() == indices_.size());
+        for (size_type row = 0; row < indices_.size(); row++)
+        {
+            double help(0);
+            const std::vector<size_type>& columns(columns_[row]);
+            const std::vector<double>& entries(entries_[row]);
+            for (size_type n = 0; n < columns.size(); n++)
+                help += entries[n] * x[columns[n]];
+            Mx[row] = help;
+        }
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    unsigned int
+    CDD1Workspace<PROBLEM,INDEX>::solve(const InfiniteVector<double, INDEX>& v,
+                                        InfiniteVector<double, INDEX>& u,
+                                        const double tol,
+                                        const unsigned int maxiter)
+    {
+        const size_type n = indices_.size();
+        Vector<double> b(n, false), xk(n);
+        for (size_type row = 0; row < n; row++)
+            b[row] = F_[row];
+
+        // initial approximation, v and the sorted array are traversed simultaneously
+        typename std::vector<std::pair<INDEX, size_type> >::const_iterator it2(sorted_.begin()), itend2(sorted_.end());
+        for (typename InfiniteVector<double, INDEX>::const_iterator it(v.begin()), itend(v.end());
+                it != itend && it2 != itend2; ++it)
+        {
+            while (it2 != itend2 && it2->first < it.index())
+                ++it2;
+            if (it2 != itend2 && !(it.index() < it2->first))
+                xk[it2->second] = *it;
+        }
+
+        unsigned int iterations = 0;
+        MathTL::JacobiPreconditioner<CDD1Workspace<PROBLEM,INDEX>, Vector<double> > J(*this);
+        PCG(*this, b, J, xk, tol, maxiter, iterations);
+
+        u.clear();
+        for (it2 = sorted_.begin(); it2 != itend2; ++it2)
+            u.push_back(it2->first, xk[it2->second]);
+        return iterations;
+    }
+
 
     template <class PROBLEM, typename INDEX>
     void CDD1_SOLVE(PROBLEM& P, const double epsilon,
@@ -90,39 +424,15 @@ namespace WaveletTL
             bool coarsening,
             const CompressionStrategy strategy)
     {
-        // INIT, cf. [BB+] 
         CDD1Parameters params;
-        params.c1 = c1;
-        params.c2 = c2;
-        params.kappa = params.c2/params.c1;
-        params.gamma = 0.8;
-        params.F = P.F_norm();
-        // determination of q=q1=q2=q3,q4 according to [CDD1, (7.23)ff]
-        params.q4 = 1. / (20. * params.kappa);
-        const double A = params.c1 / (20. * (3. + params.c1 / params.c2));
-        const double B = params.c2 * (0.1 - params.q4 * sqrt(params.kappa));
-        const double C = params.q4 / (1 / params.c2 + 6. * (params.gamma + 1.) / (params.gamma * params.c1));
-        params.q1 = params.q2 = params.q3 = std::min(A, std::min(B, C));
-        params.q0 = sqrt(params.kappa) + params.q3/params.c2;
-        params.theta = sqrt(1 - params.c1 * params.gamma * params.gamma / (4. * params.c2));
-        params.theta_bar = 1 - 1. / (6. * params.kappa);
-        params.K = (unsigned int) floor(log(20 * params.kappa) / fabs(log(params.theta))) + 1;
-#if _WAVELETTL_CDD1_VERBOSITY >= 1
-        cout << "CDD1_SOLVE parameters:" << endl;
-        cout << "c1=" << params.c1 << ", c2=" << params.c2 << ", kappa=" << params.kappa << endl;
-        cout << "gamma=" << params.gamma << endl;
-        cout << "F=" << params.F << endl;
-        cout << "q0=" << params.q0 << ", q1=" << params.q1 << ", q2=" << params.q2
-                << ", q3=" << params.q3 << ", q4=" << params.q4 << endl;
-        cout << "theta=" << params.theta << ", theta_bar=" << params.theta_bar << endl;
-        cout << "K=" << params.K << endl;
-#endif
+        CDD1_INIT(c1, c2, P.F_norm(), params);
         set<INDEX> Lambda, Lambda_hat;
         u_epsilon = guess;
         u_epsilon.support(Lambda);
         double delta = params.F;
         InfiniteVector<double,INDEX> v_hat, r_hat, u_bar, F;
         P.RHS(2*params.q2*epsilon, F);
+        CDD1Workspace<PROBLEM,INDEX> workspace(P);
 
         logger.startClock();
 
@@ -131,7 +441,7 @@ namespace WaveletTL
 #if _WAVELETTL_CDD1_VERBOSITY >= 1
             cout << "CDD1_SOLVE: delta=" << delta << endl;
 #endif
-            NPROG(P, params, F, Lambda, u_epsilon, delta, v_hat, Lambda_hat, r_hat, u_bar, logger, jmax, coarsening, strategy);
+            NPROG(P, params, F, Lambda, u_epsilon, delta, v_hat, Lambda_hat, r_hat, u_bar, workspace, logger, jmax, coarsening, strategy);
 
             double res_norm = l2_norm(r_hat);
             logger.logConvergenceData(u_bar.size(), res_norm);
@@ -157,6 +467,102 @@ namespace WaveletTL
     }
 
 
+    template <class PROBLEM>
+    void CDD1_SOLVE(PROBLEM& P, const double epsilon,
+            const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+            std::vector<InfiniteVector<double, typename PROBLEM::Index> >& u_epsilon,
+            const int jmax,
+            bool coarsening,
+            const CompressionStrategy strategy)
+    {
+        // start with pessimistic parameters c1, c2
+        MathTL::DummyLogger logger;
+        CDD1_SOLVE(P, epsilon, F, u_epsilon,
+                1.0/P.norm_Ainv(), P.norm_A(),
+                logger, jmax, coarsening, strategy);
+    }
+
+
+    template <class PROBLEM>
+    void CDD1_SOLVE(PROBLEM& P, const double epsilon,
+            const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+            std::vector<InfiniteVector<double, typename PROBLEM::Index> >& u_epsilon,
+            const double c1,
+            const double c2,
+            AbstractConvergenceLogger& logger,
+            const int jmax,
+            bool coarsening,
+            const CompressionStrategy strategy)
+    {
+        typedef typename PROBLEM::Index Index;
+
+        const unsigned int nrhs = F.size();
+        double F_norm = 0;
+        for (unsigned int i = 0; i < nrhs; i++)
+            F_norm = std::max(F_norm, l2_norm(F[i]));
+        CDD1Parameters params;
+        CDD1_INIT(c1, c2, F_norm, params);
+
+        std::vector<set<Index> > Lambda(nrhs), Lambda_hat(nrhs);
+        std::vector<InfiniteVector<double,Index> > v_hat(nrhs), r_hat(nrhs), u_bar(nrhs), Fk(nrhs);
+        std::vector<CDD1Workspace<PROBLEM,Index> > workspace;
+        workspace.reserve(nrhs);
+        std::vector<DenseAccumulator<double> > ww; // reused by the blocked APPLY calls
+        std::vector<unsigned int> rhs, unsolved; // the right-hand sides which are not solved yet
+        u_epsilon.resize(nrhs);
+        for (unsigned int i = 0; i < nrhs; i++)
+        {
+            u_epsilon[i].clear();
+            F[i].COARSE(2*params.q2*epsilon, Fk[i]);
+            workspace.push_back(CDD1Workspace<PROBLEM,Index>(P, F[i]));
+            rhs.push_back(i);
+        }
+        double delta = params.F;
+
+        logger.startClock();
+
+        while (delta > epsilon && !rhs.empty()) {
+            logger.checkAbortConditions();
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+            cout << "CDD1_SOLVE: delta=" << delta << ", " << rhs.size() << " right-hand sides" << endl;
+#endif
+            NPROG(P, params, Fk, Lambda, u_epsilon, delta, v_hat, Lambda_hat, r_hat, u_bar, workspace, ww, rhs, logger, jmax, coarsening, strategy);
+
+            double res_norm_max = 0;
+            unsigned int size = 0;
+            unsolved.clear();
+            for (unsigned int m = 0; m < rhs.size(); m++)
+            {
+                const unsigned int i = rhs[m];
+                const double res_norm = l2_norm(r_hat[i]);
+                res_norm_max = std::max(res_norm_max, res_norm);
+                size += u_bar[i].size();
+                if (res_norm + (params.q1+params.q2+(1+1./params.kappa)*params.q3)*delta <= params.c1*epsilon)
+                {
+                    u_epsilon[i].swap(u_bar[i]);
+                    workspace[i] = CDD1Workspace<PROBLEM,Index>(P, F[i]); // release the Galerkin system
+                }
+                else
+                {
+                    u_epsilon[i].swap(v_hat[i]);
+                    Lambda[i].swap(Lambda_hat[i]);
+                    unsolved.push_back(i);
+                }
+            }
+            logger.logConvergenceData(size, res_norm_max);
+            rhs.swap(unsolved);
+
+            if (coarsening)
+              delta *= 0.5; // original
+            else
+              delta *= 0.1; // tuned
+        }
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+        cout << "CDD1_SOLVE: done!" << endl;
+#endif
+    }
+
+
     template <class PROBLEM>
     void CDD1_SOLVE_LOGGED(std::ofstream& logstream,
             PROBLEM& P, const double epsilon,
@@ -181,33 +587,8 @@ namespace WaveletTL
             const int jmax,
             const CompressionStrategy strategy)
     {
-        // INIT, cf. [BB+] 
         CDD1Parameters params;
-        params.c1 = c1;
-        params.c2 = c2;
-        params.kappa = params.c2/params.c1;
-        params.gamma = 0.8;
-        params.F = P.F_norm();
-        // determination of q=q1=q2=q3,q4 according to [CDD1, (7.23)ff]
-        params.q4 = 1. / (20. * params.kappa);
-        const double A = params.c1 / (20. * (3. + params.c1 / params.c2));
-        const double B = params.c2 * (0.1 - params.q4 * sqrt(params.kappa));
-        const double C = params.q4 / (1 / params.c2 + 6. * (params.gamma + 1.) / (params.gamma * params.c1));
-        params.q1 = params.q2 = params.q3 = std::min(A, std::min(B, C));
-        params.q0 = sqrt(params.kappa) + params.q3/params.c2;
-        params.theta = sqrt(1 - params.c1 * params.gamma * params.gamma / (4. * params.c2));
-        params.theta_bar = 1 - 1. / (6. * params.kappa);
-        params.K = (unsigned int) floor(log(20 * params.kappa) / fabs(log(params.theta))) + 1;
-#if _WAVELETTL_CDD1_VERBOSITY >= 1
-        cout << "CDD1_SOLVE parameters:" << endl;
-        cout << "c1=" << params.c1 << ", c2=" << params.c2 << ", kappa=" << params.kappa << endl;
-        cout << "gamma=" << params.gamma << endl;
-        cout << "F=" << params.F << endl;
-        cout << "q0=" << params.q0 << ", q1=" << params.q1 << ", q2=" << params.q2
-                << ", q3=" << params.q3 << ", q4=" << params.q4 << endl;
-        cout << "theta=" << params.theta << ", theta_bar=" << params.theta_bar << endl;
-        cout << "K=" << params.K << endl;
-#endif
+        CDD1_INIT(c1, c2, P.F_norm(), params);
 //        typedef typename PROBLEM::WaveletBasis::Index Index;
         set<int> Lambda, Lambda_hat;
         u_epsilon = guess;
@@ -220,12 +601,13 @@ namespace WaveletTL
         InfiniteVector<double,int> Dr_hat;
         
         MathTL::DummyLogger logger;
+        CDD1Workspace<PROBLEM,int> workspace(P);
         
         while (delta > epsilon) { // sqrt(params.c1)*epsilon) { // check the additional factor c1^{1/2} in [BB+] !?
 #if _WAVELETTL_CDD1_VERBOSITY >= 1
             cout << "CDD1_SOLVE: delta=" << delta << endl;
 #endif
-            NPROG(P, params, F, Lambda, u_epsilon, delta, v_hat, Lambda_hat, r_hat, u_bar, logger, jmax, false, strategy);
+            NPROG(P, params, F, Lambda, u_epsilon, delta, v_hat, Lambda_hat, r_hat, u_bar, workspace, logger, jmax, false, strategy);
             res = l2_norm(r_hat);
             Dr_hat = r_hat;
             Dr_hat.scale(&P,1);
@@ -268,17 +650,41 @@ namespace WaveletTL
             bool coarsening,
             const CompressionStrategy strategy)
     {
-        set<INDEX> Lambda_k(Lambda), Lambda_kplus1;
+        CDD1Workspace<PROBLEM,INDEX> workspace(P);
+        NPROG(P, params, F, Lambda, v, delta, v_hat, Lambda_hat, r_hat, u_Lambda_k, workspace, logger, jmax, coarsening, strategy);
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    void NPROG(PROBLEM& P, const CDD1Parameters& params,
+            const InfiniteVector<double, INDEX>& F,
+            const set<INDEX>& Lambda,
+            const InfiniteVector<double, INDEX>& v,
+            const double delta,
+            InfiniteVector<double, INDEX>& v_hat,
+            set<INDEX>& Lambda_hat,
+            InfiniteVector<double, INDEX>& r_hat,
+            InfiniteVector<double, INDEX>& u_Lambda_k,
+            CDD1Workspace<PROBLEM, INDEX>& workspace,
+            AbstractConvergenceLogger& logger,
+            const int jmax,
+            bool coarsening,
+            const CompressionStrategy strategy)
+    {
+        // the index sets Lambda_k are only kept in the workspace,
+        // the coarsened right-hand side is the same for all NGROW calls
+        workspace.set_index_set(Lambda);
+        workspace.reset_residual_buffers();
         unsigned int k = 0;
-        GALERKIN(P, params, F, Lambda_k, v, delta, params.q3*delta/params.c2, u_Lambda_k, jmax, strategy);
+        GALERKIN(P, params, F, v, delta, params.q3*delta/params.c2, u_Lambda_k, workspace, jmax, strategy);
         while (true) 
         {
             logger.checkAbortConditions();
 #if _WAVELETTL_CDD1_VERBOSITY >= 1
             cout << "NPROG: k=" << k << " (K=" << params.K << ")" << endl;
 #endif
-            NGROW(P, params, F, Lambda_k, u_Lambda_k, params.q1*delta, params.q2*delta, Lambda_kplus1, r_hat, jmax, strategy);
-            if (l2_norm(r_hat) <= params.c1*delta/20. || k == params.K || Lambda_k.size() == Lambda_kplus1.size()) {
+            NGROW(P, params, F, u_Lambda_k, params.q1*delta, params.q2*delta, r_hat, workspace, jmax, strategy);
+            if (l2_norm(r_hat) <= params.c1*delta/20. || k == params.K || workspace.increment().empty()) {
               if (coarsening)
                 u_Lambda_k.COARSE(2.*delta/5., v_hat);
               else
@@ -286,12 +692,12 @@ namespace WaveletTL
               v_hat.support(Lambda_hat);
               break;
             }
-            GALERKIN(P, params, F, Lambda_kplus1, u_Lambda_k, params.q0*delta, params.q3*delta/params.c2, v_hat, jmax, strategy);
+            workspace.extend_index_set();
+            GALERKIN(P, params, F, u_Lambda_k, params.q0*delta, params.q3*delta/params.c2, v_hat, workspace, jmax, strategy);
             u_Lambda_k.swap(v_hat);
 #if _WAVELETTL_CDD1_VERBOSITY >= 2
             cout << "u_Lambda_k = " << endl << u_Lambda_k << endl;
 #endif
-            Lambda_k.swap(Lambda_kplus1);
             k++;
         }
 #if _WAVELETTL_CDD1_VERBOSITY >= 1
@@ -300,6 +706,89 @@ namespace WaveletTL
     }
     
     
+    template <class PROBLEM>
+    void NPROG(PROBLEM& P, const CDD1Parameters& params,
+            const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+            const std::vector<set<typename PROBLEM::Index> >& Lambda,
+            const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+            const double delta,
+            std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v_hat,
+            std::vector<set<typename PROBLEM::Index> >& Lambda_hat,
+            std::vector<InfiniteVector<double, typename PROBLEM::Index> >& r_hat,
+            std::vector<InfiniteVector<double, typename PROBLEM::Index> >& u_Lambda_k,
+            std::vector<CDD1Workspace<PROBLEM, typename PROBLEM::Index> >& workspace,
+            std::vector<DenseAccumulator<double> >& ww,
+            const std::vector<unsigned int>& rhs,
+            AbstractConvergenceLogger& logger,
+            const int jmax,
+            bool coarsening,
+            const CompressionStrategy strategy)
+    {
+        std::vector<set<typename PROBLEM::Index> > Lambda_k(Lambda.size()), Lambda_kplus1(Lambda.size());
+        for (unsigned int m = 0; m < rhs.size(); m++)
+        {
+            const unsigned int i = rhs[m];
+            Lambda_k[i] = Lambda[i];
+            GALERKIN(P, params, F[i], Lambda_k[i], v[i], delta, params.q3*delta/params.c2, u_Lambda_k[i], workspace[i], jmax, strategy);
+        }
+        // the right-hand sides for which the loop is not finished
+        std::vector<unsigned int> open(rhs), still_open;
+        unsigned int k = 0;
+        while (true) 
+        {
+            logger.checkAbortConditions();
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+            cout << "NPROG: k=" << k << " (K=" << params.K << "), " << open.size() << " right-hand sides" << endl;
+#endif
+            NGROW(P, params, F, Lambda_k, u_Lambda_k, params.q1*delta, params.q2*delta, Lambda_kplus1, r_hat, open, ww, jmax, strategy);
+            still_open.clear();
+            for (unsigned int m = 0; m < open.size(); m++)
+            {
+                const unsigned int i = open[m];
+                if (l2_norm(r_hat[i]) <= params.c1*delta/20. || k == params.K || Lambda_k[i].size() == Lambda_kplus1[i].size()) {
+                    if (coarsening)
+                        u_Lambda_k[i].COARSE(2.*delta/5., v_hat[i]);
+                    else
+                        v_hat[i] = u_Lambda_k[i];
+                    v_hat[i].support(Lambda_hat[i]);
+                }
+                else
+                    still_open.push_back(i);
+            }
+            if (still_open.empty())
+                break;
+            for (unsigned int m = 0; m < still_open.size(); m++)
+            {
+                const unsigned int i = still_open[m];
+                GALERKIN(P, params, F[i], Lambda_kplus1[i], u_Lambda_k[i], params.q0*delta, params.q3*delta/params.c2, v_hat[i], workspace[i], jmax, strategy);
+                u_Lambda_k[i].swap(v_hat[i]);
+                Lambda_k[i].swap(Lambda_kplus1[i]);
+            }
+            open.swap(still_open);
+            k++;
+        }
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+        cout << "NPROG: done" << endl;
+#endif
+    }
+    
+    
+    template <class PROBLEM, typename INDEX>
+    void GALERKIN(PROBLEM& P, const CDD1Parameters& params,
+            const InfiniteVector<double, INDEX>& F,
+            const set<INDEX>& Lambda,
+            const InfiniteVector<double, INDEX>& v,
+            const double delta,
+            const double eta,
+            InfiniteVector<double, INDEX>& u_bar,
+            const int jmax,
+            const CompressionStrategy strategy)
+    {
+        CDD1Workspace<PROBLEM,INDEX> workspace(P);
+        GALERKIN(P, params, F, Lambda, v, delta, eta, u_bar, workspace, jmax, strategy);
+    }
+
+
     template <class PROBLEM, typename INDEX>
     void GALERKIN(PROBLEM& P, const CDD1Parameters& params,
             const InfiniteVector<double, INDEX>& F,
@@ -308,6 +797,7 @@ namespace WaveletTL
             const double delta,
             const double eta,
             InfiniteVector<double, INDEX>& u_bar,
+            CDD1Workspace<PROBLEM, INDEX>& workspace,
             const int jmax,
             const CompressionStrategy strategy)
     {
@@ -335,9 +825,6 @@ namespace WaveletTL
         }
 #else
         // conjugate gradient version (no theory for its complexity available yet, but very fast)
-#if _WAVELETTL_CDD1_VERBOSITY >= 1
-        cout << "GALERKIN called..." << endl;
-#endif
 #if _WAVELETTL_CDD1_VERBOSITY >= 2
         cout << "... with Lambda=" << endl;
         for (typename set<INDEX>::const_iterator it = Lambda.begin(), itend = Lambda.end();
@@ -346,36 +833,39 @@ namespace WaveletTL
             cout << *it << endl;
         }
 #endif
-        u_bar.clear();
-        if (Lambda.size() > 0) 
-        {
-            // setup A_Lambda and f_Lambda
-            SparseMatrix<double> A_Lambda;
-            setup_stiffness_matrix(P, Lambda, A_Lambda);
-#if _WAVELETTL_CDD1_VERBOSITY >= 2
-            cout << "... GALERKIN: A_Lambda=" << endl << A_Lambda;
+        // extend (or coarsen) A_Lambda and F_Lambda from the previous index set
+        workspace.set_index_set(Lambda);
+        GALERKIN(P, params, F, v, delta, eta, u_bar, workspace, jmax, strategy);
 #endif
-            Vector<double> F_Lambda;
-            setup_righthand_side(P, Lambda, F_Lambda);
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    void GALERKIN(PROBLEM& P, const CDD1Parameters& params,
+            const InfiniteVector<double, INDEX>& F,
+            const InfiniteVector<double, INDEX>& v,
+            const double delta,
+            const double eta,
+            InfiniteVector<double, INDEX>& u_bar,
+            CDD1Workspace<PROBLEM, INDEX>& workspace,
+            const int jmax,
+            const CompressionStrategy strategy)
+    {
 #if _WAVELETTL_CDD1_VERBOSITY >= 1
-            cout << "... GALERKIN: stiffness matrix and right-hand side set up, iterating ..." << endl;
+        cout << "GALERKIN called, " << workspace.row_dimension() << " active indices..." << endl;
 #endif
-            // setup initial approximation xk
-            Vector<double> xk(Lambda.size());
-            unsigned int id = 0;
-            for (typename set<INDEX>::const_iterator it = Lambda.begin(), itend = Lambda.end();
-                    it != itend; ++it, ++id)
-                xk[id] = v.get_coefficient(*it);
-            unsigned int iterations = 0;
-            //       CG(A_Lambda, F_Lambda, xk, eta, 150, iterations);
-            CG(A_Lambda, F_Lambda, xk, 1e-15, 250, iterations);
+        u_bar.clear();
+        if (workspace.row_dimension() > 0) 
+        {
 #if _WAVELETTL_CDD1_VERBOSITY >= 1
+            cout << "... GALERKIN: stiffness matrix and right-hand side set up, iterating ..." << endl;
+            //       const unsigned int iterations = workspace.solve(v, u_bar, eta, 150);
+            const unsigned int iterations = workspace.solve(v, u_bar, 1e-15, 250);
             cout << "... GALERKIN done, " << iterations << " CG iterations needed" << endl;
+#else
+            //       workspace.solve(v, u_bar, eta, 150);
+            workspace.solve(v, u_bar, 1e-15, 250);
 #endif
-            id = 0;
-            for (typename set<INDEX>::const_iterator it = Lambda.begin(), itend = Lambda.end();
-                    it != itend; ++it, ++id)
-                u_bar.set_coefficient(*it, xk[id]);
         } 
         else 
         {
@@ -383,27 +873,18 @@ namespace WaveletTL
             cout << "... GALERKIN done, no CG iteration needed" << endl;
 #endif
         }
-#endif
     }
     
 
-    template <class PROBLEM, typename INDEX>
-    void NGROW(PROBLEM& P, const CDD1Parameters& params,
-            const InfiniteVector<double, INDEX>& F,
-            const set<INDEX>& Lambda,
-            const InfiniteVector<double, INDEX>& u_bar,
+    /*
+      norm of the approximate residual r in NGROW, aborts if it is too large
+    */
+    template <typename INDEX>
+    double NGROW_residual_norm(const InfiniteVector<double, INDEX>& u_bar,
             const double xi1,
             const double xi2,
-            set<INDEX>& Lambda_tilde,
-            InfiniteVector<double, INDEX>& r,
-            const int jmax,
-            const CompressionStrategy strategy)
+            const InfiniteVector<double, INDEX>& r)
     {
-#if _WAVELETTL_CDD1_VERBOSITY >= 1
-        cout << "NGROW called..." << endl;
-#endif
-        set<INDEX> Lambda_c;
-        NRESIDUAL(P, params, F, Lambda, u_bar, xi1, xi2, r, Lambda_c, jmax, strategy);
         const double residual_norm = l2_norm(r);
 #if _WAVELETTL_CDD1_VERBOSITY >= 2
         cout << "* NGROW: current residual is " << endl << r << endl;
@@ -425,6 +906,25 @@ namespace WaveletTL
             abort();
 #endif
         }
+        return residual_norm;
+    }
+
+
+    /*
+      second part of NGROW: given the approximate residual r and its support Lambda_c,
+      compute the new index set Lambda_tilde (Lambda_c is overwritten)
+    */
+    template <typename INDEX>
+    void NGROW_expand(const CDD1Parameters& params,
+            const set<INDEX>& Lambda,
+            const InfiniteVector<double, INDEX>& u_bar,
+            const double xi1,
+            const double xi2,
+            const InfiniteVector<double, INDEX>& r,
+            set<INDEX>& Lambda_c,
+            set<INDEX>& Lambda_tilde)
+    {
+        const double residual_norm = NGROW_residual_norm(u_bar, xi1, xi2, r);
         InfiniteVector<double,INDEX> pr;
         r.COARSE(sqrt(1-params.gamma*params.gamma)*residual_norm, pr);
         pr.support(Lambda_c);
@@ -453,6 +953,79 @@ namespace WaveletTL
 #endif
     }
 
+
+    template <class PROBLEM, typename INDEX>
+    void NGROW(PROBLEM& P, const CDD1Parameters& params,
+            const InfiniteVector<double, INDEX>& F,
+            const set<INDEX>& Lambda,
+            const InfiniteVector<double, INDEX>& u_bar,
+            const double xi1,
+            const double xi2,
+            set<INDEX>& Lambda_tilde,
+            InfiniteVector<double, INDEX>& r,
+            const int jmax,
+            const CompressionStrategy strategy)
+    {
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+        cout << "NGROW called..." << endl;
+#endif
+        set<INDEX> Lambda_c;
+        NRESIDUAL(P, params, F, Lambda, u_bar, xi1, xi2, r, Lambda_c, jmax, strategy);
+        NGROW_expand(params, Lambda, u_bar, xi1, xi2, r, Lambda_c, Lambda_tilde);
+    }
+
+
+    template <class PROBLEM, typename INDEX>
+    void NGROW(PROBLEM& P, const CDD1Parameters& params,
+            const InfiniteVector<double, INDEX>& F,
+            const InfiniteVector<double, INDEX>& u_bar,
+            const double xi1,
+            const double xi2,
+            InfiniteVector<double, INDEX>& r,
+            CDD1Workspace<PROBLEM, INDEX>& workspace,
+            const int jmax,
+            const CompressionStrategy strategy)
+    {
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+        cout << "NGROW called..." << endl;
+#endif
+        // approximate residual, cf. NRESIDUAL
+        CDD1_residual_apply(P, u_bar, xi1, workspace.Av, jmax, strategy);
+        r = workspace.coarse_rhs(F, xi2);
+        r -= workspace.Av;
+        const double residual_norm = NGROW_residual_norm(u_bar, xi1, xi2, r);
+        r.COARSE(sqrt(1-params.gamma*params.gamma)*residual_norm, workspace.r_coarse);
+        workspace.set_increment(workspace.r_coarse);
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+        cout << "... NGROW done, size of old index set: " << workspace.row_dimension()
+             << ", number of new indices: " << workspace.increment().size() << endl;
+#endif
+    }
+
+
+    template <class PROBLEM>
+    void NGROW(PROBLEM& P, const CDD1Parameters& params,
+            const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+            const std::vector<set<typename PROBLEM::Index> >& Lambda,
+            const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& u_bar,
+            const double xi1,
+            const double xi2,
+            std::vector<set<typename PROBLEM::Index> >& Lambda_tilde,
+            std::vector<InfiniteVector<double, typename PROBLEM::Index> >& r,
+            const std::vector<unsigned int>& rhs,
+            std::vector<DenseAccumulator<double> >& ww,
+            const int jmax,
+            const CompressionStrategy strategy)
+    {
+#if _WAVELETTL_CDD1_VERBOSITY >= 1
+        cout << "NGROW called for " << rhs.size() << " right-hand sides..." << endl;
+#endif
+        std::vector<set<typename PROBLEM::Index> > Lambda_c(Lambda.size());
+        NRESIDUAL(P, params, F, Lambda, u_bar, xi1, xi2, r, Lambda_c, rhs, ww, jmax, strategy);
+        for (unsigned int m = 0; m < rhs.size(); m++)
+            NGROW_expand(params, Lambda[rhs[m]], u_bar[rhs[m]], xi1, xi2, r[rhs[m]], Lambda_c[rhs[m]], Lambda_tilde[rhs[m]]);
+    }
+
     
     template <class PROBLEM, typename INDEX>
     void INRESIDUAL(PROBLEM& P, const CDD1Parameters& params,
@@ -493,12 +1066,7 @@ namespace WaveletTL
     {
         typedef typename PROBLEM::WaveletBasis::Index Index;
         InfiniteVector<double,Index> w;
-#if _WAVELETTL_USE_TBASIS == 1
-//        APPLY_TENSOR(P,v,eta1,w,jmax,strategy);
-       APPLY(P, v, eta1, w, jmax, tensor_simple); 
-#else
-        APPLY(P, v, eta1, w, jmax, strategy);
-#endif
+        CDD1_residual_apply(P, v, eta1, w, jmax, strategy);
         F.COARSE(eta2, r);
 #if _WAVELETTL_CDD1_VERBOSITY >= 2
         cout << "NRESIDUAL: v = "<<endl << v << endl<<"NRESIDUAL: w = "<< endl << w << endl<<"NRESIDUAL: F.coarse("<<eta2<<")= "<<endl <<r<<endl;
@@ -527,11 +1095,7 @@ namespace WaveletTL
             const CompressionStrategy strategy)
     {
         InfiniteVector<double, int> w;
-#if _WAVELETTL_USE_TBASIS == 1
-        APPLY_TENSOR(P,v,eta1,w,jmax,strategy, true);
-#else
-        APPLY(P, v, eta1, w, jmax, strategy);
-#endif
+        CDD1_residual_apply(P, v, eta1, w, jmax, strategy);
         F.COARSE(eta2, r);
 #if _WAVELETTL_CDD1_VERBOSITY >= 2
         cout << "NRESIDUAL: v = "<<endl << v << endl<<"NRESIDUAL: w = "<< endl << w << endl<<"NRESIDUAL: F.coarse("<<eta2<<")= "<<endl <<r<<endl;
@@ -546,4 +1110,34 @@ namespace WaveletTL
             cout << *it << endl;
 #endif
     }
+    template <class PROBLEM>
+    void NRESIDUAL(PROBLEM& P, const CDD1Parameters& params,
+            const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+            const std::vector<set<typename PROBLEM::Index> >& Lambda,
+            const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+            const double eta1,
+            const double eta2,
+            std::vector<InfiniteVector<double, typename PROBLEM::Index> >& r,
+            std::vector<set<typename PROBLEM::Index> >& Lambda_tilde,
+            const std::vector<unsigned int>& rhs,
+            std::vector<DenseAccumulator<double> >& ww,
+            const int jmax,
+            const CompressionStrategy strategy)
+    {
+        std::vector<InfiniteVector<double, typename PROBLEM::Index> > v_rhs(rhs.size()), w;
+        for (unsigned int m = 0; m < rhs.size(); m++)
+            v_rhs[m] = v[rhs[m]];
+#if _WAVELETTL_USE_TBASIS == 1
+        APPLY(P, v_rhs, std::vector<double>(rhs.size(), eta1), w, ww, jmax, tensor_simple);
+#else
+        APPLY(P, v_rhs, std::vector<double>(rhs.size(), eta1), w, ww, jmax, strategy);
+#endif
+        for (unsigned int m = 0; m < rhs.size(); m++)
+        {
+            const unsigned int i = rhs[m];
+            F[i].COARSE(eta2, r[i]);
+            r[i] -= w[m];
+            r[i].support(Lambda_tilde[i]);
+        }
+    }
 }
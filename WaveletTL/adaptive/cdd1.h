@@ -15,10 +15,12 @@
 #include <adaptive/compression.h>
 #include <cmath>
 #include <set>
+#include <vector>
 #include <algorithm>
 
 #include <algebra/sparse_matrix.h>
 #include <algebra/vector.h>
+#include <numerics/preconditioner.h>
 #include <numerics/iteratsolv.h>
 #if _WAVELETTL_USE_TBASIS == 1
 #include <adaptive/apply_tensor.h>
@@ -200,6 +202,48 @@ namespace WaveletTL
                            const CompressionStrategy strategy = St04a);
 #endif
 
+
+    /*!
+      the routine ALGORITHMc from [BB+] for k right-hand sides F[0],...,F[k-1] of
+      the same equation at once (e.g., several load cases), given by their
+      coefficient vectors (cf. P.RHS()).
+      The iterations for the right-hand sides are run simultaneously, each one with
+      its own index sets and Galerkin systems, until the stopping criterion holds for
+      u_epsilon[i]. The residuals are computed with the blocked version of APPLY,
+      so that each column of the stiffness matrix is needed only once per sweep.
+     */
+    template <class PROBLEM>
+    void CDD1_SOLVE(PROBLEM& P, const double epsilon,
+                    const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+                    std::vector<InfiniteVector<double, typename PROBLEM::Index> >& u_epsilon,
+                    const int jmax = 99,
+                    bool coarsening = false,
+#if _WAVELETTL_USE_TBASIS == 1
+                    const CompressionStrategy strategy = tensor_simple);
+#else
+                    const CompressionStrategy strategy = St04a);
+#endif
+
+
+    /*!
+      ALGORITHMc for k right-hand sides at once with convergence logger and
+      with given parameters c1,c2
+     */
+    template <class PROBLEM>
+    void CDD1_SOLVE(PROBLEM& P, const double epsilon,
+                    const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+                    std::vector<InfiniteVector<double, typename PROBLEM::Index> >& u_epsilon,
+                    const double c1,
+                    const double c2,
+                    AbstractConvergenceLogger& logger,
+                    const int jmax = 99,
+                    bool coarsening = false,
+#if _WAVELETTL_USE_TBASIS == 1
+                    const CompressionStrategy strategy = tensor_simple);
+#else
+                    const CompressionStrategy strategy = St04a);
+#endif
+
                     
     /*!
       the parameters chosen or computed in the INIT phase of ALGORITHMc
@@ -214,6 +258,146 @@ namespace WaveletTL
       double theta, theta_bar;
     } CDD1Parameters;
 
+    /*!
+      the INIT phase of ALGORITHMc, given c1, c2 and (an estimate of) ||F||
+     */
+    inline void CDD1_INIT(const double c1, const double c2, const double F,
+                          CDD1Parameters& params);
+
+    /*!
+      Persistent data of ALGORITHMc for the Galerkin problems on the index sets
+      Lambda_k, which grow within NPROG and are coarsened only between the
+      calls of NPROG.
+
+      The active indices are kept in a sorted array, together with the row of
+      the Galerkin system in which they have been inserted. When the index set
+      changes, only the rows and columns of the new indices are computed and
+      the rows of removed indices are dropped, the remaining entries of the
+      (preconditioned) stiffness matrix A_Lambda and right-hand side F_Lambda
+      are reused. Since A is assumed to be s.p.d., each new entry is computed once.
+
+      Within NPROG, the index set is grown by the increments found by NGROW,
+      which are kept as sorted arrays of the indices that are not active yet.
+      The workspace also holds the buffers of the residual computations, in
+      particular the coarsened right-hand side F.COARSE(eta), which is the
+      same for all NGROW calls of one NPROG call.
+
+      The workspace provides the matrix interface needed by the iterative
+      solvers in MathTL (row_dimension(), apply(), get_entry()).
+    */
+    template <class PROBLEM, typename INDEX>
+    class CDD1Workspace
+    {
+    public:
+      //! size type (cf. STL containers)
+      typedef typename Vector<double>::size_type size_type;
+
+      //! constructor from the problem, the index set is empty
+      CDD1Workspace(PROBLEM& P);
+
+      /*!
+        constructor from the problem and the coefficients F of another
+        right-hand side (cf. P.RHS()), which are used instead of P.f()
+      */
+      CDD1Workspace(PROBLEM& P, const InfiniteVector<double, INDEX>& F);
+
+      //! number of active indices
+      const size_type row_dimension() const { return indices_.size(); }
+
+      //! number of active indices
+      const size_type column_dimension() const { return indices_.size(); }
+
+      /*!
+        change the active index set to Lambda,
+        only the entries belonging to new indices are computed
+      */
+      void set_index_set(const set<INDEX>& Lambda);
+
+      /*!
+        the new indices found by the last call of set_increment(),
+        in increasing order
+      */
+      const std::vector<INDEX>& increment() const { return increment_; }
+
+      /*!
+        set the increment to those indices of the support of r
+        which are not active yet
+      */
+      void set_increment(const InfiniteVector<double, INDEX>& r);
+
+      /*!
+        add the indices of the increment to the active index set,
+        only their rows and columns are computed
+      */
+      void extend_index_set();
+
+      /*!
+        the coarsened right-hand side F.COARSE(eta),
+        only recomputed if eta has changed since the last call
+        (F has to be the same until the next reset_residual_buffers())
+      */
+      const InfiniteVector<double, INDEX>& coarse_rhs(const InfiniteVector<double, INDEX>& F,
+                                                      const double eta);
+
+      //! forget the coarsened right-hand side
+      void reset_residual_buffers() { F_coarse_eta_ = -1; }
+
+      //! buffers for the residual computations, e.g. for the result of APPLY
+      InfiniteVector<double, INDEX> Av, r_coarse;
+
+      //! entry of A_Lambda (in the numbering of the rows)
+      const double get_entry(const size_type row, const size_type column) const;
+
+      //! Mx = A_Lambda x
+      void apply(const Vector<double>& x, Vector<double>& Mx) const;
+
+      /*!
+        solve A_Lambda x = F_Lambda with the Jacobi preconditioned CG method,
+        starting with the restriction of v to Lambda;
+        returns the number of iterations
+      */
+      unsigned int solve(const InfiniteVector<double, INDEX>& v,
+                         InfiniteVector<double, INDEX>& u,
+                         const double tol,
+                         const unsigned int maxiter);
+
+    protected:
+      //! the problem
+      PROBLEM* P_;
+
+      //! the coefficients of the right-hand side, if not given by P
+      const InfiniteVector<double, INDEX>* F_coeffs_;
+
+      //! the active indices, in the order of the rows
+      std::vector<INDEX> indices_;
+
+      //! the active indices in increasing order, with their rows
+      std::vector<std::pair<INDEX, size_type> > sorted_;
+
+      //! nontrivial columns and entries of A_Lambda in each row
+      std::vector<std::vector<size_type> > columns_;
+      std::vector<std::vector<double> > entries_;
+
+      //! diagonal of A_Lambda
+      std::vector<double> diagonal_;
+
+      //! preconditioning factors D(lambda)
+      std::vector<double> D_;
+
+      //! right-hand side F_Lambda
+      std::vector<double> F_;
+
+      //! the new indices of the last NGROW step
+      std::vector<INDEX> increment_;
+
+      //! F.COARSE(F_coarse_eta_), valid if F_coarse_eta_ >= 0
+      InfiniteVector<double, INDEX> F_coarse_;
+      double F_coarse_eta_;
+
+      //! append a row and a column for the index lambda
+      void add_index(const INDEX& lambda);
+    };
+
     /*!
       NPROG:
       Given an approximation v (the support of which is contained in Lambda)
@@ -237,6 +421,50 @@ namespace WaveletTL
                const int jmax = 99,
                bool coarsening = false,
                const CompressionStrategy strategy = St04a);
+
+    /*!
+      NPROG with a workspace that is reused over the calls of GALERKIN
+     */
+    template <class PROBLEM, typename INDEX>
+    void NPROG(PROBLEM& P, const CDD1Parameters& params,
+               const InfiniteVector<double, INDEX>& F,
+               const set<INDEX>& Lambda,
+               const InfiniteVector<double, INDEX>& v,
+               const double delta,
+               InfiniteVector<double, INDEX>& v_hat,
+               set<INDEX>& Lambda_hat,
+               InfiniteVector<double, INDEX>& r_hat,
+               InfiniteVector<double, INDEX>& u_Lambda_k,
+               CDD1Workspace<PROBLEM, INDEX>& workspace,
+               AbstractConvergenceLogger& logger,
+               const int jmax = 99,
+               bool coarsening = false,
+               const CompressionStrategy strategy = St04a);
+
+    /*!
+      NPROG for several right-hand sides at once, with the approximations
+      F[i], the index sets Lambda[i] and so on.
+      Only the right-hand sides with the numbers in rhs are processed,
+      the loop is stopped for each of them separately.
+      The dense accumulators ww are passed on to the blocked APPLY calls.
+     */
+    template <class PROBLEM>
+    void NPROG(PROBLEM& P, const CDD1Parameters& params,
+               const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+               const std::vector<set<typename PROBLEM::Index> >& Lambda,
+               const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+               const double delta,
+               std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v_hat,
+               std::vector<set<typename PROBLEM::Index> >& Lambda_hat,
+               std::vector<InfiniteVector<double, typename PROBLEM::Index> >& r_hat,
+               std::vector<InfiniteVector<double, typename PROBLEM::Index> >& u_Lambda_k,
+               std::vector<CDD1Workspace<PROBLEM, typename PROBLEM::Index> >& workspace,
+               std::vector<DenseAccumulator<double> >& ww,
+               const std::vector<unsigned int>& rhs,
+               AbstractConvergenceLogger& logger,
+               const int jmax = 99,
+               bool coarsening = false,
+               const CompressionStrategy strategy = St04a);
     
 
     /*!
@@ -256,6 +484,36 @@ namespace WaveletTL
                   InfiniteVector<double, INDEX>& ubar,
                   const int jmax = 99,
                   const CompressionStrategy strategy = St04a);
+
+    /*!
+      GALERKIN with a workspace, which holds the Galerkin system of the
+      previous index set
+    */
+    template <class PROBLEM, typename INDEX>
+    void GALERKIN(PROBLEM& P, const CDD1Parameters& params,
+                  const InfiniteVector<double, INDEX>& F,
+                  const set<INDEX>& Lambda,
+                  const InfiniteVector<double, INDEX>& v,
+                  const double delta,
+                  const double eta,
+                  InfiniteVector<double, INDEX>& ubar,
+                  CDD1Workspace<PROBLEM, INDEX>& workspace,
+                  const int jmax = 99,
+                  const CompressionStrategy strategy = St04a);
+
+    /*!
+      GALERKIN on the active index set of the workspace
+    */
+    template <class PROBLEM, typename INDEX>
+    void GALERKIN(PROBLEM& P, const CDD1Parameters& params,
+                  const InfiniteVector<double, INDEX>& F,
+                  const InfiniteVector<double, INDEX>& v,
+                  const double delta,
+                  const double eta,
+                  InfiniteVector<double, INDEX>& ubar,
+                  CDD1Workspace<PROBLEM, INDEX>& workspace,
+                  const int jmax = 99,
+                  const CompressionStrategy strategy = St04a);
     
     
     /*!
@@ -278,6 +536,41 @@ namespace WaveletTL
                const int jmax = 99,
                const CompressionStrategy strategy = St04a);
 
+    /*!
+      NGROW on the active index set Lambda of the workspace. The residual is
+      computed with the buffers of the workspace, and instead of Lambda_tilde,
+      the increment Lambda_tilde\setminus Lambda is stored in the workspace
+      (cf. CDD1Workspace::increment()).
+    */
+    template <class PROBLEM, typename INDEX>
+    void NGROW(PROBLEM& P, const CDD1Parameters& params,
+               const InfiniteVector<double, INDEX>& F,
+               const InfiniteVector<double, INDEX>& ubar,
+               const double xi1,
+               const double xi2,
+               InfiniteVector<double, INDEX>& r,
+               CDD1Workspace<PROBLEM, INDEX>& workspace,
+               const int jmax = 99,
+               const CompressionStrategy strategy = St04a);
+
+    /*!
+      NGROW for the right-hand sides with the numbers in rhs,
+      with a blocked APPLY call (with the dense accumulators ww)
+    */
+    template <class PROBLEM>
+    void NGROW(PROBLEM& P, const CDD1Parameters& params,
+               const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+               const std::vector<set<typename PROBLEM::Index> >& Lambda,
+               const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& ubar,
+               const double xi1,
+               const double xi2,
+               std::vector<set<typename PROBLEM::Index> >& Lambda_tilde,
+               std::vector<InfiniteVector<double, typename PROBLEM::Index> >& r,
+               const std::vector<unsigned int>& rhs,
+               std::vector<DenseAccumulator<double> >& ww,
+               const int jmax = 99,
+               const CompressionStrategy strategy = St04a);
+
     
     /*!
       INRESIDUAL:
@@ -332,6 +625,24 @@ namespace WaveletTL
 		   set<int>& Lambda_tilde,
 		   const int jmax = 99,
 		   const CompressionStrategy strategy = St04a);
+
+    /*!
+      NRESIDUAL for the right-hand sides with the numbers in rhs,
+      with a blocked APPLY call (with the dense accumulators ww)
+    */
+    template <class PROBLEM>
+    void NRESIDUAL(PROBLEM& P, const CDD1Parameters& params,
+		   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& F,
+		   const std::vector<set<typename PROBLEM::Index> >& Lambda,
+		   const std::vector<InfiniteVector<double, typename PROBLEM::Index> >& v,
+		   const double eta1,
+		   const double eta2,
+		   std::vector<InfiniteVector<double, typename PROBLEM::Index> >& r,
+		   std::vector<set<typename PROBLEM::Index> >& Lambda_tilde,
+		   const std::vector<unsigned int>& rhs,
+		   std::vector<DenseAccumulator<double> >& ww,
+		   const int jmax = 99,
+		   const CompressionStrategy strategy = St04a);
 }
 
 #include <adaptive/cdd1.cpp>
@@ -128,6 +128,68 @@ namespace WaveletTL
         
   }        
         
+  template <class PROBLEM>
+  void CDD2_SOLVE(const PROBLEM& P, const double nu, const double epsilon,
+                  const std::vector<InfiniteVector<double, typename PROBLEM::WaveletBasis::Index> >& F,
+                  std::vector<InfiniteVector<double, typename PROBLEM::WaveletBasis::Index> >& u_epsilon,
+                  const unsigned int maxlevel, CompressionStrategy strategy)
+  {
+    typedef typename PROBLEM::WaveletBasis::Index Index;
+
+    // compute optimal relaxation parameter omega
+    const double omega = 2.0 / (P.norm_A() + 1.0/P.norm_Ainv());
+    cout << "CDD2_SOLVE: omega=" << omega << endl;
+
+    // compute spectral norm rho
+    const double cond_A = P.norm_A() * P.norm_Ainv();
+    const double rho = (cond_A - 1.0) / (cond_A + 1.0);
+    cout << "CDD2_SOLVE: rho=" << rho << endl;
+
+    // desired error reduction factor theta < 1/3
+    const double theta = 0.333;
+    cout << "CDD2_SOLVE: theta=" << theta << endl;
+
+    // compute minimal K such that 3*rho^K < theta
+    const int K = (int) ceil(log10(theta/3.0) / log10(rho));
+    cout << "CDD2_SOLVE: K=" << K << endl << endl;
+
+    const unsigned int k = F.size();
+    u_epsilon.resize(k);
+    for (unsigned int i = 0; i < k; i++)
+      u_epsilon[i].clear();
+
+    double epsilon_k = nu, eta;
+    std::vector<InfiniteVector<double,Index> > v, Av;
+    std::vector<DenseAccumulator<double> > ww; // reused by the blocked APPLY calls
+    InfiniteVector<double,Index> f, help;
+    while (epsilon_k > epsilon) {
+      epsilon_k *= 3*pow(rho, K) / theta;
+      cout << "CDD2_SOLVE: epsilon_k=" << epsilon_k << endl;
+      eta = theta * epsilon_k / (6*omega*K)*10;
+      cout << "eta = " << eta << endl;
+
+      v = u_epsilon;
+#if _WAVELETTL_USE_TBASIS == 1
+      APPLY(P, v, std::vector<double>(k, eta), Av, ww, maxlevel, tensor_simple);
+#else
+      // blocked APPLY_COARSE
+      APPLY(P, v, std::vector<double>(k, 0.5*eta), Av, ww, maxlevel, strategy);
+#endif
+      for (unsigned int i = 0; i < k; i++) {
+#if _WAVELETTL_USE_TBASIS != 1
+        Av[i].COARSE(0.5*eta, help);
+        Av[i].swap(help);
+#endif
+        F[i].COARSE(eta, f);
+        f -= Av[i];
+        cout << "right-hand side " << i << ": current residual error ||f-Av||=" << l2_norm(f) << endl;
+        v[i].add(0.5 * omega, f); // the factor 0.5 is needed in case the computed value of normA or normAinv isn't accurate enough
+        v[i].COARSE((1-theta)*epsilon_k, u_epsilon[i]);
+      }
+      cout << "coarse tol = " << (1-theta)*epsilon_k << endl;
+    }
+  }
+
   template <class PROBLEM>
     void CDD2_SOLVE(PROBLEM& P, const double nu, const double epsilon,
             InfiniteVector<double, int>& u_epsilon,
@@ -10,6 +10,7 @@
 #ifndef _WAVELETTL_CDD2_H
 #define _WAVELETTL_CDD2_H
 
+#include <vector>
 #include <algebra/infinite_vector.h>
 
 namespace WaveletTL
@@ -43,6 +44,19 @@ namespace WaveletTL
 		         InfiniteVector<double, typename PROBLEM::WaveletBasis::Index>& u_epsilon,
                          const unsigned int maxlevel = 12, const CompressionStrategy strategy = CDD1);
                          
+  /*
+    CDD2_SOLVE for k right-hand sides F[0],...,F[k-1] of the same equation at once
+    (e.g., several load cases), given by their coefficient vectors (cf. P.RHS()).
+    nu has to be an estimate for all ||u[i]||. The Richardson iterations for the
+    right-hand sides are run simultaneously and use the blocked version of APPLY,
+    so that each column of the stiffness matrix is needed only once per step.
+  */
+  template <class PROBLEM>
+  void CDD2_SOLVE(const PROBLEM& P, const double nu, const double epsilon,
+                  const std::vector<InfiniteVector<double, typename PROBLEM::WaveletBasis::Index> >& F,
+                  std::vector<InfiniteVector<double, typename PROBLEM::WaveletBasis::Index> >& u_epsilon,
+                  const unsigned int maxlevel = 12, const CompressionStrategy strategy = CDD1);
+
   /* same with int instead of Index */
   template <class PROBLEM>
   void CDD2_SOLVE(const PROBLEM& P, const double nu, const double epsilon,
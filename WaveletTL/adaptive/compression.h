@@ -59,6 +59,11 @@ namespace WaveletTL
     The problem class PROBLEM should indicate via a function local(), whether the
     matrix A is induced by a local operator or not.
 
+    The column is added to a dense vector w, indexed by the numbers of the wavelets.
+    VECTOR is usually Vector<double>; problems whose add_level()/add_ball() routines
+    are templated over the vector type (e.g. CachedProblem, CachedTProblem) also accept a
+    DenseAccumulator<double>, which keeps track of the touched entries.
+
     (Remark: this routine could be extended for other compression strategies or
     alternative methods to compute single columns of the stiffness matrix.)
 
@@ -73,12 +78,12 @@ namespace WaveletTL
 
   using MathTL::Vector;
 
-  template <class PROBLEM>
+  template <class PROBLEM, class VECTOR>
   void add_compressed_column(const PROBLEM& P,
 			     const double factor,
 			     const typename PROBLEM::Index& lambda,
 			     const int J,
-			     Vector<double>& w,
+			     VECTOR& w,
 			     const int jmax = 999,
 			     const CompressionStrategy strategy = St04a,
                              const bool preconditioning = true);
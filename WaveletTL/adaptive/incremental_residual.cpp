@@ -0,0 +1,106 @@
+// implementation for incremental_residual.h
+
+#include <cmath>
+
+namespace WaveletTL
+{
+  template <class PROBLEM>
+  IncrementalResidual<PROBLEM>::IncrementalResidual(const PROBLEM& P,
+						    const int jmax,
+						    const CompressionStrategy strategy,
+						    const bool apply_coarse,
+						    const double reserve)
+    : full_updates(0), incremental_updates(0), rhs_updates(0),
+      P_(P), jmax_(jmax), strategy_(strategy), apply_coarse_(apply_coarse),
+      reserve_(reserve), eta_Au_(-1), eta_F_(-1)
+  {
+    assert(reserve > 0 && reserve <= 1);
+  }
+
+  template <class PROBLEM>
+  void
+  IncrementalResidual<PROBLEM>::reset()
+  {
+    u_old_.clear();
+    Au_.clear();
+    F_.clear();
+    eta_Au_ = eta_F_ = -1;
+  }
+
+  template <class PROBLEM>
+  void
+  IncrementalResidual<PROBLEM>::apply(const InfiniteVector<double,Index>& v, const double eta,
+				      InfiniteVector<double,Index>& w) const
+  {
+    if (apply_coarse_)
+      APPLY_COARSE(P_, v, eta, w, 1.0e-6, jmax_, strategy_);
+    else
+      APPLY(P_, v, eta, w, jmax_, strategy_);
+  }
+
+  template <class PROBLEM>
+  void
+  IncrementalResidual<PROBLEM>::residual(const InfiniteVector<double,Index>& u,
+					 const double eta,
+					 InfiniteVector<double,Index>& r)
+  {
+    const double budget = eta/2.;
+
+    // the right-hand side, only if the tolerance has tightened
+    if (eta_F_ < 0 || eta_F_ > budget) {
+      P_.RHS(budget, F_);
+      eta_F_ = budget;
+      rhs_updates++;
+    }
+
+    // Au, either by updating the stored approximation or from scratch
+    bool full = (eta_Au_ < 0 || eta_Au_ >= budget);
+    if (!full) {
+      InfiniteVector<double,Index> du(u);
+      du -= u_old_; // drops the unchanged coefficients
+      if (du.size() > 0) {
+	// use half of the remaining budget, unless a full APPLY is cheaper
+	const double eta_du = (budget-eta_Au_)/2.;
+	if (l2_norm(du)/eta_du < l2_norm(u)/(reserve_*budget)) {
+	  InfiniteVector<double,Index> Adu;
+	  apply(du, eta_du, Adu);
+	  Au_ += Adu;
+	  eta_Au_ += eta_du;
+	  incremental_updates++;
+	} else
+	  full = true;
+      }
+    }
+    if (full) {
+      apply(u, reserve_*budget, Au_);
+      eta_Au_ = reserve_*budget;
+      full_updates++;
+    }
+    u_old_ = u;
+
+    r = F_;
+    r -= Au_;
+  }
+
+  template <class PROBLEM>
+  void RES(IncrementalResidual<PROBLEM>& R,
+	   const InfiniteVector<double, typename PROBLEM::Index>& w,
+	   const double xi,
+	   const double delta,
+	   const double epsilon,
+	   InfiniteVector<double, typename PROBLEM::Index>& tilde_r,
+	   double& nu,
+	   unsigned int& niter)
+  {
+    double zeta = 2.*xi;
+    double l2n = 0.;
+    do {
+      zeta /= 2.;
+      R.residual(w, zeta, tilde_r);
+      l2n = l2_norm(tilde_r);
+      nu = l2n + zeta;
+      ++niter;
+    }
+    while ( (nu > epsilon) && (zeta > delta*l2n) );
+  }
+}
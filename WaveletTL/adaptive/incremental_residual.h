@@ -0,0 +1,122 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_INCREMENTAL_RESIDUAL_H
+#define _WAVELETTL_INCREMENTAL_RESIDUAL_H
+
+#include <algebra/infinite_vector.h>
+#include <adaptive/compression.h>
+#include <adaptive/apply.h>
+
+namespace WaveletTL
+{
+  using MathTL::InfiniteVector;
+
+  /*!
+    Approximate residuals r ~ F-Au of a sequence of iterates u of an adaptive
+    solver, such that
+
+      ||r-(F-Au)|| <= eta
+
+    (as far as APPLY and P.RHS() meet their tolerances).
+
+    Instead of calling APPLY for the whole iterate each time, the engine keeps
+    the last iterate u_old together with an approximation of Au_old and its
+    accumulated error bound. For a new iterate, only the update u-u_old is
+    APPLYed, with a part of the remaining error budget eta/2. Since the work
+    of APPLY is governed by ||v||/eta (the binning of v), this is much cheaper
+    as long as the update is small compared to u. A full APPLY of u is done
+    when the error budget is used up or when it is cheaper by this measure.
+    A full APPLY uses only the fraction reserve of eta/2, the rest is left
+    for the subsequent updates.
+    The approximation of F is only recomputed if the tolerance tightens.
+
+    The engine pays off if the tolerance stays (nearly) constant between
+    the iterates, as in steepest_descent_ks_SOLVE. In AWGM_SOLVE, the
+    tolerance of RES shrinks from call to call and a full APPLY is needed
+    almost every time, so AWGM_SOLVE keeps the plain RES of apply.h.
+  */
+  template <class PROBLEM>
+  class IncrementalResidual
+  {
+  public:
+    //! wavelet index class
+    typedef typename PROBLEM::Index Index;
+
+    /*!
+      constructor from the problem and the parameters of APPLY
+      (apply_coarse: use APPLY_COARSE as in RES)
+    */
+    IncrementalResidual(const PROBLEM& P,
+			const int jmax = 99,
+			const CompressionStrategy strategy = St04a,
+			const bool apply_coarse = false,
+			const double reserve = 0.5);
+
+    /*!
+      approximate residual of u with accuracy eta
+    */
+    void residual(const InfiniteVector<double,Index>& u,
+		  const double eta,
+		  InfiniteVector<double,Index>& r);
+
+    /*!
+      forget the stored data (e.g., if the problem has changed)
+    */
+    void reset();
+
+    //! the problem
+    const PROBLEM& problem() const { return P_; }
+
+    /*
+     * statistics
+     */
+    unsigned int full_updates;         //!< number of APPLY calls for the whole iterate
+    unsigned int incremental_updates;  //!< number of APPLY calls for an update
+    unsigned int rhs_updates;          //!< number of P.RHS() calls
+
+  protected:
+    const PROBLEM& P_;
+    int jmax_;
+    CompressionStrategy strategy_;
+    bool apply_coarse_;
+    double reserve_;
+
+    // APPLY or APPLY_COARSE, as requested
+    void apply(const InfiniteVector<double,Index>& v, const double eta,
+	       InfiniteVector<double,Index>& w) const;
+
+    // the last iterate and the approximation of Au_old, valid if eta_Au_ >= 0
+    InfiniteVector<double,Index> u_old_, Au_;
+    double eta_Au_;
+
+    // the approximation of F, valid if eta_F_ >= 0
+    InfiniteVector<double,Index> F_;
+    double eta_F_;
+  };
+
+  /*!
+    RES with an incremental residual engine, the loop and the parameters are
+    the same as for RES in apply.h (jmax and the compression strategy are
+    those of R).
+  */
+  template <class PROBLEM>
+  void RES(IncrementalResidual<PROBLEM>& R,
+	   const InfiniteVector<double, typename PROBLEM::Index>& w,
+	   const double xi,
+	   const double delta,
+	   const double epsilon,
+	   InfiniteVector<double, typename PROBLEM::Index>& tilde_r,
+	   double& nu,
+	   unsigned int& niter);
+}
+
+#include <adaptive/incremental_residual.cpp>
+
+#endif
@@ -4,6 +4,7 @@
 #include <set>
 #include <utils/plot_tools.h>
 #include <adaptive/apply.h>
+#include <adaptive/incremental_residual.h>
 #include <numerics/corner_singularity.h>
 #include <interval/p_basis.h>
 
@@ -127,14 +128,17 @@ namespace WaveletTL{
 
     double dd = 0.5;
 
+    // the residuals of the iterates, w changes only by the descent steps
+    IncrementalResidual<PROBLEM> R(P, jmax, CDD1, true);
+
     // the adaptive algorithm
     for (unsigned int i = 1; i <= K; i++) {
       omega_i *= beta;
       double xi_i = omega_i / ((1+3.0*mu)*C3*M);
       double nu_i = 0.;
 
-      RES(P, w, xi_i, delta, omega_i/((1+3.*mu)*a_inv), jmax,
-	  tilde_r, nu_i, niter, CDD1); 
+      RES(R, w, xi_i, delta, omega_i/((1+3.*mu)*a_inv),
+	  tilde_r, nu_i, niter);
 
       while ( nu_i > omega_i/((1+3.*mu)*a_inv)) {
 
@@ -159,8 +163,8 @@ namespace WaveletTL{
 	++loops;
 	++niter;
 
-	RES(P, w, xi_i, delta, omega_i/((1+3.*mu)*a_inv), jmax,
-	    tilde_r, nu_i, niter, CDD1);
+	RES(R, w, xi_i, delta, omega_i/((1+3.*mu)*a_inv),
+	    tilde_r, nu_i, niter);
 
 	cout << "loop: " << loops << " nu = " 
 	     << nu_i << " epsilon = " << omega_i/((1+3.*mu)*a_inv) << endl;
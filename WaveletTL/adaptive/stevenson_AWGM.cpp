@@ -97,6 +97,114 @@ void AWGM_SOLVE(const PROBLEM& P, const double epsilon,
 
 
 
+template <class PROBLEM>
+void AWGM_SOLVE(const PROBLEM& P, const double epsilon,
+               const std::vector<InfiniteVector<double, typename PROBLEM::WaveletBasis::Index> >& F,
+               std::vector<InfiniteVector<double, typename PROBLEM::WaveletBasis::Index> >& u_epsilon,
+               const int jmax,
+               MathTL::AbstractConvergenceLogger& logger,
+               const double alpha,
+               const double omega,
+               const double gamma,
+               const double theta,
+               const CompressionStrategy strategy)
+{
+    unsigned int k = 0; // iteration counter
+
+    typedef typename PROBLEM::WaveletBasis::Index Index;
+
+    // the data of the right-hand sides which are not yet solved,
+    // number[m] is the position of the m-th of them in F
+    const unsigned int nrhs = F.size();
+    std::vector<unsigned int> number(nrhs);
+    std::vector<InfiniteVector<double, Index> > f(F), u(nrhs), r;
+    std::vector<set<Index> > Lambda(nrhs);
+    std::vector<double> nu(nrhs), xi;
+    for (unsigned int m = 0; m < nrhs; m++)
+    {
+        number[m] = m;
+        nu[m] = l2_norm(F[m]); // nu_{-1} = ||F||_2
+    }
+
+    u_epsilon.resize(nrhs);
+
+    set<Index> supp_r_coarse;
+    InfiniteVector<double, Index> r_help, g;
+    std::vector<DenseAccumulator<double> > ww; // reused by the blocked APPLY calls in RES
+
+    logger.startClock();
+
+    while(true)
+    {
+        logger.checkAbortConditions();
+
+        xi.resize(u.size());
+        for (unsigned int m = 0; m < u.size(); m++)
+            xi[m] = theta*nu[m]*omega/(1-omega);
+        unsigned int res_loop_counter = 0;
+        RES(P, f, u, xi, omega, epsilon, jmax, r, nu, res_loop_counter, ww, strategy);
+
+        double nu_max = 0;
+        unsigned int size = 0;
+        for (unsigned int m = 0; m < u.size(); m++)
+        {
+            nu_max = std::max(nu_max, nu[m]);
+            size += u[m].size();
+        }
+        cout << "GHS_SOLVE: k=" << k << ", " << u.size() << " right-hand sides left, max. nu=" << nu_max << endl;
+        cout << "       (epsilon=" << epsilon << "), total support size: " << size << endl;
+        cout << "       Number of loops needed in RES: " << res_loop_counter << endl;
+
+        logger.logConvergenceData(size, nu_max);
+
+        // remove the right-hand sides which are solved
+        for (unsigned int m = 0; m < u.size();)
+        {
+            if (nu[m] <= epsilon)
+            {
+                u_epsilon[number[m]].swap(u[m]);
+                const unsigned int last = u.size()-1;
+                std::swap(number[m], number[last]);
+                std::swap(nu[m], nu[last]);
+                f[m].swap(f[last]);
+                u[m].swap(u[last]);
+                r[m].swap(r[last]);
+                Lambda[m].swap(Lambda[last]);
+                number.pop_back();
+                nu.pop_back();
+                f.pop_back();
+                u.pop_back();
+                r.pop_back();
+                Lambda.pop_back();
+            }
+            else
+                ++m;
+        }
+        if (u.empty()) break;
+
+        for (unsigned int m = 0; m < u.size(); m++)
+        {
+            double norm_r = l2_norm(r[m]);
+            r_help = r[m];
+            r_help.clip(Lambda[m]);
+            r[m] -= r_help;
+            r[m].COARSE(sqrt(1-alpha*alpha)*norm_r, r_help);
+            r_help.support(supp_r_coarse);
+            Lambda[m].insert(supp_r_coarse.begin(), supp_r_coarse.end());
+
+            f[m].COARSE(gamma*nu[m], g);
+            g.clip(Lambda[m]);
+            GALSOLVE(P, Lambda[m], g, u[m], (1+gamma)*nu[m], gamma*nu[m]);
+        }
+
+        ++k;
+    }
+
+    cout << "GHS_SOLVE: done!" << endl;
+}
+
+
+
 template <class PROBLEM>
 void GALSOLVE(const PROBLEM& P, const set<typename PROBLEM::WaveletBasis::Index>& Lambda,
               const InfiniteVector<double, typename PROBLEM::WaveletBasis::Index>& g_Lambda,
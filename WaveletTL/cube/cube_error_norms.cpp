@@ -0,0 +1,321 @@
+// implementation for cube_error_norms.h
+
+#include <cmath>
+#include <algorithm>
+#include <algebra/vector.h>
+#include <numerics/gauss_quadrature.h>
+#include <cube/cube_support.h>
+
+namespace WaveletTL
+{
+  template <class IBASIS, unsigned int DIM>
+  CubeErrorNorms<IBASIS,DIM>::Shares::Shares()
+    : Lp(0), L_infty(0), rel_L_infty(0)
+  {
+    for (unsigned int i = 0; i < DIM; i++)
+      Lp_deriv[i] = L_infty_deriv[i] = 0;
+  }
+
+  template <class IBASIS, unsigned int DIM>
+  void
+  CubeErrorNorms<IBASIS,DIM>::Shares::add(const Shares& s)
+  {
+    Lp += s.Lp;
+    L_infty = std::max(L_infty, s.L_infty);
+    rel_L_infty = std::max(rel_L_infty, s.rel_L_infty);
+    for (unsigned int i = 0; i < DIM; i++) {
+      Lp_deriv[i] += s.Lp_deriv[i];
+      L_infty_deriv[i] = std::max(L_infty_deriv[i], s.L_infty_deriv[i]);
+    }
+  }
+
+  template <class IBASIS, unsigned int DIM>
+  double
+  CubeErrorNorms<IBASIS,DIM>::Shares::W1p() const
+  {
+    double r = Lp;
+    for (unsigned int i = 0; i < DIM; i++)
+      r += Lp_deriv[i];
+    return r;
+  }
+
+  template <class IBASIS, unsigned int DIM>
+  CubeErrorNorms<IBASIS,DIM>::CubeErrorNorms(const Basis& basis,
+					     const Function<DIM>* u_exact,
+					     const Function<DIM>* u_exact_deriv,
+					     const int doe_quad,
+					     const double tolerance,
+					     const int max_depth)
+    : basis_(basis), u_exact_(u_exact), u_exact_deriv_(u_exact_deriv),
+      N_Gauss(std::max(1, (doe_quad+1)/2)), tolerance_(tolerance), max_depth_(max_depth), p_(2)
+  {
+  }
+
+  template <class IBASIS, unsigned int DIM>
+  void
+  CubeErrorNorms<IBASIS,DIM>::gauss(const std::vector<std::pair<Index,double> >& coeffs,
+				    const int j, const FixedArray1D<int,DIM>& k, Shares& shares) const
+  {
+    shares = Shares();
+
+    // Gauss points and weights of the cell (GaussLegendreTable: any N_Gauss >= 1)
+    const double h = ldexp(1.0, -j);
+    const Array1D<double>& points(GaussLegendreTable::points(N_Gauss));
+    const Array1D<double>& weights(GaussLegendreTable::weights(N_Gauss));
+    FixedArray1D<Array1D<double>,DIM> gauss_points, gauss_weights;
+    int n_points = 1;
+    for (unsigned int i = 0; i < DIM; i++) {
+      gauss_points[i].resize(N_Gauss);
+      gauss_weights[i].resize(N_Gauss);
+      for (int n = 0; n < N_Gauss; n++) {
+	gauss_points[i][n] = h*(2*k[i]+1+points[n])/2.;
+	gauss_weights[i][n] = h*weights[n];
+      }
+      n_points *= N_Gauss;
+    }
+
+    // values and partial derivatives of u_epsilon at the Gauss points
+    std::vector<double> values(n_points, 0.0), derivs(DIM*n_points, 0.0);
+    FixedArray1D<Array1D<double>,DIM> psi_values, psi_der_values;
+    for (typename std::vector<std::pair<Index,double> >::const_iterator it(coeffs.begin());
+	 it != coeffs.end(); ++it) {
+      const Index& lambda(it->first);
+      for (unsigned int i = 0; i < DIM; i++) {
+	const typename IBASIS::Index lambda_i(lambda.j(), lambda.e()[i], lambda.k()[i], basis_.bases()[i]);
+	evaluate(*basis_.bases()[i], 0, lambda_i, gauss_points[i], psi_values[i]);
+	if (u_exact_deriv_)
+	  evaluate(*basis_.bases()[i], 1, lambda_i, gauss_points[i], psi_der_values[i]);
+      }
+      int index[DIM];
+      for (unsigned int i = 0; i < DIM; i++)
+	index[i] = 0;
+      for (int id = 0; id < n_points; id++) {
+	double value = it->second;
+	for (unsigned int i = 0; i < DIM; i++)
+	  value *= psi_values[i][index[i]];
+	values[id] += value;
+	if (u_exact_deriv_) {
+	  for (unsigned int i = 0; i < DIM; i++) {
+	    double deriv = it->second;
+	    for (unsigned int s = 0; s < DIM; s++)
+	      deriv *= (s == i ? psi_der_values[s][index[s]] : psi_values[s][index[s]]);
+	    derivs[i*n_points+id] += deriv;
+	  }
+	}
+	// "++index"
+	for (unsigned int i = 0; i < DIM; i++) {
+	  if (index[i] == N_Gauss-1)
+	    index[i] = 0;
+	  else {
+	    index[i]++;
+	    break;
+	  }
+	}
+      }
+    }
+
+    // sum up the shares
+    Point<DIM> x;
+    Vector<double> deriv_values_u_exact(DIM);
+    int index[DIM];
+    for (unsigned int i = 0; i < DIM; i++)
+      index[i] = 0;
+    for (int id = 0; id < n_points; id++) {
+      double weights = 1.0;
+      for (unsigned int i = 0; i < DIM; i++) {
+	x[i] = gauss_points[i][index[i]];
+	weights *= gauss_weights[i][index[i]];
+      }
+
+      const double value_u_exact = u_exact_->value(x);
+      const double error = fabs(value_u_exact - values[id]);
+      shares.Lp += weights * pow(error, p_);
+      shares.L_infty = std::max(shares.L_infty, error);
+      if (fabs(value_u_exact) > 1e-14)
+	shares.rel_L_infty = std::max(shares.rel_L_infty, error/fabs(value_u_exact));
+
+      if (u_exact_deriv_) {
+	u_exact_deriv_->vector_value(x, deriv_values_u_exact);
+	for (unsigned int i = 0; i < DIM; i++) {
+	  const double deriv_error = fabs(deriv_values_u_exact[i] - derivs[i*n_points+id]);
+	  shares.Lp_deriv[i] += weights * pow(deriv_error, p_);
+	  shares.L_infty_deriv[i] = std::max(shares.L_infty_deriv[i], deriv_error);
+	}
+      }
+
+      // "++index"
+      for (unsigned int i = 0; i < DIM; i++) {
+	if (index[i] == N_Gauss-1)
+	  index[i] = 0;
+	else {
+	  index[i]++;
+	  break;
+	}
+      }
+    }
+  }
+
+  template <class IBASIS, unsigned int DIM>
+  int
+  CubeErrorNorms<IBASIS,DIM>::adaptive_gauss(const std::vector<std::pair<Index,double> >& coeffs,
+					     const int j, const FixedArray1D<int,DIM>& k,
+					     const Shares& coarse, const int depth, Shares& shares) const
+  {
+    // Gauss rule on the children
+    Array1D<Shares> children(1<<DIM);
+    Array1D<FixedArray1D<int,DIM> > kchildren(1<<DIM);
+    Shares fine;
+    for (int c = 0; c < (1<<DIM); c++) {
+      for (unsigned int i = 0; i < DIM; i++)
+	kchildren[c][i] = 2*k[i] + ((c >> i) & 1);
+      gauss(coeffs, j+1, kchildren[c], children[c]);
+      fine.add(children[c]);
+    }
+
+    if (depth >= max_depth_
+	|| fabs(fine.W1p() - coarse.W1p()) <= tolerance_ * ldexp(1.0, -j*(int)DIM)) {
+      shares = fine;
+      return depth;
+    }
+
+    // bisect further
+    shares = Shares();
+    int maxdepth = depth;
+    for (int c = 0; c < (1<<DIM); c++) {
+      Shares child_shares;
+      maxdepth = std::max(maxdepth, adaptive_gauss(coeffs, j+1, kchildren[c], children[c], depth+1, child_shares));
+      shares.add(child_shares);
+    }
+    return maxdepth;
+  }
+
+  template <class IBASIS, unsigned int DIM>
+  void
+  CubeErrorNorms<IBASIS,DIM>::LeafSum::operator () (const int i)
+  {
+    const int j = E_->leaves[i].first;
+    const int patch = E_->leaves[i].second;
+    const int j0 = E_->basis_.j0();
+
+    // collect the active coefficients whose supports contain the leaf,
+    // they are registered on the leaf or on one of its ancestors
+    std::vector<std::pair<Index,double> > coeffs;
+    FixedArray1D<int,DIM> k;
+    for (unsigned int s = 0; s < DIM; s++)
+      k[s] = (patch >> (j*s)) & ((1<<j)-1);
+    for (int r = j; r >= j0; r--) {
+      int ancestor = 0;
+      for (unsigned int s = 0; s < DIM; s++)
+	ancestor += (k[s] >> (j-r)) << (r*s);
+      typename std::map<int, std::map<int, CoefficientList> >::const_iterator level(E_->registered.find(r));
+      if (level == E_->registered.end()) continue;
+      typename std::map<int, CoefficientList>::const_iterator it(level->second.find(ancestor));
+      if (it != level->second.end())
+	coeffs.insert(coeffs.end(), it->second.begin(), it->second.end());
+    }
+
+    Shares coarse, leaf_shares;
+    E_->gauss(coeffs, j, k, coarse);
+    const int depth = E_->adaptive_gauss(coeffs, j, k, coarse, 0, leaf_shares);
+
+    CellIndicator& indicator(E_->indicators[i]);
+    indicator.j = j;
+    indicator.k = k;
+    indicator.Lp = leaf_shares.Lp;
+    indicator.Lp_deriv = leaf_shares.W1p() - leaf_shares.Lp;
+    indicator.L_infty = leaf_shares.L_infty;
+    indicator.depth = depth;
+
+    shares.add(leaf_shares);
+  }
+
+  template <class IBASIS, unsigned int DIM>
+  void
+  CubeErrorNorms<IBASIS,DIM>::compute(const InfiniteVector<double,Index>& u_epsilon, const double p)
+  {
+    p_ = p;
+    registered.clear();
+    refined.clear();
+    leaves.clear();
+
+    const int j0 = basis_.j0();
+
+    // register the coefficients on the cells of their supports,
+    // all ancestors of these cells are refined
+    typedef typename Basis::Support Support;
+    for (typename InfiniteVector<double,Index>::const_iterator it(u_epsilon.begin()), itend(u_epsilon.end());
+	 it != itend; ++it) {
+      Support supp;
+      support<IBASIS,DIM>(basis_, it.index(), supp);
+      std::map<int, CoefficientList>& level(registered[supp.j]);
+      int cell[DIM];
+      for (unsigned int i = 0; i < DIM; i++)
+	cell[i] = supp.a[i];
+      while (true) {
+	int patch = 0;
+	for (unsigned int i = 0; i < DIM; i++)
+	  patch += cell[i] << (supp.j*i);
+	level[patch].push_back(std::make_pair(it.index(), *it));
+
+	int child = patch;
+	for (int r = supp.j; r > j0; r--) {
+	  int parent = 0;
+	  for (unsigned int i = 0; i < DIM; i++)
+	    parent += (((child >> (r*i)) & ((1<<r)-1)) >> 1) << ((r-1)*i);
+	  if (!refined[r-1].insert(parent).second) break;
+	  child = parent;
+	}
+
+	// "++cell"
+	bool exit = false;
+	for (unsigned int i = 0; i < DIM; i++) {
+	  if (cell[i] == supp.b[i]-1) {
+	    cell[i] = supp.a[i];
+	    exit = (i == DIM-1);
+	  } else {
+	    cell[i]++;
+	    break;
+	  }
+	}
+	if (exit) break;
+      }
+    }
+
+    // collect the leaves, depth first
+    std::list<std::pair<int,int> > stack;
+    for (int patch = (1<<(j0*DIM))-1; patch >= 0; patch--)
+      stack.push_back(std::make_pair(j0, patch));
+    while (!stack.empty()) {
+      const std::pair<int,int> cell(stack.back());
+      stack.pop_back();
+      typename std::map<int, std::set<int> >::const_iterator level(refined.find(cell.first));
+      if (level != refined.end() && level->second.find(cell.second) != level->second.end()) {
+	const int j = cell.first;
+	for (int c = (1<<DIM)-1; c >= 0; c--) {
+	  int patch = 0;
+	  for (unsigned int i = 0; i < DIM; i++)
+	    patch += (2*((cell.second >> (j*i)) & ((1<<j)-1)) + ((c >> i) & 1)) << ((j+1)*i);
+	  stack.push_back(std::make_pair(j+1, patch));
+	}
+      } else
+	leaves.push_back(cell);
+    }
+
+    // integrate over all leaves
+    indicators.resize(leaves.size());
+    LeafSum sum(this);
+    MathTL::parallel_reduce(0, leaves.size(), sum);
+
+    error_Lp = pow(sum.shares.Lp, 1.0/p);
+    error_W1p = error_Lp;
+    error_L_infty = sum.shares.L_infty;
+    error_W1_infty = error_L_infty;
+    for (unsigned int i = 0; i < DIM; i++) {
+      error_Lp_deriv[i] = pow(sum.shares.Lp_deriv[i], 1.0/p);
+      error_W1p += error_Lp_deriv[i];
+      error_L_infty_deriv[i] = sum.shares.L_infty_deriv[i];
+      error_W1_infty += error_L_infty_deriv[i];
+    }
+    rel_error_L_infty = sum.shares.rel_L_infty;
+  }
+}
@@ -0,0 +1,168 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_CUBE_ERROR_NORMS_H
+#define _WAVELETTL_CUBE_ERROR_NORMS_H
+
+#include <list>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+#include <utils/array1d.h>
+#include <utils/fixed_array1d.h>
+#include <utils/function.h>
+#include <utils/task_scheduler.h>
+#include <algebra/infinite_vector.h>
+#include <geometry/point.h>
+#include <cube/cube_basis.h>
+
+using MathTL::Array1D;
+using MathTL::FixedArray1D;
+using MathTL::Function;
+using MathTL::InfiniteVector;
+using MathTL::Point;
+
+namespace WaveletTL
+{
+  /*!
+    Streamed evaluation of the errors
+      ||u_exact-u_epsilon||_{L_p}, ||d/dx_i (u_exact-u_epsilon)||_{L_p},
+      ||u_exact-u_epsilon||_{L_infty}, ||d/dx_i (u_exact-u_epsilon)||_{L_infty},
+      ||(u_exact-u_epsilon)/u_exact||_{L_infty}
+    of a finite wavelet expansion u_epsilon w.r.t. a CubeBasis on [0,1]^d.
+
+    The integrals are computed cell by cell on the dyadic partition induced by
+    u_epsilon: starting with the cells of level j0, a cell is refined if it lies
+    within the support of a finer active coefficient, so u_epsilon is polynomial
+    on each leaf. On each leaf, an adaptive composite Gauss rule is applied, the leaf
+    is bisected (up to max_depth times) as long as the Gauss rule on the cell
+    and on its children differ by more than tolerance*|cell|
+    (this matters for nonsmooth u_exact).
+    The cells are processed in parallel on the common TaskScheduler, each with the
+    active coefficients whose supports contain it, no global grid is set up.
+    The L_infty norms are the maxima over all quadrature points visited.
+
+    Besides the norms, compute() stores one error indicator per leaf.
+    If no derivative of u_exact is given, the derivative errors are not computed.
+  */
+  template <class IBASIS, unsigned int DIM>
+  class CubeErrorNorms
+  {
+  public:
+    //! the wavelet basis
+    typedef CubeBasis<IBASIS,DIM> Basis;
+
+    //! wavelet index class
+    typedef typename Basis::Index Index;
+
+    /*!
+      constructor from the basis, the exact solution and its gradient
+      (u_exact_deriv->vector_value() has to return the DIM partial derivatives);
+      doe_quad is the degree of exactness of the Gauss rule on each cell
+    */
+    CubeErrorNorms(const Basis& basis,
+		   const Function<DIM>* u_exact,
+		   const Function<DIM>* u_exact_deriv = 0,
+		   const int doe_quad = 3,
+		   const double tolerance = 1e-10,
+		   const int max_depth = 4);
+
+    /*!
+      error indicator of one leaf 2^{-j}(k+[0,1]^d) of the partition
+    */
+    struct CellIndicator
+    {
+      int j;
+      FixedArray1D<int,DIM> k;
+      double Lp;        //!< \int_cell |u_exact-u_epsilon|^p
+      double Lp_deriv;  //!< \sum_i \int_cell |d/dx_i (u_exact-u_epsilon)|^p
+      double L_infty;   //!< max_cell |u_exact-u_epsilon|
+      int depth;        //!< number of bisections of the adaptive quadrature
+    };
+
+    /*!
+      compute all error norms of u_epsilon for the given exponent p
+    */
+    void compute(const InfiniteVector<double,Index>& u_epsilon, const double p);
+
+    /*
+     * the results of compute()
+     */
+    double error_Lp;
+    FixedArray1D<double,DIM> error_Lp_deriv;
+    double error_W1p;   //!< error_Lp + \sum_i error_Lp_deriv[i]
+    double error_L_infty;
+    FixedArray1D<double,DIM> error_L_infty_deriv;
+    double error_W1_infty;  //!< error_L_infty + \sum_i error_L_infty_deriv[i]
+    double rel_error_L_infty;
+    Array1D<CellIndicator> indicators;
+
+  protected:
+    const Basis& basis_;
+    const Function<DIM>* u_exact_;
+    const Function<DIM>* u_exact_deriv_;
+    int N_Gauss;
+    double tolerance_;
+    int max_depth_;
+    double p_;
+
+    // the active coefficients registered on the cells of their supports,
+    // the keys code the resolution and the cell number \sum_i k_i 2^{j*i}
+    typedef std::list<std::pair<Index,double> > CoefficientList;
+    std::map<int, std::map<int, CoefficientList> > registered;
+
+    // the refined cells of the partition
+    std::map<int, std::set<int> > refined;
+
+    // the leaves of the partition (resolution, cell number)
+    std::vector<std::pair<int,int> > leaves;
+
+    /*
+      partial results of the quadrature
+    */
+    struct Shares
+    {
+      double Lp;
+      FixedArray1D<double,DIM> Lp_deriv;
+      double L_infty;
+      FixedArray1D<double,DIM> L_infty_deriv;
+      double rel_L_infty;
+      Shares();
+      void add(const Shares& s);
+      double W1p() const;
+    };
+
+    // Gauss rule on the cell 2^{-j}(k+[0,1]^d) with the coefficients relevant there
+    void gauss(const std::vector<std::pair<Index,double> >& coeffs,
+	       const int j, const FixedArray1D<int,DIM>& k, Shares& shares) const;
+
+    // adaptive quadrature on the cell, returns the number of bisections used
+    int adaptive_gauss(const std::vector<std::pair<Index,double> >& coeffs,
+		       const int j, const FixedArray1D<int,DIM>& k,
+		       const Shares& coarse, const int depth, Shares& shares) const;
+
+    // the body of parallel_reduce() over the leaves
+    class LeafSum
+    {
+    public:
+      LeafSum(CubeErrorNorms* E) : E_(E) {}
+      LeafSum(LeafSum& s, MathTL::TaskScheduler::Split) : E_(s.E_) {}
+      void operator () (const int i);
+      void join(LeafSum& s) { shares.add(s.shares); }
+      Shares shares;
+    protected:
+      CubeErrorNorms* E_;
+    };
+  };
+}
+
+#include <cube/cube_error_norms.cpp>
+
+#endif
@@ -5,6 +5,7 @@
 #include <geometry/point.h>
 #include <geometry/grid.h>
 #include <geometry/sampled_mapping.h>
+#include <generic/tensor_sampler.h>
 
 using namespace MathTL;
 
@@ -39,15 +40,22 @@ namespace WaveletTL
 	   const bool primal,
 	   const int resolution)
   {
-    Grid<DIM> grid(Point<DIM>(0), Point<DIM>(1), 1<<resolution);
-    SampledMapping<DIM> result(grid); // zero
+    // sample each 1D factor only once and sum up the tensor products locally
+    TensorSampler<DIM> sampler(resolution);
+    FixedArray1D<SampledFactorCache,DIM> caches;
+    FixedArray1D<const SampledFactor*,DIM> factors;
 
     typedef typename CubeBasis<IBASIS,DIM>::Index Index;
     for (typename InfiniteVector<double,Index>::const_iterator it(coeffs.begin()),
-	   itend(coeffs.end()); it != itend; ++it)
-      result.add(*it, evaluate(basis, it.index(), primal, resolution));
+	   itend(coeffs.end()); it != itend; ++it) {
+      for (unsigned int i = 0; i < DIM; i++)
+	factors[i] = &sampled_factor(*(basis.bases()[i]),
+				     it.index().j(), it.index().e()[i], it.index().k()[i],
+				     primal, resolution, caches[i]);
+      sampler.add(*it, factors);
+    }
 
-    return result;
+    return sampler.sampled_mapping(Point<DIM>(0), Point<DIM>(1));
   }
 
 
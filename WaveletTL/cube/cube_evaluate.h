@@ -38,6 +38,8 @@ namespace WaveletTL
   /*!
     Evaluate an arbitrary linear combination of primal/dual wavelets
     on a dyadic subgrid of [0,1]^d.
+    Each univariate factor is sampled only once, and the tensor products
+    are summed up locally on their supports (see TensorSampler).
   */
   template <class IBASIS, unsigned int DIM>
   SampledMapping<DIM> evaluate(const CubeBasis<IBASIS,DIM>& basis,
@@ -26,6 +26,13 @@ namespace WaveletTL
 	  j0_(other.j0_), jmax_(other.jmax_),
       bases_infact(), bases_()
   {
+    if (!other.delete_pointers) {
+      // the 1D bases are not owned by other (e.g., shared via IntervalBasisRegistry)
+      for (unsigned int i = 0; i < DIM; ++i)
+        bases_[i] = other.bases_[i];
+      delete_pointers = false;
+      return;
+    }
     for (typename list<IBASIS*>::const_iterator it(other.bases_infact.begin());
          it != other.bases_infact.end(); ++it)
     {
@@ -71,6 +78,13 @@ namespace WaveletTL
 */
   	template <class IBASIS, unsigned int DIM>
   	TensorBasis<IBASIS,DIM>::TensorBasis(const FixedArray1D<int,2*DIM>& s) {
+#if _WAVELETTL_SHARED_INTERVAL_BASES
+    	for (unsigned int i = 0; i < DIM; i++) {
+            bases_[i] = IntervalBasisRegistry<IBASIS>::instance(s[2*i], s[2*i+1]);
+            j0_[i] = bases_[i]->j0();
+    	}
+    	delete_pointers = false;
+#else
     	for (unsigned int i = 0; i < DIM; i++) {
       		// check whether the corresponding 1d basis already exists
       		IBASIS* b = 0;
@@ -89,10 +103,18 @@ namespace WaveletTL
       		j0_[i] = b->j0();
     	}
     	delete_pointers = true;
+#endif
   	}
 
   	template <class IBASIS, unsigned int DIM>
   	TensorBasis<IBASIS,DIM>::TensorBasis(const FixedArray1D<bool,2*DIM>& bc) {
+#if _WAVELETTL_SHARED_INTERVAL_BASES
+    	for (unsigned int i = 0; i < DIM; i++) {
+            bases_[i] = IntervalBasisRegistry<IBASIS>::instance(bc[2*i], bc[2*i+1]);
+            j0_[i] = bases_[i]->j0();
+    	}
+    	delete_pointers = false;
+#else
     	for (unsigned int i = 0; i < DIM; i++) {
       		// check whether the corresponding 1d basis already exists
       		IBASIS* b = 0;
@@ -111,6 +133,7 @@ namespace WaveletTL
       		j0_[i] = b->j0();
     	}
     	delete_pointers = true;
+#endif
   	}
 
   	template <class IBASIS, unsigned int DIM>
@@ -30,6 +30,7 @@
 #include <utils/array1d.h>
 
 #include <numerics/gauss_data.h>
+#include <interval/interval_basis_registry.h>
 
 // for convenience, include also some functionality
 #include <cube/tbasis_support.h>
@@ -58,18 +58,21 @@ namespace WaveletTL
 	   const bool primal,
 	   const int resolution)
   {
-    Grid<1> grid(0.0, 1.0, 1<<resolution);
-    SampledMapping<1> result(grid); // zero
+    TensorSampler<1> sampler(resolution);
+    SampledFactorCache cache;
+    FixedArray1D<const SampledFactor*,1> factors;
 
     typedef typename TensorBasis<IBASIS,1>::Index Index;
     for (typename InfiniteVector<double,Index>::const_iterator it(coeffs.begin()),
 	   itend(coeffs.end()); it != itend; ++it)
-           {
-               result.add(*it, evaluate(basis, it.index(), primal, resolution));
-           }
-
-
-    return result;
+      {
+	factors[0] = &sampled_factor(*(basis.bases()[0]),
+				     it.index().j()[0], it.index().e()[0], it.index().k()[0],
+				     primal, resolution, cache);
+	sampler.add(*it, factors);
+      }
+
+    return sampler.sampled_mapping(Point<1>(0.0), Point<1>(1.0));
   }
   
   template <class IBASIS>
@@ -79,18 +82,22 @@ namespace WaveletTL
 	   const bool primal,
 	   const int resolution)
   {
-    Grid<1> grid(0.0, 1.0, 1<<resolution);
-    SampledMapping<1> result(grid); // zero
+    TensorSampler<1> sampler(resolution);
+    SampledFactorCache cache;
+    FixedArray1D<const SampledFactor*,1> factors;
 
     typedef typename TensorBasis<IBASIS,1>::Index Index;
-    for (typename InfiniteVector<double,Index>::const_iterator it(coeffs.begin()),
+    for (typename InfiniteVector<double,int>::const_iterator it(coeffs.begin()),
 	   itend(coeffs.end()); it != itend; ++it)
-           {
-               result.add(*it, evaluate(basis, it.index(), primal, resolution));
-           }
-
-
-    return result;
+      {
+	const Index lambda(basis.get_wavelet(it.index()));
+	factors[0] = &sampled_factor(*(basis.bases()[0]),
+				     lambda.j()[0], lambda.e()[0], lambda.k()[0],
+				     primal, resolution, cache);
+	sampler.add(*it, factors);
+      }
+
+    return sampler.sampled_mapping(Point<1>(0.0), Point<1>(1.0));
   }
   
 
@@ -101,18 +108,23 @@ namespace WaveletTL
 	   const bool primal,
 	   const int resolution)
   {
-    Grid<DIM> grid(Point<DIM>(0), Point<DIM>(1), 1<<resolution);
-    SampledMapping<DIM> result(grid); // zero
+    // sample each 1D factor only once and sum up the tensor products locally
+    TensorSampler<DIM> sampler(resolution);
+    FixedArray1D<SampledFactorCache,DIM> caches;
+    FixedArray1D<const SampledFactor*,DIM> factors;
 
     typedef typename TensorBasis<IBASIS,DIM>::Index Index;
     for (typename InfiniteVector<double,Index>::const_iterator it(coeffs.begin()),
 	   itend(coeffs.end()); it != itend; ++it)
-           {
-               result.add(*it, evaluate(basis, it.index(), primal, resolution));
-           }
-      
-
-    return result;
+      {
+	for (unsigned int i = 0; i < DIM; i++)
+	  factors[i] = &sampled_factor(*(basis.bases()[i]),
+				       it.index().j()[i], it.index().e()[i], it.index().k()[i],
+				       primal, resolution, caches[i]);
+	sampler.add(*it, factors);
+      }
+
+    return sampler.sampled_mapping(Point<DIM>(0), Point<DIM>(1));
   }
   
   template <class IBASIS, unsigned int DIM>
@@ -122,18 +134,24 @@ namespace WaveletTL
 	   const bool primal,
 	   const int resolution)
   {
-    Grid<DIM> grid(Point<DIM>(0), Point<DIM>(1), 1<<resolution);
-    SampledMapping<DIM> result(grid); // zero
+    // sample each 1D factor only once and sum up the tensor products locally
+    TensorSampler<DIM> sampler(resolution);
+    FixedArray1D<SampledFactorCache,DIM> caches;
+    FixedArray1D<const SampledFactor*,DIM> factors;
 
-//    typedef typename TensorBasis<IBASIS,DIM>::Index Index;
+    typedef typename TensorBasis<IBASIS,DIM>::Index Index;
     for (typename InfiniteVector<double,int>::const_iterator it(coeffs.begin()),
 	   itend(coeffs.end()); it != itend; ++it)
-           {
-               result.add(*it, evaluate(basis, it.index(), primal, resolution));
-           }
-      
-
-    return result;
+      {
+	const Index lambda(basis.get_wavelet(it.index()));
+	for (unsigned int i = 0; i < DIM; i++)
+	  factors[i] = &sampled_factor(*(basis.bases()[i]),
+				       lambda.j()[i], lambda.e()[i], lambda.k()[i],
+				       primal, resolution, caches[i]);
+	sampler.add(*it, factors);
+      }
+
+    return sampler.sampled_mapping(Point<DIM>(0), Point<DIM>(1));
   }
 }
 
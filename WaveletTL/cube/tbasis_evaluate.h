@@ -19,6 +19,7 @@
 #include <utils/array1d.h>
 #include <utils/fixed_array1d.h>
 #include <geometry/grid.h>
+#include <generic/tensor_sampler.h>
 
 using MathTL::Grid;
 using MathTL::SampledMapping;
@@ -47,6 +48,8 @@ namespace WaveletTL
   /*!
     Evaluate an arbitrary linear combination of primal/dual wavelets
     on a dyadic subgrid of [0,1]^d.
+    Each univariate factor is sampled only once, and the tensor products
+    are summed up locally on their supports (see TensorSampler).
   */
   template <class IBASIS, unsigned int DIM>
   SampledMapping<DIM> evaluate(const TensorBasis<IBASIS,DIM>& basis,
@@ -0,0 +1,319 @@
+// implementation for cached_helmholtz_problem.h
+
+#include <cassert>
+#include <cmath>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <numerics/eigenvalues.h>
+#include <numerics/iteratsolv.h>
+#include <galerkin/galerkin_utils.h>
+
+namespace WaveletTL
+{
+  template <class GRAMIAN, class ELLIPTIC>
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::CachedHelmholtzProblem(const GRAMIAN* G,
+								   const ELLIPTIC* A,
+								   const double alpha,
+								   const double estnormA,
+								   const double estnormAinv)
+    : gramian(G), elliptic(A), alpha_(alpha),
+      givennormA(estnormA), givennormAinv(estnormAinv),
+      normA(estnormA), normAinv(estnormAinv)
+  {
+    assert(alpha >= 0);
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  void
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::set_alpha(const double alpha) const
+  {
+    assert(alpha >= 0);
+    if (alpha != alpha_) {
+      alpha_ = alpha;
+      // the cached entries stay valid, only the norm estimates depend on alpha
+      normA = givennormA;
+      normAinv = givennormAinv;
+    }
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  const typename CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::Entry&
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::diagonal(const Index& lambda) const
+  {
+    const int lambda_num = lambda.number();
+    typename std::map<int,Entry>::iterator lb(diagonal_cache.lower_bound(lambda_num));
+    if (lb == diagonal_cache.end() || diagonal_cache.key_comp()(lambda_num, lb->first))
+      lb = diagonal_cache.insert(lb, std::make_pair(lambda_num,
+						    Entry(gramian->a(lambda, lambda),
+							  elliptic->a(lambda, lambda))));
+    return lb->second;
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  inline
+  double
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::D(const Index& lambda) const
+  {
+    const Entry& entry(diagonal(lambda));
+    return sqrt(alpha_ * entry.first + entry.second);
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  const typename CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::Block&
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::block(const Index& nu, const int j) const
+  {
+    const int nu_num = nu.number();
+
+    // search for column 'nu'
+    typename ColumnCache::iterator col_lb(entries_cache.lower_bound(nu_num));
+    typename ColumnCache::iterator col_it(col_lb);
+    if (col_lb == entries_cache.end() ||
+	entries_cache.key_comp()(nu_num, col_lb->first))
+      {
+	// insert a new column
+	typedef typename ColumnCache::value_type value_type;
+	col_it = entries_cache.insert(col_lb, value_type(nu_num, Column()));
+      }
+
+    Column& col(col_it->second);
+
+    // check whether the level has already been calculated
+    typename Column::iterator lb(col.lower_bound(j));
+    if (lb != col.end() && !col.key_comp()(j, lb->first))
+      return lb->second;
+
+    // collect the rows of the level block
+    std::list<Index> nus;
+    if (local_operator()) {
+      intersecting_wavelets(basis(), nu,
+			    std::max(j, basis().j0()),
+			    j == (basis().j0()-1),
+			    nus);
+    } else {
+      // for nonlocal operators, we put full level blocks into the cache
+      if (j == (basis().j0()-1)) {
+	for (Index lambda = basis().first_generator(basis().j0());; ++lambda) {
+	  nus.push_back(lambda);
+	  if (lambda == basis().last_generator(basis().j0())) break;
+	}
+      } else {
+	for (Index lambda = basis().first_wavelet(j);; ++lambda) {
+	  nus.push_back(lambda);
+	  if (lambda == basis().last_wavelet(j)) break;
+	}
+      }
+    }
+
+    // compute the entries of both operators
+    Block block;
+    for (typename std::list<Index>::const_iterator it(nus.begin()), itend(nus.end());
+	 it != itend; ++it) {
+      const Entry entry(gramian->a(*it, nu), elliptic->a(*it, nu));
+      if (entry.first != 0. || entry.second != 0.) {
+	block.insert(block.end(), typename Block::value_type((*it).number(), entry));
+	if ((*it).number() == nu_num)
+	  diagonal_cache.insert(std::make_pair(nu_num, entry));
+      }
+    }
+
+    typedef typename Column::value_type value_type;
+    return col.insert(lb, value_type(j, block))->second;
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  double
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::a(const Index& lambda,
+					      const Index& nu) const
+  {
+    // BE CAREFUL: KEY OF GENERATOR LEVEL IS j0-1 NOT j0 !!!!
+    typedef typename Index::type_type generator_type;
+    const int j = (lambda.e() == generator_type()) ? (lambda.j()-1) : lambda.j();
+
+    const Block& b(block(nu, j));
+    typename Block::const_iterator it(b.find(lambda.number()));
+
+    return (it == b.end() ? 0. : alpha_ * it->second.first + it->second.second);
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  template <class VECTOR>
+  void
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::add_level(const Index& lambda,
+						      VECTOR& w,
+						      const int j,
+						      const double factor,
+						      const int J,
+						      const CompressionStrategy strategy,
+						      const int jmax,
+						      const int pmax,
+						      const double a,
+						      const double b) const
+  {
+    const Block& blk(block(lambda, j));
+    const double d1 = D(lambda);
+
+    for (typename Block::const_iterator it(blk.begin()), itend(blk.end());
+	 it != itend; ++it) {
+      const Index& nu(*(basis().get_wavelet(it->first)));
+      if (strategy == St04a
+	  && !(abs(lambda.j()-j) <= J/((double) space_dimension) ||
+	       intersect_singular_support(basis(), lambda, nu)))
+	continue;
+
+      // the rows of the block are in the diagonal cache
+      const Entry& dnu(diagonal(nu));
+      w[it->first] += factor * (alpha_ * it->second.first + it->second.second)
+	/ (d1 * sqrt(alpha_ * dnu.first + dnu.second));
+    }
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  void
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::RHS(const double eta,
+						InfiniteVector<double, Index>& coeffs) const
+  {
+    elliptic->RHS(eta, coeffs);
+    coeffs.scale(elliptic, 1); // coeffs *= D
+    coeffs.scale(this, -1);    // coeffs *= D_alpha^{-1}
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  double
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::F_norm() const
+  {
+    InfiniteVector<double,Index> coeffs;
+    RHS(0., coeffs);
+    return l2_norm(coeffs);
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  void
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::compute_norms() const
+  {
+    std::set<Index> Lambda;
+    const int j0 = basis().j0();
+    const int jmax = std::min(j0+2, basis().jmax());
+    for (Index lambda = basis().first_generator(j0);; ++lambda) {
+      Lambda.insert(lambda);
+      if (lambda == basis().last_wavelet(jmax)) break;
+    }
+    SparseMatrix<double> A_Lambda;
+    setup_stiffness_matrix(*this, Lambda, A_Lambda);
+
+    Vector<double> xk(Lambda.size(), false), yk(Lambda.size(), false);
+    xk = 1, yk = 1;
+    unsigned int iterations;
+    const double lambdamax = MathTL::PowerIteration(A_Lambda, xk, 1e-3, 100, iterations);
+    const double lambdamin = MathTL::InversePowerIteration(A_Lambda, yk, 1e-1, 1e-3, 100, iterations);
+    if (givennormA == 0.0) normA = lambdamax;
+    if (givennormAinv == 0.0) normAinv = 1./lambdamin;
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  double
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::norm_A() const
+  {
+    if (normA == 0.0)
+      compute_norms();
+    return normA;
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  double
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::norm_Ainv() const
+  {
+    if (normAinv == 0.0)
+      compute_norms();
+    return normAinv;
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  void
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::InverseGramian::apply_preconditioner
+  (const Vector<double>& x, Vector<double>& y) const
+  {
+    y.resize(x.size());
+    unsigned int iterations;
+    CG(M_, x, y, 1e-12, M_.row_dimension(), iterations);
+  }
+
+  template <class GRAMIAN, class ELLIPTIC>
+  bool
+  CachedHelmholtzProblem<GRAMIAN,ELLIPTIC>::solve_shifted(const std::set<Index>& Lambda,
+							  const Array1D<double>& alphas,
+							  Array1D<InfiniteVector<double, Index> >& us,
+							  const double tol,
+							  const unsigned int maxiter,
+							  unsigned int& iterations) const
+  {
+    typedef typename SparseMatrix<double>::size_type size_type;
+
+    double alphamin = alphas.size() > 0 ? alphas[0] : 0.;
+    for (unsigned int s = 1; s < alphas.size(); s++)
+      alphamin = std::min(alphamin, alphas[s]);
+
+    // the positions of the indices within Lambda (-1 if not in Lambda), by number,
+    // and the levels of the blocks which may contain columns in Lambda
+    typedef typename Index::type_type generator_type;
+    int maxnumber = -1;
+    std::set<int> levels;
+    for (typename std::set<Index>::const_iterator it(Lambda.begin()), itend(Lambda.end());
+	 it != itend; ++it) {
+      maxnumber = std::max(maxnumber, (*it).number());
+      levels.insert(((*it).e() == generator_type()) ? ((*it).j()-1) : (*it).j());
+    }
+    std::vector<int> position(maxnumber+1, -1);
+    int id = 0;
+    for (typename std::set<Index>::const_iterator it(Lambda.begin()), itend(Lambda.end());
+	 it != itend; ++it, ++id)
+      position[(*it).number()] = id;
+
+    // setup M_Lambda, the seed matrix alphamin*M_Lambda + A_Lambda and f_Lambda,
+    // from the cached blocks of each row
+    SparseMatrix<double> M(Lambda.size()), S(Lambda.size());
+    Vector<double> f(Lambda.size());
+    size_type row = 0;
+    for (typename std::set<Index>::const_iterator it1(Lambda.begin()), itend(Lambda.end());
+	 it1 != itend; ++it1, ++row)
+      {
+	std::map<size_type, Entry> entries; // sorted by column
+	for (std::set<int>::const_iterator itj(levels.begin()); itj != levels.end(); ++itj) {
+	  const Block& b(block(*it1, *itj));
+	  for (typename Block::const_iterator it(b.begin()), itbend(b.end()); it != itbend; ++it)
+	    if (it->first <= maxnumber && position[it->first] >= 0)
+	      entries[position[it->first]] = it->second;
+	}
+	std::list<size_type> indices;
+	std::list<double> mentries, sentries;
+	for (typename std::map<size_type, Entry>::const_iterator it(entries.begin()), itend2(entries.end());
+	     it != itend2; ++it) {
+	  indices.push_back(it->first);
+	  mentries.push_back(it->second.first);
+	  sentries.push_back(alphamin * it->second.first + it->second.second);
+	}
+	M.set_row(row, indices, mentries);
+	S.set_row(row, indices, sentries);
+	f[row] = elliptic->f(*it1);
+      }
+
+    Array1D<double> shifts(alphas.size());
+    for (unsigned int s = 0; s < alphas.size(); s++)
+      shifts[s] = alphas[s] - alphamin;
+
+    Array1D<Vector<double> > xs;
+    const bool converged = MultiShiftPCG(S, f, InverseGramian(M), shifts, xs, tol, maxiter, iterations);
+
+    us.resize(alphas.size());
+    for (unsigned int s = 0; s < alphas.size(); s++) {
+      us[s].clear();
+      row = 0;
+      for (typename std::set<Index>::const_iterator it(Lambda.begin()), itend(Lambda.end());
+	   it != itend; ++it, ++row)
+	if (xs[s][row] != 0.)
+	  us[s].set_coefficient(*it, xs[s][row]);
+    }
+
+    return converged;
+  }
+}
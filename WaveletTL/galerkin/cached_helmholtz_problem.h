@@ -0,0 +1,275 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_CACHED_HELMHOLTZ_PROBLEM_H
+#define _WAVELETTL_CACHED_HELMHOLTZ_PROBLEM_H
+
+#include <map>
+#include <set>
+#include <utility>
+#include <utils/array1d.h>
+#include <algebra/vector.h>
+#include <algebra/infinite_vector.h>
+#include <algebra/sparse_matrix.h>
+#include <adaptive/compression.h>
+#include <galerkin/infinite_preconditioner.h>
+
+using MathTL::Array1D;
+using MathTL::Vector;
+using MathTL::InfiniteVector;
+using MathTL::SparseMatrix;
+
+namespace WaveletTL
+{
+  /*!
+    This class provides a cache layer for Helmholtz type problems
+      a_alpha(u,v) = alpha*<u,v> + a(u,v),  alpha >= 0,
+    where the Gramian part and the elliptic part a(.,.) are modeled by two
+    (uncached) problem classes GRAMIAN and ELLIPTIC on the same wavelet basis.
+
+    In contrast to CachedProblem<HelmholtzEquation>, the entries of the mass matrix M
+    and of the stiffness matrix A are cached separately (per column and level, as in
+    CachedProblem) and combined on the fly as alpha*M + A. The diagonal entries are
+    cached as well, so that the diagonal preconditioner
+      D_alpha(lambda) = sqrt(alpha*M_{lambda,lambda} + A_{lambda,lambda})
+    can be evaluated for any alpha without a single new integration.
+    So set_alpha() is free of charge, which is important for the stage equations of
+    ROW methods and W-methods, where alpha = 1/(h*gamma) changes from stage to stage.
+
+    For a fixed index set Lambda, solve_shifted() solves the Galerkin systems for several
+    values of alpha at once, reusing one Krylov space (see MultiShiftPCG()).
+
+    The template class CachedHelmholtzProblem implements the minimal signature to be
+    used within the APPLY routine.
+  */
+  template <class GRAMIAN, class ELLIPTIC>
+  class CachedHelmholtzProblem
+    : public FullyDiagonalEnergyNormPreconditioner<typename ELLIPTIC::Index>
+  {
+  public:
+    /*!
+      constructor from the uncached Gramian and elliptic problems,
+      you can specify the estimates for ||A|| and ||A^{-1}|| which are then used for all alpha
+      (if zero, CachedHelmholtzProblem will compute the estimates for the current alpha)
+    */
+    CachedHelmholtzProblem(const GRAMIAN* G,
+			   const ELLIPTIC* A,
+			   const double alpha = 0.0,
+			   const double normA = 0.0,
+			   const double normAinv = 0.0);
+
+    /*!
+      make wavelet basis type accessible
+    */
+    typedef typename ELLIPTIC::WaveletBasis WaveletBasis;
+
+    /*!
+      wavelet index class
+    */
+    typedef typename ELLIPTIC::Index Index;
+
+    /*!
+      read access to the basis
+    */
+    const WaveletBasis& basis() const { return elliptic->basis(); }
+
+    /*!
+      space dimension of the problem
+    */
+    static const int space_dimension = ELLIPTIC::space_dimension;
+
+    /*!
+      locality of the operator
+    */
+    static bool local_operator() { return ELLIPTIC::local_operator() && GRAMIAN::local_operator(); }
+
+    /*!
+      (half) order t of the operator
+    */
+    double operator_order() const { return elliptic->operator_order(); }
+
+    /*!
+      the current shift alpha
+    */
+    double alpha() const { return alpha_; }
+
+    /*!
+      set the shift alpha, the entry caches stay valid
+    */
+    void set_alpha(const double alpha) const;
+
+    /*!
+      evaluate the diagonal preconditioner D_alpha
+    */
+    double D(const Index& lambda) const;
+
+    /*
+     * access to the underlying problems
+     */
+    const GRAMIAN* get_gramian() const { return gramian; }
+    const ELLIPTIC* get_elliptic() const { return elliptic; }
+
+    /*!
+      evaluate the (unpreconditioned) bilinear form a_alpha
+      (cached)
+    */
+    double a(const Index& lambda,
+	     const Index& nu) const;
+
+    /*!
+      estimate the spectral norm ||A_alpha||
+    */
+    double norm_A() const;
+
+    /*!
+      estimate the spectral norm ||A_alpha^{-1}||
+    */
+    double norm_Ainv() const;
+
+    /*!
+      estimate compressibility exponent s^*
+    */
+    double s_star() const {
+      return elliptic->s_star();
+    }
+
+    /*!
+      estimate the compression constants alpha_k in
+      ||A-A_k|| <= alpha_k * 2^{-s*k}
+    */
+    double alphak(const unsigned int k) const {
+      return 2*norm_A(); // pessimistic
+    }
+
+    /*!
+      evaluate the (unpreconditioned) right-hand side f
+      (the one of the elliptic problem)
+    */
+    double f(const Index& lambda) const {
+      return elliptic->f(lambda);
+    }
+
+    /*!
+      approximate the wavelet coefficient set of the preconditioned right-hand side F,
+      i.e., the one of the elliptic problem, rescaled by D/D_alpha
+    */
+    void RHS(const double eta,
+	     InfiniteVector<double, Index>& coeffs) const;
+
+    /*!
+      compute (or estimate) ||F||_2
+    */
+    double F_norm() const;
+
+    /*!
+      w += factor * (stiffness matrix entries in column lambda on level j),
+      w is a dense vector indexed by numbers (Vector<double> or DenseAccumulator<double>);
+      as usual, j == j0-1 denotes the generators on level j0
+    */
+    template <class VECTOR>
+    void add_level (const Index& lambda,
+		    VECTOR& w,
+		    const int j,
+		    const double factor,
+		    const int J,
+		    const CompressionStrategy strategy = St04a,
+		    const int jmax = 99,
+		    const int pmax = 0,
+		    const double a = 0,
+		    const double b = 0) const;
+
+    /*!
+      Solve the (unpreconditioned) Galerkin systems
+        (alphas[s]*M_Lambda + A_Lambda) u_s = f_Lambda
+      for all given shifts at once, with a multi-shift CG iteration for the seed
+      system of the smallest alpha. The iteration is preconditioned with M_Lambda^{-1},
+      since this is the only preconditioner that does not destroy the shift structure
+      (the inverse is applied by an inner CG iteration; M_Lambda is well-conditioned
+      for L_2-Riesz bases). Hence the number of iterations is the one of
+      M_Lambda^{-1}(alpha_min*M_Lambda + A_Lambda), which grows with the finest level
+      in Lambda for small alpha_min. The mode pays off for several large values of alpha
+      on the same index set, e.g., for the stages of a ROW method.
+      \param tol relative residual tolerance of each system
+      \param iterations number of (outer) cg iterations
+      \return convergence within <maxiter> iterations
+    */
+    bool solve_shifted(const std::set<Index>& Lambda,
+		       const Array1D<double>& alphas,
+		       Array1D<InfiniteVector<double, Index> >& us,
+		       const double tol,
+		       const unsigned int maxiter,
+		       unsigned int& iterations) const;
+
+    /*!
+      clear the entry caches
+    */
+    void clear_cache() {
+      entries_cache.clear();
+      diagonal_cache.clear();
+    }
+
+  protected:
+    //! the underlying (uncached) problems
+    const GRAMIAN* gramian;
+    const ELLIPTIC* elliptic;
+
+    //! the current shift
+    mutable double alpha_;
+
+    // type of one entry, (Gramian entry, elliptic entry)
+    typedef std::pair<double,double> Entry;
+
+    // type of one block in one column of M and A
+    typedef std::map<int, Entry> Block;
+
+    // type of one column in the entry cache,
+    // the key codes the level, that data are the entries
+    typedef std::map<int, Block> Column;
+
+    // type of the entry cache
+    typedef std::map<int, Column> ColumnCache;
+
+    // entries cache for M and A (mutable to overcome the constness of a())
+    mutable ColumnCache entries_cache;
+
+    // cache of the diagonal entries of M and A, the key is the number of the index
+    mutable std::map<int, Entry> diagonal_cache;
+
+    // estimates for ||A_alpha|| and ||A_alpha^{-1}|| given by the user
+    double givennormA, givennormAinv;
+
+    // estimates for ||A_alpha|| and ||A_alpha^{-1}|| for the current alpha
+    mutable double normA, normAinv;
+
+    //! get (or compute) the block of column nu on level j (j == j0-1 denotes the generators)
+    const Block& block(const Index& nu, const int j) const;
+
+    //! get (or compute) the diagonal entries of M and A for lambda
+    const Entry& diagonal(const Index& lambda) const;
+
+    //! compute the estimates for ||A_alpha|| and ||A_alpha^{-1}||
+    void compute_norms() const;
+
+    /*!
+      the preconditioner of solve_shifted(), applying M_Lambda^{-1} by a CG iteration
+    */
+    class InverseGramian
+    {
+    public:
+      InverseGramian(const SparseMatrix<double>& M) : M_(M) {}
+      void apply_preconditioner(const Vector<double>& x, Vector<double>& y) const;
+    protected:
+      const SparseMatrix<double>& M_;
+    };
+  };
+}
+
+#include <galerkin/cached_helmholtz_problem.cpp>
+
+#endif
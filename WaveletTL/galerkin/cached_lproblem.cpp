@@ -270,10 +270,11 @@ namespace WaveletTL
     }
 
     template <class PROBLEM>
+    template <class VECTOR>
     void
     CachedLProblem<PROBLEM>::add_ball(const Index& lambda,
 				      //InfiniteVector<double, Index>& w,
-				      Vector<double>& w,
+				      VECTOR& w,
 				      const int radius,
 				      const double factor,
 				      const int maxlevel,
@@ -393,9 +394,10 @@ namespace WaveletTL
     }
 
     template <class PROBLEM>
+    template <class VECTOR>
     void
     CachedLProblem<PROBLEM>::add_level_recurse(const Index& lambda,
-                                               Vector<double>& w,
+                                               VECTOR& w,
                                                const int radius,
                                                const double factor,
                                                const int current_level,
@@ -239,9 +239,10 @@ namespace WaveletTL
          * "strategy" argument ist needed for compatibility with compression.h .
          * There is only 1 strategy for TBasis at the moment
          */
+        template <class VECTOR>
         void add_ball(const Index& lambda,
                      //InfiniteVector<double, Index>& w,
-                     Vector<double>& w,
+                     VECTOR& w,
                      const int radius,
                      const double factor,
                      const int maxlevel,
@@ -268,8 +269,9 @@ namespace WaveletTL
          * All dimensions are visited with the current dimension denoted by current_dim.
          * Indices with the highest recursion depth (level = DIM) are added to w
          */
+        template <class VECTOR>
         void add_level_recurse(const Index& lambda,
-                               Vector<double>& w,
+                               VECTOR& w,
                                const int radius,
                                const double factor,
                                const int current_level,
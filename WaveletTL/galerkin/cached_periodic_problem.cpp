@@ -0,0 +1,305 @@
+// implementation for cached_periodic_problem.h
+
+#include <cassert>
+#include <cmath>
+#include <list>
+#include <algorithm>
+#include <numerics/fft.h>
+
+namespace WaveletTL
+{
+  template <class PROBLEM>
+  CachedPeriodicProblem<PROBLEM>::CachedPeriodicProblem(const PROBLEM* P,
+							const double estnormA,
+							const double estnormAinv)
+    : problem(P),
+      normA(estnormA > 0 ? estnormA : P->norm_A()),
+      normAinv(estnormAinv > 0 ? estnormAinv : P->norm_Ainv()),
+      fft_density(0.25),
+      apply_density(0.5)
+  {
+  }
+
+  template <class PROBLEM>
+  inline
+  std::pair<int,int>
+  CachedPeriodicProblem<PROBLEM>::level_type(const int j) const
+  {
+    const int j0 = basis().j0();
+    return (j < j0 ? std::make_pair(j0, 0) : std::make_pair(j, 1));
+  }
+
+  template <class PROBLEM>
+  const typename CachedPeriodicProblem<PROBLEM>::Stencil&
+  CachedPeriodicProblem<PROBLEM>::stencil(const std::pair<int,int>& rowtype,
+					  const std::pair<int,int>& coltype) const
+  {
+    const StencilKey key(rowtype, coltype);
+    typename std::map<StencilKey, Stencil>::iterator lb(stencils.lower_bound(key));
+    if (lb != stencils.end() && !stencils.key_comp()(key, lb->first))
+      return lb->second;
+
+    // compute the nontrivial entries for the translate k=0 of the coarser level type
+    // (for equal levels, the row index is fixed)
+    const bool fixed_row = rowtype.first <= coltype.first;
+    const Index anchor(fixed_row
+		       ? Index(rowtype.first, rowtype.second, 0)
+		       : Index(coltype.first, coltype.second, 0));
+    const std::pair<int,int>& other(fixed_row ? coltype : rowtype);
+
+    std::list<Index> nus;
+    intersecting_wavelets(basis(), anchor, other.first, other.second == 0, nus);
+
+    std::map<int,double> entries;
+    for (typename std::list<Index>::const_iterator it(nus.begin()), itend(nus.end());
+	 it != itend; ++it) {
+      const double entry = fixed_row ? problem->a(anchor, *it) : problem->a(*it, anchor);
+      if (entry != 0.)
+	entries[(*it).k()] = entry;
+    }
+
+    Stencil s;
+    s.period = 1<<other.first;
+    s.first = 0;
+    int length = 0;
+    if (!entries.empty()) {
+      // the band starts behind the largest (circular) gap between the nontrivial offsets
+      int gap = entries.begin()->first + s.period - entries.rbegin()->first;
+      s.first = entries.begin()->first;
+      for (std::map<int,double>::const_iterator it(entries.begin()), itnext(++entries.begin());
+	   itnext != entries.end(); ++it, ++itnext) {
+	if (itnext->first - it->first > gap) {
+	  gap = itnext->first - it->first;
+	  s.first = itnext->first;
+	}
+      }
+      length = s.period - gap + 1;
+    }
+    s.entries.resize(length);
+    for (int i = 0; i < length; i++)
+      s.entries[i] = 0;
+    for (std::map<int,double>::const_iterator it(entries.begin()); it != entries.end(); ++it)
+      s.entries[(it->first - s.first) & (s.period-1)] = it->second;
+
+    return stencils.insert(lb, std::make_pair(key, s))->second;
+  }
+
+  template <class PROBLEM>
+  double
+  CachedPeriodicProblem<PROBLEM>::a(const Index& lambda,
+				    const Index& nu) const
+  {
+    const Stencil& s(stencil(std::make_pair(lambda.j(), (int)lambda.e()),
+			     std::make_pair(nu.j(), (int)nu.e())));
+
+    // offset of the finer index, relative to the translate k=0 of the coarser one
+    const int offset = (lambda.j() <= nu.j()
+			? nu.k() - (lambda.k() << (nu.j()-lambda.j()))
+			: lambda.k() - (nu.k() << (lambda.j()-nu.j())));
+    const unsigned int i((offset - s.first) & (s.period-1));
+
+    return (i < s.entries.size() ? s.entries[i] : 0.);
+  }
+
+  template <class PROBLEM>
+  template <class VECTOR>
+  void
+  CachedPeriodicProblem<PROBLEM>::add_level(const Index& lambda,
+					    VECTOR& w,
+					    const int j,
+					    const double factor,
+					    const int J,
+					    const CompressionStrategy strategy,
+					    const int jmax,
+					    const int pmax,
+					    const double a,
+					    const double b) const
+  {
+    // On the periodic interval, intersect_singular_support() coincides with
+    // intersect_supports(), so both St04a and CDD1 keep all nontrivial entries
+    // of the level.
+    const std::pair<int,int> rowtype(level_type(j));
+    const Stencil& s(stencil(rowtype, std::make_pair(lambda.j(), (int)lambda.e())));
+
+    // D is translation invariant
+    const double d1 = D(lambda);
+    const double d2 = D(Index(rowtype.first, rowtype.second, 0));
+    const double scale = factor / (d1*d2);
+
+    const int mask = s.period-1;
+    if (rowtype.first <= lambda.j()) {
+      // rows on a coarser level: nu.k() = (lambda.k()-offset)/2^d, if divisible
+      const int d = lambda.j()-rowtype.first;
+      const int divmask = (1<<d)-1;
+      for (unsigned int t = 0; t < s.entries.size(); t++) {
+	const int m = (lambda.k() - s.first - (int)t) & mask;
+	if ((m & divmask) == 0 && s.entries[t] != 0.)
+	  w[Index(rowtype.first, rowtype.second, m >> d).number()] += s.entries[t] * scale;
+      }
+    } else {
+      // rows on a finer level: nu.k() = 2^d*lambda.k()+offset
+      const int shift = lambda.k() << (rowtype.first-lambda.j());
+      for (unsigned int t = 0; t < s.entries.size(); t++)
+	if (s.entries[t] != 0.)
+	  w[Index(rowtype.first, rowtype.second, (shift + s.first + (int)t) & mask).number()]
+	    += s.entries[t] * scale;
+    }
+  }
+
+  template <class PROBLEM>
+  void
+  CachedPeriodicProblem<PROBLEM>::apply_level(const int j, const int jprime,
+					      const Vector<double>& x, Vector<double>& y,
+					      const double factor) const
+  {
+    const std::pair<int,int> rowtype(level_type(j)), coltype(level_type(jprime));
+    const int nrows = 1<<rowtype.first, ncols = 1<<coltype.first;
+    assert(x.size() == (unsigned int)ncols && y.size() == (unsigned int)nrows);
+
+    const Stencil& s(stencil(rowtype, coltype));
+    const int length = s.entries.size();
+    const int mask = s.period-1;
+    const bool fixed_row = rowtype.first <= coltype.first;
+    const int d = fixed_row ? coltype.first-rowtype.first : rowtype.first-coltype.first;
+
+    const double scale = factor
+      / (D(Index(rowtype.first, rowtype.second, 0)) * D(Index(coltype.first, coltype.second, 0)));
+
+    // direct summation costs O(period*density) operations, the FFT path O(period*log(period))
+    if (length <= fft_density * s.period) {
+      if (fixed_row) {
+	// y_i += \sum_t S_t x_{(first+t+2^d i) mod period}
+	for (int i = 0; i < nrows; i++) {
+	  double yi = 0;
+	  for (int t = 0; t < length; t++)
+	    yi += s.entries[t] * x[(s.first + t + (i << d)) & mask];
+	  y[i] += scale * yi;
+	}
+      } else {
+	// y_{(first+t+2^d m) mod period} += S_t x_m
+	for (int m = 0; m < ncols; m++) {
+	  const double xm = scale * x[m];
+	  if (xm != 0.)
+	    for (int t = 0; t < length; t++)
+	      y[(s.first + t + (m << d)) & mask] += s.entries[t] * xm;
+	}
+      }
+    } else {
+      // the full stencil, S_o for all offsets o
+      Vector<double> full(s.period), v(s.period), z;
+      for (int t = 0; t < length; t++)
+	full[(s.first + t) & mask] = s.entries[t];
+
+      if (fixed_row) {
+	// circular correlation z_o = \sum_l S_l x_{l+o} = (reversed S * x)_o,
+	// y_i += z_{2^d i}
+	for (int l = 0; l < s.period; l++)
+	  v[l] = full[(-l) & mask];
+	circular_convolution(v, x, z);
+	for (int i = 0; i < nrows; i++)
+	  y[i] += scale * z[i << d];
+      } else {
+	// circular convolution of S with the upsampled x
+	for (int m = 0; m < ncols; m++)
+	  v[m << d] = x[m];
+	circular_convolution(full, v, z);
+	for (int i = 0; i < nrows; i++)
+	  y[i] += scale * z[i];
+      }
+    }
+  }
+
+  template <class PROBLEM>
+  template <class VECTOR>
+  void
+  CachedPeriodicProblem<PROBLEM>::add_compressed_level(const int jprime,
+						       const Vector<double>& x,
+						       const int J,
+						       VECTOR& w,
+						       const double factor,
+						       const int jmax,
+						       const CompressionStrategy strategy) const
+  {
+    // the row levels of add_compressed_column(), for d == 1
+    const int j0 = basis().j0();
+    const int lambda_j = std::max(jprime, j0);
+    int minlevel = j0-1, maxlevel = j0-2;
+    if (strategy == CDD1) {
+      minlevel = std::max(j0-1, lambda_j-J);
+      maxlevel = std::min(lambda_j+J, jmax);
+    } else if (strategy == St04a) {
+      const double kjd = std::max((double)J, ceil(J*(operator_order()+basis().primal_vanishing_moments()) /
+						  ((double) basis().primal_regularity()-operator_order()-0.5)));
+      minlevel = std::max(j0-1, (int)ceil(lambda_j-kjd));
+      maxlevel = std::min((int)floor(lambda_j+kjd), jmax);
+    }
+
+    for (int j = minlevel; j <= maxlevel; j++) {
+      const std::pair<int,int> rowtype(level_type(j));
+      Vector<double> y(1<<rowtype.first);
+      apply_level(j, jprime, x, y, factor);
+      for (unsigned int i = 0; i < y.size(); i++)
+	if (y[i] != 0.)
+	  w[Index(rowtype.first, rowtype.second, i).number()] += y[i];
+    }
+  }
+
+  template <class PROBLEM>
+  void APPLY(const CachedPeriodicProblem<PROBLEM>& P,
+	     const InfiniteVector<double, typename PROBLEM::Index>& v,
+	     const double eta,
+	     InfiniteVector<double, typename PROBLEM::Index>& w,
+	     const int jmax,
+	     const CompressionStrategy strategy)
+  {
+    typedef typename PROBLEM::Index Index;
+
+    w.clear();
+    if (v.size() == 0) return;
+
+    std::vector<std::pair<Index, double> > entries;
+    entries.reserve(v.size());
+    for (typename InfiniteVector<double,Index>::const_iterator it(v.begin());
+	 it != v.end(); ++it)
+      entries.push_back(std::make_pair(it.index(), *it));
+
+    std::list<std::list<std::pair<Index, double> > > vks;
+    const unsigned int J = APPLY_binning(P, entries, eta, vks);
+
+    DenseAccumulator<double> ww(P.basis().degrees_of_freedom());
+
+    // compute w = \sum_{k=0}^\ell A_{J-k}v_{[k]}, level by level within each segment
+    // (the key of a level is j' in the notation of add_level(), j0-1 for the generators)
+    const bool levelwise = (strategy == CDD1 || strategy == St04a);
+    const int j0 = P.basis().j0();
+    unsigned int k = 0;
+    for (typename std::list<std::list<std::pair<Index, double> > >::const_iterator it(vks.begin());
+	 it != vks.end(); ++it, ++k) {
+      std::map<int, std::list<std::pair<Index, double> > > levels;
+      for (typename std::list<std::pair<Index, double> >::const_iterator itk(it->begin());
+	   itk != it->end(); ++itk)
+	levels[itk->first.e() == 0 ? j0-1 : itk->first.j()].push_back(*itk);
+
+      for (typename std::map<int, std::list<std::pair<Index, double> > >::const_iterator
+	     itl(levels.begin()); itl != levels.end(); ++itl) {
+	const int translates = 1 << std::max(itl->first, j0);
+	if (levelwise && itl->second.size() >= P.get_apply_density() * translates) {
+	  Vector<double> x(translates);
+	  for (typename std::list<std::pair<Index, double> >::const_iterator itx(itl->second.begin());
+	       itx != itl->second.end(); ++itx)
+	    x[itx->first.k()] = itx->second;
+	  P.add_compressed_level(itl->first, x, J-k, ww, 1.0, jmax, strategy);
+	} else {
+	  for (typename std::list<std::pair<Index, double> >::const_iterator itx(itl->second.begin());
+	       itx != itl->second.end(); ++itx)
+	    add_compressed_column(P, itx->second, itx->first, J-k, ww, jmax, strategy, true);
+	}
+      }
+    }
+
+    NumberedVector<double> wn;
+    ww.extract(wn);
+    for (typename NumberedVector<double>::size_type n = 0; n < wn.size(); n++)
+      w.push_back(*(P.basis().get_wavelet(wn.number(n))), wn.value(n));
+  }
+}
@@ -0,0 +1,289 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner, Philipp Keding                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_CACHED_PERIODIC_PROBLEM_H
+#define _WAVELETTL_CACHED_PERIODIC_PROBLEM_H
+
+#include <map>
+#include <utility>
+#include <utils/array1d.h>
+#include <algebra/vector.h>
+#include <algebra/infinite_vector.h>
+#include <adaptive/compression.h>
+#include <adaptive/apply.h>
+#include <galerkin/infinite_preconditioner.h>
+
+using MathTL::Array1D;
+using MathTL::Vector;
+using MathTL::InfiniteVector;
+
+namespace WaveletTL
+{
+  /*!
+    This class provides a cache layer for (preconditioned) matrix problems
+    on a periodic wavelet basis PeriodicBasis<RBASIS>, like PeriodicIntervalLaplacian
+    or PeriodicIntervalGramian.
+
+    On the periodic interval, the translates of a generator or wavelet are
+    shifts of each other, psi_{j,e,k}(x) = psi_{j,e,0}(x-2^{-j}k). For a translation
+    invariant operator, the entry a(psi_{j,e,k},psi_{j',e',k'}) with j <= j'
+    thus depends only on (j,e,j',e') and the offset k'-2^{j'-j}k mod 2^{j'}.
+    Instead of caching the single entries per column (cf. CachedProblem), we
+    store one stencil per pair of level types (j,e),(j',e'), i.e., the band of
+    nontrivial entries relative to the translate k=0 of the coarser index.
+    So the cache needs O(levels^2 * bandwidth) entries instead of
+    O(degrees of freedom * bandwidth), and add_level() amounts to copying
+    a band of contiguous values.
+
+    Full level blocks can be applied with apply_level() by a circular convolution,
+    which is done via FFT for dense stencils. APPLY (see below) uses this for
+    the levels on which v is dense, and add_level() for the others.
+
+    The diagonal preconditioner is D(lambda) = sqrt(a(lambda,lambda)), as in CachedProblem.
+
+    The template class CachedPeriodicProblem implements the minimal signature to be
+    used within the APPLY routine.
+  */
+  template <class PROBLEM>
+  class CachedPeriodicProblem
+    : public FullyDiagonalEnergyNormPreconditioner<typename PROBLEM::Index>
+  {
+  public:
+    /*!
+      constructor from an uncached problem,
+      you can specify the estimates for ||A|| and ||A^{-1}||
+      (if zero, the estimates of the uncached problem are used)
+    */
+    CachedPeriodicProblem(const PROBLEM* P,
+			  const double normA = 0.0,
+			  const double normAinv = 0.0);
+
+    /*!
+      make wavelet basis type accessible
+    */
+    typedef typename PROBLEM::WaveletBasis WaveletBasis;
+
+    /*!
+      wavelet index class
+    */
+    typedef typename PROBLEM::Index Index;
+
+    /*!
+      read access to the basis
+    */
+    const WaveletBasis& basis() const { return problem->basis(); }
+
+    /*!
+      space dimension of the problem
+    */
+    static const int space_dimension = PROBLEM::space_dimension;
+
+    /*!
+      locality of the operator
+    */
+    static bool local_operator() { return PROBLEM::local_operator(); }
+
+    /*!
+      (half) order t of the operator
+    */
+    double operator_order() const { return problem->operator_order(); }
+
+    /*!
+      evaluate the diagonal preconditioner D
+    */
+    double D(const Index& lambda) const { return sqrt(a(lambda, lambda)); }
+
+    /*
+     * access to the underlying problem
+     */
+    const PROBLEM* get_problem() const { return problem; }
+
+    /*!
+      evaluate the (unpreconditioned) bilinear form a
+      (cached)
+    */
+    double a(const Index& lambda,
+	     const Index& nu) const;
+
+    /*!
+      estimate the spectral norm ||A||
+    */
+    double norm_A() const { return normA; }
+
+    /*!
+      estimate the spectral norm ||A^{-1}||
+    */
+    double norm_Ainv() const { return normAinv; }
+
+    /*!
+      estimate compressibility exponent s^*
+    */
+    double s_star() const {
+      return problem->s_star();
+    }
+
+    /*!
+      estimate the compression constants alpha_k in
+      ||A-A_k|| <= alpha_k * 2^{-s*k}
+    */
+    double alphak(const unsigned int k) const {
+      return 2*norm_A(); // pessimistic
+    }
+
+    /*!
+      evaluate the (unpreconditioned) right-hand side f
+    */
+    double f(const Index& lambda) const {
+      return problem->f(lambda);
+    }
+
+    /*!
+      approximate the wavelet coefficient set of the preconditioned right-hand side F
+      within a prescribed \ell_2 error tolerance
+    */
+    void RHS(const double eta,
+	     InfiniteVector<double, Index>& coeffs) const {
+      problem->RHS(eta, coeffs);
+    }
+
+    /*!
+      compute (or estimate) ||F||_2
+    */
+    double F_norm() const { return problem->F_norm(); }
+
+    /*!
+      w += factor * (stiffness matrix entries in column lambda on level j),
+      w is a dense vector indexed by numbers (Vector<double> or DenseAccumulator<double>);
+      as usual, j == j0-1 denotes the generators on level j0
+    */
+    template <class VECTOR>
+    void add_level (const Index& lambda,
+		    VECTOR& w,
+		    const int j,
+		    const double factor,
+		    const int J,
+		    const CompressionStrategy strategy = St04a,
+		    const int jmax = 99,
+		    const int pmax = 0,
+		    const double a = 0,
+		    const double b = 0) const;
+
+    /*!
+      y += factor * A_{j,j'} x for a full level block of the preconditioned stiffness matrix,
+      where x holds the coefficients of all translates on the column level j'
+      and y the ones on the row level j (indexed by k, j == j0-1 denotes the generators);
+      dense stencils are applied by FFT
+    */
+    void apply_level(const int j, const int jprime,
+		     const Vector<double>& x, Vector<double>& y,
+		     const double factor = 1.0) const;
+
+    /*!
+      w += factor * A_{J} x for all coefficients x (indexed by k) on the column
+      level j', i.e., the compressed columns of all translates on that level,
+      with the row levels of add_compressed_column() (strategies CDD1 and St04a);
+      w is a dense vector indexed by numbers
+    */
+    template <class VECTOR>
+    void add_compressed_level(const int jprime,
+			      const Vector<double>& x,
+			      const int J,
+			      VECTOR& w,
+			      const double factor = 1.0,
+			      const int jmax = 99,
+			      const CompressionStrategy strategy = St04a) const;
+
+    /*!
+      set the density (length of the band / number of translates) from which on
+      apply_level() uses the FFT path (default: 0.25)
+    */
+    void set_fft_density(const double density) { fft_density = density; }
+
+    /*!
+      set the density (number of active coefficients / number of translates) from which on
+      APPLY handles the coefficients of a level by add_compressed_level() (default: 0.5)
+    */
+    void set_apply_density(const double density) { apply_density = density; }
+
+    //! the density from which on APPLY works level-wise
+    double get_apply_density() const { return apply_density; }
+
+    /*!
+      clear the stencil cache
+    */
+    void clear_cache() { stencils.clear(); }
+
+    /*!
+      number of cached stencils
+    */
+    unsigned int stencil_count() const { return stencils.size(); }
+
+  protected:
+    //! the underlying (uncached) problem
+    const PROBLEM* problem;
+
+    /*!
+      nontrivial entries in the row (or column) of the translate k=0 of the
+      coarser level type, entries[i] belongs to the offset (first+i) mod period
+    */
+    struct Stencil
+    {
+      //! 2^j of the finer level
+      int period;
+
+      //! first offset of the band
+      int first;
+
+      //! values in the band
+      Array1D<double> entries;
+    };
+
+    //! key of a stencil: level type (j,e) of the row and of the column index
+    typedef std::pair<std::pair<int,int>, std::pair<int,int> > StencilKey;
+
+    //! stencil cache (mutable to overcome the constness of a())
+    mutable std::map<StencilKey, Stencil> stencils;
+
+    // estimates for ||A|| and ||A^{-1}||
+    double normA, normAinv;
+
+    // stencil density from which on apply_level() uses FFT
+    double fft_density;
+
+    // density of the active coefficients from which on APPLY works level-wise
+    double apply_density;
+
+    //! level type (j,e) of the row/column level j in the notation of add_level()
+    std::pair<int,int> level_type(const int j) const;
+
+    //! get (or compute) the stencil for rows of type (jrow,erow) and columns of type (jcol,ecol)
+    const Stencil& stencil(const std::pair<int,int>& rowtype,
+			   const std::pair<int,int>& coltype) const;
+  };
+
+  /*!
+    APPLY for the stencil cache layer, with the same binning and compression as
+    APPLY in apply.h. Within each segment v_{[k]}, the coefficients are grouped by
+    their level. A level with at least the fraction get_apply_density() of its
+    translates active is applied at once by add_compressed_level(), all other
+    coefficients column by column. For compression strategies other than CDD1
+    and St04a, all coefficients are applied column by column.
+  */
+  template <class PROBLEM>
+  void APPLY(const CachedPeriodicProblem<PROBLEM>& P,
+	     const InfiniteVector<double, typename PROBLEM::Index>& v,
+	     const double eta,
+	     InfiniteVector<double, typename PROBLEM::Index>& w,
+	     const int jmax = 99,
+	     const CompressionStrategy strategy = St04a);
+}
+
+#include <galerkin/cached_periodic_problem.cpp>
+
+#endif
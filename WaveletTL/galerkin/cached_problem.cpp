@@ -15,6 +15,28 @@ namespace WaveletTL
   {
   }
 
+  template <class PROBLEM>
+  typename CachedProblem<PROBLEM>::Column&
+  CachedProblem<PROBLEM>::column(const int number) const
+  {
+    // the map of the columns is shared by all threads, while a column itself
+    // is only filled by the thread working on it
+    Column* col = 0;
+#pragma omp critical (WaveletTL_CachedProblem_column)
+    {
+      typename ColumnCache::iterator col_lb(entries_cache.lower_bound(number));
+      if (col_lb == entries_cache.end() ||
+	  entries_cache.key_comp()(number, col_lb->first))
+	{
+	  // insert a new column
+	  typedef typename ColumnCache::value_type value_type;
+	  col_lb = entries_cache.insert(col_lb, value_type(number, Column()));
+	}
+      col = &col_lb->second;
+    }
+    return *col;
+  }
+
   template <class PROBLEM>
   double
   CachedProblem<PROBLEM>::a(const Index& lambda,
@@ -41,20 +63,8 @@ namespace WaveletTL
       // check wether entry has already been computed
       typedef std::list<Index> IntersectingList;
 
-      // search for column 'mu'
-      typename ColumnCache::iterator col_lb(entries_cache.lower_bound(nu_num));
-      typename ColumnCache::iterator col_it(col_lb);
-      
-      if (col_lb == entries_cache.end() ||
-	  entries_cache.key_comp()(nu_num, col_lb->first))
-	
-	{
-	  // insert a new column
-	  typedef typename ColumnCache::value_type value_type;
-	  col_it = entries_cache.insert(col_lb, value_type(nu_num, Column()));
-	}
-	  
-      Column& col(col_it->second);
+      // column 'mu' (inserted if necessary)
+      Column& col(column(nu_num));
       
       // check wether the level 'lambda' belongs to has already been calculated
       typename Column::iterator lb(col.lower_bound(j));
@@ -140,19 +150,8 @@ namespace WaveletTL
       typedef typename Index::type_type generator_type;
       int j = (lambda.e() == generator_type()) ? (lambda.j()-1) : lambda.j();
 
-      // search for column 'mu'
-      typename ColumnCache::iterator col_lb(entries_cache.lower_bound(nu_num));
-      typename ColumnCache::iterator col_it(col_lb);
-
-      if (col_lb == entries_cache.end() ||
-	  entries_cache.key_comp()(nu_num, col_lb->first))
-	  {
-	    // insert a new column
-	    typedef typename ColumnCache::value_type value_type;
-	    col_it = entries_cache.insert(col_lb, value_type(nu_num, Column()));
-	  }
-
-      Column& col(col_it->second);
+      // column 'mu' (inserted if necessary)
+      Column& col(column(nu_num));
 
       // check wether the level block which 'lambda' belongs to has already been calculated
       typename Column::iterator lb(col.lower_bound(j));
@@ -256,10 +255,11 @@ namespace WaveletTL
   }
   
   template <class PROBLEM>
+  template <class VECTOR>
   void
   CachedProblem<PROBLEM>::add_level(const Index& lambda,
 				     //InfiniteVector<double, Index>& w,
-				     Vector<double>& w,
+				     VECTOR& w,
 				     const int j,
 				     const double factor,
 				     const int J,
@@ -273,20 +273,13 @@ namespace WaveletTL
 
       int lambda_num = lambda.number();
 
-      // search for column 'lambda'
-      typedef std::list<Index> IntersectingList;
-      typename ColumnCache::iterator col_lb(entries_cache.lower_bound(lambda_num));
-      typename ColumnCache::iterator col_it(col_lb);
-	 
-      if (col_lb == entries_cache.end() ||
-	  entries_cache.key_comp()(lambda_num,col_lb->first))
-	{
-	  // insert a new column
-	  typedef typename ColumnCache::value_type value_type;
-	  col_it = entries_cache.insert(col_lb, value_type(lambda_num, Column()));
-	}
+      // D(lambda) may compute and cache levels of the column lambda itself,
+      // so it has to be evaluated before an (empty) level block is inserted below
+      const double d1 = D(lambda);
 
-      Column& col(col_it->second);
+      typedef std::list<Index> IntersectingList;
+      // column 'lambda' (inserted if necessary)
+      Column& col(column(lambda_num));
 
       // check wether the level has already been calculated
       typename Column::iterator lb(col.lower_bound(j));
@@ -311,7 +304,6 @@ namespace WaveletTL
 	  Block& block(it->second);
 
 	    // do the rest of the job
-	    const double d1 = D(lambda);
 	    if (strategy == St04a)
 	    {
 	      for (typename IntersectingList::iterator it2(nus.begin()), itend2(nus.end());
@@ -351,8 +343,6 @@ namespace WaveletTL
 
 	    Block& block(it->second);
 
-	    const double d1 = D(lambda);
-
 	    // do the rest of the job
 	    if (strategy == St04a)
 	    {
@@ -405,19 +395,8 @@ namespace WaveletTL
 
       const int lambda_num = lambda.number();
 
-      // search for column 'lambda'
-      typename ColumnCache::iterator col_lb(entries_cache.lower_bound(lambda_num));
-      typename ColumnCache::iterator col_it(col_lb);
-      
-      if (col_lb == entries_cache.end() ||
-	  entries_cache.key_comp()(lambda_num, col_lb->first))
-	{
-	  // insert a new column
-	  typedef typename ColumnCache::value_type value_type;
-	  col_it = entries_cache.insert(col_lb, value_type(lambda_num, Column()));
-	}
-      
-      Column& col(col_it->second);
+      // column 'lambda' (inserted if necessary)
+      Column& col(column(lambda_num));
       
       // check wether the level block which 'lambda' belongs to has already been calculated
       typename Column::iterator lb(col.lower_bound(j));
@@ -15,6 +15,7 @@
 #include <algebra/sparse_matrix.h>
 #include <adaptive/compression.h>
 #include <galerkin/infinite_preconditioner.h>
+#include <galerkin/galerkin_utils.h>
 
 using MathTL::InfiniteVector;
 
@@ -184,11 +185,13 @@ namespace WaveletTL
     double F_norm() const { return problem->F_norm(); }
     
     /*!
-      w += factor * (stiffness matrix entries in column lambda on level j, p)
+      w += factor * (stiffness matrix entries in column lambda on level j, p),
+      w is a dense vector indexed by numbers (Vector<double> or DenseAccumulator<double>)
     */
+    template <class VECTOR>
     void add_level (const Index& lambda,
 		    //InfiniteVector<double, Index>& w,
-		    Vector<double>& w,
+		    VECTOR& w,
 		    const int j,
 		    const double factor,
 		    const int J,
@@ -226,11 +229,26 @@ namespace WaveletTL
 
     // entries cache for A (mutable to overcome the constness of add_column())
     mutable ColumnCache entries_cache;
+
+    // the column of entries_cache with the given number, inserted if necessary
+    // (thread-safe, the column itself is not guarded)
+    Column& column(const int number) const;
     
     // estimates for ||A|| and ||A^{-1}||
     mutable double normA, normAinv;
   };
 
+  /*!
+    The columns of the entries cache are inserted in a critical section,
+    so CachedProblem<PROBLEM> computes entries of distinct columns concurrently
+    whenever PROBLEM does.
+  */
+  template <class PROBLEM>
+  struct ConcurrentEntries<CachedProblem<PROBLEM> >
+  {
+    static const bool value = ConcurrentEntries<PROBLEM>::value;
+  };
+
   /*!
     This class provides a cache layer for generic (preconditioned, cf. precond.h)
     infinite-dimensional matrix problems of the form
@@ -2007,6 +2007,10 @@ sdfsdf
             // iterate the levellines. offset relative to center_j's levelline
             for (int offset = -std::min(dist2j0,(int)radius); offset < std::min(dist2maxlevel,(int)radius)+1; offset++)
             {
+                // the intersections are computed anew for every levelline
+                intersection.clear();
+                intersection_x.clear();
+                intersection_y.clear();
                 // iterate over the levels on the levelline
                 // ignoring restrictions by j0 for the moment, we have:
                 
@@ -2559,6 +2563,12 @@ sdfsdf
         FixedArray1D<bool,DIM> mu_min_type;
         FixedArray1D< Block*, DIM> waveletBlock;
         FixedArray1D< Block*, DIM> generatorBlock;
+        // the 1d caches are shared between threads. A missing level block is computed into
+        // a local Block outside of the critical sections, only the lookup and the insertion
+        // are serialized (if another thread has inserted the block meanwhile, the local one
+        // is discarded). Blocks are never modified after their insertion, and std::map does
+        // not move its elements, so the pointers stay valid outside.
+        bool intersecting(true);
         for (unsigned int i=0; i<DIM; i++)
         {
             lami_basisnum = (((basis_->get_bc()[lambda_p][2*i])?0:2) + ((basis_->get_bc()[lambda_p][2*i+1])?0:1));
@@ -2599,39 +2609,38 @@ sdfsdf
                 default:
                     abort();
             }
-            // search for column 'lami'
+            // search for column 'lami' and the level 'mu_i' belongs to
             typename QTBASIS::IntervalBasis::Index lami(lambda_j[i],lambda_e[i],lambda_k[i],basis_->get_bases_infact()[lami_basisnum]);
             unsigned int lami_num = lami.number();
-            typename ColumnCache::iterator col_lb(cachePointer->lower_bound(lami_num));
-            typename ColumnCache::iterator col_it(col_lb);
-            if (col_lb == cachePointer->end() ||
-                cachePointer->key_comp()(lami_num, col_lb->first))
+            int mui_levelnum (mu_j[i] - basis_->j0()[mu_p][i]);
+            bool cached(false);
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_CachedQTProblem_cache)
+#endif
             {
-                // the lami-th column has not been requested so far
-                // insert a new column and continue with the blocks
-                typedef typename ColumnCache::value_type value_type;
-                col_it = cachePointer->insert(col_lb, value_type(lami_num, Column()));
+                typename ColumnCache::iterator col_it(cachePointer->find(lami_num));
+                if (col_it != cachePointer->end())
+                {
+                    typename Column::iterator it(col_it->second.find(mui_levelnum));
+                    if (it != col_it->second.end())
+                    {
+                        cached = true;
+                        waveletBlock[i] = & it->second;
+                        if (mu_min_type[i])
+                            generatorBlock[i] = & cachePointerGen->find(lami_num)->second;
+                    }
+                }
             }
-            // col_it points to the column of lami
-            Column& col(col_it->second);
-            // check whether the level 'mu_i' belongs to has already been calculated
-            int mui_levelnum (mu_j[i] - basis_->j0()[mu_p][i]);
-            typename Column::iterator lb(col.lower_bound(mui_levelnum));
-            typename Column::iterator it(lb);
-            if (lb == col.end() ||
-                col.key_comp()(mui_levelnum, lb->first))
+            if (!cached)
             {
                 // no entries have ever been computed for this column and this level
-                // insert a new block, 
-                // and then compute the whole level block 
+                // compute the whole level block 
                 //      (\int psi_mui psi_lami)_mui, (\int psi_mui' psi_lami')_mui
                 // for all mui that intersect lami. 
-                // if mui is on the minimal level we also need to add a new Block() to
+                // if mui is on the minimal level we also need to compute a new Block() for
                 // the generator integral cache, i.e., we need to 
                 // integrate against all generators on the lowest level
-                typedef typename Column::value_type value_type;
-                it = col.insert(lb, value_type(mui_levelnum, Block()));
-                waveletBlock[i] = & it->second;
+                Block wavBlock, genBlock;
                 bool gen_intersection_i, wav_intersection_i;
                 basis_->get_onedim_intersections(intinfo[i],
                         lambda_j[i],
@@ -2649,43 +2658,59 @@ sdfsdf
                         wav_intersection_i);
                 FixedArray1D<double,ONEDIMHAARCOUNT> gram;
                 FixedArray1D<double,DER_ONEDIMHAARCOUNT> der;
-                if (mu_min_type[i])
+                typedef typename Block::value_type value_type_block;
+                if (mu_min_type[i] && gen_intersection_i)
                 {
-                    typename Column::iterator lb2(cachePointerGen->lower_bound(lami_num));
-                    typename Column::iterator it2(lb2);
-                    if (lb2 == cachePointerGen->end() ||
-                        cachePointerGen->key_comp()(lami_num, lb2->first))
+                    for (int kgen = kmingen[i]; kgen <= kmaxgen[i]; ++kgen)
+                    {
+                        compute_onedim_haar_integrals(!(((intinfo[i] == 0) || (intinfo[i] == 4) ) || (intinfo[i] == 8) ), lambda_j[i], lambda_e[i], lambda_k[i], lami_basisnum,
+                                mu_j[i], 0, kgen, mui_basisnum,
+                                gram,
+                                der);
+                        genBlock.insert(genBlock.end(), value_type_block(kgen, make_pair(gram,der)));
+                    }
+                }
+                // wav_intersection_i == true guarantees kminwavi <=kmaxwavi and that the values are meaningful
+                if (wav_intersection_i)
+                {
+                    for (int kwav = kminwav[i]; kwav <= kmaxwav[i]; ++kwav)
+                    {
+                        compute_onedim_haar_integrals(!(((intinfo[i] == 0) || (intinfo[i] == 4) ) || (intinfo[i] == 8) ), lambda_j[i], lambda_e[i], lambda_k[i], lami_basisnum,
+                                mu_j[i], 1, kwav, mui_basisnum,
+                                gram,
+                                der);
+                        wavBlock.insert(wavBlock.end(), value_type_block(kwav, make_pair (gram,der) ));
+                    }
+                }
+                // insert the blocks, unless another thread has been faster
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_CachedQTProblem_cache)
+#endif
+                {
+                    Column& col((*cachePointer)[lami_num]);
+                    typename Column::iterator it(col.lower_bound(mui_levelnum));
+                    if (it == col.end() ||
+                        col.key_comp()(mui_levelnum, it->first))
                     {
-                        // no entries have ever been computed for this column and this level
-                        // insert a new block, 
-                        // and then compute the whole level block 
-                        //      (\int psi_nui psi_mui)_nui, (\int psi_nui' psi_mui')_nui
-                        // for all nui that intersect mui. 
-                        // if mui is on the minimal level we also need to add a new Block() to
-                        // the generator integral cache, i.e., we need to 
-                        // integrate against all generators on the lowest level
                         typedef typename Column::value_type value_type;
-                        it2 = cachePointerGen->insert(lb2, value_type(lami_num, Block()));
-                        generatorBlock[i] =  & it2->second;
-                        //Block& block2(it2->second);
-                        if (gen_intersection_i)
+                        it = col.insert(it, value_type(mui_levelnum, Block()));
+                        it->second.swap(wavBlock);
+                        if (mu_min_type[i])
                         {
-                            for (int kgen = kmingen[i]; kgen <= kmaxgen[i]; ++kgen)
+                            typename Column::iterator it2(cachePointerGen->lower_bound(lami_num));
+                            if (it2 != cachePointerGen->end() &&
+                                !cachePointerGen->key_comp()(lami_num, it2->first))
                             {
-                                compute_onedim_haar_integrals(!(((intinfo[i] == 0) || (intinfo[i] == 4) ) || (intinfo[i] == 8) ), lambda_j[i], lambda_e[i], lambda_k[i], lami_basisnum,
-                                        mu_j[i], 0, kgen, mui_basisnum,
-                                        gram,
-                                        der);
-                                typedef typename Block::value_type value_type_block;
-                                generatorBlock[i]->insert(generatorBlock[i]->end(), value_type_block(kgen, make_pair(gram,der)));
+                                cout << "just inserted a wavelet block, but gen block was already existent?!!" << endl;
+                                abort();
                             }
+                            it2 = cachePointerGen->insert(it2, value_type(lami_num, Block()));
+                            it2->second.swap(genBlock);
                         }
                     }
-                    else
-                    {
-                        cout << "just inserted a wavelet block, but gen block was already existent?!!" << endl;
-                        abort();
-                    }
+                    waveletBlock[i] = & it->second;
+                    if (mu_min_type[i])
+                        generatorBlock[i] = & cachePointerGen->find(lami_num)->second;
                 }
                 // code invariant: there exists a Block() (maybe empty) corresponding to lami and mui
                 
@@ -2701,32 +2726,15 @@ sdfsdf
                 // However, most lambdas will have some intersection? In this case this variant leads to 1 additional check
                 // so ... hopefully this makes the average access time to the cache faster
                 
-                if (!wav_intersection_i) 
-                    return;
-                // wav_intersection_i == true guarantees kminwavi <=kmaxwavi and that the values are meaningful
-                for (int kwav = kminwav[i]; kwav <= kmaxwav[i]; ++kwav)
-                {
-                    compute_onedim_haar_integrals(!(((intinfo[i] == 0) || (intinfo[i] == 4) ) || (intinfo[i] == 8) ), lambda_j[i], lambda_e[i], lambda_k[i], lami_basisnum,
-                            mu_j[i], 1, kwav, mui_basisnum,
-                            gram,
-                            der);
-
-                    typedef typename Block::value_type value_type_block;
-                    waveletBlock[i]->insert(waveletBlock[i]->end(), value_type_block(kwav, make_pair (gram,der) ));
-                }
             }
-            else // column and levelblock already exist
+            if (waveletBlock[i]->size() == 0)
             {
-                waveletBlock[i] = & it->second;
-                if (waveletBlock[i]->size() == 0)
-                    return;
-                if (mu_min_type[i])
-                {
-                    typename Column::iterator lb2(cachePointerGen->lower_bound(lami_num));
-                    generatorBlock[i] = & lb2->second;
-                }
+                intersecting = false;
+                break;
             }
         } // end of loop over dim
+        if (!intersecting)
+            return;
         // part 2: compose all relevant entries of w from the extracted 1d Blocks
         // part 2a: include information about mu into LMR info:
         FixedArray1D<Array1D<unsigned int> ,DIM> mu_gen_adapted_intinfo;
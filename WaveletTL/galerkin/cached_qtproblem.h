@@ -13,12 +13,16 @@
 
 #include <adaptive/compression.h>
 #include <map>
+#include <vector>
 #include <utils/fixed_array1d.h>
 #include <algebra/fixed_matrix.h>
 #include <galerkin/infinite_preconditioner.h>
 #include <interval/p_evaluate.h>
 #include <iostream>
 #include <fstream>
+
+using std::min;
+using std::make_pair;
         
 namespace WaveletTL
 {
@@ -407,6 +411,14 @@ namespace WaveletTL
                 const int levelnum,
                 const double factor) const;
         */
+        /*
+         * add_level (and hence add_ball) may be called concurrently from several
+         * OpenMP threads, provided that each thread works on its own vector w.
+         * Only the lookup and the insertion of the one-dimensional cache blocks
+         * are serialized, missing blocks are computed and the entries of w are
+         * composed in parallel.
+         * The other methods (e.g. a()) are not thread safe.
+         */
         void add_level(const unsigned int& lambdanum,
                 Vector<double>& w,
                 const unsigned int levelnum,
@@ -466,7 +478,52 @@ namespace WaveletTL
         
         //typedef FixedArray1D<double,ONEDIMHAARCOUNT> entries;
         typedef std::pair<FixedArray1D<double,ONEDIMHAARCOUNT>, FixedArray1D<double,DER_ONEDIMHAARCOUNT> > entries;
-        typedef std::map<int, entries> Block;
+        
+        /*
+         * A level block holds the entries for a contiguous range kmin,...,kmax of mu_i_k
+         * (all mu_i on one level that intersect lambda_i), inserted in ascending order.
+         * So we store them contiguously in a vector and access them by the offset k-kmin
+         * instead of a std::map<int, entries>.
+         * Only the part of the std::map interface used in this class is provided.
+         */
+        class Block
+        {
+        public:
+            typedef std::pair<int, entries> value_type;
+            typedef typename std::vector<value_type>::iterator iterator;
+            typedef typename std::vector<value_type>::const_iterator const_iterator;
+            typedef typename std::vector<value_type>::reverse_iterator reverse_iterator;
+            typedef std::less<int> key_compare;
+            
+            iterator begin() { return entries_.begin(); }
+            iterator end() { return entries_.end(); }
+            const_iterator begin() const { return entries_.begin(); }
+            const_iterator end() const { return entries_.end(); }
+            reverse_iterator rbegin() { return entries_.rbegin(); }
+            unsigned int size() const { return entries_.size(); }
+            key_compare key_comp() const { return key_compare(); }
+            void swap(Block& b) { entries_.swap(b.entries_); }
+            
+            // append an entry, the keys have to be consecutive
+            iterator insert(iterator, const value_type& v)
+            {
+                assert(entries_.empty() || v.first == entries_.back().first+1);
+                entries_.push_back(v);
+                return entries_.end()-1;
+            }
+            
+            // first entry with key >= k
+            iterator lower_bound(const int k)
+            {
+                if (entries_.empty() || k <= entries_.front().first)
+                    return entries_.begin();
+                const unsigned int n(k - entries_.front().first);
+                return (n < entries_.size()) ? entries_.begin()+n : entries_.end();
+            }
+            
+        protected:
+            std::vector<value_type> entries_;
+        };
         typedef std::map<int, Block> Column;
         typedef std::map<int, Column> ColumnCache;
         typedef FixedArray1D<ColumnCache,16> typeIcache;
@@ -268,10 +268,11 @@ namespace WaveletTL
     }
 
     template <class PROBLEM>
+    template <class VECTOR>
     void
     CachedTProblem<PROBLEM>::add_ball(const Index& lambda,
 				      //InfiniteVector<double, Index>& w,
-				      Vector<double>& w,
+				      VECTOR& w,
 				      const int radius,
 				      const double factor,
 				      const int maxlevel,
@@ -389,9 +390,10 @@ namespace WaveletTL
     }
 
     template <class PROBLEM>
+    template <class VECTOR>
     void
     CachedTProblem<PROBLEM>::add_level_recurse(const Index& lambda,
-                                               Vector<double>& w,
+                                               VECTOR& w,
                                                const int radius,
                                                const double factor,
                                                const index_lt & current_level,
@@ -516,6 +518,180 @@ namespace WaveletTL
         }
 
     }
+
+    template <class PROBLEM>
+    template <class VECTOR>
+    bool
+    CachedTProblem<PROBLEM>::add_level_sweep(const index_lt& j,
+                                             const Vector<double>& x,
+                                             VECTOR& w,
+                                             const int radius,
+                                             const int maxlevel,
+                                             const bool precond) const
+    {
+        double ax, qx;
+        if (!problem->kronecker_coefficients(ax, qx))
+            return false;
+
+        // the (preconditioned) input block in tensor product ordering
+        int first;
+        Array1D<int> positions;
+        Array1D<double> diagonal;
+        kronecker_level_data(j, ax, qx, first, positions, diagonal);
+        assert(x.size() == positions.size());
+        Vector<double> xk(x.size());
+        for (unsigned int m = 0; m < positions.size(); m++)
+            xk[positions[m]] = precond ? x[m]/sqrt(diagonal[m]) : x[m];
+
+        // iterate over the box around j, the levels in the 1-norm ball are added
+        const index_lt j0(basis().j0());
+        index_lt current_level;
+        for (int s = 0; s < space_dimension; s++)
+            current_level[s] = max(j0[s], j[s]-radius);
+        FixedArray1D<const SparseMatrix<double>*,space_dimension> G, K, B;
+        Vector<double> yk;
+        while (true)
+        {
+            int dist = 0;
+            for (int s = 0; s < space_dimension; s++)
+                dist += abs(current_level[s]-j[s]);
+            if (dist <= radius && (int)multi_degree(current_level) <= maxlevel)
+            {
+                int rows = 1;
+                for (int s = 0; s < space_dimension; s++)
+                {
+                    problem->level_blocks_1D(s, current_level[s], j[s], G[s], K[s]);
+                    rows *= G[s]->row_dimension();
+                }
+                yk.resize(rows);
+                // a * \sum_i (G \otimes ... \otimes K \otimes ... \otimes G) + q * (G \otimes ... \otimes G)
+                if (ax != 0.)
+                {
+                    for (int i = 0; i < space_dimension; i++)
+                    {
+                        B = G;
+                        B[i] = K[i];
+                        apply_kronecker(B, xk, yk, ax);
+                    }
+                }
+                if (qx != 0.)
+                    apply_kronecker(G, xk, yk, qx);
+
+                // scatter the result into w
+                int current_first;
+                Array1D<int> current_positions;
+                Array1D<double> current_diagonal;
+                kronecker_level_data(current_level, ax, qx, current_first, current_positions, current_diagonal);
+                for (unsigned int m = 0; m < current_positions.size(); m++)
+                    w[current_first+m] += precond
+                            ? yk[current_positions[m]]/sqrt(current_diagonal[m])
+                            : yk[current_positions[m]];
+            }
+
+            // "++current_level", the last direction varies fastest
+            int s = space_dimension-1;
+            for (; s >= 0; s--)
+            {
+                if (current_level[s] < j[s]+radius)
+                {
+                    ++current_level[s];
+                    break;
+                }
+                current_level[s] = max(j0[s], j[s]-radius);
+            }
+            if (s < 0) break;
+        }
+        return true;
+    }
+
+    template <class PROBLEM>
+    void
+    CachedTProblem<PROBLEM>::kronecker_level_data(const index_lt& j,
+                                                  const double ax,
+                                                  const double qx,
+                                                  int& first,
+                                                  Array1D<int>& positions,
+                                                  Array1D<double>& diagonal) const
+    {
+        // on the minimal level the generators are part of the level block
+        first = (j == basis().j0()) ? 0 : basis().first_wavelet(j).number();
+        const int last = basis().last_wavelet(j).number();
+        positions.resize(last-first+1);
+        diagonal.resize(last-first+1);
+
+        FixedArray1D<const SparseMatrix<double>*,space_dimension> G, K;
+        FixedArray1D<int,space_dimension> stride;
+        stride[space_dimension-1] = 1;
+        for (int s = space_dimension-2; s >= 0; s--)
+            stride[s] = stride[s+1] * problem->level_size_1D(s+1, j[s+1]);
+        for (int s = 0; s < space_dimension; s++)
+            problem->level_blocks_1D(s, j[s], j[s], G[s], K[s]);
+
+        FixedArray1D<double,space_dimension> g, k;
+        for (int m = 0; m <= last-first; m++)
+        {
+            const Index* mu = basis().get_wavelet(first+m);
+            positions[m] = 0;
+            for (int s = 0; s < space_dimension; s++)
+            {
+                const int p = problem->level_position_1D(s, j[s], mu->e()[s], mu->k()[s]);
+                positions[m] += p*stride[s];
+                g[s] = G[s]->get_entry(p, p);
+                k[s] = K[s]->get_entry(p, p);
+            }
+            double grad(0), mass(1);
+            for (int i = 0; i < space_dimension; i++)
+            {
+                double share = k[i];
+                for (int s = 0; s < space_dimension; s++)
+                    if (s != i) share *= g[s];
+                grad += share;
+                mass *= g[i];
+            }
+            diagonal[m] = ax*grad + qx*mass;
+        }
+    }
+
+    template <class PROBLEM>
+    void
+    CachedTProblem<PROBLEM>::apply_kronecker(const FixedArray1D<const SparseMatrix<double>*,space_dimension>& B,
+                                             const Vector<double>& x,
+                                             Vector<double>& y,
+                                             const double factor)
+    {
+        if (space_dimension == 2)
+        {
+            KroneckerHelper<double,SparseMatrix<double>,SparseMatrix<double> > AB(*B[0], *B[1], factor);
+            AB.apply(x, y, 0, 0, true);
+            return;
+        }
+
+        // apply B[s] to the s-th direction of the tensor t, for s = 0,...,space_dimension-1
+        FixedArray1D<int,space_dimension> shape;
+        for (int s = 0; s < space_dimension; s++)
+            shape[s] = B[s]->column_dimension();
+        Vector<double> t(x), tnew;
+        for (int s = 0; s < space_dimension; s++)
+        {
+            int outer(1), inner(1);
+            for (int l = 0; l < s; l++) outer *= shape[l];
+            for (int l = s+1; l < space_dimension; l++) inner *= shape[l];
+            const int rows = B[s]->row_dimension(), columns = shape[s];
+            tnew.resize(outer*rows*inner);
+            for (int o = 0; o < outer; o++)
+                for (int r = 0; r < rows; r++)
+                    for (unsigned int n = 0; n < B[s]->entries_in_row(r); n++)
+                    {
+                        const int c = B[s]->get_nth_index(r, n);
+                        const double entry = B[s]->get_nth_entry(r, n);
+                        for (int i = 0; i < inner; i++)
+                            tnew[(o*rows+r)*inner+i] += entry * t[(o*columns+c)*inner+i];
+                    }
+            t.swap(tnew);
+            shape[s] = rows;
+        }
+        y.add(factor, t);
+    }
 /*
     template <class PROBLEM>
     void
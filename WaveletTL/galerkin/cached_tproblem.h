@@ -15,6 +15,7 @@
 #include <adaptive/compression.h>
 #include <algebra/infinite_vector.h>
 #include <algebra/vector.h>
+#include <algebra/kronecker_matrix.h>
 #include <galerkin/galerkin_utils.h>
 #include <galerkin/infinite_preconditioner.h>
 #include <numerics/eigenvalues.h>
@@ -234,13 +235,15 @@ namespace WaveletTL
          * Called by APPLY // add_compressed_column
          * w += factor * (stiffness matrix entries in column lambda with ||nu-lambda|| <= range && ||nu|| <= maxlevel)
          * Hack? : works with non dynamic vector w of size = degrees_of_freedom
+         * (Vector<double> or DenseAccumulator<double>, indexed by numbers)
          *
          * "strategy" argument ist needed for compatibility with compression.h .
          * There is only 1 strategy for TBasis at the moment
          */
+        template <class VECTOR>
         void add_ball(const Index& lambda,
                      //InfiniteVector<double, Index>& w,
-                     Vector<double>& w,
+                     VECTOR& w,
                      const int radius,
                      const double factor,
                      const int maxlevel,
@@ -262,13 +265,29 @@ namespace WaveletTL
 
          */
 
+        /*
+         * Called by APPLY_TENSOR in sweep mode for a fully populated level block j of the input:
+         * w += D^{-1} A_{j',j} D^{-1} x for all levels j' with ||j'-j||_1 <= radius and |j'| <= maxlevel,
+         * where x[m] is the coefficient of the m-th index on level j (ordered by number).
+         * The blocks A_{j',j} are not taken from the entries cache but applied with their
+         * Kronecker structure (cf. TensorEquation::kronecker_coefficients()) on dense arrays.
+         * Returns false and does nothing if the underlying problem has no Kronecker structure.
+         */
+        template <class VECTOR>
+        bool add_level_sweep(const index_lt& j,
+                             const Vector<double>& x,
+                             VECTOR& w,
+                             const int radius,
+                             const int maxlevel,
+                             const bool precond = true) const;
         /*
          * Called by add_ball. Recursively all levels with |J-|lambda||<=range are added.
          * All dimensions are visited with the current dimension denoted by current_dim.
          * Indices with the highest recursion depth (level = DIM) are added to w
          */
+        template <class VECTOR>
         void add_level_recurse(const Index& lambda,
-                               Vector<double>& w,
+                               VECTOR& w,
                                const int radius,
                                const double factor,
                                const index_lt & current_level,
@@ -318,9 +337,44 @@ namespace WaveletTL
 
         // estimates for ||A|| and ||A^{-1}||
         mutable double normA, normAinv;
+        /*
+         * Kronecker data of the level block j, used by add_level_sweep:
+         * first is the number of the first index on level j, positions[m] the position
+         * of the m-th index in the tensor product ordering of the 1D levels
+         * (direction 0 varies slowest) and diagonal[m] its diagonal entry a(mu,mu)
+         */
+        void kronecker_level_data(const index_lt& j,
+                                  const double ax,
+                                  const double qx,
+                                  int& first,
+                                  Array1D<int>& positions,
+                                  Array1D<double>& diagonal) const;
+        /*
+         * y += factor * (B[0] \otimes ... \otimes B[space_dimension-1]) x on dense arrays,
+         * applied direction by direction (via KroneckerHelper for space_dimension == 2)
+         */
+        static void apply_kronecker(const FixedArray1D<const SparseMatrix<double>*,space_dimension>& B,
+                                    const Vector<double>& x,
+                                    Vector<double>& y,
+                                    const double factor);
     };
 
 
+    /*
+     * sweep mode hook of APPLY_TENSOR for CachedTProblem, cf. apply_tensor.h
+     */
+    template <class PROBLEM, class VECTOR>
+    inline bool add_level_sweep(const CachedTProblem<PROBLEM>& P,
+                                const typename CachedTProblem<PROBLEM>::index_lt& j,
+                                const Vector<double>& x,
+                                VECTOR& w,
+                                const int radius,
+                                const int maxlevel,
+                                const bool preconditioning)
+    {
+        return P.add_level_sweep(j, x, w, radius, maxlevel, preconditioning);
+    }
+
     /*!
      * problem which uses a precomputed SparseMatrix. Uses adaptive matrix-vextor multiplication.
      */
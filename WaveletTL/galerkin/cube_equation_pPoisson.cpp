@@ -14,7 +14,8 @@ namespace WaveletTL
 						   const int min_res_quad_f)
     : param_p(parameter_p), max_level_wavelet_basis(max_lev_wav_basis), max_level_wavelets_rhs(max_lev_wav_rhs), degree_of_exactness_quadrature_a(doe_quad_a), 
       min_res_quadrature_a(min_res_quad_a), degree_of_exactness_quadrature_f(doe_quad_f), min_res_quadrature_f(min_res_quad_f),
-      bvp_(bvp), basis_(bc), normA(0.0), normAinv(0.0)      
+      bvp_(bvp), basis_(bc), normA(0.0), normAinv(0.0),
+      iterate_set(false), iterate_jmax(-1), iterate_epsilon_lb(0.0), iterate_epsilon_ub(0.0)
   {
     basis_.set_jmax(max_level_wavelet_basis);
     if (doe_quad_a == 0)
@@ -37,7 +38,8 @@ namespace WaveletTL
 						   const int min_res_quad_f)
     : param_p(parameter_p), max_level_wavelet_basis(max_lev_wav_basis), max_level_wavelets_rhs(max_lev_wav_rhs), degree_of_exactness_quadrature_a(doe_quad_a), 
       min_res_quadrature_a(min_res_quad_a), degree_of_exactness_quadrature_f(doe_quad_f), min_res_quadrature_f(min_res_quad_f),
-      bvp_(bvp), basis_(bc), normA(0.0), normAinv(0.0)
+      bvp_(bvp), basis_(bc), normA(0.0), normAinv(0.0),
+      iterate_set(false), iterate_jmax(-1), iterate_epsilon_lb(0.0), iterate_epsilon_ub(0.0)
   {
     basis_.set_jmax(max_level_wavelet_basis);
     if (doe_quad_a == 0)
@@ -58,7 +60,9 @@ namespace WaveletTL
       degree_of_exactness_quadrature_a(eq.degree_of_exactness_quadrature_a),
       min_res_quadrature_a(eq.min_res_quadrature_a),
       degree_of_exactness_quadrature_f(eq.degree_of_exactness_quadrature_f),
-      min_res_quadrature_f(eq.min_res_quadrature_f), param_p(eq.param_p)
+      min_res_quadrature_f(eq.min_res_quadrature_f), param_p(eq.param_p),
+      iterate_tree(eq.iterate_tree), iterate_set(eq.iterate_set), iterate_jmax(eq.iterate_jmax),
+      iterate_epsilon_lb(eq.iterate_epsilon_lb), iterate_epsilon_ub(eq.iterate_epsilon_ub)
   {
     //const int jmax = 4; // for a first quick hack
     basis_.set_jmax(max_level_wavelet_basis);
@@ -456,7 +460,8 @@ if (abs(r - value_a2) > 1e-16)
           }
 
           // compute entry at gauss point x
-	      double entry =  bvp_->a(x);
+	      // (from the cell tree of the current iterate, if available)
+	      double entry = iterate_set ? iterate_coeff_a(x) : bvp_->a(x);
 
 	      typedef typename Func_values::value_type value_type_Func_values;
 
@@ -1060,4 +1065,615 @@ if (abs(r - value_a2) > 1e-16)
     return normAinv;
   }
 
+
+//! +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//! tree-based evaluation of the nonlinearity
+//! +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  void
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::lagrange_values(const double t, Array1D<double>& values)
+  {
+    const int N = N_nodes();
+    values.resize(N);
+    for (int n = 0; n < N; n++)
+    {
+      values[n] = 1.0;
+      const double tn = (1+GaussPoints[N-1][n])/2.;
+      for (int m = 0; m < N; m++)
+      {
+        if (m != n)
+        {
+          const double tm = (1+GaussPoints[N-1][m])/2.;
+          values[n] *= (t-tm)/(tn-tm);
+        }
+      }
+    }
+  }
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  void
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::tensor_apply(const FixedArray1D<Matrix<double>,DIM>& M,
+                                                           const bool transposed,
+                                                           const Vector<double>& in, const unsigned int offset_in,
+                                                           Vector<double>& out, const unsigned int offset_out)
+  {
+    // apply the 1D matrices direction by direction, the first coordinate running fastest
+    int shape[DIM];
+    int size = 1;
+    for (unsigned int i = 0; i < DIM; i++)
+    {
+      shape[i] = transposed ? M[i].row_dimension() : M[i].column_dimension();
+      size *= shape[i];
+    }
+    std::vector<double> current(in.begin()+offset_in, in.begin()+offset_in+size), next;
+
+    int stride = 1;
+    for (unsigned int i = 0; i < DIM; i++)
+    {
+      const int n_in = shape[i];
+      const int n_out = transposed ? M[i].column_dimension() : M[i].row_dimension();
+      const int outer = size / (stride*n_in);
+      next.assign(outer*n_out*stride, 0.0);
+      for (int o = 0; o < outer; o++)
+        for (int m = 0; m < n_out; m++)
+          for (int n = 0; n < n_in; n++)
+          {
+            const double factor = transposed ? M[i](n, m) : M[i](m, n);
+            if (factor == 0.0) continue;
+            for (int q = 0; q < stride; q++)
+              next[(o*n_out+m)*stride+q] += factor * current[(o*n_in+n)*stride+q];
+          }
+      current.swap(next);
+      size = outer*n_out*stride;
+      shape[i] = n_out;
+      stride *= n_out;
+    }
+
+    for (int id = 0; id < size; id++)
+      out[offset_out+id] += current[id];
+  }
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  void
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::clear_iterate()
+  {
+    iterate_tree.clear();
+    iterate_set = false;
+    iterate_jmax = -1;
+    clear_coeff_cache();
+  }
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  void
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::set_iterate(const InfiniteVector<double,Index>& u,
+                                                          const double epsilon_lb, const double epsilon_ub)
+  {
+    clear_iterate();
+    iterate_set = true;
+    iterate_epsilon_lb = epsilon_lb;
+    iterate_epsilon_ub = epsilon_ub;
+
+    const int N = N_nodes();
+    int n_nodes = 1;
+    for (unsigned int i = 0; i < DIM; i++)
+      n_nodes *= N;
+    const int values_size = (DIM+1)*n_nodes;
+    const int j0 = basis_.j0();
+    iterate_jmax = j0;
+
+    // add each coefficient on the cells of its own support
+    typedef typename CUBEBASIS::Support Support;
+    for (typename InfiniteVector<double,Index>::const_iterator it(u.begin()), itend(u.end());
+         it != itend; ++it)
+    {
+      const Index& lambda(it.index());
+      Support supp;
+      basis_.support(lambda, supp);
+      iterate_jmax = std::max(iterate_jmax, supp.j);
+
+      // 1D point values and derivatives at the nodes of all cells of the support
+      const double h = ldexp(1.0, -supp.j);
+      FixedArray1D<Array1D<double>,DIM> points, values, der_values;
+      for (unsigned int i = 0; i < DIM; i++)
+      {
+        points[i].resize(N*(supp.b[i]-supp.a[i]));
+        for (int patch = supp.a[i]; patch < supp.b[i]; patch++)
+          for (int n = 0; n < N; n++)
+            points[i][(patch-supp.a[i])*N+n] = h*(2*patch+1+GaussPoints[N-1][n])/2.;
+        const typename IBASIS::Index lambda_i(lambda.j(), lambda.e()[i], lambda.k()[i], basis_.bases()[i]);
+        evaluate(*basis_.bases()[i], 0, lambda_i, points[i], values[i]);
+        evaluate(*basis_.bases()[i], 1, lambda_i, points[i], der_values[i]);
+      }
+
+      std::map<int, Cell>& level(iterate_tree[supp.j]);
+      int cell[DIM];
+      for (unsigned int i = 0; i < DIM; i++)
+        cell[i] = supp.a[i];
+      while (true)
+      {
+        int patch = 0;
+        for (unsigned int i = 0; i < DIM; i++)
+          patch += cell[i] << (supp.j*i);
+        Cell& c(level[patch]);
+        if (c.values.size() == 0)
+        {
+          c.refined = false;
+          c.values.resize(values_size);
+        }
+
+        // "iterate" over the nodes of the cell
+        int node[DIM];
+        for (unsigned int i = 0; i < DIM; i++)
+          node[i] = 0;
+        for (int id = 0; id < n_nodes; id++)
+        {
+          double value = *it;
+          double grad[DIM];
+          for (unsigned int i = 0; i < DIM; i++)
+            grad[i] = *it;
+          for (unsigned int s = 0; s < DIM; s++)
+          {
+            const int point = (cell[s]-supp.a[s])*N+node[s];
+            value *= values[s][point];
+            for (unsigned int i = 0; i < DIM; i++)
+              grad[i] *= (i == s ? der_values[s][point] : values[s][point]);
+          }
+          c.values[id] += value;
+          for (unsigned int i = 0; i < DIM; i++)
+            c.values[(1+i)*n_nodes+id] += grad[i];
+
+          for (unsigned int i = 0; i < DIM; i++)
+          {
+            if (node[i] == N-1)
+              node[i] = 0;
+            else
+            {
+              node[i]++;
+              break;
+            }
+          }
+        }
+
+        // "++cell"
+        bool exit = false;
+        for (unsigned int i = 0; i < DIM; i++)
+        {
+          if (cell[i] == supp.b[i]-1)
+          {
+            cell[i] = supp.a[i];
+            exit = (i == DIM-1);
+          }
+          else
+          {
+            cell[i]++;
+            break;
+          }
+        }
+        if (exit) break;
+      }
+    }
+
+    // all ancestors of the cells are refined
+    for (int j = iterate_jmax; j > j0; j--)
+    {
+      std::map<int, Cell>& parents(iterate_tree[j-1]);
+      for (typename std::map<int, Cell>::const_iterator it(iterate_tree[j].begin()), itend(iterate_tree[j].end());
+           it != itend; ++it)
+      {
+        int parent = 0;
+        for (unsigned int i = 0; i < DIM; i++)
+          parent += (((it->first >> (j*i)) & ((1<<j)-1)) >> 1) << ((j-1)*i);
+        Cell& c(parents[parent]);
+        if (c.values.size() == 0)
+          c.values.resize(values_size);
+        c.refined = true;
+      }
+    }
+
+    // interpolation matrices from the nodes of a cell to the nodes of its children
+    FixedArray1D<Matrix<double>,2> P;
+    Array1D<double> lvalues;
+    for (int child = 0; child <= 1; child++)
+    {
+      P[child].resize(N, N);
+      for (int m = 0; m < N; m++)
+      {
+        lagrange_values((child+(1+GaussPoints[N-1][m])/2.)/2., lvalues);
+        for (int n = 0; n < N; n++)
+          P[child](m, n) = lvalues[n];
+      }
+    }
+
+    // push the local polynomials down to the leaves
+    for (int j = j0; j < iterate_jmax; j++)
+    {
+      std::map<int, Cell>& children(iterate_tree[j+1]);
+      for (typename std::map<int, Cell>::const_iterator it(iterate_tree[j].begin()), itend(iterate_tree[j].end());
+           it != itend; ++it)
+      {
+        if (!it->second.refined) continue;
+        for (int child = 0; child < (1<<DIM); child++)
+        {
+          int patch = 0;
+          FixedArray1D<Matrix<double>,DIM> M;
+          for (unsigned int i = 0; i < DIM; i++)
+          {
+            const int c_i = (child >> i) & 1;
+            patch += (2*((it->first >> (j*i)) & ((1<<j)-1)) + c_i) << ((j+1)*i);
+            M[i] = P[c_i];
+          }
+          Cell& c(children[patch]);
+          if (c.values.size() == 0)
+          {
+            c.refined = false;
+            c.values.resize(values_size);
+          }
+          for (unsigned int comp = 0; comp <= DIM; comp++)
+            tensor_apply(M, false, it->second.values, comp*n_nodes, c.values, comp*n_nodes);
+        }
+      }
+    }
+  }
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  const typename CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::Cell*
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::find_leaf(const Point<DIM>& x, int& j, int& patch) const
+  {
+    for (j = basis_.j0(); j <= iterate_jmax; j++)
+    {
+      typename CellTree::const_iterator level(iterate_tree.find(j));
+      if (level == iterate_tree.end())
+        return 0;
+      patch = 0;
+      for (unsigned int i = 0; i < DIM; i++)
+        patch += std::max(0, std::min((1<<j)-1, (int)floor(ldexp(x[i], j)))) << (j*i);
+      typename std::map<int, Cell>::const_iterator it(level->second.find(patch));
+      if (it == level->second.end())
+        return 0;
+      if (!it->second.refined)
+        return &it->second;
+    }
+    return 0;
+  }
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  inline
+  double
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::relaxed_coefficient(const double* grad) const
+  {
+    double r = 0;
+    for (unsigned int i = 0; i < DIM; i++)
+      r += grad[i]*grad[i];
+    r = std::min(std::max(iterate_epsilon_lb, sqrt(r)), iterate_epsilon_ub);
+    return pow(r, param_p - 2.0);
+  }
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  double
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::iterate_coeff_a(const Point<DIM>& x) const
+  {
+    double grad[DIM];
+    for (unsigned int i = 0; i < DIM; i++)
+      grad[i] = 0;
+
+    int j, patch;
+    const Cell* leaf = find_leaf(x, j, patch);
+    if (leaf)
+    {
+      const int N = N_nodes();
+      FixedArray1D<Array1D<double>,DIM> lvalues;
+      int n_nodes = 1;
+      for (unsigned int i = 0; i < DIM; i++)
+      {
+        lagrange_values(ldexp(x[i], j) - ((patch >> (j*i)) & ((1<<j)-1)), lvalues[i]);
+        n_nodes *= N;
+      }
+      int node[DIM];
+      for (unsigned int i = 0; i < DIM; i++)
+        node[i] = 0;
+      for (int id = 0; id < n_nodes; id++)
+      {
+        double weight = 1.0;
+        for (unsigned int i = 0; i < DIM; i++)
+          weight *= lvalues[i][node[i]];
+        for (unsigned int i = 0; i < DIM; i++)
+          grad[i] += weight * leaf->values[(1+i)*n_nodes+id];
+        for (unsigned int i = 0; i < DIM; i++)
+        {
+          if (node[i] == N-1)
+            node[i] = 0;
+          else
+          {
+            node[i]++;
+            break;
+          }
+        }
+      }
+    }
+
+    return relaxed_coefficient(grad);
+  }
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  void
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::add_flux_moments(const Cell& leaf, const int jl, const int patchl,
+                                                               const int jq, const int patchq,
+                                                               const int jb, const int patchb,
+                                                               Vector<double>& moments) const
+  {
+    const int N = N_nodes();
+    const int N_Gauss = (degree_of_exactness_quadrature_a+1)/2;
+    const double h = ldexp(1.0, -jq);
+
+    // Lagrange bases of the leaf and of the test cell at the Gauss points of the quadrature cell
+    FixedArray1D<Matrix<double>,DIM> U, B;
+    FixedArray1D<Array1D<double>,DIM> gauss_points, gauss_weights;
+    Array1D<double> lvalues;
+    int n_nodes = 1, n_points = 1;
+    for (unsigned int i = 0; i < DIM; i++)
+    {
+      const int kq = (patchq >> (jq*i)) & ((1<<jq)-1);
+      const int kl = (patchl >> (jl*i)) & ((1<<jl)-1);
+      const int kb = (patchb >> (jb*i)) & ((1<<jb)-1);
+      U[i].resize(N_Gauss, N);
+      B[i].resize(N_Gauss, N);
+      gauss_points[i].resize(N_Gauss);
+      gauss_weights[i].resize(N_Gauss);
+      for (int p = 0; p < N_Gauss; p++)
+      {
+        const double x = h*(2*kq+1+GaussPoints[N_Gauss-1][p])/2.;
+        gauss_points[i][p] = x;
+        gauss_weights[i][p] = h*GaussWeights[N_Gauss-1][p];
+        lagrange_values(ldexp(x, jl) - kl, lvalues);
+        for (int n = 0; n < N; n++)
+          U[i](p, n) = lvalues[n];
+        lagrange_values(ldexp(x, jb) - kb, lvalues);
+        for (int n = 0; n < N; n++)
+          B[i](p, n) = lvalues[n];
+      }
+      n_nodes *= N;
+      n_points *= N_Gauss;
+    }
+
+    // values of u and grad u at the Gauss points
+    Vector<double> uvalues((DIM+1)*n_points);
+    for (unsigned int comp = 0; comp <= DIM; comp++)
+      tensor_apply(U, false, leaf.values, comp*n_nodes, uvalues, comp*n_points);
+
+    // weighted fluxes q(x)u(x) and a(x)grad u(x)
+    Vector<double> fluxes((DIM+1)*n_points);
+    Point<DIM> x;
+    int index[DIM];
+    for (unsigned int i = 0; i < DIM; i++)
+      index[i] = 0;
+    for (int id = 0; id < n_points; id++)
+    {
+      double weights = 1.0;
+      for (unsigned int i = 0; i < DIM; i++)
+      {
+        x[i] = gauss_points[i][index[i]];
+        weights *= gauss_weights[i][index[i]];
+      }
+      double grad[DIM];
+      for (unsigned int i = 0; i < DIM; i++)
+        grad[i] = uvalues[(1+i)*n_points+id];
+      const double a_value = relaxed_coefficient(grad);
+      fluxes[id] = bvp_->q(x) * uvalues[id] * weights;
+      for (unsigned int i = 0; i < DIM; i++)
+        fluxes[(1+i)*n_points+id] = a_value * grad[i] * weights;
+
+      for (unsigned int i = 0; i < DIM; i++)
+      {
+        if (index[i] == N_Gauss-1)
+          index[i] = 0;
+        else
+        {
+          index[i]++;
+          break;
+        }
+      }
+    }
+
+    // test against the nodal basis of the test cell
+    for (unsigned int comp = 0; comp <= DIM; comp++)
+      tensor_apply(B, true, fluxes, comp*n_points, moments, comp*n_nodes);
+  }
+
+  template <class IBASIS, unsigned int DIM, class CUBEBASIS>
+  void
+  CubeEquationpPoisson<IBASIS,DIM,CUBEBASIS>::evaluate_nonlinear(const std::set<Index>& Lambda,
+                                                                 InfiniteVector<double,Index>& w) const
+  {
+    w.clear();
+
+    const int N = N_nodes();
+    int n_nodes = 1;
+    for (unsigned int i = 0; i < DIM; i++)
+      n_nodes *= N;
+    const int moments_size = (DIM+1)*n_nodes;
+    const int j0 = basis_.j0();
+
+    // moments on the leaves, with the quadrature resolution of 'a'
+    MomentTree moments;
+    for (typename CellTree::const_iterator level(iterate_tree.begin()); level != iterate_tree.end(); ++level)
+    {
+      const int j = level->first;
+      const int jq = std::max(j, min_res_quadrature_a);
+      for (typename std::map<int, Cell>::const_iterator it(level->second.begin()), itend(level->second.end());
+           it != itend; ++it)
+      {
+        if (it->second.refined) continue;
+        Vector<double>& m(moments[j][it->first]);
+        m.resize(moments_size);
+        for (int sub = 0; sub < (1 << ((jq-j)*DIM)); sub++)
+        {
+          int patchq = 0;
+          for (unsigned int i = 0; i < DIM; i++)
+            patchq += ((((it->first >> (j*i)) & ((1<<j)-1)) << (jq-j))
+                       + ((sub >> ((jq-j)*i)) & ((1<<(jq-j))-1))) << (jq*i);
+          add_flux_moments(it->second, j, it->first, jq, patchq, j, it->first, m);
+        }
+      }
+    }
+
+    // restriction matrices from the nodes of a child to the nodes of its parent (transposed)
+    FixedArray1D<Matrix<double>,2> P;
+    Array1D<double> lvalues;
+    for (int child = 0; child <= 1; child++)
+    {
+      P[child].resize(N, N);
+      for (int m = 0; m < N; m++)
+      {
+        lagrange_values((child+(1+GaussPoints[N-1][m])/2.)/2., lvalues);
+        for (int n = 0; n < N; n++)
+          P[child](m, n) = lvalues[n];
+      }
+    }
+
+    // accumulate the moments bottom-up
+    for (int j = iterate_jmax; j > j0; j--)
+    {
+      std::map<int, Vector<double> >& parents(moments[j-1]);
+      for (typename std::map<int, Vector<double> >::const_iterator it(moments[j].begin()), itend(moments[j].end());
+           it != itend; ++it)
+      {
+        int parent = 0;
+        FixedArray1D<Matrix<double>,DIM> M;
+        for (unsigned int i = 0; i < DIM; i++)
+        {
+          const int k = (it->first >> (j*i)) & ((1<<j)-1);
+          parent += (k >> 1) << ((j-1)*i);
+          M[i] = P[k & 1];
+        }
+        Vector<double>& m(parents[parent]);
+        if (m.size() == 0)
+          m.resize(moments_size);
+        for (unsigned int comp = 0; comp <= DIM; comp++)
+          tensor_apply(M, true, it->second, comp*n_nodes, m, comp*n_nodes);
+      }
+    }
+
+    // read off the entries from the cells of the supports
+    typedef typename CUBEBASIS::Support Support;
+    Vector<double> local_moments(moments_size);
+    for (typename std::set<Index>::const_iterator lambdait(Lambda.begin()); lambdait != Lambda.end(); ++lambdait)
+    {
+      const Index& lambda(*lambdait);
+      Support supp;
+      basis_.support(lambda, supp);
+
+      const double h = ldexp(1.0, -supp.j);
+      FixedArray1D<Array1D<double>,DIM> points, values, der_values;
+      for (unsigned int i = 0; i < DIM; i++)
+      {
+        points[i].resize(N*(supp.b[i]-supp.a[i]));
+        for (int patch = supp.a[i]; patch < supp.b[i]; patch++)
+          for (int n = 0; n < N; n++)
+            points[i][(patch-supp.a[i])*N+n] = h*(2*patch+1+GaussPoints[N-1][n])/2.;
+        const typename IBASIS::Index lambda_i(lambda.j(), lambda.e()[i], lambda.k()[i], basis_.bases()[i]);
+        evaluate(*basis_.bases()[i], 0, lambda_i, points[i], values[i]);
+        evaluate(*basis_.bases()[i], 1, lambda_i, points[i], der_values[i]);
+      }
+
+      double r = 0;
+      int cell[DIM];
+      for (unsigned int i = 0; i < DIM; i++)
+        cell[i] = supp.a[i];
+      while (true)
+      {
+        int patch = 0;
+        Point<DIM> center;
+        for (unsigned int i = 0; i < DIM; i++)
+        {
+          patch += cell[i] << (supp.j*i);
+          center[i] = h*(cell[i]+0.5);
+        }
+
+        // moments of the cell, computed directly if the cell lies within a leaf
+        const Vector<double>* m = 0;
+        typename MomentTree::const_iterator level(moments.find(supp.j));
+        if (level != moments.end())
+        {
+          typename std::map<int, Vector<double> >::const_iterator it(level->second.find(patch));
+          if (it != level->second.end())
+            m = &it->second;
+        }
+        if (!m)
+        {
+          int jl, patchl;
+          const Cell* leaf = find_leaf(center, jl, patchl);
+          if (leaf && jl < supp.j)
+          {
+            local_moments.scale(0);
+            const int jq = std::max((int)supp.j, min_res_quadrature_a);
+            for (int sub = 0; sub < (1 << ((jq-supp.j)*DIM)); sub++)
+            {
+              int patchq = 0;
+              for (unsigned int i = 0; i < DIM; i++)
+                patchq += ((cell[i] << (jq-supp.j)) + ((sub >> ((jq-supp.j)*i)) & ((1<<(jq-supp.j))-1))) << (jq*i);
+              add_flux_moments(*leaf, jl, patchl, jq, patchq, supp.j, patch, local_moments);
+            }
+            m = &local_moments;
+          }
+        }
+
+        if (m)
+        {
+          int node[DIM];
+          for (unsigned int i = 0; i < DIM; i++)
+            node[i] = 0;
+          for (int id = 0; id < n_nodes; id++)
+          {
+            double value = 1.0;
+            double grad[DIM];
+            for (unsigned int i = 0; i < DIM; i++)
+              grad[i] = 1.0;
+            for (unsigned int s = 0; s < DIM; s++)
+            {
+              const int point = (cell[s]-supp.a[s])*N+node[s];
+              value *= values[s][point];
+              for (unsigned int i = 0; i < DIM; i++)
+                grad[i] *= (i == s ? der_values[s][point] : values[s][point]);
+            }
+            r += value * (*m)[id];
+            for (unsigned int i = 0; i < DIM; i++)
+              r += grad[i] * (*m)[(1+i)*n_nodes+id];
+
+            for (unsigned int i = 0; i < DIM; i++)
+            {
+              if (node[i] == N-1)
+                node[i] = 0;
+              else
+              {
+                node[i]++;
+                break;
+              }
+            }
+          }
+        }
+
+        // "++cell"
+        bool exit = false;
+        for (unsigned int i = 0; i < DIM; i++)
+        {
+          if (cell[i] == supp.b[i]-1)
+          {
+            cell[i] = supp.a[i];
+            exit = (i == DIM-1);
+          }
+          else
+          {
+            cell[i]++;
+            break;
+          }
+        }
+        if (exit) break;
+      }
+
+      if (r != 0)
+        w.set_coefficient(lambda, r);
+    }
+  }
+
 }
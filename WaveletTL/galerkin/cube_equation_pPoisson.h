@@ -13,6 +13,9 @@
 #include <set>
 #include <utils/fixed_array1d.h>
 #include <utils/array1d.h>
+#include <algebra/vector.h>
+#include <algebra/matrix.h>
+#include <algebra/infinite_vector.h>
 #include <numerics/bvp.h>
 
 #include <galerkin/galerkin_utils.h>
@@ -20,6 +23,8 @@
 
 using MathTL::FixedArray1D;
 using MathTL::EllipticBVP;
+using MathTL::Vector;
+using MathTL::Matrix;
 extern double time_consumption_of_a;
 
 namespace WaveletTL
@@ -276,6 +281,39 @@ namespace WaveletTL
       coeff_cache.clear();
     }
 
+    /*!
+      Set the current iterate u of the Kacanov iteration for the tree-based evaluation
+      of the nonlinearity. u is reconstructed locally as piecewise polynomials on the
+      tree of dyadic cells spanned by the supports of its active coefficients:
+      each coefficient is added once on the cells of its own support, then the local
+      polynomials are pushed down to the leaves of the tree (nodal interpolation
+      at d Gauss points per direction, which is exact for splines of order d).
+      Afterwards, the coefficient
+        a(x) = ( min{ max{epsilon_lb, |grad u(x)|}, epsilon_ub} )^{p-2}
+      is computed from the tree instead of by bvp_->a (see cached_coeff_a()),
+      and evaluate_nonlinear() is available.
+      The coefficient cache is cleared.
+    */
+    void set_iterate(const InfiniteVector<double,Index>& u,
+                     const double epsilon_lb, const double epsilon_ub);
+
+    /*!
+      forget the iterate from set_iterate(), i.e., use bvp_->a again
+    */
+    void clear_iterate();
+
+    /*!
+      For the iterate u from set_iterate(), evaluate the (unpreconditioned) nonlinear form
+        w_lambda = \int_Omega [a(x)grad u(x)grad psi_lambda(x)+q(x)u(x)psi_lambda(x)] dx
+      for all lambda in Lambda in one sweep. The fluxes are integrated once on the leaves
+      of the cell tree (with the quadrature rule of 'a'), accumulated bottom-up as moments
+      against the local nodal bases, and each w_lambda is read off from the cells of its
+      support. So the evaluation costs O(#Lambda + #cells) instead of O(#Lambda * #supp u)
+      quadratures with a().
+    */
+    void evaluate_nonlinear(const std::set<Index>& Lambda,
+                            InfiniteVector<double,Index>& w) const;
+
 
   //protected:
     //const EllipticBVP<DIM>* bvp_;
@@ -321,6 +359,60 @@ namespace WaveletTL
     mutable Resolution coeff_cache;
 
 
+    /*!
+      cell tree of the iterate u from set_iterate()
+    */
+
+    // type of one cell: refinement flag and the values of u, d/dx_1 u, ..., d/dx_DIM u
+    // at the nodes (tensor product Gauss points, the first coordinate running fastest)
+    struct Cell
+    {
+      bool refined;
+      Vector<double> values;
+    };
+
+    // type of the cell tree, the keys code the resolution and the patch (as in coeff_cache)
+    typedef std::map<int, std::map<int, Cell> > CellTree;
+
+    // type of the moments of the fluxes on the cells of the tree
+    typedef std::map<int, std::map<int, Vector<double> > > MomentTree;
+
+    // the cell tree, its finest resolution and the relaxation parameters
+    CellTree iterate_tree;
+    bool iterate_set;
+    int iterate_jmax;
+    double iterate_epsilon_lb, iterate_epsilon_ub;
+
+    // number of nodes per direction of the local polynomials
+    static int N_nodes() { return IBASIS::primal_polynomial_degree(); }
+
+    // values of the Lagrange basis w.r.t. the nodes on [0,1] at t
+    static void lagrange_values(const double t, Array1D<double>& values);
+
+    // apply the tensor product of the matrices M[i] (or of their transposes)
+    // to the block of values starting at in[offset_in]
+    static void tensor_apply(const FixedArray1D<Matrix<double>,DIM>& M,
+                             const bool transposed,
+                             const Vector<double>& in, const unsigned int offset_in,
+                             Vector<double>& out, const unsigned int offset_out);
+
+    // the leaf of the cell tree which contains x (0 if x is outside of the tree)
+    const Cell* find_leaf(const Point<DIM>& x, int& j, int& patch) const;
+
+    // the relaxed coefficient for a given gradient
+    double relaxed_coefficient(const double* grad) const;
+
+    // point evaluation of the coefficient from the cell tree
+    double iterate_coeff_a(const Point<DIM>& x) const;
+
+    // add the moments of the fluxes over the cell (jq,patchq) w.r.t. the nodal basis
+    // of the cell (jb,patchb), u is taken from the leaf (jl,patchl)
+    void add_flux_moments(const Cell& leaf, const int jl, const int patchl,
+                          const int jq, const int patchq,
+                          const int jb, const int patchb,
+                          Vector<double>& moments) const;
+
+
   };
 }
 
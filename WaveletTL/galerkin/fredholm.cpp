@@ -1,5 +1,13 @@
 // implementation for fredholm.h
 
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <algebra/matrix.h>
+#include <numerics/aca.h>
+#include <numerics/eigenvalues.h>
+#include <galerkin/galerkin_utils.h>
+
 namespace WaveletTL
 {
   template <int d, int dT, int J0>
@@ -8,13 +16,154 @@ namespace WaveletTL
    const InfiniteVector<double,Index>& y)
     : basis_(basis),
       y_(y),
-      normA(0.0), normAinv(0.0)
+      normA(0.0), normAinv(0.0),
+      distance_factor(2.0), admissibility_eta(1.0), aca_tolerance(1e-10)
   {
   }
 
   template <int d, int dT, int J0>
   FredholmIntegralOperator<d,dT,J0>::~FredholmIntegralOperator () {}
 
+  template <int d, int dT, int J0>
+  void
+  FredholmIntegralOperator<d,dT,J0>::set_compression(const double a,
+						     const double eta,
+						     const double epsilon)
+  {
+    distance_factor = a;
+    admissibility_eta = eta;
+    aca_tolerance = epsilon;
+    clear_cache();
+  }
+
+  template <int d, int dT, int J0>
+  void
+  FredholmIntegralOperator<d,dT,J0>::clear_cache() const
+  {
+    values_cache.clear();
+    kernel_cache.clear();
+    diagonal_cache.clear();
+    blocks_cache.clear();
+  }
+
+  template <int d, int dT, int J0>
+  inline
+  void
+  FredholmIntegralOperator<d,dT,J0>::support(const Index& lambda, int& j, int& k1, int& k2) const
+  {
+    j = lambda.j()+lambda.e();
+    basis().support(lambda, k1, k2);
+  }
+
+  template <int d, int dT, int J0>
+  void
+  FredholmIntegralOperator<d,dT,J0>::translation_range(const int j, const int e,
+						       const double a, const double b,
+						       int& k1, int& k2) const
+  {
+    const int kmin = (e == 0 ? basis().DeltaLmin() : basis().Nablamin());
+    const int kmax = (e == 0 ? basis().DeltaRmax(j) : basis().Nablamax(j));
+    int jsupp, k1supp, k2supp;
+
+    // bisection for the first k with 2^{-jsupp}*k2supp >= a
+    int lo = kmin, hi = kmax+1;
+    while (lo < hi) {
+      const int k = lo+(hi-lo)/2;
+      support(Index(j, e, k), jsupp, k1supp, k2supp);
+      if (ldexp((double)k2supp, -jsupp) >= a) hi = k; else lo = k+1;
+    }
+    k1 = lo;
+
+    // bisection for the last k with 2^{-jsupp}*k1supp <= b
+    lo = kmin-1, hi = kmax;
+    while (lo < hi) {
+      const int k = lo+(hi-lo+1)/2;
+      support(Index(j, e, k), jsupp, k1supp, k2supp);
+      if (ldexp((double)k1supp, -jsupp) <= b) lo = k; else hi = k-1;
+    }
+    k2 = lo;
+  }
+
+  template <int d, int dT, int J0>
+  void
+  FredholmIntegralOperator<d,dT,J0>::gauss_points(const int j, const int k1, const int k2,
+						  Array1D<double>& points)
+  {
+    const unsigned int N = N_Gauss();
+    const double h = ldexp(1.0, -j);
+    points.resize(N*(k2-k1));
+    for (int patch = k1, id = 0; patch < k2; patch++)
+      for (unsigned int n = 0; n < N; n++, id++)
+	points[id] = h*(2*patch+1+GaussPoints[N-1][n])/2.;
+  }
+
+  template <int d, int dT, int J0>
+  const Array1D<double>&
+  FredholmIntegralOperator<d,dT,J0>::weighted_values(const Index& lambda) const
+  {
+    const int lambda_num = lambda.number();
+    typename std::map<int, Array1D<double> >::iterator lb(values_cache.lower_bound(lambda_num));
+    if (lb != values_cache.end() && !values_cache.key_comp()(lambda_num, lb->first))
+      return lb->second;
+
+    int j, k1, k2;
+    support(lambda, j, k1, k2);
+    Array1D<double> points, values;
+    gauss_points(j, k1, k2, points);
+    basis().evaluate(0, lambda, points, values);
+
+    const unsigned int N = N_Gauss();
+    const double h = ldexp(1.0, -j);
+    for (unsigned int id = 0; id < values.size(); id++)
+      values[id] *= GaussWeights[N-1][id%N] * h;
+
+    return values_cache.insert(lb, std::make_pair(lambda_num, values))->second;
+  }
+
+  template <int d, int dT, int J0>
+  const Array1D<double>&
+  FredholmIntegralOperator<d,dT,J0>::kernel_block(const int j, const int k,
+						  const int jprime, const int kprime) const
+  {
+    KernelTable& table(kernel_cache[std::make_pair(j, jprime)]);
+    const std::pair<int,int> key(k, kprime);
+    typename KernelTable::iterator lb(table.lower_bound(key));
+    if (lb != table.end() && !table.key_comp()(key, lb->first))
+      return lb->second;
+
+    const unsigned int N = N_Gauss();
+    Array1D<double> x, y, values(N*N);
+    gauss_points(j, k, k+1, x);
+    gauss_points(jprime, kprime, kprime+1, y);
+    for (unsigned int m = 0, id = 0; m < N; m++)
+      for (unsigned int n = 0; n < N; n++, id++)
+	values[id] = g(x[m], y[n]);
+
+    return table.insert(lb, std::make_pair(key, values))->second;
+  }
+
+  template <int d, int dT, int J0>
+  bool
+  FredholmIntegralOperator<d,dT,J0>::admissible(const int j, const int k1, const int k2,
+						const int jprime, const int k1prime, const int k2prime) const
+  {
+    const double a1 = ldexp((double)k1, -j), b1 = ldexp((double)k2, -j);
+    const double a2 = ldexp((double)k1prime, -jprime), b2 = ldexp((double)k2prime, -jprime);
+    const double dist = std::max(a1, a2) - std::min(b1, b2);
+    return dist > 0 && std::min(b1-a1, b2-a2) <= admissibility_eta * dist;
+  }
+
+  template <int d, int dT, int J0>
+  inline
+  double
+  FredholmIntegralOperator<d,dT,J0>::cutoff(const int j, const int jprime, const int J) const
+  {
+    if (distance_factor <= 0)
+      return std::numeric_limits<double>::max();
+    return distance_factor * std::max(ldexp(1.0, -std::min(j, jprime)),
+				      pow(2.0, (J-(j+jprime)*(dT+0.5))/(2.0*dT)));
+  }
+
   template <int d, int dT, int J0>
   double
   FredholmIntegralOperator<d,dT,J0>::a
@@ -27,47 +176,207 @@ namespace WaveletTL
     //   <K^*Ku,v> = int_0^1 int_0^1 g(s,t) u(s) v(t) ds dt
     // with u=psi_lambda, v=psi_mu
 
-    int j_lambda = lambda.j()+lambda.e();
-    int j_mu = mu.j()+mu.e();
-    int k1_lambda, k2_lambda, k1_mu, k2_mu;
-    basis().support(lambda, k1_lambda, k2_lambda);
-    basis().support(mu, k1_mu, k2_mu);
-
-    // Set up Gauss points and weights for a composite quadrature formula:
-    const unsigned int N_Gauss = basis().primal_polynomial_degree()+1;
-    const double h_lambda = ldexp(1.0, -j_lambda);
-    const double h_mu = ldexp(1.0, -j_mu);
-    Array1D<double> gp_lambda(N_Gauss*(k2_lambda-k1_lambda)),
-      gp_mu(N_Gauss*(k2_mu-k1_mu)),
-      psi_lambda_values, psi_mu_values;
-    for (int patch = k1_lambda, id = 0; patch < k2_lambda; patch++)
-      for (unsigned int n = 0; n < N_Gauss; n++, id++)
-	gp_lambda[id] = h_lambda*(2*patch+1+GaussPoints[N_Gauss-1][n])/2.;
-    for (int patch = k1_mu, id = 0; patch < k2_mu; patch++)
-      for (unsigned int n = 0; n < N_Gauss; n++, id++)
-	gp_mu[id] = h_mu*(2*patch+1+GaussPoints[N_Gauss-1][n])/2.;
-
-    // - compute point values of the integrands
-    basis().evaluate(0, lambda, gp_lambda, psi_lambda_values);
-    basis().evaluate(0, mu, gp_mu, psi_mu_values);
-
-    // - add all integral shares
-    for (int patch_lambda = k1_lambda, id2_lambda = 0; patch_lambda < k2_lambda; patch_lambda++)
-      for (unsigned int n_lambda = 0; n_lambda < N_Gauss; n_lambda++, id2_lambda++) {
-	const double gw_lambda = GaussWeights[N_Gauss-1][n_lambda] * h_lambda;
-	for (int patch_mu = k1_mu, id2_mu = 0; patch_mu < k2_mu; patch_mu++)
-	  for (unsigned int n_mu = 0; n_mu < N_Gauss; n_mu++, id2_mu++) {
-	    const double gw_mu = GaussWeights[N_Gauss-1][n_mu] * h_mu;
-	    entry +=
-	      psi_lambda_values[id2_lambda] * gw_lambda
-	      * psi_mu_values[id2_mu] * gw_mu
-	      * g(gp_lambda[id2_lambda], gp_mu[id2_mu]);
-	  }
+    int j_lambda, k1_lambda, k2_lambda, j_mu, k1_mu, k2_mu;
+    support(lambda, j_lambda, k1_lambda, k2_lambda);
+    support(mu, j_mu, k1_mu, k2_mu);
+
+    const Array1D<double>& psi_lambda_values(weighted_values(lambda));
+    const Array1D<double>& psi_mu_values(weighted_values(mu));
+
+    if (admissible(j_lambda, k1_lambda, k2_lambda, j_mu, k1_mu, k2_mu)) {
+      // far field: g(x,y) \approx \sum_r U(x,r)V(y,r)
+      Array1D<double> gp_lambda, gp_mu;
+      gauss_points(j_lambda, k1_lambda, k2_lambda, gp_lambda);
+      gauss_points(j_mu, k1_mu, k2_mu, gp_mu);
+      MathTL::Matrix<double> U, V;
+      const unsigned int rank = MathTL::ACA(KernelMatrix(this, gp_lambda, gp_mu), aca_tolerance,
+					    std::min(gp_lambda.size(), gp_mu.size()), U, V);
+      for (unsigned int r = 0; r < rank; r++) {
+	double ulambda(0), vmu(0);
+	for (unsigned int m = 0; m < gp_lambda.size(); m++)
+	  ulambda += psi_lambda_values[m] * U(m, r);
+	for (unsigned int n = 0; n < gp_mu.size(); n++)
+	  vmu += psi_mu_values[n] * V(n, r);
+	entry += ulambda * vmu;
       }
-    
+    } else {
+      // near field: add all integral shares, with tabulated kernel values
+      const unsigned int N = N_Gauss();
+      for (int patch_lambda = k1_lambda; patch_lambda < k2_lambda; patch_lambda++)
+	for (int patch_mu = k1_mu; patch_mu < k2_mu; patch_mu++) {
+	  const Array1D<double>& gvalues(kernel_block(j_lambda, patch_lambda, j_mu, patch_mu));
+	  const unsigned int id_lambda = (patch_lambda-k1_lambda)*N, id_mu = (patch_mu-k1_mu)*N;
+	  for (unsigned int m = 0, id = 0; m < N; m++) {
+	    double share = 0;
+	    for (unsigned int n = 0; n < N; n++, id++)
+	      share += gvalues[id] * psi_mu_values[id_mu+n];
+	    entry += psi_lambda_values[id_lambda+m] * share;
+	  }
+	}
+    }
+
     return entry;
   }
-  
+
+  template <int d, int dT, int J0>
+  double
+  FredholmIntegralOperator<d,dT,J0>::D(const Index& lambda) const
+  {
+    const int lambda_num = lambda.number();
+    typename std::map<int,double>::iterator lb(diagonal_cache.lower_bound(lambda_num));
+    if (lb == diagonal_cache.end() || diagonal_cache.key_comp()(lambda_num, lb->first))
+      lb = diagonal_cache.insert(lb, std::make_pair(lambda_num, sqrt(a(lambda, lambda))));
+    return lb->second;
+  }
+
+  template <int d, int dT, int J0>
+  template <class VECTOR>
+  void
+  FredholmIntegralOperator<d,dT,J0>::add_level(const Index& lambda,
+					       VECTOR& w,
+					       const int j,
+					       const double factor,
+					       const int J,
+					       const CompressionStrategy strategy,
+					       const int jmax,
+					       const int pmax,
+					       const double a,
+					       const double b) const
+  {
+    // the rows are generators (j == j0-1) or wavelets on level j
+    const bool generators = (j == basis().j0()-1);
+    const int jrow = generators ? basis().j0() : j;
+    const double B = cutoff(lambda.j(), jrow, J);
+
+    const std::pair<int,int> key(lambda.number(), j);
+    typename std::map<std::pair<int,int>, LevelBlock>::iterator blockit(blocks_cache.find(key));
+    if (blockit == blocks_cache.end() || blockit->second.J < J) {
+      // compute the level block for the compression parameter J
+      LevelBlock& block(blocks_cache[key]);
+      block.J = J;
+      block.entries.clear();
+
+      int j_lambda, k1_lambda, k2_lambda;
+      support(lambda, j_lambda, k1_lambda, k2_lambda);
+      const double a_lambda = ldexp((double)k1_lambda, -j_lambda);
+      const double b_lambda = ldexp((double)k2_lambda, -j_lambda);
+      const double d_lambda = D(lambda);
+      const Array1D<double>& psi_lambda_values(weighted_values(lambda));
+
+      // Collect the rows within the cut-off distance. Rows with a distance of at least
+      // diam(supp psi_lambda)/eta are in the far field, those on the left and on the
+      // right of supp psi_lambda are treated by one cross approximation each.
+      std::list<std::pair<Index,double> > far_left, far_right;
+      int jfar = 0, left1 = 0, left2 = 0, right1 = 0, right2 = 0;
+
+      // only the translations whose supports intersect [a_lambda-B,b_lambda+B]
+      int firstk, lastk;
+      translation_range(jrow, generators ? 0 : 1, a_lambda-B, b_lambda+B, firstk, lastk);
+      for (int k = firstk; k <= lastk; k++) {
+	const Index nu(jrow, generators ? 0 : 1, k);
+	int j_nu, k1_nu, k2_nu;
+	support(nu, j_nu, k1_nu, k2_nu);
+	const double a_nu = ldexp((double)k1_nu, -j_nu), b_nu = ldexp((double)k2_nu, -j_nu);
+	const double dist = std::max(0.0, std::max(a_nu, a_lambda) - std::min(b_nu, b_lambda));
+	if (dist <= B) {
+	  jfar = j_nu;
+	  if (dist > 0 && (b_lambda-a_lambda) <= admissibility_eta * dist) {
+	    if (b_nu <= a_lambda) {
+	      if (far_left.empty()) left1 = k1_nu;
+	      left2 = k2_nu;
+	      far_left.push_back(std::make_pair(nu, dist));
+	    } else {
+	      if (far_right.empty()) right1 = k1_nu;
+	      right2 = k2_nu;
+	      far_right.push_back(std::make_pair(nu, dist));
+	    }
+	  } else {
+	    const double entry = this->a(nu, lambda);
+	    if (entry != 0.)
+	      block.entries[nu.number()] = std::make_pair(entry / (D(nu)*d_lambda), dist);
+	  }
+	}
+      }
+
+      Array1D<double> gp_lambda;
+      gauss_points(j_lambda, k1_lambda, k2_lambda, gp_lambda);
+      for (int side = 0; side <= 1; side++) {
+	const std::list<std::pair<Index,double> >& rows(side == 0 ? far_left : far_right);
+	if (rows.empty()) continue;
+	const int k1 = (side == 0 ? left1 : right1), k2 = (side == 0 ? left2 : right2);
+
+	// kernel applied to psi_lambda on the far field grid,
+	// u(x) = \sum_y g(x,y)psi_lambda(y) \approx U*(V^T*psi_lambda)
+	Array1D<double> gp_far;
+	gauss_points(jfar, k1, k2, gp_far);
+	MathTL::Matrix<double> U, V;
+	const unsigned int rank = MathTL::ACA(KernelMatrix(this, gp_far, gp_lambda), aca_tolerance,
+					      std::min(gp_far.size(), gp_lambda.size()), U, V);
+	Vector<double> t(rank), u(gp_far.size());
+	for (unsigned int r = 0; r < rank; r++)
+	  for (unsigned int n = 0; n < gp_lambda.size(); n++)
+	    t[r] += V(n, r) * psi_lambda_values[n];
+	for (unsigned int m = 0; m < gp_far.size(); m++)
+	  for (unsigned int r = 0; r < rank; r++)
+	    u[m] += U(m, r) * t[r];
+
+	const unsigned int N = N_Gauss();
+	for (typename std::list<std::pair<Index,double> >::const_iterator it(rows.begin());
+	     it != rows.end(); ++it) {
+	  int j_nu, k1_nu, k2_nu;
+	  support(it->first, j_nu, k1_nu, k2_nu);
+	  const Array1D<double>& psi_nu_values(weighted_values(it->first));
+	  double entry = 0;
+	  for (unsigned int m = 0; m < psi_nu_values.size(); m++)
+	    entry += psi_nu_values[m] * u[(k1_nu-k1)*N+m];
+	  if (entry != 0.)
+	    block.entries[it->first.number()] = std::make_pair(entry / (D(it->first)*d_lambda), it->second);
+	}
+      }
+
+      blockit = blocks_cache.find(key);
+    }
+
+    for (typename std::map<int, std::pair<double,double> >::const_iterator
+	   it(blockit->second.entries.begin()), itend(blockit->second.entries.end());
+	 it != itend; ++it)
+      if (it->second.second <= B)
+	w[it->first] += factor * it->second.first;
+  }
+
+  template <int d, int dT, int J0>
+  double
+  FredholmIntegralOperator<d,dT,J0>::norm_A() const
+  {
+    if (normA == 0.0) {
+      std::set<Index> Lambda;
+      const int j0 = basis().j0();
+      for (Index lambda = basis().first_generator(j0);; ++lambda) {
+	Lambda.insert(lambda);
+	if (lambda == basis().last_wavelet(j0+2)) break;
+      }
+      SparseMatrix<double> A_Lambda;
+      setup_stiffness_matrix(*this, Lambda, A_Lambda);
+
+      Vector<double> xk(Lambda.size(), false), yk(Lambda.size(), false);
+      xk = 1, yk = 1;
+      unsigned int iterations;
+      normA = MathTL::PowerIteration(A_Lambda, xk, 1e-3, 100, iterations);
+      normAinv = 1./MathTL::InversePowerIteration(A_Lambda, yk, 1e-1, 1e-3, 100, iterations);
+    }
+
+    return normA;
+  }
+
+  template <int d, int dT, int J0>
+  double
+  FredholmIntegralOperator<d,dT,J0>::norm_Ainv() const
+  {
+    if (normAinv == 0.0)
+      norm_A();
+    return normAinv;
+  }
+
   template <int d, int dT, int J0>
   VolterraIntegralOperator<d,dT,J0>::VolterraIntegralOperator
   (const WaveletBasis& basis,
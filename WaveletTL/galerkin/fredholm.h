@@ -11,6 +11,8 @@
 #define _WAVELETTL_FREDHOLM_H
 
 #include <set>
+#include <map>
+#include <utility>
 #include <utils/fixed_array1d.h>
 #include <utils/array1d.h>
 #include <algebra/infinite_vector.h>
@@ -47,6 +49,28 @@ namespace WaveletTL
 
     The class has the minimal signature to be used within the APPLY routine
     or within adaptive solvers like CDD1.
+
+    Evaluation of the entries:
+    The integrands are discretized with a composite Gauss rule on the dyadic patches
+    of the supports. The weighted point values of the wavelets are cached per index,
+    and the values of g on the quadrature grids of the levels j,j' are tabulated per
+    pair of patches in the near field, so that neighboring entries share them.
+    In the far field, i.e., if the support of the finer function has a distance
+    of at least diam/eta to the other one, the kernel block is approximated
+    by adaptive cross approximation (see MathTL::ACA()), so that only O(r(m+n))
+    instead of O(mn) kernel evaluations are necessary.
+
+    A priori compression (add_level()):
+    Since g is assumed to be smooth away from the diagonal s=t, the entries decay
+    with the distance of the supports due to the vanishing moments of the wavelets.
+    In the spirit of [DPS], the entries with
+      dist(supp psi_lambda, supp psi_nu) > a*max(2^{-min(j,j')}, 2^{(J-(j+j')(dT+1/2))/(2dT)})
+    are dropped, where J is the compression parameter of the APPLY routine.
+
+    References:
+    [DPS] Dahmen, Proessdorf, Schneider:
+          Wavelet approximation methods for pseudodifferential equations II:
+          Matrix compression and fast solution
   */
   template <int d, int dT, int J0>
   class FredholmIntegralOperator
@@ -102,7 +126,7 @@ namespace WaveletTL
     /*!
       evaluate the diagonal preconditioner D
     */
-    double D(const Index& lambda) const { return sqrt(a(lambda,lambda)); }
+    double D(const Index& lambda) const;
     
     /*
       kernel function
@@ -167,7 +191,39 @@ namespace WaveletTL
     void set_rhs(const InfiniteVector<double, typename WaveletBasis::Index>& y) const {
       y_ = y;
     }
- 
+
+    /*!
+      w += factor * (stiffness matrix entries in column lambda on level j),
+      w is a dense vector indexed by numbers (Vector<double> or DenseAccumulator<double>);
+      as usual, j == j0-1 denotes the generators on level j0;
+      the level blocks are compressed a priori and cached
+    */
+    template <class VECTOR>
+    void add_level (const Index& lambda,
+		    VECTOR& w,
+		    const int j,
+		    const double factor,
+		    const int J,
+		    const CompressionStrategy strategy = St04a,
+		    const int jmax = 99,
+		    const int pmax = 0,
+		    const double a = 0,
+		    const double b = 0) const;
+
+    /*!
+      set the parameters of the a priori compression and the far field approximation
+      (a <= 0 switches off the a priori compression)
+      \param a factor of the distance cut-off (default: 2)
+      \param eta admissibility parameter of the far field (default: 1)
+      \param epsilon relative tolerance of the cross approximation (default: 1e-10)
+    */
+    void set_compression(const double a, const double eta, const double epsilon);
+
+    /*!
+      clear the caches of point values, kernel values and level blocks
+    */
+    void clear_cache() const;
+
   protected:
     // the wavelet basis
     const WaveletBasis& basis_;
@@ -177,6 +233,83 @@ namespace WaveletTL
     
     // estimates for ||A|| and ||A^{-1}||
     mutable double normA, normAinv;
+
+    // parameters of the compression
+    double distance_factor, admissibility_eta, aca_tolerance;
+
+    //! number of Gauss points per patch
+    static unsigned int N_Gauss() { return WaveletBasis::primal_polynomial_degree()+1; }
+
+    //! patches 2^{-j}[k,k+1], k1 <= k < k2, of the support of psi_lambda
+    void support(const Index& lambda, int& j, int& k1, int& k2) const;
+
+    /*!
+      translations k1 <= k <= k2 of the generators (e == 0) or wavelets (e == 1)
+      on the level j whose supports intersect [a,b]
+      (the ends of the supports are nondecreasing in k, including the boundary functions)
+    */
+    void translation_range(const int j, const int e, const double a, const double b,
+			   int& k1, int& k2) const;
+
+    //! Gauss points on the patches 2^{-j}[k,k+1], k1 <= k < k2
+    static void gauss_points(const int j, const int k1, const int k2, Array1D<double>& points);
+
+    //! Gauss weights times point values of psi_lambda on its support (cached)
+    const Array1D<double>& weighted_values(const Index& lambda) const;
+
+    //! values g(x_m,y_n) for the Gauss points of the patches 2^{-j}[k,k+1], 2^{-j'}[k',k'+1] (cached)
+    const Array1D<double>& kernel_block(const int j, const int k,
+					const int jprime, const int kprime) const;
+
+    //! far field criterion for two supports
+    bool admissible(const int j, const int k1, const int k2,
+		    const int jprime, const int k1prime, const int k2prime) const;
+
+    //! distance cut-off of the a priori compression
+    double cutoff(const int j, const int jprime, const int J) const;
+
+    /*!
+      helper class for the cross approximation, the matrix (g(x_m,y_n))_{m,n}
+    */
+    class KernelMatrix
+    {
+    public:
+      KernelMatrix(const FredholmIntegralOperator* op,
+		   const Array1D<double>& x, const Array1D<double>& y)
+	: op_(op), x_(x), y_(y) {}
+      double operator () (const unsigned int row, const unsigned int column) const {
+	return op_->g(x_[row], y_[column]);
+      }
+      unsigned int row_dimension() const { return x_.size(); }
+      unsigned int column_dimension() const { return y_.size(); }
+    protected:
+      const FredholmIntegralOperator* op_;
+      const Array1D<double>& x_;
+      const Array1D<double>& y_;
+    };
+
+    //! cache of the weighted point values, the key is the number of the index
+    mutable std::map<int, Array1D<double> > values_cache;
+
+    //! tabulated kernel values per level pair (j,j') and pair of patches (k,k')
+    typedef std::map<std::pair<int,int>, Array1D<double> > KernelTable;
+    mutable std::map<std::pair<int,int>, KernelTable> kernel_cache;
+
+    //! diagonal entries, the key is the number of the index
+    mutable std::map<int, double> diagonal_cache;
+
+    /*!
+      one compressed level block of a column, for each row the entry and the distance
+      of the supports, computed for the compression parameter J
+    */
+    struct LevelBlock
+    {
+      int J;
+      std::map<int, std::pair<double,double> > entries;
+    };
+
+    //! cache of the level blocks, the key is (number of the column, level)
+    mutable std::map<std::pair<int,int>, LevelBlock> blocks_cache;
   };
 
   /*!
@@ -73,6 +73,78 @@ namespace WaveletTL
 //   }
  
 
+  /*
+    the rows of setup_stiffness_matrix(), as a body for parallel_for();
+    row lambda only calls P.a(.,lambda), the diagonal preconditioner is
+    evaluated beforehand, so that the rows may use P.a() concurrently
+    if ConcurrentEntries<PROBLEM> allows it; otherwise the entries are
+    computed in a critical section
+  */
+  template <class PROBLEM>
+  class StiffnessMatrixRows
+  {
+  public:
+    typedef typename PROBLEM::Index Index;
+    typedef typename SparseMatrix<double>::size_type size_type;
+
+    StiffnessMatrixRows(PROBLEM& P,
+			const std::set<Index>& Lambda,
+			SparseMatrix<double>& A_Lambda,
+			const bool preconditioned)
+      : P_(P), Lambda_(Lambda), A_Lambda_(A_Lambda), preconditioned_(preconditioned)
+    {
+      rows_.reserve(Lambda.size());
+      D_.reserve(Lambda.size());
+      for (typename std::set<Index>::const_iterator it(Lambda.begin()), itend(Lambda.end());
+	   it != itend; ++it) {
+	rows_.push_back(it);
+	D_.push_back(preconditioned ? P.D(*it) : 1.0);
+      }
+    }
+
+    void operator () (const int row)
+    {
+      typename std::set<Index>::const_iterator it1(rows_[row]);
+      std::list<size_type> indices;
+      std::list<double> entries;
+      size_type column = 0;
+      for (typename std::set<Index>::const_iterator it2(Lambda_.begin()), itend(Lambda_.end());
+	   it2 != itend; ++it2, ++column)
+	{
+	  const double entry = ConcurrentEntries<PROBLEM>::value
+	    ? P_.a(*it2, *it1)
+	    : serial_entry(*it2, *it1);
+#if _WAVELETTL_GALERKINUTILS_VERBOSITY >= 2
+	  if (fabs(entry) > 1e-15) {
+	    cout << " column: " << *it2 <<  ", value " << entry << endl;
+	  }
+#endif
+	  if (fabs(entry) > 1e-15) {
+	    indices.push_back(column);
+	    entries.push_back(entry / (D_[row] * D_[column]));
+	  }
+	}
+      A_Lambda_.set_row(row, indices, entries);
+    }
+
+  protected:
+    // P.a(lambda,nu), one thread at a time
+    double serial_entry(const Index& lambda, const Index& nu)
+    {
+      double entry = 0;
+#pragma omp critical (WaveletTL_StiffnessMatrixRows_entry)
+      entry = P_.a(lambda, nu);
+      return entry;
+    }
+
+    PROBLEM& P_;
+    const std::set<Index>& Lambda_;
+    SparseMatrix<double>& A_Lambda_;
+    const bool preconditioned_;
+    std::vector<typename std::set<Index>::const_iterator> rows_;
+    std::vector<double> D_;
+  };
+
   template <class PROBLEM>
   void setup_stiffness_matrix(PROBLEM& P,
 			      const std::set<typename PROBLEM::Index>& Lambda,
@@ -88,41 +160,8 @@ namespace WaveletTL
     typedef typename PROBLEM::Index Index;
 #if PARALLEL==1
     cout<<"parallel computing stiffness matrix"<<endl;
-#pragma omp parallel
-    {
-#pragma omp for
-    for(size_type row=0;row<Lambda.size();row++){
-        typename std::set<Index>::const_iterator it1(Lambda.begin());
-        advance(it1, row);
-
-//        cout << "Index nu: " << *it1 << endl;
-	const double d1 = preconditioned ? P.D(*it1) : 1.0;
-	std::list<size_type> indices;
-	std::list<double> entries;
-	size_type column = 0;
-	for (typename std::set<Index>::const_iterator it2(Lambda.begin()), itend(Lambda.end());
-	     it2 != itend; ++it2, ++column)
-	  {
-	    // 	    if (intersect_singular_support(P.basis(), *it1, *it2)) {
-#pragma omp critical
-            {
-                double entry = P.a(*it2, *it1);
-	    
-	    //const double entry = 0;
-#if _WAVELETTL_GALERKINUTILS_VERBOSITY >= 2
- 	    if (fabs(entry) > 1e-15) {
- 	      cout << " column: " << *it2 <<  ", value " << entry << endl;
- 	    }
-#endif
-	    if (fabs(entry) > 1e-15) {
-		indices.push_back(column);
-		entries.push_back(entry / (preconditioned ? d1 * P.D(*it2) : 1.0));
-	    }
-	    }
-	  }
-	A_Lambda.set_row(row, indices, entries);
-      }
-    }
+    StiffnessMatrixRows<PROBLEM> rows(P, Lambda, A_Lambda, preconditioned);
+    parallel_for(0, Lambda.size(), rows);
  #else
     cout<<"sequentiell computing stiffness matrix"<<endl;
     size_type row=0;
@@ -375,4 +414,25 @@ namespace WaveletTL
             F_Lambda[row] = P.f(*it);
         }
     }
+
+  template <class PROBLEM>
+  void
+  FrameRHSCoefficients<PROBLEM>::operator () (const int i)
+  {
+    const Index& lambda(*(P_.frame().get_quarklet(i)));
+    const double coeff = P_.f(lambda) / P_.D(lambda);
+    if (fabs(coeff)>1e-15)
+      {
+	coeffs.set_coefficient(lambda, coeff);
+	coeffs_int.set_coefficient(i, coeff);
+      }
+  }
+
+  template <class PROBLEM>
+  void
+  FrameRHSCoefficients<PROBLEM>::join(FrameRHSCoefficients& c)
+  {
+    coeffs.add(c.coeffs);
+    coeffs_int.add(c.coeffs_int);
+  }
 }
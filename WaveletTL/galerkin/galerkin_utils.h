@@ -11,19 +11,38 @@
 #define _WAVELETTL_GALERKIN_UTILS_H
 
 #include <set>
+#include <vector>
 
 #include <algebra/sparse_matrix.h>
 #include <algebra/vector.h>
+#include <algebra/infinite_vector.h>
+#include <utils/task_scheduler.h>
 #include <omp.h>
 
 using MathTL::SparseMatrix;
 using MathTL::Vector;
+using MathTL::InfiniteVector;
+using MathTL::TaskScheduler;
+using MathTL::parallel_for;
+using MathTL::parallel_reduce;
 
 //extern int number_of_entries_computed;
 //extern int number_of_entries_from_cache;
 
 namespace WaveletTL
 {
+  /*!
+    Trait telling whether P.a(lambda,nu) may be called concurrently for distinct nu,
+    e.g. by the threads of the parallel setup_stiffness_matrix().
+    Since most problem classes keep unguarded caches, the default is false,
+    and the entries are computed one at a time.
+  */
+  template <class PROBLEM>
+  struct ConcurrentEntries
+  {
+    static const bool value = false;
+  };
+
   /*!
     Setup the (sparse, preconditioned per default) stiffness matrix for a given problem and a given active
     index set Lambda.
@@ -74,6 +93,40 @@ namespace WaveletTL
     void setup_righthand_side(PROBLEM& P,
             const std::set<int>& Lambda,
             Vector<double>& F_Lambda);
+
+  /*!
+    The (preconditioned) right-hand side coefficients P.f(lambda)/P.D(lambda)
+    for all quarklets lambda of the finite frame P.frame(), as a body for
+    parallel_reduce() over the quarklet numbers, cf. compute_rhs() of
+    LDomainFrameEquation. Coefficients with modulus below 1e-15 are dropped.
+    (The squared norm should be computed afterwards from coeffs_int, which
+    sums up in the same order as a sequential loop over the numbers.)
+  */
+  template <class PROBLEM>
+  class FrameRHSCoefficients
+  {
+  public:
+    typedef typename PROBLEM::Index Index;
+
+    //! constructor from the problem
+    FrameRHSCoefficients(const PROBLEM& P) : P_(P) {}
+
+    //! splitting constructor for parallel_reduce()
+    FrameRHSCoefficients(FrameRHSCoefficients& c, TaskScheduler::Split) : P_(c.P_) {}
+
+    //! compute the coefficient of the i-th quarklet
+    void operator () (const int i);
+
+    //! add the coefficients collected by c
+    void join(FrameRHSCoefficients& c);
+
+    //! the nontrivial coefficients, indexed by quarklets and by numbers
+    InfiniteVector<double,Index> coeffs;
+    InfiniteVector<double,int> coeffs_int;
+
+  protected:
+    const PROBLEM& P_;
+  };
 }
 
 #include <galerkin/galerkin_utils.cpp>
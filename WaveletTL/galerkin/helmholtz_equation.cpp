@@ -109,10 +109,11 @@ namespace WaveletTL
   }
 
   template <int d, int dT, int J0>
+  template <class VECTOR>
   void
   HelmholtzEquation1D<d,dT,J0>::add_level (const Index& lambda,
 					   //InfiniteVector<double, Index>& w,
-					   Vector<double>& w,
+					   VECTOR& w,
 					   const int j,
 					   const double factor,
 					   const int J,
@@ -152,14 +153,11 @@ namespace WaveletTL
     help1.add(help2);
     help1.scale(this, -1); // help1 *= D_alpha^{-1}
 
-    Vector<double> help1_full_new(w.size());
+    //    w.add(help1);
     for (typename InfiniteVector<double,Index>::const_iterator it(help1.begin());
  	   it != help1.end(); ++it) {
-      help1_full_new[it.index().number()] = *it;
+      w[it.index().number()] += *it;
     }
-
-    //    w.add(help1);
-    w += help1_full_new;
   }
   
   
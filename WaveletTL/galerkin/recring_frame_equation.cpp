@@ -83,26 +83,12 @@ namespace WaveletTL
         double coeff;
         
 #if PARALLEL==1
-        double fnorm_sqr_help = 0.;
         cout<<"parallel computing rhs"<<endl;
-        
-#pragma omp parallel 
-{
-//        cout<<"number of threads: "<<omp_get_num_threads()<<endl;
-#pragma omp for  private(coeff) schedule(static) reduction(+:fnorm_sqr_help)
-        for (int i = 0; i< frame_->degrees_of_freedom();i++)
-        {
-            coeff = f(*(frame_->get_quarklet(i))) / D(*(frame_->get_quarklet(i)));
-            if (fabs(coeff)>1e-15)
-            {
-#pragma omp critical
-                {fhelp.set_coefficient(*(frame_->get_quarklet(i)), coeff);}
-                
-                fnorm_sqr_help += coeff*coeff;
-            }
-        }
-}
-        fnorm_sqr=fnorm_sqr_help;
+        FrameRHSCoefficients<RecRingFrameEquation<IFRAME, RECRINGFRAME> > rhs(*this);
+        parallel_reduce(0, frame_->degrees_of_freedom(), rhs);
+        fhelp.swap(rhs.coeffs);
+        fhelp_int.swap(rhs.coeffs_int);
+        fnorm_sqr = l2_norm_sqr(fhelp_int);
 #else 
        for (int i = 0; i< frame_->degrees_of_freedom();i++)
         {
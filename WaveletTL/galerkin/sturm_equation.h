@@ -228,6 +228,15 @@ namespace WaveletTL
     // estimates for ||A|| and ||A^{-1}||
     mutable double normA, normAinv;
   };
+
+  /*!
+    a(lambda,nu) only evaluates the basis functions, so it may be called concurrently
+  */
+  template <class WBASIS>
+  struct ConcurrentEntries<SturmEquation<WBASIS> >
+  {
+    static const bool value = true;
+  };
 }
 
 #include <galerkin/sturm_equation.cpp>
@@ -21,7 +21,7 @@ namespace WaveletTL
     TensorEquation<IBASIS,DIM,TENSORBASIS>::TensorEquation(const EllipticBVP<DIM>* bvp,
                                                      const FixedArray1D<int,2*DIM>& bc,
                                                      const bool precompute)
-    : bvp_(bvp), basis_(bc), normA(0.0), normAinv(0.0)
+    : bvp_(const_cast<EllipticBVP<DIM>*>(bvp)), basis_(bc), normA(0.0), normAinv(0.0)
     {
         if (precompute == true)
         {
@@ -118,27 +118,13 @@ namespace WaveletTL
         {
             // setup Gauss points and weights for a composite quadrature formula:
             const int N_Gauss = (p+1)/2;
-
-            //const double h = ldexp(1.0, -supp.j); // granularity for the quadrature
-            // FixedArray1D<double,DIM> h; // granularity for the quadrature
-            double hi; // granularity for the quadrature
-            FixedArray1D<Array1D<double>,DIM> gauss_points, gauss_weights;
-            for (unsigned int i = 0; i < DIM; i++) {
-                hi = ldexp(1.0, -supp.j[i]);
-                gauss_points[i].resize(N_Gauss*(supp.b[i]-supp.a[i]));
-                gauss_weights[i].resize(N_Gauss*(supp.b[i]-supp.a[i]));
-                for (int patch = supp.a[i]; patch < supp.b[i]; patch++)
-                    for (int n = 0; n < N_Gauss; n++) {
-                        gauss_points[i][(patch-supp.a[i])*N_Gauss+n]
-                                = hi*(2*patch+1+GaussPoints[N_Gauss-1][n])/2.;
-                        gauss_weights[i][(patch-supp.a[i])*N_Gauss+n]
-                                = hi*GaussWeights[N_Gauss-1][n];
-                    }
-            }
+            FixedArray1D<MathTL::DyadicGaussRule,DIM> rules;
+            for (unsigned int i = 0; i < DIM; i++)
+                rules[i].setup(supp.j[i], supp.a[i], supp.b[i], N_Gauss);
             // compute point values of the integrand (where we use that it is a tensor product)
-            FixedArray1D<Array1D<double>,DIM> psi_lambda_values,     // values of the components of psi_lambda at gauss_points[i]
+            FixedArray1D<Array1D<double>,DIM> psi_lambda_values,     // values of the components of psi_lambda at the Gauss points
                                               psi_mu_values,         // -"-, for psi_mu
-                                              psi_lambda_der_values, // values of the 1st deriv. of the components of psi_lambda at gauss_points[i]
+                                              psi_lambda_der_values, // values of the 1st deriv. of the components of psi_lambda at the Gauss points
                                               psi_mu_der_values;     // -"-, for psi_mu
             for (unsigned int i = 0; i < DIM; i++) {
                 evaluate(*basis_.bases()[i],
@@ -146,14 +132,14 @@ namespace WaveletTL
                                                 lambda.e()[i],
                                                 lambda.k()[i],
                                                 basis_.bases()[i]),
-                         gauss_points[i], psi_lambda_values[i], psi_lambda_der_values[i]);
+                         rules[i].points(), psi_lambda_values[i], psi_lambda_der_values[i]);
 //                
                 evaluate(*basis_.bases()[i],
                          typename IBASIS::Index(mu.j()[i],
                                                 mu.e()[i],
                                                 mu.k()[i],
                                                 basis_.bases()[i]),
-                         gauss_points[i], psi_mu_values[i], psi_mu_der_values[i]);
+                         rules[i].points(), psi_mu_values[i], psi_mu_der_values[i]);
 //                
             }
             // iterate over all points and sum up the integral shares
@@ -172,11 +158,11 @@ namespace WaveletTL
 //                    cout << endl << "gauss_weights[" << i << "]: " << gauss_weights[i] << endl;
 //                    cout << "psi_lambda_values[" << i << "]: " << psi_lambda_values[i] << endl;
 //                    cout << "psi_mu_values[" << i << "]: " << psi_mu_values[i] << endl;
-                    for (unsigned int ind = 0; ind < gauss_points[i].size(); ind++){
+                    for (unsigned int ind = 0; ind < rules[i].size(); ind++){
 //                        if(i==1)
 //                        cout << "Zwischenwert integral: " << integral[i] << endl;
-                        integral[i] += psi_lambda_values[i][ind] * psi_mu_values[i][ind] * gauss_weights[i][ind];
-                        der_integral[i] += psi_lambda_der_values[i][ind] * psi_mu_der_values[i][ind] * gauss_weights[i][ind];
+                        integral[i] += psi_lambda_values[i][ind] * psi_mu_values[i][ind] * rules[i].weights()[ind];
+                        der_integral[i] += psi_lambda_der_values[i][ind] * psi_mu_der_values[i][ind] * rules[i].weights()[ind];
                     }
                 }
                 
@@ -192,11 +178,11 @@ namespace WaveletTL
             {
                 while (true) {
                     for (unsigned int i = 0; i < DIM; i++)
-                        x[i] = gauss_points[i][index[i]];
+                        x[i] = rules[i].points()[index[i]];
                     // product of current Gauss weights
                     weights = 1.0;
                     for (unsigned int i = 0; i < DIM; i++)
-                        weights *= gauss_weights[i][index[i]];
+                        weights *= rules[i].weights()[index[i]];
                     // compute the share a(x)(grad psi_lambda)(x)(grad psi_mu)(x)
                     for (unsigned int i = 0; i < DIM; i++) {
                         grad_psi_lambda[i] = 1.0;
@@ -263,29 +249,18 @@ namespace WaveletTL
         support(basis_, lambda, supp);
         // setup Gauss points and weights for a composite quadrature formula:
         const int N_Gauss = 5;
-        // FixedArray1D<double,DIM> h; // = ldexp(1.0, -supp.j); // granularity for the quadrature
-        double hi; // granularity for the quadrature
-        FixedArray1D<Array1D<double>,DIM> gauss_points, gauss_weights, v_values;
-        for (unsigned int i = 0; i < DIM; i++) {
-            hi = ldexp(1.0,-supp.j[i]);
-            gauss_points[i].resize(N_Gauss*(supp.b[i]-supp.a[i]));
-            gauss_weights[i].resize(N_Gauss*(supp.b[i]-supp.a[i]));
-            for (int patch = supp.a[i]; patch < supp.b[i]; patch++)
-                for (int n = 0; n < N_Gauss; n++) {
-                    gauss_points[i][(patch-supp.a[i])*N_Gauss+n]
-                            = hi*(2*patch+1+GaussPoints[N_Gauss-1][n])/2.;
-                    gauss_weights[i][(patch-supp.a[i])*N_Gauss+n]
-                            = hi*GaussWeights[N_Gauss-1][n];
-                }
-        }
+        FixedArray1D<MathTL::DyadicGaussRule,DIM> rules;
+        for (unsigned int i = 0; i < DIM; i++)
+            rules[i].setup(supp.j[i], supp.a[i], supp.b[i], N_Gauss);
         // compute the point values of the integrand (where we use that it is a tensor product)
+        FixedArray1D<Array1D<double>,DIM> v_values;
         for (unsigned int i = 0; i < DIM; i++)
             evaluate(*basis_.bases()[i], 0,
                      typename IBASIS::Index(lambda.j()[i],
                                             lambda.e()[i],
                                             lambda.k()[i],
                                             basis_.bases()[i]),
-                     gauss_points[i], v_values[i]);
+                     rules[i].points(), v_values[i]);
         // iterate over all points and sum up the integral shares
         int index[DIM]; // current multiindex for the point values
         for (unsigned int i = 0; i < DIM; i++)
@@ -293,10 +268,10 @@ namespace WaveletTL
         Point<DIM> x;
         while (true) {
             for (unsigned int i = 0; i < DIM; i++)
-                x[i] = gauss_points[i][index[i]];
+                x[i] = rules[i].points()[index[i]];
             double share = bvp_->f(x);
             for (unsigned int i = 0; i < DIM; i++)
-                share *= gauss_weights[i][index[i]] * v_values[i][index[i]];
+                share *= rules[i].weights()[index[i]] * v_values[i][index[i]];
             r += share;
             // "++index"
             bool exit = false;
@@ -355,7 +330,7 @@ namespace WaveletTL
     void
     TensorEquation<IBASIS,DIM,TENSORBASIS>::set_bvp(const EllipticBVP<DIM>* bvp)
     {
-        bvp_ = bvp;
+        bvp_ = const_cast<EllipticBVP<DIM>*>(bvp);
         compute_rhs();
     }
 
@@ -466,4 +441,108 @@ namespace WaveletTL
         }
         return normAinv;
     }
+
+    template <class IBASIS, unsigned int DIM, class TENSORBASIS>
+    bool
+    TensorEquation<IBASIS,DIM,TENSORBASIS>::kronecker_coefficients(double& ax, double& qx) const
+    {
+        if (!bvp_->constant_coefficients())
+            return false;
+        Point<DIM> x;
+        ax = bvp_->a(x);
+        qx = bvp_->q(x);
+        return true;
+    }
+
+    template <class IBASIS, unsigned int DIM, class TENSORBASIS>
+    int
+    TensorEquation<IBASIS,DIM,TENSORBASIS>::level_size_1D(const unsigned int i, const int j) const
+    {
+        const IBASIS* basis1d = basis_.bases()[i];
+        return (j == basis1d->j0())
+                ? basis1d->Deltasize(j) + basis1d->Nablasize(j)
+                : basis1d->Nablasize(j);
+    }
+
+    template <class IBASIS, unsigned int DIM, class TENSORBASIS>
+    int
+    TensorEquation<IBASIS,DIM,TENSORBASIS>::level_position_1D(const unsigned int i,
+                                                              const int j, const int e, const int k) const
+    {
+        const IBASIS* basis1d = basis_.bases()[i];
+        if (e == 0)
+            return k - basis1d->DeltaLmin();
+        return (j == basis1d->j0() ? basis1d->Deltasize(j) : 0) + k - basis1d->Nablamin();
+    }
+
+    template <class IBASIS, unsigned int DIM, class TENSORBASIS>
+    void
+    TensorEquation<IBASIS,DIM,TENSORBASIS>::level_blocks_1D(const unsigned int i,
+                                                            const int j_row, const int j_col,
+                                                            const SparseMatrix<double>*& G,
+                                                            const SparseMatrix<double>*& K) const
+    {
+        const typename LevelBlockCache1D::key_type key(i, std::make_pair(j_row, j_col));
+        typename LevelBlockCache1D::iterator it(one_d_level_blocks.lower_bound(key));
+        if (it == one_d_level_blocks.end() || one_d_level_blocks.key_comp()(key, it->first))
+        {
+            // compute the blocks, all 1D indices on the levels j_row and j_col are
+            // piecewise polynomials of degree d-1, so that d Gauss points per cell suffice
+            typedef typename LevelBlockCache1D::value_type value_type;
+            it = one_d_level_blocks.insert(it, value_type(key, std::make_pair(SparseMatrix<double>(), SparseMatrix<double>())));
+            SparseMatrix<double>& Gblock(it->second.first);
+            SparseMatrix<double>& Kblock(it->second.second);
+
+            const IBASIS* basis1d = basis_.bases()[i];
+            const int j0 = basis1d->j0();
+            const int rows = level_size_1D(i, j_row), columns = level_size_1D(i, j_col);
+            Gblock.resize(rows, columns);
+            Kblock.resize(rows, columns);
+            const int N_Gauss = IBASIS::primal_polynomial_degree();
+
+            // (e,k) of the m-th index on a 1D level
+            Array1D<int> e_row(rows), k_row(rows), e_col(columns), k_col(columns);
+            for (int m = 0; m < rows; m++) {
+                e_row[m] = (j_row == j0 && m < basis1d->Deltasize(j0)) ? 0 : 1;
+                k_row[m] = (e_row[m] == 0) ? basis1d->DeltaLmin() + m
+                        : basis1d->Nablamin() + m - (j_row == j0 ? basis1d->Deltasize(j0) : 0);
+            }
+            for (int m = 0; m < columns; m++) {
+                e_col[m] = (j_col == j0 && m < basis1d->Deltasize(j0)) ? 0 : 1;
+                k_col[m] = (e_col[m] == 0) ? basis1d->DeltaLmin() + m
+                        : basis1d->Nablamin() + m - (j_col == j0 ? basis1d->Deltasize(j0) : 0);
+            }
+
+            MathTL::DyadicGaussRule rule;
+            Array1D<double> values_row, dervalues_row, values_col, dervalues_col;
+            for (int r = 0; r < rows; r++) {
+                int a1, b1;
+                basis1d->support(j_row, e_row[r], k_row[r], a1, b1);
+                for (int c = 0; c < columns; c++) {
+                    // supports 2^{-(j+e)}[a,b], intersect them on the finer grid
+                    int a2, b2;
+                    basis1d->support(j_col, e_col[c], k_col[c], a2, b2);
+                    const int jsupp = std::max(j_row+e_row[r], j_col+e_col[c]);
+                    const int a = std::max(a1 << (jsupp-j_row-e_row[r]), a2 << (jsupp-j_col-e_col[c]));
+                    const int b = std::min(b1 << (jsupp-j_row-e_row[r]), b2 << (jsupp-j_col-e_col[c]));
+                    if (a >= b) continue;
+
+                    rule.setup(jsupp, a, b, N_Gauss);
+                    evaluate(*basis1d, j_row, e_row[r], k_row[r], rule.points(), values_row, dervalues_row);
+                    evaluate(*basis1d, j_col, e_col[c], k_col[c], rule.points(), values_col, dervalues_col);
+                    double integral(0), der_integral(0);
+                    for (unsigned int n = 0; n < rule.size(); n++) {
+                        integral += values_row[n] * values_col[n] * rule.weights()[n];
+                        der_integral += dervalues_row[n] * dervalues_col[n] * rule.weights()[n];
+                    }
+                    if (fabs(integral) > 1e-16)
+                        Gblock.set_entry(r, c, integral);
+                    if (fabs(der_integral) > 1e-16)
+                        Kblock.set_entry(r, c, der_integral);
+                }
+            }
+        }
+        G = &it->second.first;
+        K = &it->second.second;
+    }
 }
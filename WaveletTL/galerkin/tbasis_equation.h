@@ -11,9 +11,11 @@
 #define	_WAVELETTL_TBASIS_EQUATION_H
 
 #include <set>
+#include <map>
 #include <utils/fixed_array1d.h>
 #include <utils/array1d.h>
 #include <numerics/bvp.h>
+#include <numerics/gauss_quadrature.h>
 
 #include <galerkin/galerkin_utils.h>
 #include <galerkin/infinite_preconditioner.h>
@@ -171,6 +173,35 @@ namespace WaveletTL
         double a(const typename WaveletBasis::Index& lambda,
                  const typename WaveletBasis::Index& nu,
                  const unsigned int p) const;
+
+        /*
+         * For constant coefficients a(x)=a, q(x)=q the stiffness matrix has
+         * Kronecker structure on each pair of levels j', j:
+         *   A_{j',j} = a*\sum_i \otimes_s (s==i ? K^s_{j'_s,j_s} : G^s_{j'_s,j_s}) + q*\otimes_s G^s_{j'_s,j_s},
+         * with the 1D Gramian G^s and the 1D stiffness matrix K^s in direction s.
+         * Returns false for nonconstant coefficients, otherwise a and q are set.
+         */
+        bool kronecker_coefficients(double& ax, double& qx) const;
+
+        /*
+         * 1D level blocks G^i_{j_row,j_col} and K^i_{j_row,j_col} in direction i.
+         * A 1D level consists of the wavelets on level j (and the generators if j
+         * is the minimal level), ordered by their numbers, cf. level_size_1D().
+         * The blocks are computed on demand and cached, the returned pointers stay valid.
+         */
+        void level_blocks_1D(const unsigned int i, const int j_row, const int j_col,
+                             const SparseMatrix<double>*& G,
+                             const SparseMatrix<double>*& K) const;
+
+        /*
+         * number of 1D indices on the level j in direction i
+         */
+        int level_size_1D(const unsigned int i, const int j) const;
+
+        /*
+         * position of the 1D index (j,e,k) in direction i within its 1D level block
+         */
+        int level_position_1D(const unsigned int i, const int j, const int e, const int k) const;
                     
         /*
          * estimate the spectral norm ||A||
@@ -246,6 +277,11 @@ namespace WaveletTL
     typedef std::map<Index1D,Column1D> One_D_IntegralCache;
     
     mutable One_D_IntegralCache one_d_integrals;
+
+    // 1D level blocks (G,K) for the Kronecker representation, key: (i,(j_row,j_col))
+    typedef std::map<std::pair<unsigned int,std::pair<int,int> >,
+                     std::pair<SparseMatrix<double>,SparseMatrix<double> > > LevelBlockCache1D;
+    mutable LevelBlockCache1D one_d_level_blocks;
     // #####################################################################################
         EllipticBVP<DIM>* bvp_;
         TENSORBASIS basis_;
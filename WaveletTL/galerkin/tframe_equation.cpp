@@ -42,6 +42,7 @@ namespace WaveletTL
         TensorFrameEquation<IFRAME,DIM,TENSORFRAME>::TensorFrameEquation(const EllipticBVP<DIM>* bvp, const Frame* frame, const bool precompute_rhs)
     : nonzeroneumann_(false), bvp_(bvp), frame_(frame), normA(0.0), normAinv(0.0)
 	{
+        setup_quarklet_integrals();
 #ifndef DYADIC
             compute_diagonal(); 
 #endif
@@ -59,6 +60,7 @@ namespace WaveletTL
     : nonzeroneumann_(true), bvp_(bvp), frame_(frame), phi_(phi), normA(0.0), normAinv(0.0)
 	{
         cout<<"set non-zero neumann boundary conditions"<<endl;
+        setup_quarklet_integrals();
 #ifndef DYADIC
             compute_diagonal(); 
 #endif
@@ -76,6 +78,7 @@ namespace WaveletTL
       fcoeffs(eq.fcoeffs), fnorm_sqr(eq.fnorm_sqr),
       normA(eq.normA), normAinv(eq.normAinv)
     {
+        setup_quarklet_integrals();
 #ifndef DYADIC
             compute_diagonal(); 
 #endif
@@ -83,6 +86,15 @@ namespace WaveletTL
 //            frame_.set_jpmax(multi_degree(frame_.j0()),0);
     }
 
+    template <class IFRAME, unsigned int DIM, class TENSORFRAME>
+    void
+    TensorFrameEquation<IFRAME,DIM,TENSORFRAME>::setup_quarklet_integrals()
+    {
+        for (unsigned int i = 0; i < DIM; i++)
+            quarklet_integrals[i] = QuarkletIntegralCache<IFRAME>(frame_->frames()[i], frame_->get_pmax(),
+                                                                  quarklet_integrals[i].max_blocks());
+    }
+
 // TODO PERFORMANCE:: use setup_full_collection entries
     template <class IFRAME, unsigned int DIM, class TENSORFRAME>
     void
@@ -167,7 +179,31 @@ namespace WaveletTL
     TensorFrameEquation<IFRAME,DIM,TENSORFRAME>::a(const Index& lambda,
                                           const Index& nu) const
     {
-        return a(lambda, nu, IFRAME::primal_polynomial_degree()*IFRAME::primal_polynomial_degree());
+        // a(u,v) = \int_Omega [a(x)grad u(x)grad v(x)+q(x)u(x)v(x)] dx, constant coefficients,
+        // all 1D integrals stem from the p-blocked caches
+        double r = 0;
+        typename Frame::Support supp;
+        if (intersect_supports(*frame_, lambda, nu, supp))
+        {
+            Point<DIM> x;
+            const double ax = bvp_->constant_coefficients() ? bvp_->a(x) : 0.0;
+            const double qx = bvp_->constant_coefficients() ? bvp_->q(x) : 0.0;
+            FixedArray1D<double,DIM> integral, der_integral;
+            for (unsigned int i = 0; i < DIM; i++)
+                quarklet_integrals[i].integrals(lambda.p()[i], lambda.j()[i], lambda.e()[i], lambda.k()[i],
+                                                nu.p()[i], nu.j()[i], nu.e()[i], nu.k()[i],
+                                                integral[i], der_integral[i]);
+            double grad(0), mass(1);
+            for (unsigned int i = 0; i < DIM; i++) {
+                double share = der_integral[i];
+                for (unsigned int s = 0; s < DIM; s++)
+                    if (s != i) share *= integral[s];
+                grad += share;
+                mass *= integral[i];
+            }
+            r = ax * grad + qx * mass;
+        }
+        return r;
     }
 
     template <class IFRAME, unsigned int DIM, class TENSORFRAME>
@@ -23,6 +23,7 @@
 #include <interval/pq_expansion.h>
 #include <interval/indexq1D.h>
 #include <interval/i_q_index.h>
+#include <interval/pq_integral_cache.h>
 
 using MathTL::FixedArray1D;
 using MathTL::EllipticBVP;
@@ -171,7 +172,10 @@ namespace WaveletTL
 
         /*
          * evaluate the (unpreconditioned) bilinear form a
-         * (inherited from FullyDiagonalEnergyNormPreconditioner)
+         * (inherited from FullyDiagonalEnergyNormPreconditioner);
+         * the 1D integrals are taken from the p-blocked caches quarklet_integrals,
+         * so that all polynomial degrees of a pair of 1D spline indices are
+         * integrated in a single sweep
          */
         double a(const Index& lambda,
                  const Index& nu) const;
@@ -243,6 +247,26 @@ namespace WaveletTL
          * set or change the righthandside
          */
         void set_f(const Function<DIM>* fnew);
+
+        /*!
+          clear the caches of the 1D integrals
+        */
+        void clear_integral_cache()
+        {
+            one_d_integrals.clear();
+            for (unsigned int i = 0; i < DIM; i++)
+                quarklet_integrals[i].clear();
+        }
+
+        /*!
+          bound the number of p-blocks in each cache of the 1D integrals (0: unbounded),
+          cf. QuarkletIntegralCache::set_max_blocks()
+        */
+        void set_max_integral_blocks(const unsigned int max_blocks)
+        {
+            for (unsigned int i = 0; i < DIM; i++)
+                quarklet_integrals[i].set_max_blocks(max_blocks);
+        }
         
         /*!
          function for neumann-bc
@@ -290,6 +314,12 @@ namespace WaveletTL
         typedef std::map<IndexQ1D<IFRAME>,Column1D> One_D_IntegralCache;
 
         mutable One_D_IntegralCache one_d_integrals;
+
+        // p-blocked caches of the 1D integrals, one for each coordinate direction
+        mutable FixedArray1D<QuarkletIntegralCache<IFRAME>,DIM> quarklet_integrals;
+
+        // attach the caches quarklet_integrals to the interval frames of frame_
+        void setup_quarklet_integrals();
         // #####################################################################################
         
         
@@ -9,7 +9,11 @@ namespace WaveletTL
     QTBasis<IBASIS,DIM>::QTBasis() : numofbw_((IBASIS::primal_polynomial_degree() + IBASIS::primal_vanishing_moments() -2) / 2)
     {
         // we only need one instance of IBASIS (with homogeneous b.c.)
+#if _WAVELETTL_SHARED_INTERVAL_BASES
+    	IBASIS* b = IntervalBasisRegistry<IBASIS>::instance(true,true);
+#else
     	IBASIS* b = new IBASIS(true,true);
+#endif
     	bases_infact_[0] = b;
         //boundary_gens_infact_[0]=boundary_gens_infact_[1]=boundary_wavs_infact_[0]=boundary_wavs_infact_[1]=0; // no need to initialize _infact for the other bases
         //j0 = new Array1D<MultiIndex<int,DIM>> (1);
@@ -82,7 +86,11 @@ namespace WaveletTL
                 b = bases_infact_[tempint];
                 if (b==0)
                 {
+#if _WAVELETTL_SHARED_INTERVAL_BASES
+                    b = IntervalBasisRegistry<IBASIS>::instance(bc[p][2*i], bc[p][2*i+1]);
+#else
                     b = new IBASIS(bc[p][2*i], bc[p][2*i+1]);
+#endif
                     bases_infact_[tempint] = b;
 #if 0                    
                     // compute number of nonvanishing boundary generators/wavelets
@@ -232,7 +240,11 @@ namespace WaveletTL
                 IBASIS* b = bases_infact_[tempint];
                 if (b==0)
                 {
+#if _WAVELETTL_SHARED_INTERVAL_BASES
+                    b = IntervalBasisRegistry<IBASIS>::instance(bc[p][2*i], bc[p][2*i+1]);
+#else
                     b = new IBASIS(bc[p][2*i], bc[p][2*i+1]);
+#endif
                     bases_infact_[tempint] = b;
 #if 0
                     // compute number of nonvanishing boundary generators/wavelets
@@ -347,6 +359,8 @@ namespace WaveletTL
     template <class IBASIS, unsigned int DIM>
     QTBasis<IBASIS,DIM>::~QTBasis()
     {
+#if !_WAVELETTL_SHARED_INTERVAL_BASES
+        // (otherwise the 1D bases are owned by the IntervalBasisRegistry)
         for (unsigned int i=0; i<4 ; ++i)
         {
             if ( bases_infact_[i] != 0)
@@ -354,6 +368,7 @@ namespace WaveletTL
                 delete bases_infact_[i];
             }
         }
+#endif
     }
 
     template <class IBASIS, unsigned int DIM>
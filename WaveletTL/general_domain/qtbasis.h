@@ -19,6 +19,7 @@
 #include <geometry/point.h>
 #include <utils/array1d.h>
 #include <algebra/matrix.h>
+#include <interval/interval_basis_registry.h>
 
 #include <general_domain/qtbasis_index.h>
 
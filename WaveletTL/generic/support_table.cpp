@@ -0,0 +1,178 @@
+// implementation for support_table.h
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+namespace WaveletTL
+{
+  template <unsigned int DIM>
+  SupportTable<DIM>::SupportTable()
+    : levels_(), compressed_(false)
+  {
+  }
+
+  template <unsigned int DIM>
+  void
+  SupportTable<DIM>::insert(const int j, const int key, const Point<DIM>& a, const Point<DIM>& b)
+  {
+    assert(!compressed_ && j >= 0);
+
+    if (j >= (int)levels_.size())
+      levels_.resize(j+1);
+
+    levels_[j].key.push_back(key);
+    levels_[j].a.push_back(a);
+    levels_[j].b.push_back(b);
+  }
+
+  template <unsigned int DIM>
+  unsigned int
+  SupportTable<DIM>::size(const int j) const
+  {
+    return (j >= 0 && j < (int)levels_.size()) ? levels_[j].key.size() : 0;
+  }
+
+  template <unsigned int DIM>
+  inline
+  int
+  SupportTable<DIM>::cell(const Level& level, const unsigned int i, const double x)
+  {
+    const int c = (int) floor((x - level.lower[i]) / level.h[i]);
+    return std::max(0, std::min(level.ncells[i]-1, c));
+  }
+
+  template <unsigned int DIM>
+  inline
+  int
+  SupportTable<DIM>::cell_number(const Level& level, const FixedArray1D<int,DIM>& c)
+  {
+    int r = c[0];
+    for (unsigned int i = 1; i < DIM; i++)
+      r = r * level.ncells[i] + c[i];
+    return r;
+  }
+
+  template <unsigned int DIM>
+  void
+  SupportTable<DIM>::compress()
+  {
+    for (typename std::vector<Level>::iterator it(levels_.begin()); it != levels_.end(); ++it) {
+      Level& level = *it;
+      const unsigned int n = level.key.size();
+      if (n == 0) {
+	for (unsigned int i = 0; i < DIM; i++) {
+	  level.lower[i] = 0;
+	  level.h[i] = 1;
+	  level.ncells[i] = 1;
+	}
+	level.offsets.assign(2, 0);
+	continue;
+      }
+
+      // bounding box and largest support extent in each coordinate direction
+      Point<DIM> upper(level.b[0]), extent;
+      level.lower = level.a[0];
+      for (unsigned int s = 0; s < n; s++) {
+	for (unsigned int i = 0; i < DIM; i++) {
+	  level.lower[i] = std::min(level.lower[i], level.a[s][i]);
+	  upper[i] = std::max(upper[i], level.b[s][i]);
+	  extent[i] = std::max(extent[i], level.b[s][i] - level.a[s][i]);
+	}
+      }
+      int ncells_total = 1;
+      for (unsigned int i = 0; i < DIM; i++) {
+	const double width = upper[i] - level.lower[i];
+	level.h[i] = extent[i] > 0 ? extent[i] : (width > 0 ? width : 1.0);
+	level.ncells[i] = std::max(1, (int) ceil(width / level.h[i]));
+	ncells_total *= level.ncells[i];
+      }
+
+      // counting sort of the slots into the cells
+      level.offsets.assign(ncells_total+1, 0);
+      for (int pass = 0; pass < 2; pass++) {
+	if (pass == 1) {
+	  for (int c = 0; c < ncells_total; c++)
+	    level.offsets[c+1] += level.offsets[c];
+	  level.slots.resize(level.offsets[ncells_total]);
+	}
+	std::vector<int> fill(level.offsets.begin(), level.offsets.end()-1);
+	for (unsigned int s = 0; s < n; s++) {
+	  FixedArray1D<int,DIM> cmin, cmax, c;
+	  for (unsigned int i = 0; i < DIM; i++) {
+	    cmin[i] = c[i] = cell(level, i, level.a[s][i]);
+	    cmax[i] = cell(level, i, level.b[s][i]);
+	  }
+	  while (true) {
+	    const int number = cell_number(level, c);
+	    if (pass == 0)
+	      level.offsets[number+1]++;
+	    else
+	      level.slots[fill[number]++] = s;
+
+	    // next cell in the range (odometer)
+	    unsigned int i = DIM;
+	    while (i > 0) {
+	      i--;
+	      if (c[i] < cmax[i]) { c[i]++; break; }
+	      c[i] = cmin[i];
+	      if (i == 0) { i = DIM+1; break; }
+	    }
+	    if (i == DIM+1) break;
+	  }
+	}
+      }
+    }
+
+    compressed_ = true;
+  }
+
+  template <unsigned int DIM>
+  void
+  SupportTable<DIM>::intersecting(const int j, const Point<DIM>& a, const Point<DIM>& b,
+				  std::vector<int>& keys) const
+  {
+    assert(compressed_);
+    if (j < 0 || j >= (int)levels_.size()) return;
+    const Level& level = levels_[j];
+    if (level.key.empty()) return;
+
+    const unsigned int first = keys.size();
+
+    FixedArray1D<int,DIM> cmin, cmax, c;
+    for (unsigned int i = 0; i < DIM; i++) {
+      cmin[i] = c[i] = cell(level, i, a[i]);
+      cmax[i] = cell(level, i, b[i]);
+    }
+    while (true) {
+      const int number = cell_number(level, c);
+      for (int m = level.offsets[number]; m < level.offsets[number+1]; m++) {
+	const int s = level.slots[m];
+	bool hit = true;
+	for (unsigned int i = 0; i < DIM && hit; i++)
+	  hit = level.a[s][i] < b[i] && level.b[s][i] > a[i];
+	if (!hit) continue;
+
+	// report the support only in the cell containing the lower left corner
+	// of the intersection box, so that each key is found exactly once
+	bool home = true;
+	for (unsigned int i = 0; i < DIM && home; i++)
+	  home = cell(level, i, std::max(a[i], level.a[s][i])) == c[i];
+	if (home)
+	  keys.push_back(level.key[s]);
+      }
+
+      // next cell in the range (odometer)
+      unsigned int i = DIM;
+      while (i > 0) {
+	i--;
+	if (c[i] < cmax[i]) { c[i]++; break; }
+	c[i] = cmin[i];
+	if (i == 0) { i = DIM+1; break; }
+      }
+      if (i == DIM+1) break;
+    }
+
+    std::sort(keys.begin()+first, keys.end());
+  }
+}
@@ -0,0 +1,109 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_SUPPORT_TABLE_H
+#define _WAVELETTL_SUPPORT_TABLE_H
+
+#include <vector>
+#include <geometry/point.h>
+#include <utils/fixed_array1d.h>
+
+using MathTL::Point;
+using MathTL::FixedArray1D;
+
+namespace WaveletTL
+{
+  /*!
+    A level-indexed spatial index for the (rectangular) supports of wavelets,
+    generators or frame elements, independent of the concrete index type.
+
+    On each level, the supports are given as boxes [a,b] in R^DIM together
+    with an integer key (typically the number of the index, or its position
+    in a levelwise collection). After all boxes have been inserted, compress()
+    sorts them into a uniform grid of "dyadic" cells whose edge length is the
+    largest support extent on that level, so that each support overlaps at
+    most 2^DIM cells. The cell-to-key relation is stored in compressed row
+    format (one offset array plus one array of slots), i.e., the storage is
+    linear in the number of inserted supports.
+
+    The query intersecting(j, a, b, keys) returns all keys on level j whose
+    support intersects the open box (a,b), in time proportional to the number
+    of visited cells plus the output size. Every key is reported exactly once
+    and the output is sorted.
+
+    Typical usage: build one table per discretization (e.g. in the constructor
+    of AggregatedFrame) and use it in intersecting_wavelets(), which in turn is
+    called from CachedProblem::a(), add_level() and setup_stiffness_matrix().
+  */
+  template <unsigned int DIM>
+  class SupportTable
+  {
+  public:
+    //! default constructor, yields an empty table
+    SupportTable();
+
+    /*!
+      insert the support [a,b] with the given key on the level j >= 0
+      (only allowed before compress())
+    */
+    void insert(const int j, const int key, const Point<DIM>& a, const Point<DIM>& b);
+
+    /*!
+      build the compressed cell structure, afterwards no more insertions are allowed
+    */
+    void compress();
+
+    //! number of levels
+    unsigned int levels() const { return levels_.size(); }
+
+    //! number of supports stored on level j
+    unsigned int size(const int j) const;
+
+    /*!
+      compute all keys on level j whose support intersects the open box (a,b);
+      the result is appended to keys in ascending order
+    */
+    void intersecting(const int j, const Point<DIM>& a, const Point<DIM>& b,
+		      std::vector<int>& keys) const;
+
+  protected:
+    //! the data of a single level
+    struct Level
+    {
+      //! keys and supports, in the order of insertion
+      std::vector<int> key;
+      std::vector<Point<DIM> > a, b;
+
+      //! lower left corner of the bounding box and cell width in each direction
+      Point<DIM> lower, h;
+
+      //! number of cells in each direction
+      FixedArray1D<int,DIM> ncells;
+
+      //! compressed cell->slot relation
+      std::vector<int> offsets, slots;
+    };
+
+    //! the levels
+    std::vector<Level> levels_;
+
+    //! flag whether compress() has been called
+    bool compressed_;
+
+    //! cell coordinate of a point in direction i, clamped to the grid
+    static int cell(const Level& level, const unsigned int i, const double x);
+
+    //! linear number of the cell with coordinates c
+    static int cell_number(const Level& level, const FixedArray1D<int,DIM>& c);
+  };
+}
+
+#include <generic/support_table.cpp>
+
+#endif
@@ -0,0 +1,206 @@
+// implementation for tensor_sampler.h
+
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include <geometry/grid.h>
+#include <algebra/matrix.h>
+
+namespace WaveletTL
+{
+  inline
+  void
+  set_sampled_factor(const Array1D<double>& values, SampledFactor& factor)
+  {
+    int first = 0, last = (int)values.size()-1;
+    while (first <= last && values[first] == 0) first++;
+    while (last >= first && values[last] == 0) last--;
+
+    factor.first = first;
+    factor.values.resize(last >= first ? last-first+1 : 0);
+    for (int n = first; n <= last; n++)
+      factor.values[n-first] = values[n];
+  }
+
+  template <class IBASIS>
+  const SampledFactor&
+  sampled_factor(const IBASIS& basis,
+		 const int j, const int e, const int k,
+		 const bool primal, const int resolution,
+		 SampledFactorCache& cache)
+  {
+    const std::pair<int,std::pair<int,int> > key(j, std::make_pair(e, k));
+    typename SampledFactorCache::iterator it(cache.lower_bound(key));
+    if (it == cache.end() || cache.key_comp()(key, it->first)) {
+      it = cache.insert(it, std::make_pair(key, SampledFactor()));
+      set_sampled_factor(evaluate(basis, typename IBASIS::Index(j, e, k, &basis),
+				  primal, resolution).values(),
+			 it->second);
+    }
+    return it->second;
+  }
+
+  template <unsigned int DIM>
+  TensorSampler<DIM>::TensorSampler(const int resolution)
+    : resolution_(resolution), entries_()
+  {
+    assert(resolution >= 0);
+  }
+
+  template <unsigned int DIM>
+  void
+  TensorSampler<DIM>::add(const double c, const FixedArray1D<const SampledFactor*,DIM>& factors)
+  {
+    if (c == 0) return;
+    for (unsigned int i = 0; i < DIM; i++)
+      if (factors[i]->values.size() == 0) return;
+
+    Entry entry;
+    entry.c = c;
+    entry.factors = factors;
+    entries_.push_back(entry);
+  }
+
+  template <unsigned int DIM>
+  inline
+  bool
+  TensorSampler<DIM>::EntryOrder::operator () (const Entry& e1, const Entry& e2) const
+  {
+    std::less<const SampledFactor*> less;
+    for (int i = DIM-1; i >= 0; i--) {
+      if (less(e1.factors[i], e2.factors[i])) return true;
+      if (less(e2.factors[i], e1.factors[i])) return false;
+    }
+    return false;
+  }
+
+  template <unsigned int DIM>
+  void
+  TensorSampler<DIM>::sum(typename std::vector<Entry>::const_iterator begin,
+			  typename std::vector<Entry>::const_iterator end,
+			  const unsigned int d,
+			  std::vector<double>& block,
+			  FixedArray1D<int,DIM>& lower, FixedArray1D<int,DIM>& n)
+  {
+    // bounding box of the entries in the directions 0,...,d
+    int size = 1;
+    for (unsigned int i = 0; i <= d; i++) {
+      int upper = lower[i] = begin->factors[i]->first;
+      for (typename std::vector<Entry>::const_iterator it(begin); it != end; ++it) {
+	lower[i] = std::min(lower[i], it->factors[i]->first);
+	upper = std::max(upper, it->factors[i]->first + (int)it->factors[i]->values.size());
+      }
+      n[i] = upper - lower[i];
+      size *= n[i];
+    }
+    block.assign(size, 0.0);
+
+    if (d == 0) {
+      for (typename std::vector<Entry>::const_iterator it(begin); it != end; ++it) {
+	const SampledFactor* f = it->factors[0];
+	double* target = &block[f->first - lower[0]];
+	for (unsigned int t = 0; t < f->values.size(); t++)
+	  target[t] += it->c * f->values[t];
+      }
+      return;
+    }
+
+    // strides of the block
+    FixedArray1D<int,DIM> stride;
+    stride[0] = 1;
+    for (unsigned int i = 1; i <= d; i++)
+      stride[i] = stride[i-1] * n[i-1];
+
+    std::vector<double> sub;
+    FixedArray1D<int,DIM> sublower, subn;
+    for (typename std::vector<Entry>::const_iterator group(begin); group != end;) {
+      // the entries with the same factor in direction d form a contiguous range
+      typename std::vector<Entry>::const_iterator groupend(group);
+      while (groupend != end && groupend->factors[d] == group->factors[d]) ++groupend;
+
+      sum(group, groupend, d-1, sub, sublower, subn);
+
+      // add the tensor product of the factor in direction d with the partial sum,
+      // line by line in direction 0
+      const SampledFactor* f = group->factors[d];
+      int lines = 1;
+      for (unsigned int i = 1; i < d; i++) lines *= subn[i];
+      for (int l = 0; l < lines; l++) {
+	int offset = sublower[0] - lower[0], rest = l;
+	for (unsigned int i = 1; i < d; i++) {
+	  offset += (sublower[i] - lower[i] + rest % subn[i]) * stride[i];
+	  rest /= subn[i];
+	}
+	const double* source = &sub[l*subn[0]];
+	for (unsigned int t = 0; t < f->values.size(); t++) {
+	  double* target = &block[offset + (f->first + (int)t - lower[d]) * stride[d]];
+	  const double factor = f->values[t];
+	  for (int x = 0; x < subn[0]; x++)
+	    target[x] += factor * source[x];
+	}
+      }
+
+      group = groupend;
+    }
+  }
+
+  template <unsigned int DIM>
+  void
+  TensorSampler<DIM>::accumulate(Array1D<double>& values) const
+  {
+    const int N = points();
+    int size = 1;
+    for (unsigned int i = 0; i < DIM; i++) size *= N;
+    if ((int)values.size() != size) {
+      values.resize(size);
+      for (int m = 0; m < size; m++) values[m] = 0;
+    }
+    if (entries_.empty()) return;
+
+    std::vector<Entry> entries(entries_);
+    std::sort(entries.begin(), entries.end(), EntryOrder());
+
+    std::vector<double> block;
+    FixedArray1D<int,DIM> lower, n;
+    sum(entries.begin(), entries.end(), DIM-1, block, lower, n);
+
+    // copy the bounding box into the full grid, line by line in direction 0
+    int lines = 1;
+    for (unsigned int i = 1; i < DIM; i++) lines *= n[i];
+    for (int l = 0; l < lines; l++) {
+      int offset = lower[0], rest = l, stride = 1;
+      for (unsigned int i = 1; i < DIM; i++) {
+	stride *= N;
+	offset += (lower[i] + rest % n[i]) * stride;
+	rest /= n[i];
+      }
+      for (int x = 0; x < n[0]; x++)
+	values[offset+x] += block[l*n[0]+x];
+    }
+  }
+
+  template <>
+  inline
+  SampledMapping<1>
+  TensorSampler<1>::sampled_mapping(const Point<1>& a, const Point<1>& b) const
+  {
+    Array1D<double> values;
+    accumulate(values);
+    return SampledMapping<1>(MathTL::Grid<1>(a[0], b[0], 1<<resolution_), values);
+  }
+
+  template <>
+  inline
+  SampledMapping<2>
+  TensorSampler<2>::sampled_mapping(const Point<2>& a, const Point<2>& b) const
+  {
+    Array1D<double> values;
+    accumulate(values);
+    const int N = points();
+    MathTL::Matrix<double> m(N, N);
+    for (int row = 0, id = 0; row < N; row++)
+      for (int column = 0; column < N; column++, id++)
+	m(row, column) = values[id];
+    return SampledMapping<2>(MathTL::Grid<2>(a, b, 1<<resolution_), m);
+  }
+}
@@ -0,0 +1,143 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_TENSOR_SAMPLER_H
+#define _WAVELETTL_TENSOR_SAMPLER_H
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <utils/array1d.h>
+#include <utils/fixed_array1d.h>
+#include <geometry/point.h>
+#include <geometry/sampled_mapping.h>
+
+using MathTL::Array1D;
+using MathTL::FixedArray1D;
+using MathTL::Point;
+using MathTL::SampledMapping;
+
+namespace WaveletTL
+{
+  /*!
+    point values of a univariate function on the grid points
+    first,...,first+values.size()-1 of a uniform grid, outside of which it vanishes
+  */
+  struct SampledFactor
+  {
+    int first;
+    Array1D<double> values;
+  };
+
+  //! cache of sampled factors, keyed by (j,(e,k)); std::map keeps the addresses stable
+  typedef std::map<std::pair<int,std::pair<int,int> >, SampledFactor> SampledFactorCache;
+
+  //! restrict the point values of a univariate function to its nonzero window
+  void set_sampled_factor(const Array1D<double>& values, SampledFactor& factor);
+
+  /*!
+    lookup (or compute) the point values of the primal or dual generator/wavelet
+    psi_{j,e,k} of an interval basis IBASIS on 2^resolution+1 equidistant points
+    in [0,1], using evaluate(basis, lambda, primal, resolution)
+  */
+  template <class IBASIS>
+  const SampledFactor& sampled_factor(const IBASIS& basis,
+				      const int j, const int e, const int k,
+				      const bool primal, const int resolution,
+				      SampledFactorCache& cache);
+
+  /*!
+    Accumulation of linear combinations of tensor product functions
+
+      f = \sum_m c_m \phi_{m,0} \otimes ... \otimes \phi_{m,DIM-1}
+
+    on the uniform grid with 2^resolution+1 points per coordinate direction,
+    as it is needed for plotting expansions in tensor product wavelet bases.
+
+    Each univariate factor is given by its point values on the 1D grid,
+    restricted to the window where it does not vanish (a SampledFactor).
+    Since the factors are passed by pointer, equal factors should be shared
+    between the summands, e.g. by looking them up in a SampledFactorCache.
+    The summation is done by sum factorization: the summands are sorted by
+    their factors, and all summands with the same factor in the slowest
+    direction are first summed up on the support of the remaining factors. So the work per summand is
+    local to its support and, for densely populated coefficient sets, the
+    grid is not traversed once per coefficient.
+
+    The point values are stored in a single array with the first coordinate
+    direction running fastest, i.e., for DIM=2 the value at the grid point
+    (x_n, y_m) has the number m*(2^resolution+1)+n, matching the row/column
+    convention of SampledMapping<2>.
+  */
+  template <unsigned int DIM>
+  class TensorSampler
+  {
+  public:
+    //! constructor from the grid resolution
+    TensorSampler(const int resolution);
+
+    //! the grid resolution
+    int resolution() const { return resolution_; }
+
+    //! number of grid points per coordinate direction
+    int points() const { return (1<<resolution_)+1; }
+
+    //! add c times the tensor product of the given factors
+    void add(const double c, const FixedArray1D<const SampledFactor*,DIM>& factors);
+
+    //! number of collected summands
+    unsigned int size() const { return entries_.size(); }
+
+    /*!
+      add the point values of the collected sum to a dense array of size
+      points()^DIM (which is resized and zeroed if it has the wrong size)
+    */
+    void accumulate(Array1D<double>& values) const;
+
+    /*!
+      the collected sum as a sampled mapping on the box [a,b]
+      (only available for DIM=1 and DIM=2)
+    */
+    SampledMapping<DIM> sampled_mapping(const Point<DIM>& a, const Point<DIM>& b) const;
+
+  protected:
+    //! grid resolution
+    int resolution_;
+
+    //! a single summand
+    struct Entry
+    {
+      double c;
+      FixedArray1D<const SampledFactor*,DIM> factors;
+    };
+
+    //! the collected summands
+    std::vector<Entry> entries_;
+
+    //! lexicographical order of the factors, slowest direction first
+    struct EntryOrder
+    {
+      bool operator () (const Entry& e1, const Entry& e2) const;
+    };
+
+    /*!
+      sum up the entries [begin,end) in the directions 0,...,d on their
+      bounding box with lower corner lower and extents n
+    */
+    static void sum(typename std::vector<Entry>::const_iterator begin,
+		    typename std::vector<Entry>::const_iterator end,
+		    const unsigned int d,
+		    std::vector<double>& block,
+		    FixedArray1D<int,DIM>& lower, FixedArray1D<int,DIM>& n);
+  };
+}
+
+#include <generic/tensor_sampler.cpp>
+
+#endif
@@ -0,0 +1,141 @@
+// implementation for interval_basis_registry.h
+
+namespace WaveletTL
+{
+  template <class IBASIS>
+  std::map<typename IntervalBasisRegistry<IBASIS>::Key, IBASIS*>&
+  IntervalBasisRegistry<IBASIS>::registry()
+  {
+    static std::map<Key,IBASIS*> bases;
+    return bases;
+  }
+
+  template <class IBASIS>
+  IBASIS*&
+  IntervalBasisRegistry<IBASIS>::lookup(const int flavor, const int a, const int b, const int jmax)
+  {
+    // caller has to hold the lock
+    typename std::map<Key,IBASIS*>::iterator it
+      = registry().insert(std::make_pair(Key(std::make_pair(flavor, jmax), std::make_pair(a,b)),
+					 (IBASIS*)0)).first;
+    return it->second;
+  }
+
+  template <class IBASIS>
+  IBASIS*
+  IntervalBasisRegistry<IBASIS>::instance()
+  {
+    IBASIS* r = 0;
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_IntervalBasisRegistry)
+#endif
+    {
+      IBASIS*& entry = lookup(0, 0, 0);
+      if (entry == 0)
+	entry = new IBASIS();
+      r = entry;
+    }
+    return r;
+  }
+
+  template <class IBASIS>
+  IBASIS*
+  IntervalBasisRegistry<IBASIS>::instance(const int s0, const int s1)
+  {
+    IBASIS* r = 0;
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_IntervalBasisRegistry)
+#endif
+    {
+      IBASIS*& entry = lookup(1, s0, s1);
+      if (entry == 0)
+	entry = new IBASIS(s0, s1);
+      r = entry;
+    }
+    return r;
+  }
+
+  template <class IBASIS>
+  IBASIS*
+  IntervalBasisRegistry<IBASIS>::instance(const bool bc_left, const bool bc_right)
+  {
+    IBASIS* r = 0;
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_IntervalBasisRegistry)
+#endif
+    {
+      IBASIS*& entry = lookup(2, bc_left ? 1 : 0, bc_right ? 1 : 0);
+      if (entry == 0)
+	entry = new IBASIS(bc_left, bc_right);
+      r = entry;
+    }
+    return r;
+  }
+
+  template <class IBASIS>
+  IBASIS*
+  IntervalBasisRegistry<IBASIS>::instance(const int s0, const int s1, const int jmax)
+  {
+    IBASIS* r = 0;
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_IntervalBasisRegistry)
+#endif
+    {
+      IBASIS*& entry = lookup(1, s0, s1, jmax);
+      if (entry == 0) {
+	// set up completely before the basis is shared
+	entry = new IBASIS(s0, s1);
+	entry->set_jmax(jmax);
+      }
+      r = entry;
+    }
+    return r;
+  }
+
+  template <class IBASIS>
+  IBASIS*
+  IntervalBasisRegistry<IBASIS>::instance(const bool bc_left, const bool bc_right, const int jmax)
+  {
+    IBASIS* r = 0;
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_IntervalBasisRegistry)
+#endif
+    {
+      IBASIS*& entry = lookup(2, bc_left ? 1 : 0, bc_right ? 1 : 0, jmax);
+      if (entry == 0) {
+	// set up completely before the basis is shared
+	entry = new IBASIS(bc_left, bc_right);
+	entry->set_jmax(jmax);
+      }
+      r = entry;
+    }
+    return r;
+  }
+
+  template <class IBASIS>
+  unsigned int
+  IntervalBasisRegistry<IBASIS>::size()
+  {
+    unsigned int r = 0;
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_IntervalBasisRegistry)
+#endif
+    r = registry().size();
+    return r;
+  }
+
+  template <class IBASIS>
+  void
+  IntervalBasisRegistry<IBASIS>::clear()
+  {
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_IntervalBasisRegistry)
+#endif
+    {
+      for (typename std::map<Key,IBASIS*>::iterator it(registry().begin());
+	   it != registry().end(); ++it)
+	delete it->second;
+      registry().clear();
+    }
+  }
+}
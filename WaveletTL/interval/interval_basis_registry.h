@@ -0,0 +1,107 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_INTERVAL_BASIS_REGISTRY_H
+#define _WAVELETTL_INTERVAL_BASIS_REGISTRY_H
+
+#include <map>
+#include <utility>
+
+/*
+ * If set to 1, composite bases (TensorBasis, QTBasis, ...) fetch their interval bases
+ * from the IntervalBasisRegistry instead of constructing (and owning) private copies.
+ */
+#ifndef _WAVELETTL_SHARED_INTERVAL_BASES
+#define _WAVELETTL_SHARED_INTERVAL_BASES 0
+#endif
+
+namespace WaveletTL
+{
+  /*!
+    Process-wide registry of interval bases (PBasis, DSBasis, JLBasis, SplineBasis, ...).
+
+    Each interval basis is constructed at most once per combination of its
+    template parameters (d, dT, flavor, ...) and its boundary conditions;
+    the coarsest level j0 is a function of these and hence part of the key, too.
+    All subsequent requests return a pointer to the same instance, so that
+    composite bases (TensorBasis, QTBasis, AggregatedFrame, ...) with many patches
+    share the setup of the refinement matrices instead of redoing it per patch.
+
+    The registry owns the bases; they live until clear() is called or the
+    process terminates. Clients must not delete the returned pointers.
+
+    If a finest level jmax is requested, it is part of the key as well: the basis
+    is constructed and its full collection of wavelet indices is set up via
+    set_jmax(jmax) before it is handed out for the first time. A registered
+    basis is never modified afterwards, so other clients may read it while
+    new bases are requested. (Clients should not call set_jmax() on a shared
+    basis, either.)
+
+    All methods are safe to be called concurrently from OpenMP threads.
+  */
+  template <class IBASIS>
+  class IntervalBasisRegistry
+  {
+  public:
+    /*!
+      get the basis without boundary conditions (default constructor)
+    */
+    static IBASIS* instance();
+
+    /*!
+      get the basis with primal b.c. orders s0, s1, i.e. IBASIS(s0,s1)
+    */
+    static IBASIS* instance(const int s0, const int s1);
+
+    /*!
+      get the basis with homogeneous Dirichlet b.c.'s on/off, i.e. IBASIS(bc_left,bc_right)
+    */
+    static IBASIS* instance(const bool bc_left, const bool bc_right);
+
+    /*!
+      same as instance(s0,s1), but with the full collection set up to the level jmax
+    */
+    static IBASIS* instance(const int s0, const int s1, const int jmax);
+
+    /*!
+      same as instance(bc_left,bc_right), but with the full collection set up
+      to the level jmax
+    */
+    static IBASIS* instance(const bool bc_left, const bool bc_right, const int jmax);
+
+    /*!
+      number of bases constructed so far
+    */
+    static unsigned int size();
+
+    /*!
+      destroy all registered bases
+      (invalidates all pointers handed out before, use with care)
+    */
+    static void clear();
+
+  protected:
+    /*!
+      key of a registered basis: the constructor flavor (0: default, 1: int b.c.'s,
+      2: bool b.c.'s) and the requested jmax (-1: none), and the two boundary
+      condition parameters
+    */
+    typedef std::pair<std::pair<int,int>, std::pair<int,int> > Key;
+
+    //! the storage, a function-local static to avoid static initialization order problems
+    static std::map<Key,IBASIS*>& registry();
+
+    //! lookup the entry for a given key (0 for a new entry, to be constructed by the caller)
+    static IBASIS*& lookup(const int flavor, const int a, const int b, const int jmax = -1);
+  };
+}
+
+#include <interval/interval_basis_registry.cpp>
+
+#endif
@@ -60,6 +60,59 @@ namespace WaveletTL
   protected:
     int j_, k_;
   };
+
+  /*!
+    Evaluate the expansion
+
+      f(x) = \sum_{k=kmin}^{kmin+coeffs.size()-1} coeffs[k-kmin] \phi_{j,k}(x)
+
+    in the primal generators \phi_{j,k} of PBasis (see SchoenbergIntervalBSpline_td)
+    and its derivatives up to the given order at a batch of points x_m in [0,1]:
+
+      values[s][m] = f^{(s)}(x_m), s=0,...,derivatives
+
+    The generators on level j are the dilated B-splines 2^{j/2}N_{k-d/2,d}(2^jx)
+    w.r.t. the knots SchoenbergIntervalKnots(2^j), so all d of them which do
+    not vanish at x_m are evaluated at once by de Boor's scheme (evaluate_Bsplines()).
+  */
+  template <int d>
+  void evaluate_interval_bsplines(const int j, const int kmin, const Array1D<double>& coeffs,
+				  const unsigned int derivatives,
+				  const Array1D<double>& points,
+				  Array1D<Array1D<double> >& values)
+  {
+    const unsigned int n = points.size();
+    values.resize(derivatives+1);
+    for (unsigned int s = 0; s <= derivatives; s++)
+      values[s].resize(n);
+    if (n == 0) return;
+
+    Array1D<double> y(n);
+    for (unsigned int m = 0; m < n; m++)
+      y[m] = ldexp(points[m], j);
+
+    Array1D<int> intervals;
+    Array1D<double> N;
+    evaluate_Bsplines<d>(SchoenbergIntervalKnots(1<<j), derivatives, y, intervals, N);
+
+    const int* l = &intervals[0];
+    const double* c = coeffs.size() > 0 ? &coeffs[0] : 0;
+    double factor = twotothejhalf(j);
+    for (unsigned int s = 0; s <= derivatives; s++, factor *= 1<<j) {
+      double* f = &values[s][0];
+      for (unsigned int m = 0; m < n; m++)
+	f[m] = 0;
+      for (int i = 0; i < d; i++) {
+	const double* Ni = &N[(s*d+i)*n];
+	for (unsigned int m = 0; m < n; m++) {
+	  // N_{l-d+1+i,d} belongs to the generator with k = l-d+1+i+d/2
+	  const unsigned int id = l[m]-d+1+i+d/2-kmin;
+	  if (id < coeffs.size())
+	    f[m] += factor * c[id] * Ni[m];
+	}
+      }
+    }
+  }
 }
 
 #endif
@@ -3064,4 +3064,36 @@ namespace WaveletTL
 
   }
 
+  template <int d, int dT>
+  const Array1D<Piecewise<double> >&
+  PBasis<d,dT>::wavelets_on_level(const int j) const
+  {
+    assert(evaluate_with_pre_computation && j >= j0_ && j < (int)wavelets.size());
+    
+    // once per level: the flag is read and written atomically, with the
+    // ordering of seq_cst, so a thread which sees it set also sees the
+    // expansion; the expansion itself is done within the critical section
+    bool computed;
+#ifdef _OPENMP
+#pragma omp atomic read seq_cst
+#endif
+    computed = wavelets_computed[j];
+    if (!computed) {
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_PBasis_waveletPP)
+#endif
+      {
+	if (!wavelets_computed[j]) {
+	  waveletPP(j, wavelets[j]);
+#ifdef _OPENMP
+#pragma omp atomic write seq_cst
+#endif
+	  wavelets_computed[j] = true;
+	}
+      }
+    }
+    
+    return wavelets[j];
+  }
+
 }
@@ -440,19 +440,39 @@ namespace WaveletTL
     //! Wavelets eines bestimmten levels
 
 
-    Array1D<Array1D<Piecewise<double> > > wavelets;
+    /*!
+      piecewise polynomial expansions of the wavelets, level-wise;
+      level j is only valid after a call of wavelets_on_level(j)
+    */
+    mutable Array1D<Array1D<Piecewise<double> > > wavelets;
 
+    /*!
+      Switch on the evaluation with precomputed piecewise polynomial expansions.
+      The expansions are set up lazily, level j is expanded on the first
+      call of wavelets_on_level(j). Further calls do nothing, so the expansions
+      computed so far (and the references to them) stay valid. So it is cheap
+      to call this routine also for bases that are shared between many patches
+      or problems.
+    */
     void pre_compute_wavelets(){
-        int jmax = JMAX;  // wählen des max levels   12: 2,41 sek
-                          //                         16: 37,0 sek
-                          //  Pro Level erhöhung verdoppelt sich die Zeit
+        const int jmax = JMAX;  // per level, the expansion time doubles
+        if (evaluate_with_pre_computation && wavelets.size() == (unsigned int)jmax+1)
+            return;
         evaluate_with_pre_computation = true;
         wavelets.resize(jmax+1);
-        for(int i = j0_; i<=jmax; i++){
-            waveletPP(i,wavelets[i]);
+        wavelets_computed.resize(jmax+1);
+        for(int i = 0; i<=jmax; i++){
+            wavelets_computed[i] = false;
         }
     }
 
+    /*!
+      read access to the piecewise polynomial expansions of all wavelets on level j,
+      they are computed on the first access; concurrent calls are safe, each level is
+      expanded exactly once (but pre_compute_wavelets() must not run at the same time)
+    */
+    const Array1D<Piecewise<double> >& wavelets_on_level(const int j) const;
+
     //! the primal order
     int get_primalorder() const{return primal;};
 
@@ -467,6 +487,9 @@ namespace WaveletTL
     //! evaluate_with_pre_computation
     bool evaluate_with_pre_computation;
 
+    //! flags whether the expansions wavelets[j] are already available
+    mutable Array1D<bool> wavelets_computed;
+
     //! the dual order
     int dual;
 
@@ -4,6 +4,7 @@
 #include <Rd/cdf_utils.h>
 #include <utils/array1d.h>
 #include <numerics/schoenberg_splines.h>
+#include <interval/interval_bspline.h>
 #include <interval/p_basis.h>
 
 namespace WaveletTL
@@ -116,9 +117,25 @@ namespace WaveletTL
       else
 	basis.reconstruct_t(coeffs,jmax,gcoeffs);
 
-      for (typename InfiniteVector<double,Index>::const_iterator it(gcoeffs.begin()),
-	     itend(gcoeffs.end()); it != itend; ++it)
-	result.add(*it, evaluate(basis, it.index(), primal, resolution));
+      if (primal) {
+	// evaluate all generators on level jmax at once
+	Array1D<double> gc(basis.DeltaRmax(jmax)-basis.DeltaLmin()+1);
+	for (unsigned int i = 0; i < gc.size(); i++)
+	  gc[i] = 0;
+	for (typename InfiniteVector<double,Index>::const_iterator it(gcoeffs.begin()),
+	       itend(gcoeffs.end()); it != itend; ++it)
+	  gc[it.index().k()-basis.DeltaLmin()] = *it;
+	Array1D<double> points((1<<resolution)+1);
+	for (unsigned int i = 0; i < points.size(); i++)
+	  points[i] = i*ldexp(1.0, -resolution);
+	Array1D<Array1D<double> > values;
+	evaluate_interval_bsplines<d>(jmax, basis.DeltaLmin(), gc, 0, points, values);
+	result = SampledMapping<1>(Grid<1>(0, 1, 1<<resolution), values[0]);
+      } else {
+	for (typename InfiniteVector<double,Index>::const_iterator it(gcoeffs.begin()),
+	       itend(gcoeffs.end()); it != itend; ++it)
+	  result.add(*it, evaluate(basis, it.index(), primal, resolution));
+      }
     }
     
     return result;
@@ -267,96 +284,39 @@ namespace WaveletTL
     evaluate(const PBasis<d,dT>& basis, const unsigned int derivative,
             const typename PBasis<d,dT>::Index& lambda,
             const Array1D<double>& points, Array1D<double>& values)
-    {   
-        assert(derivative <= 2); // we only support derivatives up to the second order
-        values.resize(points.size());
-        for (unsigned int i(0); i < values.size(); i++)
-            values[i] = 0;
-        if (lambda.e() == 0) 
-        {
-            // generator
-            if (lambda.k() > (1<<lambda.j())-ell1<d>()-d) 
-                switch (derivative) {
-                    case 0:
-                        for (unsigned int m(0); m < points.size(); m++)
-                            values[m] = MathTL::EvaluateSchoenbergBSpline_td<d>(lambda.j(),
-                                    (1<<lambda.j())-d-lambda.k()-2*ell1<d>(),
-                                    1-points[m]);
-                        break;
-                    case 1: 
-                        for (unsigned int m(0); m < points.size(); m++)
-                            values[m] = -MathTL::EvaluateSchoenbergBSpline_td_x<d>(lambda.j(),
-                                    (1<<lambda.j())-d-lambda.k()-2*ell1<d>(),
-                                    1-points[m]);
-                        break;
-                    case 2:
-                        for (unsigned int m(0); m < points.size(); m++)
-                            values[m] = MathTL::EvaluateSchoenbergBSpline_td_xx<d>(lambda.j(),
-                                    (1<<lambda.j())-d-lambda.k()-2*ell1<d>(),
-                                    1-points[m]);
-                        break;
-                }
-            else 
-                switch (derivative) {
-                    case 0: 
-                        for (unsigned int m(0); m < points.size(); m++)
-                            values[m] = MathTL::EvaluateSchoenbergBSpline_td<d>(lambda.j(),
-                                    lambda.k(),
-                                    points[m]);
-                        break;
-                    case 1: 
-                        for (unsigned int m(0); m < points.size(); m++)
-                            values[m] = MathTL::EvaluateSchoenbergBSpline_td_x<d>(lambda.j(),
-                                    lambda.k(),
-                                    points[m]); 
-                        break;
-                    case 2:
-                        for (unsigned int m(0); m < points.size(); m++)
-                            values[m] = MathTL::EvaluateSchoenbergBSpline_td_xx<d>(lambda.j(),
-                                    lambda.k(),
-                                    points[m]); 
-                        break;
-                }
-        }
-        else // wavelet
-        {
-            if(basis.get_evaluate_with_pre_computation()){ // with pre compuatation 
-                switch (derivative) {
-                    case 0: 
-                        for (unsigned int m(0); m < points.size(); m++){
-                            values[m] = basis.wavelets[lambda.j()][lambda.k()](points[m]);
-                        }
-                        break;
-                    case 1: 
-                        for (unsigned int m(0); m < points.size(); m++){
-                            values[m] = basis.wavelets[lambda.j()][lambda.k()].derivative(points[m]);
-                        }
-                        break;
-                    case 2: 
-                        for (unsigned int m(0); m < points.size(); m++){
-                            values[m] = basis.wavelets[lambda.j()][lambda.k()].secondDerivative(points[m]);
-                        }
-                        break;
-                }
-            }
-            else // not with pre computation
-            {
-                InfiniteVector<double,int> gcoeffs;
-                basis.reconstruct_1(lambda.j(),lambda.e(), lambda.k(), lambda.j()+1, gcoeffs);
-                const int Lmin(basis.DeltaLmin());
-                Array1D<double> help(points.size());
-                for (typename InfiniteVector<double,int>::const_iterator it(gcoeffs.begin());
-                        it != gcoeffs.end(); ++it)
-                {
-                    evaluate(basis, derivative, lambda.j()+1,0,Lmin+it.index(), points, help);
-                    for (unsigned int i = 0; i < points.size(); i++)
-                        values[i] += *it * help[i];
-                }
-                
-            }
+    {
+        evaluate(basis, derivative, lambda.j(), lambda.e(), lambda.k(), points, values);
+    }
+
+    /*
+      Without pre computation, a wavelet is evaluated as an expansion in the generators
+      on level j+1, all of which are evaluated at once by de Boor's scheme.
+    */
+    template <int d, int dT>
+    void evaluate_wavelet_expansion(const PBasis<d,dT>& basis,
+            const unsigned int derivatives,
+            const int j_, const int e_, const int k_,
+            const Array1D<double>& points, Array1D<Array1D<double> >& values)
+    {
+        InfiniteVector<double,int> gcoeffs;
+        basis.reconstruct_1(j_, e_, k_, j_+1, gcoeffs);
+        // gcoeffs contains only coeffs related to generators on level j+1,
+        // k = DeltaLmin() + it.index()
+        int first(0), last(-1);
+        for (typename InfiniteVector<double,int>::const_iterator it(gcoeffs.begin());
+                it != gcoeffs.end(); ++it) {
+            if (last < first) first = it.index();
+            last = it.index();
         }
+        Array1D<double> coeffs(last-first+1);
+        for (unsigned int i = 0; i < coeffs.size(); i++)
+            coeffs[i] = 0;
+        for (typename InfiniteVector<double,int>::const_iterator it(gcoeffs.begin());
+                it != gcoeffs.end(); ++it)
+            coeffs[it.index()-first] = *it;
+        evaluate_interval_bsplines<d>(j_+1, basis.DeltaLmin()+first, coeffs, derivatives, points, values);
     }
-             
+
     template <int d, int dT>
     void evaluate(const PBasis<d,dT>& basis, const unsigned int derivative,
             const int j_, const int e_, const int k_,
@@ -364,8 +324,6 @@ namespace WaveletTL
     {   
         assert(derivative <= 2); // we only support derivatives up to the second order
         values.resize(points.size());
-        for (unsigned int i(0); i < values.size(); i++)
-            values[i] = 0;
         if (e_ == 0) 
         {
             // generator
@@ -418,34 +376,26 @@ namespace WaveletTL
                 switch (derivative) {
                     case 0: 
                         for (unsigned int m(0); m < points.size(); m++){
-                            values[m] = basis.wavelets[j_][k_](points[m]);
+                            values[m] = basis.wavelets_on_level(j_)[k_](points[m]);
                         }
                         break;
                     case 1: 
                         for (unsigned int m(0); m < points.size(); m++){
-                            values[m] = basis.wavelets[j_][k_].derivative(points[m]);
+                            values[m] = basis.wavelets_on_level(j_)[k_].derivative(points[m]);
                         }
                         break;
                     case 2: 
                         for (unsigned int m(0); m < points.size(); m++){
-                            values[m] = basis.wavelets[j_][k_].secondDerivative(points[m]);
+                            values[m] = basis.wavelets_on_level(j_)[k_].secondDerivative(points[m]);
                         }
                         break;
                 }
             }
             else // not with pre computation
             {
-                InfiniteVector<double,int> gcoeffs;
-                basis.reconstruct_1(j_,e_,k_, j_+1, gcoeffs);
-                const int Lmin(basis.DeltaLmin());
-                Array1D<double> help;
-                for (typename InfiniteVector<double,int>::const_iterator it(gcoeffs.begin());
-                        it != gcoeffs.end(); ++it)
-                {
-                    evaluate(basis, derivative, j_+1,0,Lmin+it.index(), points, help);
-                    for (unsigned int i = 0; i < points.size(); i++)
-                        values[i] += *it * help[i];
-                }
+                Array1D<Array1D<double> > help;
+                evaluate_wavelet_expansion(basis, derivative, j_, e_, k_, points, help);
+                values.swap(help[derivative]);
             }
         }
     }
@@ -455,62 +405,7 @@ namespace WaveletTL
             const typename PBasis<d,dT>::Index& lambda,
             const Array1D<double>& points, Array1D<double>& funcvalues, Array1D<double>& dervalues)
     {
-        const unsigned int npoints(points.size());
-        funcvalues.resize(npoints);
-        dervalues.resize(npoints);
-        //basis.setWavelets();
-        if (lambda.e() == 0) {
-            // generator
-            if (lambda.k() > (1<<lambda.j())-ell1<d>()-d) {
-                for (unsigned int m(0); m < npoints; m++) {
-                    funcvalues[m] = MathTL::EvaluateSchoenbergBSpline_td<d>  (lambda.j(),
-                            (1<<lambda.j())-d-lambda.k()-2*ell1<d>(),
-                            1-points[m]);
-                    dervalues[m]  = -MathTL::EvaluateSchoenbergBSpline_td_x<d>(lambda.j(),
-                            (1<<lambda.j())-d-lambda.k()-2*ell1<d>(),
-                            1-points[m]);
-                }
-            } else {
-                for (unsigned int m(0); m < npoints; m++) {
-                    funcvalues[m] = MathTL::EvaluateSchoenbergBSpline_td<d>  (lambda.j(),
-                            lambda.k(),
-                            points[m]);
-                    dervalues[m]  = MathTL::EvaluateSchoenbergBSpline_td_x<d>(lambda.j(),
-                            lambda.k(), 
-                            points[m]);
-                }
-            }
-        } 
-        else {
-            
-            // wavelet
-            if(basis.get_evaluate_with_pre_computation()) { // with pre compuatation 
-                for (unsigned int m(0); m < npoints; m++){
-                    funcvalues[m] = basis.wavelets[lambda.j()][lambda.k()](points[m]);
-                    dervalues[m] = basis.wavelets[lambda.j()][lambda.k()].derivative(points[m]);
-                }
-            }
-            else {  //without pre computation
-                for (unsigned int i(0); i < npoints; i++) {
-                    funcvalues[i] = 0;
-                    dervalues[i] = 0;
-                }
-                // wavelet
-                InfiniteVector<double,int> gcoeffs;
-                basis.reconstruct_1(lambda.j(), lambda.e(), lambda.k(), lambda.j()+1, gcoeffs);
-                const int Lmin(basis.DeltaLmin());
-                Array1D<double> help1, help2;
-                for (typename InfiniteVector<double,int>::const_iterator it(gcoeffs.begin());
-                        it != gcoeffs.end(); ++it)
-                {
-                    evaluate(basis, lambda.j()+1,0,Lmin+it.index(), points, help1, help2);
-                    for (unsigned int i = 0; i < points.size(); i++) {
-                        funcvalues[i] += *it * help1[i];
-                        dervalues[i]  += *it * help2[i];
-                    }
-                }
-            }
-        }
+        evaluate(basis, lambda.j(), lambda.e(), lambda.k(), points, funcvalues, dervalues);
     }
     
     template <int d, int dT>
@@ -521,7 +416,6 @@ namespace WaveletTL
         const unsigned int npoints(points.size());
         funcvalues.resize(npoints);
         dervalues.resize(npoints);
-        //basis.setWavelets();
         if (e_ == 0) {
             // generator
             if (k_ > (1<<j_)-ell1<d>()-d) {
@@ -548,28 +442,15 @@ namespace WaveletTL
             // wavelet
             if(basis.get_evaluate_with_pre_computation()) { // with pre compuatation 
                 for (unsigned int m(0); m < npoints; m++){
-                    funcvalues[m] = basis.wavelets[j_][k_](points[m]);
-                    dervalues[m] = basis.wavelets[j_][k_].derivative(points[m]);
+                    funcvalues[m] = basis.wavelets_on_level(j_)[k_](points[m]);
+                    dervalues[m] = basis.wavelets_on_level(j_)[k_].derivative(points[m]);
                 }
             }
             else {  //without pre computation
-                for (unsigned int i(0); i < npoints; i++) {
-                    funcvalues[i] = 0;
-                    dervalues[i] = 0;
-                }
-                InfiniteVector<double,int> gcoeffs;
-                basis.reconstruct_1(j_, e_, k_, j_+1, gcoeffs);
-                const int Lmin(basis.DeltaLmin());
-                Array1D<double> help1, help2;
-                for (typename InfiniteVector<double,int>::const_iterator it(gcoeffs.begin());
-                        it != gcoeffs.end(); ++it)
-                {
-                    evaluate(basis, j_+1,0,Lmin+it.index(), points, help1, help2);
-                    for (unsigned int i = 0; i < points.size(); i++) {
-                        funcvalues[i] += *it * help1[i];
-                        dervalues[i]  += *it * help2[i];
-                    }
-                }
+                Array1D<Array1D<double> > help;
+                evaluate_wavelet_expansion(basis, 1, j_, e_, k_, points, help);
+                funcvalues.swap(help[0]);
+                dervalues.swap(help[1]);
             }
         }
     }
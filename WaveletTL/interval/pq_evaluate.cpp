@@ -5,6 +5,7 @@
 #include <utils/array1d.h>
 #include <utils/tiny_tools.h>
 #include <numerics/schoenberg_splines.h>
+#include <interval/interval_bspline.h>
 #include <interval/pq_frame.h>
 
 namespace WaveletTL
@@ -834,4 +835,126 @@ namespace WaveletTL
             }
         }
     }
+    /*
+      the affine factor t of a generator psi_{p,j,0,k}(x) = B(x)*t(x)^p and its derivative
+    */
+    template <int d, int dT>
+    inline
+    void quarklet_factor(const PQFrame<d,dT>& basis, const int j, const int k,
+            const double x, double& t, double& tx)
+    {
+        if (k > (1<<j)-ell1<d>()-d) {//right boundary quarks
+            const double rightside = 1./(basis.DeltaRmax(j)-k+1);
+            t  =  (1<<j)*(1-x)*rightside;
+            tx = -(1<<j)*rightside;
+        }
+        else if (k < -ell1<d>()) {//left boundary quarks
+            const double leftside = 1./(k-basis.DeltaLmin()+1);
+            t  = (1<<j)*x*leftside;
+            tx = (1<<j)*leftside;
+        }
+        else {//inner quarks
+            const double pfktrez = 2./d;
+            t  = ((1<<j)*x-k-((d % 2 == 0)? 0 : 0.5))*pfktrez;
+            tx = (1<<j)*pfktrez;
+        }
+    }
+
+    template <int d, int dT>
+    void evaluate(const PQFrame<d,dT>& basis, const int pmax,
+            const int j_, const int e_, const int k_,
+            const Array1D<double>& points,
+            Array1D<Array1D<double> >& funcvalues, Array1D<Array1D<double> >& dervalues)
+    {
+        const unsigned int npoints(points.size());
+        funcvalues.resize(pmax+1);
+        dervalues.resize(pmax+1);
+        for (int p = 0; p <= pmax; p++) {
+            funcvalues[p].resize(npoints);
+            dervalues[p].resize(npoints);
+        }
+        if (e_ == 0) {
+            // generator, psi_{p,j,0,k}(x) = B(x)*t(x)^p with an affine t
+            const int kright = (1<<j_)-d-k_-2*ell1<d>();
+            for (unsigned int m(0); m < npoints; m++) {
+                double b, bx, t, tx;
+                if (k_ > (1<<j_)-ell1<d>()-d) {
+                    b  =  MathTL::EvaluateSchoenbergBSpline_td<d>  (j_, kright, 1-points[m]);
+                    bx = -MathTL::EvaluateSchoenbergBSpline_td_x<d>(j_, kright, 1-points[m]);
+                } else {
+                    b  = MathTL::EvaluateSchoenbergBSpline_td<d>  (j_, k_, points[m]);
+                    bx = MathTL::EvaluateSchoenbergBSpline_td_x<d>(j_, k_, points[m]);
+                }
+                quarklet_factor(basis, j_, k_, points[m], t, tx);
+                // (B t^p)' = B' t^p + p B t^{p-1} t'
+                double tp(1), tpm1(0);
+                for (int p = 0; p <= pmax; p++) {
+                    funcvalues[p][m] = b*tp;
+                    dervalues[p][m]  = bx*tp + p*b*tpm1*tx;
+                    tpm1 = tp;
+                    tp *= t;
+                }
+            }
+        }
+        else {
+            // wavelet, the generator coefficients may depend on p (boundary quarklets)
+            for (int p = 0; p <= pmax; p++)
+                for (unsigned int m(0); m < npoints; m++) {
+                    funcvalues[p][m] = 0;
+                    dervalues[p][m] = 0;
+                }
+            if (npoints == 0) return;
+
+            // generator coefficients on level j+1, c[p][k-first], k = DeltaLmin()+it.index()
+            const int jj = j_+1;
+            Array1D<InfiniteVector<double,int> > gcoeffs(pmax+1);
+            int first(0), last(-1);
+            for (int p = 0; p <= pmax; p++) {
+                basis.reconstruct_1(p, j_, e_, k_, jj, gcoeffs[p]);
+                for (typename InfiniteVector<double,int>::const_iterator it(gcoeffs[p].begin());
+                        it != gcoeffs[p].end(); ++it) {
+                    if (last < first) first = last = it.index();
+                    first = std::min(first, it.index());
+                    last = std::max(last, it.index());
+                }
+            }
+            const int ncoeffs = last-first+1;
+            Array1D<double> c((pmax+1)*std::max(ncoeffs, 0));
+            for (unsigned int i = 0; i < c.size(); i++)
+                c[i] = 0;
+            for (int p = 0; p <= pmax; p++)
+                for (typename InfiniteVector<double,int>::const_iterator it(gcoeffs[p].begin());
+                        it != gcoeffs[p].end(); ++it)
+                    c[p*ncoeffs+it.index()-first] = *it;
+
+            // the B-spline factors of all generators on level j+1 at once, see interval_bspline.h
+            Array1D<double> y(npoints);
+            for (unsigned int m = 0; m < npoints; m++)
+                y[m] = ldexp(points[m], jj);
+            Array1D<int> intervals;
+            Array1D<double> N;
+            evaluate_Bsplines<d>(SchoenbergIntervalKnots(1<<jj), 1, y, intervals, N);
+            const double factor = twotothejhalf(jj), dfactor = factor*(1<<jj);
+
+            const int kfirst = basis.DeltaLmin()+first;
+            for (unsigned int m = 0; m < npoints; m++)
+                for (int i = 0; i < d; i++) {
+                    // N_{l-d+1+i,d} belongs to the generator with k = l-d+1+i+d/2
+                    const int k = intervals[m]-d+1+i+d/2;
+                    if (k < kfirst || k >= kfirst+ncoeffs) continue;
+                    const double b  = factor*N[i*npoints+m];
+                    const double bx = dfactor*N[(d+i)*npoints+m];
+                    double t, tx;
+                    quarklet_factor(basis, jj, k, points[m], t, tx);
+                    double tp(1), tpm1(0);
+                    for (int p = 0; p <= pmax; p++) {
+                        const double cp = c[p*ncoeffs+k-kfirst];
+                        funcvalues[p][m] += cp*b*tp;
+                        dervalues[p][m]  += cp*(bx*tp + p*b*tpm1*tx);
+                        tpm1 = tp;
+                        tp *= t;
+                    }
+                }
+        }
+    }
 }
@@ -100,6 +100,18 @@ namespace WaveletTL
 		const int p, const int j, const int e, const int k,
 		const Array1D<double>& points, Array1D<double>& funcvalues, Array1D<double>& dervalues);
 
+  /*!
+    point evaluation of 0-th and first derivative of all quarklets \psi_{p,j,e,k}
+    with polynomial degree 0 <= p <= pmax at several points simultaneously,
+    i.e., funcvalues[p][m] = \psi_{p,j,e,k}(points[m]) etc.
+    The spline parts are evaluated only once per point and generator,
+    the polynomial factors of all degrees p are generated recursively.
+  */
+  template <int d, int dT>
+  void evaluate(const PQFrame<d,dT>& basis, const int pmax,
+		const int j, const int e, const int k,
+		const Array1D<double>& points,
+		Array1D<Array1D<double> >& funcvalues, Array1D<Array1D<double> >& dervalues);
 
 }
 
@@ -0,0 +1,135 @@
+// implementation for pq_integral_cache.h
+
+#include <cmath>
+#include <algorithm>
+#include <numerics/gauss_quadrature.h>
+
+namespace WaveletTL
+{
+  template <class IFRAME>
+  QuarkletIntegralCache<IFRAME>::QuarkletIntegralCache(const IFRAME* frame, const int pmax,
+						       const unsigned int max_blocks)
+    : frame_(frame), pmax_(pmax), max_blocks_(max_blocks)
+  {
+  }
+
+  template <class IFRAME>
+  void
+  QuarkletIntegralCache<IFRAME>::set_frame(const IFRAME* frame)
+  {
+    frame_ = frame;
+    clear();
+  }
+
+  template <class IFRAME>
+  void
+  QuarkletIntegralCache<IFRAME>::clear()
+  {
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_QuarkletIntegralCache)
+#endif
+    blocks_.clear();
+  }
+
+  template <class IFRAME>
+  void
+  QuarkletIntegralCache<IFRAME>::compute_block(const int pmax,
+					       const int j1, const int e1, const int k1,
+					       const int j2, const int e2, const int k2,
+					       Block& block) const
+  {
+    // supports 2^{-(j+e)}[a,b], the quarklets are piecewise polynomials on this grid
+    int a1, b1, a2, b2;
+    frame_->support(j1, e1, k1, a1, b1);
+    frame_->support(j2, e2, k2, a2, b2);
+    const int jsupp = std::max(j1+e1, j2+e2);
+    a1 <<= jsupp-j1-e1; b1 <<= jsupp-j1-e1;
+    a2 <<= jsupp-j2-e2; b2 <<= jsupp-j2-e2;
+    const int a = std::max(a1, a2), b = std::min(b1, b2);
+    if (a >= b) return;
+
+    // composite Gauss rule on the cells 2^{-jsupp}[k,k+1], exact for the
+    // piecewise polynomials of degree 2*(d-1+pmax)
+    MathTL::DyadicGaussRule rule;
+    rule.setup(jsupp, a, b, IFRAME::primal_polynomial_degree()+pmax);
+    const Array1D<double>& gauss_points(rule.points());
+    const Array1D<double>& gauss_weights(rule.weights());
+
+    Array1D<Array1D<double> > values1, dervalues1, values2, dervalues2;
+    evaluate(*frame_, pmax, j1, e1, k1, gauss_points, values1, dervalues1);
+    evaluate(*frame_, pmax, j2, e2, k2, gauss_points, values2, dervalues2);
+
+    block.integrals.resize((pmax+1)*(pmax+1));
+    block.der_integrals.resize((pmax+1)*(pmax+1));
+    for (int p1 = 0; p1 <= pmax; p1++)
+      for (int p2 = 0; p2 <= pmax; p2++) {
+	double integral(0), der_integral(0);
+	for (unsigned int m = 0; m < gauss_points.size(); m++) {
+	  integral += values1[p1][m] * values2[p2][m] * gauss_weights[m];
+	  der_integral += dervalues1[p1][m] * dervalues2[p2][m] * gauss_weights[m];
+	}
+	block.integrals[p1*(pmax+1)+p2] = integral;
+	block.der_integrals[p1*(pmax+1)+p2] = der_integral;
+      }
+  }
+
+  template <class IFRAME>
+  void
+  QuarkletIntegralCache<IFRAME>::integrals(const int p1, const int j1, const int e1, const int k1,
+					   const int p2, const int j2, const int e2, const int k2,
+					   double& integral, double& der_integral) const
+  {
+    // use the symmetry of both integrals
+    std::pair<int,int> first(2*j1+e1, k1), second(2*j2+e2, k2);
+    int q1(p1), q2(p2);
+    if (second < first) {
+      std::swap(first, second);
+      std::swap(q1, q2);
+    }
+    const Key key(first, second);
+
+    bool found = false;
+    int pmax = 0;
+    integral = der_integral = 0;
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_QuarkletIntegralCache)
+#endif
+    {
+      if (std::max(q1, q2) > pmax_) {
+	pmax_ = std::max(q1, q2);
+	blocks_.clear();
+      }
+      pmax = pmax_;
+      typename std::map<Key,Block>::const_iterator it(blocks_.find(key));
+      if (it != blocks_.end()) {
+	found = true;
+	if (it->second.integrals.size() > 0) {
+	  integral = it->second.integrals[q1*(pmax+1)+q2];
+	  der_integral = it->second.der_integrals[q1*(pmax+1)+q2];
+	}
+      }
+    }
+    if (found) return;
+
+    // compute the block outside of the critical section
+    Block block;
+    compute_block(pmax,
+		  first.first/2, first.first%2, first.second,
+		  second.first/2, second.first%2, second.second,
+		  block);
+    if (block.integrals.size() > 0) {
+      integral = block.integrals[q1*(pmax+1)+q2];
+      der_integral = block.der_integrals[q1*(pmax+1)+q2];
+    }
+#ifdef _OPENMP
+#pragma omp critical(WaveletTL_QuarkletIntegralCache)
+#endif
+    {
+      if (pmax == pmax_) {
+	if (max_blocks_ > 0 && blocks_.size() >= max_blocks_)
+	  blocks_.clear();
+	blocks_.insert(std::make_pair(key, block));
+      }
+    }
+  }
+}
@@ -0,0 +1,118 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_PQ_INTEGRAL_CACHE_H
+#define _WAVELETTL_PQ_INTEGRAL_CACHE_H
+
+#include <map>
+#include <utility>
+#include <utils/array1d.h>
+
+using MathTL::Array1D;
+
+namespace WaveletTL
+{
+  /*!
+    Cache for the 1D integrals
+
+      \int_0^1 \psi_{p,j,e,k}(x) \psi_{p',j',e',k'}(x) dx,
+      \int_0^1 \psi_{p,j,e,k}'(x) \psi_{p',j',e',k'}'(x) dx
+
+    of an interval quarklet frame IFRAME (e.g. PQFrame<d,dT>), as they appear
+    in the evaluation of tensor product bilinear forms.
+
+    The integrals are stored in p-blocks: for each pair of spline indices
+    (j,e,k), (j',e',k') the full (pmax+1)x(pmax+1) matrices of the integrals
+    for all polynomial degrees p,p' <= pmax are computed at once, using a single
+    composite Gauss rule on the intersection of the supports and the
+    evaluation of all p at once (see pq_evaluate.h). Only pairs with
+    (j,e,k) <= (j',e',k') are stored, the others follow by symmetry.
+
+    If a degree larger than pmax is requested, pmax is increased and the
+    cache is cleared. The number of stored blocks can be bounded by
+    set_max_blocks(), the cache is cleared when the bound is reached.
+
+    The cache may be accessed concurrently from OpenMP threads.
+  */
+  template <class IFRAME>
+  class QuarkletIntegralCache
+  {
+  public:
+    /*!
+      constructor from the interval frame and the initial maximal polynomial degree
+    */
+    QuarkletIntegralCache(const IFRAME* frame = 0, const int pmax = 0,
+			  const unsigned int max_blocks = 0);
+
+    /*!
+      set the underlying interval frame (clears the cache)
+    */
+    void set_frame(const IFRAME* frame);
+
+    /*!
+      compute (or lookup) both integrals for the quarklets (p1,j1,e1,k1) and (p2,j2,e2,k2)
+    */
+    void integrals(const int p1, const int j1, const int e1, const int k1,
+		   const int p2, const int j2, const int e2, const int k2,
+		   double& integral, double& der_integral) const;
+
+    //! current maximal polynomial degree
+    int pmax() const { return pmax_; }
+
+    //! number of stored p-blocks
+    unsigned int size() const { return blocks_.size(); }
+
+    //! delete all stored p-blocks
+    void clear();
+
+    /*!
+      bound the number of stored p-blocks (0: unbounded, the default),
+      the cache is cleared whenever a new block would exceed the bound
+    */
+    void set_max_blocks(const unsigned int max_blocks) { max_blocks_ = max_blocks; }
+
+    //! maximal number of stored p-blocks (0: unbounded)
+    unsigned int max_blocks() const { return max_blocks_; }
+
+  protected:
+    //! the underlying frame
+    const IFRAME* frame_;
+
+    //! maximal polynomial degree of the stored blocks
+    mutable int pmax_;
+
+    //! maximal number of stored blocks (0: unbounded)
+    unsigned int max_blocks_;
+
+    /*!
+      one p-block, integrals[p1*(pmax+1)+p2] and der_integrals[p1*(pmax+1)+p2];
+      empty arrays stand for disjoint supports
+    */
+    struct Block
+    {
+      Array1D<double> integrals, der_integrals;
+    };
+
+    //! key of a block: ((2*j1+e1,k1),(2*j2+e2,k2))
+    typedef std::pair<std::pair<int,int>, std::pair<int,int> > Key;
+
+    //! the stored blocks
+    mutable std::map<Key,Block> blocks_;
+
+    //! compute a single p-block
+    void compute_block(const int pmax,
+		       const int j1, const int e1, const int k1,
+		       const int j2, const int e2, const int k2,
+		       Block& block) const;
+  };
+}
+
+#include <interval/pq_integral_cache.cpp>
+
+#endif
@@ -692,18 +692,16 @@ namespace WaveletTL
       else
 	apply_Tj(jmax-1, wcoeffs, gcoeffs);
       
-      Array1D<double> values((1<<resolution)+1);
-      for (unsigned int i(0); i < values.size(); i++) {
-	values[i] = 0;
-	const double x = i*ldexp(1.0, -resolution);
-	SchoenbergIntervalBSpline_td<d> sbs(jmax,0);
-	for (unsigned int k = 0; k < gcoeffs.size(); k++) {
-	  sbs.set_k(DeltaLmin()+k);
-	  values[i] += gcoeffs[k] * sbs.value(Point<1>(x));
-	}
-      }
+      // evaluate all generators on level jmax at once
+      Array1D<double> points((1<<resolution)+1), gc(gcoeffs.size());
+      for (unsigned int i(0); i < points.size(); i++)
+	points[i] = i*ldexp(1.0, -resolution);
+      for (unsigned int k = 0; k < gcoeffs.size(); k++)
+	gc[k] = gcoeffs[k];
+      Array1D<Array1D<double> > values;
+      evaluate_interval_bsplines<d>(jmax, DeltaLmin(), gc, 0, points, values);
       
-      return SampledMapping<1>(grid, values);
+      return SampledMapping<1>(grid, values[0]);
     }
     
     return result;
@@ -1112,14 +1110,18 @@ namespace WaveletTL
 	  wc[w_number] = 1.0;
 	  SplineBasisData<d,dT,P_construction,s0,s1,sT0,sT1>::Mj1_.set_level(lambda.j());
 	  SplineBasisData<d,dT,P_construction,s0,s1,sT0,sT1>::Mj1_.apply(wc, gc, 0, 0);
-	  typedef typename SplineBasis<d,dT,P_construction,s0,s1,sT0,sT1,J0>::Index Index;
-	  Array1D<double> help(points.size());
+	  // evaluate all generators on level j+1 at once
+	  const size_type first = gc.empty() ? 0 : gc.begin()->first;
+	  Array1D<double> gcoeffs(gc.empty() ? 0 : gc.rbegin()->first-first+1);
+	  for (unsigned int i = 0; i < gcoeffs.size(); i++)
+	    gcoeffs[i] = 0;
 	  for (typename std::map<size_type,double>::const_iterator it(gc.begin());
-	       it != gc.end(); ++it) {
-	    evaluate(derivative, Index(lambda.j()+1, 0, DeltaLmin()+it->first), points, help);
-	    for (unsigned int i = 0; i < points.size(); i++)
-	      values[i] += it->second * help[i];
-	  }
+	       it != gc.end(); ++it)
+	    gcoeffs[it->first-first] = it->second;
+	  Array1D<Array1D<double> > help;
+	  evaluate_interval_bsplines<d>(lambda.j()+1, DeltaLmin()+first, gcoeffs, derivative, points, help);
+	  for (unsigned int i = 0; i < points.size(); i++)
+	    values[i] += help[derivative][i];
 	}
 #else
       // old version, switch to generator representation for all wavelets
@@ -1282,16 +1284,20 @@ namespace WaveletTL
 	  wc[w_number] = 1.0;
 	  SplineBasisData<d,dT,P_construction,s0,s1,sT0,sT1>::Mj1_.set_level(lambda.j());
 	  SplineBasisData<d,dT,P_construction,s0,s1,sT0,sT1>::Mj1_.apply(wc, gc, 0, 0);
-	  typedef typename SplineBasis<d,dT,P_construction,s0,s1,sT0,sT1,J0>::Index Index;
-	  Array1D<double> fhelp(points.size()), dhelp(points.size());
+	  // evaluate all generators on level j+1 at once
+	  const size_type first = gc.empty() ? 0 : gc.begin()->first;
+	  Array1D<double> gcoeffs(gc.empty() ? 0 : gc.rbegin()->first-first+1);
+	  for (unsigned int i = 0; i < gcoeffs.size(); i++)
+	    gcoeffs[i] = 0;
 	  for (typename std::map<size_type,double>::const_iterator it(gc.begin());
-	       it != gc.end(); ++it) {
-	    evaluate(Index(lambda.j()+1, 0, DeltaLmin()+it->first), points, fhelp, dhelp);
-	    for (unsigned int i = 0; i < points.size(); i++)
-	      funcvalues[i] += it->second * fhelp[i];
-	    for (unsigned int i = 0; i < points.size(); i++)
-	      dervalues[i] += it->second * dhelp[i];
-	  }
+	       it != gc.end(); ++it)
+	    gcoeffs[it->first-first] = it->second;
+	  Array1D<Array1D<double> > help;
+	  evaluate_interval_bsplines<d>(lambda.j()+1, DeltaLmin()+first, gcoeffs, 1, points, help);
+	  for (unsigned int i = 0; i < points.size(); i++)
+	    funcvalues[i] += help[0][i];
+	  for (unsigned int i = 0; i < points.size(); i++)
+	    dervalues[i] += help[1][i];
 	}
 #else
       // old version, switch to generator representation for all wavelets
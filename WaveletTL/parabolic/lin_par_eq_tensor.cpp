@@ -15,11 +15,12 @@ namespace WaveletTL
 
 
     template <class CACHEDPROBLEM>
+    template <class VECTOR>
     void
     LinParEqTenROWStageEquationHelper<CACHEDPROBLEM>
     ::add_ball(const Index& lambda,
                //InfiniteVector<double, Index>& w,
-               Vector<double>& w,
+               VECTOR& w,
                const int radius,
                const double factor,
                const int maxlevel,
@@ -59,13 +60,11 @@ namespace WaveletTL
         }
         g.scale(this, -1);
 
-        Vector<double> g_full_new(w.size());
+        //w.add(g);
         for (typename InfiniteVector<double,Index>::const_iterator it(g.begin());
                it != g.end(); ++it) {
-          g_full_new[it.index().number()] = *it;
+          w[it.index().number()] += *it;
         }
-        //w.add(g);
-        w += g_full_new;
 #endif
     }
 
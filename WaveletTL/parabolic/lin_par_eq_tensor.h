@@ -175,9 +175,10 @@ namespace WaveletTL
      * "strategy" argument ist needed for compatibility with compression.h .
      * There is only 1 strategy for TBasis at the moment
      */
+    template <class VECTOR>
     void add_ball(const Index& lambda,
                  //InfiniteVector<double, Index>& w,
-                 Vector<double>& w,
+                 VECTOR& w,
                  const int radius,
                  const double factor,
                  const int maxlevel,
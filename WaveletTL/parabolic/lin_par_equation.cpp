@@ -17,11 +17,12 @@ namespace WaveletTL
   }
   
   template <class ELLIPTIC_EQ>
+  template <class VECTOR>
   void
   LinParEqROWStageEquationHelper<ELLIPTIC_EQ>
   ::add_level (const Index& lambda,
 	       //InfiniteVector<double, Index>& w,
-	       Vector<double>& w,
+	       VECTOR& w,
 	       const int j,
 	       const double factor,
 	       const int J,
@@ -44,14 +45,11 @@ namespace WaveletTL
     
     g.scale(this, -1);
 
-    Vector<double> g_full_new(w.size());
+    //w.add(g);
     for (typename InfiniteVector<double,Index>::const_iterator it(g.begin());
  	   it != g.end(); ++it) {
-      g_full_new[it.index().number()] = *it;
+      w[it.index().number()] += *it;
     }
-
-    //w.add(g);
-    w += g_full_new;
     
     T->add_level(lambda, w, j, factor, J, strategy);
 
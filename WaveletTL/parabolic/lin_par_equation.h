@@ -152,9 +152,10 @@ namespace WaveletTL
     /*!
       w += factor * (stiffness matrix entries in column lambda on level j)
     */
+    template <class VECTOR>
     void add_level (const Index& lambda,
  		    //InfiniteVector<double, Index>& w,
-		    Vector<double>& w,
+		    VECTOR& w,
 		    const int j,
  		    const double factor,
  		    const int J,
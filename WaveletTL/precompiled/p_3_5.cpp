@@ -0,0 +1,6 @@
+// explicit instantiations for PBasis<3,5>, cf. precompiled.h
+
+#define _WAVELETTL_PRECOMPILED_INSTANTIATE
+#include <precompiled/precompiled.h>
+
+_WAVELETTL_PRECOMPILED_CONFIGURATION(,3,5)
@@ -0,0 +1,189 @@
+// -*- c++ -*-
+
+// +--------------------------------------------------------------------+
+// | This file is part of WaveletTL - the Wavelet Template Library      |
+// |                                                                    |
+// | Copyright (c) 2002-2009                                            |
+// | Thorsten Raasch, Manuel Werner                                     |
+// +--------------------------------------------------------------------+
+
+#ifndef _WAVELETTL_PRECOMPILED_H
+#define _WAVELETTL_PRECOMPILED_H
+
+/*
+  Explicit instantiations of the most common configurations of WaveletTL
+
+  Since WaveletTL is a template library, each program recompiles the bases,
+  problem classes and adaptive solvers it uses. For the configurations below,
+  the library libwavelettl.a (cf. precompiled/Makefile, target "lib" in the
+  WaveletTL Makefile) contains optimized, explicitly instantiated code, and a
+  program can skip the instantiation by including this header (after or
+  instead of the usual WaveletTL headers) and linking against the library:
+
+    #include <precompiled/precompiled.h>
+    ...
+    g++ ... -fopenmp test.o -L$(WAVELETTL_DIR)/precompiled -lwavelettl
+
+  Covered are, for (d,dT) in {(2,2),(3,3),(3,5)} and DIM in {2,3},
+
+  - PBasis<d,dT> and InfiniteVector<double,PBasis<d,dT>::Index>,
+  - TensorBasis<PBasis<d,dT>,DIM>, TensorEquation<PBasis<d,dT>,DIM>
+    and InfiniteVector<double,TensorBasis<PBasis<d,dT>,DIM>::Index>,
+  - the constructor, a(), norm_A(), norm_Ainv(), set_f(), add_ball() and
+    add_level_sweep() of CachedTProblem<TensorEquation<PBasis<d,dT>,DIM> >,
+  - APPLY, APPLY_TENSOR and the first two variants of CDD1_SOLVE for this problem.
+
+  The library is compiled with the default settings of the configuration
+  macros. The extern declarations of a group are only active if the
+  settings of the including program agree, otherwise the program simply
+  instantiates the templates itself:
+
+  - all groups: NDEBUG must be defined, since the library is compiled
+    with -DNDEBUG and the assert()s in the inline and template code
+    would otherwise differ between the library and the program
+    (a debug build simply instantiates everything itself),
+  - PBasis: additionally _PRE_COMPUTE_WAVELETS must not be defined,
+  - tensor bases/equations: additionally _WAVELETTL_SHARED_INTERVAL_BASES == 0,
+  - cached problem and solvers: additionally _WAVELETTL_USE_TBASIS == 1,
+    BASIS defined and FRAME undefined (cf. adaptive/compression.cpp),
+    PARALLEL != 1, and the verbosity levels _WAVELETTL_CACHEDPROBLEM_VERBOSITY,
+    _WAVELETTL_CDD1_VERBOSITY are zero (or undefined).
+
+  Define _WAVELETTL_NO_PRECOMPILED to switch off all extern declarations.
+*/
+
+#include <interval/p_basis.h>
+#include <cube/tbasis.h>
+#include <cube/tbasis_support.h>
+#include <galerkin/tbasis_equation.h>
+#include <galerkin/cached_tproblem.h>
+#include <adaptive/apply.h>
+#include <adaptive/apply_tensor.h>
+#include <adaptive/cdd1.h>
+
+namespace WaveletTL
+{
+  /*!
+    the types of a precompiled tensor product problem
+  */
+  template <int d, int dT, unsigned int DIM>
+  struct PrecompiledTensorProblem
+  {
+    typedef TensorEquation<PBasis<d,dT>,DIM> Equation;
+    typedef CachedTProblem<Equation> Problem;
+    typedef typename Problem::Index Index;
+    typedef typename Index::level_type Level;
+    typedef InfiniteVector<double,Index> Coefficients;
+  };
+}
+
+/*
+  The instantiation lists. EXTERN is either "extern" (declarations, in client
+  code) or empty (definitions, in the library sources). The lists have to be
+  expanded in the global namespace, since they also contain MathTL classes.
+*/
+
+#define _WAVELETTL_PRECOMPILED_INTERVAL(EXTERN,d,dT) \
+  EXTERN template class WaveletTL::PBasis<d,dT>; \
+  EXTERN template class MathTL::InfiniteVector<double,WaveletTL::PBasis<d,dT>::Index>;
+
+#define _WAVELETTL_PRECOMPILED_TENSOR(EXTERN,d,dT,DIM) \
+  EXTERN template class WaveletTL::TensorBasis<WaveletTL::PBasis<d,dT>,DIM>; \
+  EXTERN template class WaveletTL::TensorEquation<WaveletTL::PBasis<d,dT>,DIM>; \
+  EXTERN template class MathTL::InfiniteVector<double,WaveletTL::TensorBasis<WaveletTL::PBasis<d,dT>,DIM>::Index>;
+
+#define _WAVELETTL_PRECOMPILED_PROBLEM(EXTERN,d,dT,DIM) \
+  EXTERN template \
+  WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem::CachedTProblem \
+  (WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Equation*, const double, const double); \
+  EXTERN template \
+  double WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem::a \
+  (const WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Index&, \
+   const WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Index&) const; \
+  EXTERN template \
+  double WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem::norm_A() const; \
+  EXTERN template \
+  double WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem::norm_Ainv() const; \
+  EXTERN template \
+  void WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem::set_f \
+  (const MathTL::Function<DIM>*); \
+  EXTERN template \
+  void WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem::add_ball \
+  (const WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Index&, MathTL::Vector<double>&, \
+   const int, const double, const int, const WaveletTL::CompressionStrategy, const bool) const; \
+  EXTERN template \
+  bool WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem::add_level_sweep \
+  (const WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Level&, const MathTL::Vector<double>&, \
+   MathTL::Vector<double>&, const int, const int, const bool) const; \
+  EXTERN template \
+  void WaveletTL::APPLY<WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem> \
+  (const WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem&, \
+   const WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Coefficients&, const double, \
+   WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Coefficients&, const int, const WaveletTL::CompressionStrategy); \
+  EXTERN template \
+  void WaveletTL::APPLY_TENSOR<WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem> \
+  (WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem&, \
+   const WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Coefficients&, const double, \
+   WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Coefficients&, const int, const WaveletTL::CompressionStrategy, \
+   const bool, const bool); \
+  EXTERN template \
+  void WaveletTL::CDD1_SOLVE<WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem,WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Index> \
+  (WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem&, const double, \
+   WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Coefficients&, const int, bool, const WaveletTL::CompressionStrategy); \
+  EXTERN template \
+  void WaveletTL::CDD1_SOLVE<WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem,WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Index> \
+  (WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Problem&, const double, \
+   const WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Coefficients&, \
+   WaveletTL::PrecompiledTensorProblem<d,dT,DIM>::Coefficients&, const int, bool, const WaveletTL::CompressionStrategy);
+
+//! all instantiations for a pair (d,dT)
+#define _WAVELETTL_PRECOMPILED_CONFIGURATION(EXTERN,d,dT) \
+  _WAVELETTL_PRECOMPILED_INTERVAL_GROUP(EXTERN,d,dT) \
+  _WAVELETTL_PRECOMPILED_TENSOR_GROUP(EXTERN,d,dT,2) \
+  _WAVELETTL_PRECOMPILED_TENSOR_GROUP(EXTERN,d,dT,3) \
+  _WAVELETTL_PRECOMPILED_PROBLEM_GROUP(EXTERN,d,dT,2) \
+  _WAVELETTL_PRECOMPILED_PROBLEM_GROUP(EXTERN,d,dT,3)
+
+// in the library sources, all groups are instantiated
+#ifdef _WAVELETTL_PRECOMPILED_INSTANTIATE
+
+#ifndef NDEBUG
+#error "the precompiled library has to be compiled with -DNDEBUG"
+#endif
+
+#define _WAVELETTL_PRECOMPILED_INTERVAL_GROUP _WAVELETTL_PRECOMPILED_INTERVAL
+#define _WAVELETTL_PRECOMPILED_TENSOR_GROUP _WAVELETTL_PRECOMPILED_TENSOR
+#define _WAVELETTL_PRECOMPILED_PROBLEM_GROUP _WAVELETTL_PRECOMPILED_PROBLEM
+
+#else // client code, check the configuration macros
+
+#define _WAVELETTL_PRECOMPILED_SKIP(EXTERN,...)
+
+#if !defined(_WAVELETTL_NO_PRECOMPILED) && defined(NDEBUG) && !defined(_PRE_COMPUTE_WAVELETS)
+#define _WAVELETTL_PRECOMPILED_INTERVAL_GROUP _WAVELETTL_PRECOMPILED_INTERVAL
+#if _WAVELETTL_SHARED_INTERVAL_BASES == 0
+#define _WAVELETTL_PRECOMPILED_TENSOR_GROUP _WAVELETTL_PRECOMPILED_TENSOR
+#if _WAVELETTL_USE_TBASIS == 1 && defined(BASIS) && !defined(FRAME) && PARALLEL != 1 \
+  && !(_WAVELETTL_CACHEDPROBLEM_VERBOSITY > 0) && !(_WAVELETTL_CDD1_VERBOSITY > 0)
+#define _WAVELETTL_PRECOMPILED_PROBLEM_GROUP _WAVELETTL_PRECOMPILED_PROBLEM
+#endif
+#endif
+#endif
+
+#ifndef _WAVELETTL_PRECOMPILED_INTERVAL_GROUP
+#define _WAVELETTL_PRECOMPILED_INTERVAL_GROUP _WAVELETTL_PRECOMPILED_SKIP
+#endif
+#ifndef _WAVELETTL_PRECOMPILED_TENSOR_GROUP
+#define _WAVELETTL_PRECOMPILED_TENSOR_GROUP _WAVELETTL_PRECOMPILED_SKIP
+#endif
+#ifndef _WAVELETTL_PRECOMPILED_PROBLEM_GROUP
+#define _WAVELETTL_PRECOMPILED_PROBLEM_GROUP _WAVELETTL_PRECOMPILED_SKIP
+#endif
+
+_WAVELETTL_PRECOMPILED_CONFIGURATION(extern,2,2)
+_WAVELETTL_PRECOMPILED_CONFIGURATION(extern,3,3)
+_WAVELETTL_PRECOMPILED_CONFIGURATION(extern,3,5)
+
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <cstdlib>
+#include <time.h>
+
+#include <utils/fixed_array1d.h>
+#include <utils/function.h>
+#include <numerics/bvp.h>
+#include <interval/p_basis.h>
+#include <cube/tbasis.h>
+#include <galerkin/tbasis_equation.h>
+#include <galerkin/cached_tproblem.h>
+#include <adaptive/apply_tensor.h>
+
+using namespace std;
+using namespace WaveletTL;
+
+using MathTL::FixedArray1D;
+
+class ConstantRHS
+  : public Function<2,double>
+{
+public:
+  virtual ~ConstantRHS() {};
+  double value(const Point<2>& p, const unsigned int component = 0) const { return 1.0; }
+  void vector_value(const Point<2>& p, Vector<double>& values) const { values[0] = 1.0; }
+};
+
+int main()
+{
+  cout << "Testing the sweep mode of APPLY_TENSOR..." << endl;
+
+  const unsigned int dim = 2;
+  const int jmax = 7;
+  typedef PBasis<3,3> Basis1d;
+  typedef TensorBasis<Basis1d,dim> Basis;
+  typedef Basis::Index Index;
+
+  FixedArray1D<bool,2*dim> bc;
+  bc[0] = bc[1] = bc[2] = bc[3] = true;
+  ConstantRHS rhs;
+  PoissonBVP<dim> poisson(&rhs);
+  TensorEquation<Basis1d,dim,Basis> eq(&poisson, bc);
+  eq.set_jmax(jmax);
+
+  // two caches, so that the timings are independent
+  CachedTProblem<TensorEquation<Basis1d,dim,Basis> > columnwise(&eq, 5.0, 20.0), sweep(&eq, 5.0, 20.0);
+
+  // all indices up to |j| = jmax-1 with coefficients +-1, plus one index on the finest level
+  InfiniteVector<double,Index> v, w_columnwise, w_sweep;
+  srand(1);
+  for (int n = 0; n < eq.basis().degrees_of_freedom(); n++) {
+    const Index* lambda = eq.basis().get_wavelet(n);
+    if (multi_degree(lambda->j()) < jmax)
+      v.set_coefficient(*lambda, (rand()%2) ? 1.0 : -1.0);
+  }
+  v.set_coefficient(*eq.basis().get_wavelet(eq.basis().degrees_of_freedom()-1), 1.0);
+  cout << "- number of coefficients of v: " << v.size() << endl;
+
+  for (int run = 0; run < 2; run++) {
+    clock_t tstart = clock();
+    APPLY_TENSOR(columnwise, v, 1e-3, w_columnwise, jmax, tensor_simple, true, false);
+    clock_t tmiddle = clock();
+    APPLY_TENSOR(sweep, v, 1e-3, w_sweep, jmax, tensor_simple, true, true);
+    clock_t tend = clock();
+    cout << "- " << (run == 0 ? "first" : "second") << " application:" << endl
+         << "  columnwise: " << w_columnwise.size() << " entries, "
+         << (double)(tmiddle-tstart)/CLOCKS_PER_SEC << "s" << endl
+         << "  sweep:      " << w_sweep.size() << " entries, "
+         << (double)(tend-tmiddle)/CLOCKS_PER_SEC << "s" << endl
+         << "  ||w_columnwise-w_sweep||_2 = " << l2_norm(w_columnwise-w_sweep) << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,188 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#define BASIS
+#define _WAVELETTL_GALERKINUTILS_VERBOSITY 0
+#define _WAVELETTL_CDD1_VERBOSITY 0
+
+#include <algebra/infinite_vector.h>
+#include <numerics/sturm_bvp.h>
+#include <utils/convergence_logger.h>
+#include <interval/p_basis.h>
+#include <galerkin/sturm_equation.h>
+#include <galerkin/cached_problem.h>
+#include <adaptive/apply.h>
+#include <adaptive/cdd1.h>
+#include <adaptive/cdd2.h>
+#include <adaptive/stevenson_AWGM.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+/*
+  -u''=g with homogeneous Dirichlet b.c.'s, for the three right-hand sides
+  g(t)=1, g(t)=t and g(t)=sin(pi*t)
+*/
+class PoissonProblem
+  : public SimpleSturmBVP
+{
+public:
+  PoissonProblem(const int N) : N_(N) {}
+  double p(const double t) const { return 1; }
+  double p_prime(const double t) const { return 0; }
+  double q(const double t) const { return 0; }
+  double g(const double t) const {
+    switch(N_) {
+    case 0: return 1;
+    case 1: return t;
+    default: return sin(M_PI*t);
+    }
+  }
+  bool bc_left() const { return true; }
+  bool bc_right() const { return true; }
+protected:
+  int N_;
+};
+
+int main()
+{
+  cout << "Testing the blocked variants for several right-hand sides..." << endl;
+
+  typedef PBasis<3,3> Basis;
+  typedef SturmEquation<Basis> Equation;
+  typedef CachedProblem<Equation> Problem;
+  typedef Problem::Index Index;
+
+  const int jmax = 10;
+  const unsigned int k = 3;
+  Basis basis(1, 1);
+  basis.set_jmax(jmax);
+
+  // one problem per right-hand side, the blocked variants are called for the first one
+  std::vector<PoissonProblem*> bvps(k);
+  std::vector<Equation*> equations(k);
+  std::vector<Problem*> problems(k);
+  std::vector<InfiniteVector<double,Index> > F(k);
+  for (unsigned int i = 0; i < k; i++) {
+    bvps[i] = new PoissonProblem(i);
+    equations[i] = new Equation(*bvps[i], basis);
+    problems[i] = new Problem(equations[i]);
+    problems[i]->RHS(1e-12, F[i]);
+  }
+  Problem& P = *problems[0];
+
+  // APPLY: ||w[i]-Av[i]|| <= eta[i] for the blocked and the single vector version,
+  // the accumulators are reused by the second blocked call
+  {
+    std::vector<InfiniteVector<double,Index> > v(k), w;
+    std::vector<double> eta(k);
+    for (unsigned int i = 0; i < k; i++) {
+      F[i].COARSE(1e-3, v[i]);
+      eta[i] = 1e-3 * (i+1);
+    }
+    std::vector<DenseAccumulator<double> > ww;
+    double deviation = 0, deviation_identical = 0;
+    for (unsigned int pass = 0; pass < 2; pass++) {
+      APPLY(P, v, eta, w, ww, jmax);
+      for (unsigned int i = 0; i < k; i++) {
+	InfiniteVector<double,Index> wi;
+	APPLY(P, v[i], eta[i], wi, jmax);
+	deviation = std::max(deviation, l2_norm(w[i]-wi) / (2*eta[i]));
+      }
+      std::reverse(v.begin(), v.end());
+      std::reverse(eta.begin(), eta.end());
+    }
+    // for identical vectors, the result is the one of the single vector version
+    std::vector<InfiniteVector<double,Index> > v0(k, v[0]);
+    APPLY(P, v0, std::vector<double>(k, eta[0]), w, ww, jmax);
+    InfiniteVector<double,Index> w0;
+    APPLY(P, v[0], eta[0], w0, jmax);
+    for (unsigned int i = 0; i < k; i++)
+      deviation_identical = std::max(deviation_identical, l2_norm(w[i]-w0));
+    cout << "* APPLY: max. ||w_blocked[i]-w_single[i]||/(2*eta[i]): " << deviation
+	 << (deviation <= 1 ? " (ok)" : " (too large)") << endl
+	 << "  identical vectors: max. ||w_blocked[i]-w_single||: " << deviation_identical
+	 << (deviation_identical < 1e-12 ? " (ok)" : " (too large)") << endl;
+  }
+
+  // RES: nu[i] is an upper bound for ||F[i]-Aw[i]||, blocked as well as single
+  {
+    std::vector<InfiniteVector<double,Index> > w(k), r;
+    std::vector<double> xi(k, 1e-2), nu;
+    for (unsigned int i = 0; i < k; i++)
+      F[i].COARSE(1e-2, w[i]);
+    unsigned int niter = 0;
+    RES(P, F, w, xi, 0.1, 1e-6, jmax, r, nu, niter);
+    bool ok = true;
+    for (unsigned int i = 0; i < k; i++) {
+      InfiniteVector<double,Index> Aw, ri;
+      APPLY(P, w[i], 1e-8, Aw, jmax);
+      const double exact = l2_norm(F[i]-Aw);
+      double nu_single;
+      unsigned int niter_single = 0;
+      RES(*problems[i], w[i], xi[i], 0.1, 1e-6, jmax, ri, nu_single, niter_single);
+      ok = ok && exact <= nu[i] && exact <= nu_single;
+      cout << "* RES, right-hand side " << i << ": ||F-Aw||=" << exact
+	   << ", nu blocked: " << nu[i] << ", nu single: " << nu_single << endl;
+    }
+    cout << "  nu bounds the residuals: " << (ok ? "yes (ok)" : "no") << endl;
+  }
+
+  // the solvers: ||u-u_epsilon|| <= C*epsilon for the blocked and the single versions
+  // (with C = 1 for CDD1 and CDD2, and C = ||A^{-1}|| for AWGM),
+  // so the difference is at most 2*C*epsilon
+  const double epsilon = 1e-3;
+  const double normAinv = P.norm_Ainv();
+  const double C = std::max(1.0, normAinv);
+  {
+    std::vector<InfiniteVector<double,Index> > u;
+    CDD1_SOLVE(P, epsilon, F, u, jmax);
+    double deviation = 0;
+    for (unsigned int i = 0; i < k; i++) {
+      InfiniteVector<double,Index> ui;
+      CDD1_SOLVE(*problems[i], epsilon, ui, jmax);
+      deviation = std::max(deviation, l2_norm(u[i]-ui) / (2*C*epsilon));
+    }
+    cout << "* CDD1_SOLVE: max. ||u_blocked[i]-u_single[i]||/(2*C*epsilon): " << deviation
+	 << (deviation <= 1 ? " (ok)" : " (too large)") << endl;
+  }
+  {
+    double nu = 0;
+    for (unsigned int i = 0; i < k; i++)
+      nu = std::max(nu, normAinv * l2_norm(F[i]));
+    std::vector<InfiniteVector<double,Index> > u;
+    CDD2_SOLVE(P, nu, epsilon, F, u, jmax);
+    double deviation = 0;
+    for (unsigned int i = 0; i < k; i++) {
+      InfiniteVector<double,Index> ui;
+      CDD2_SOLVE(*problems[i], nu, epsilon, ui, jmax);
+      deviation = std::max(deviation, l2_norm(u[i]-ui) / (2*C*epsilon));
+    }
+    cout << "* CDD2_SOLVE: max. ||u_blocked[i]-u_single[i]||/(2*C*epsilon): " << deviation
+	 << (deviation <= 1 ? " (ok)" : " (too large)") << endl;
+  }
+  {
+    DummyLogger logger;
+    std::vector<InfiniteVector<double,Index> > u;
+    AWGM_SOLVE(P, epsilon, F, u, jmax, logger);
+    double deviation = 0;
+    for (unsigned int i = 0; i < k; i++) {
+      InfiniteVector<double,Index> ui;
+      AWGM_SOLVE(*problems[i], epsilon, ui, jmax, logger);
+      deviation = std::max(deviation, l2_norm(u[i]-ui) / (2*C*epsilon));
+    }
+    cout << "* AWGM_SOLVE: max. ||u_blocked[i]-u_single[i]||/(2*C*epsilon): " << deviation
+	 << (deviation <= 1 ? " (ok)" : " (too large)") << endl;
+  }
+
+  for (unsigned int i = 0; i < k; i++) {
+    delete problems[i];
+    delete equations[i];
+    delete bvps[i];
+  }
+
+  return 0;
+}
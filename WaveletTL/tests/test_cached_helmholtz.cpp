@@ -0,0 +1,130 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#define BASIS
+#define _WAVELETTL_GALERKINUTILS_VERBOSITY 0
+
+#include <algebra/vector.h>
+#include <algebra/sparse_matrix.h>
+#include <numerics/sturm_bvp.h>
+#include <numerics/iteratsolv.h>
+#include <interval/p_basis.h>
+#include <galerkin/sturm_equation.h>
+#include <galerkin/cached_helmholtz_problem.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+/*
+  -(pu')'+qu = 1 with homogeneous Dirichlet b.c.'s,
+  p=0,q=1 models the Gramian, p=1,q=0 the Laplacian
+*/
+class SturmProblem
+  : public SimpleSturmBVP
+{
+public:
+  SturmProblem(const double p, const double q) : p_(p), q_(q) {}
+  double p(const double t) const { return p_; }
+  double p_prime(const double t) const { return 0; }
+  double q(const double t) const { return q_; }
+  double g(const double t) const { return 1; }
+  bool bc_left() const { return true; }
+  bool bc_right() const { return true; }
+protected:
+  double p_, q_;
+};
+
+int main()
+{
+  cout << "Testing CachedHelmholtzProblem..." << endl;
+
+  typedef PBasis<3,3> Basis;
+  typedef Basis::Index Index;
+  typedef SturmEquation<Basis> Problem;
+
+  const int jmax = 6;
+  Basis basis(1, 1);
+  basis.set_jmax(jmax);
+
+  SturmProblem mass(0, 1), laplace(1, 0);
+  Problem G(mass, basis), A(laplace, basis);
+  CachedHelmholtzProblem<Problem,Problem> H(&G, &A);
+
+  const int j0 = basis.j0();
+  const int dof = basis.Deltasize(jmax+1);
+  const double alphas[] = { 0.0, 1.0, 100.0 };
+
+  for (unsigned int i = 0; i < 3; i++) {
+    const double alpha = alphas[i];
+    H.set_alpha(alpha);
+    cout << "* alpha=" << alpha << ":" << endl;
+
+    // single entries and D_alpha
+    double err(0), maxentry(0), errD(0);
+    for (Index lambda(basis.first_generator(j0));; ++lambda) {
+      for (Index nu(basis.first_generator(j0));; ++nu) {
+	const double entry = alpha * G.a(lambda, nu) + A.a(lambda, nu);
+	err = std::max(err, fabs(H.a(lambda, nu) - entry));
+	maxentry = std::max(maxentry, fabs(entry));
+	if (nu == basis.last_wavelet(jmax)) break;
+      }
+      errD = std::max(errD, fabs(H.D(lambda)
+				 - sqrt(alpha * G.a(lambda, lambda) + A.a(lambda, lambda))));
+      if (lambda == basis.last_wavelet(jmax)) break;
+    }
+    cout << "- entries a(lambda,nu) up to level " << jmax << ", max. relative deviation: "
+	 << (err < 1e-12*maxentry ? "< 1e-12" : "too large") << endl;
+    cout << "- diagonal preconditioner, max. deviation: "
+	 << (errD < 1e-12*sqrt(maxentry) ? "< 1e-12" : "too large") << endl;
+
+    // preconditioned columns
+    err = 0;
+    for (Index lambda(basis.first_generator(j0));; ++lambda) {
+      Vector<double> w(dof), wref(dof);
+      for (int j = j0-1; j <= jmax; j++)
+	H.add_level(lambda, w, j, 1.0, 99, CDD1);
+      for (Index nu(basis.first_generator(j0));; ++nu) {
+	wref[nu.number()] = (alpha * G.a(nu, lambda) + A.a(nu, lambda))
+	  / (sqrt(alpha * G.a(nu, nu) + A.a(nu, nu)) * sqrt(alpha * G.a(lambda, lambda) + A.a(lambda, lambda)));
+	if (nu == basis.last_wavelet(jmax)) break;
+      }
+      w -= wref;
+      err = std::max(err, linfty_norm(w));
+      if (lambda == basis.last_wavelet(jmax)) break;
+    }
+    cout << "- columns via add_level(), max. deviation: "
+	 << (err < 1e-12 ? "< 1e-12" : "too large") << endl;
+  }
+
+  // shifted solves on a full index set
+  const int jLambda = j0+2;
+  std::set<Index> Lambda;
+  for (Index lambda(basis.first_generator(j0));; ++lambda) {
+    Lambda.insert(lambda);
+    if (lambda == basis.last_wavelet(jLambda)) break;
+  }
+  Array1D<double> shifts(3);
+  shifts[0] = 10; shifts[1] = 100; shifts[2] = 1000;
+  Array1D<InfiniteVector<double,Index> > us;
+  unsigned int iterations;
+  H.solve_shifted(Lambda, shifts, us, 1e-10, 500, iterations);
+  cout << "* shifted solves for alpha=10,100,1000 up to level " << jLambda
+       << ", " << iterations << " iterations:" << endl;
+  for (unsigned int s = 0; s < shifts.size(); s++) {
+    // residual of the unpreconditioned Galerkin system
+    double res(0), fnorm(0);
+    for (std::set<Index>::const_iterator it1(Lambda.begin()); it1 != Lambda.end(); ++it1) {
+      double r = A.f(*it1);
+      for (std::set<Index>::const_iterator it2(Lambda.begin()); it2 != Lambda.end(); ++it2)
+	r -= (shifts[s] * G.a(*it1, *it2) + A.a(*it1, *it2)) * us[s].get_coefficient(*it2);
+      res += r*r;
+      fnorm += A.f(*it1)*A.f(*it1);
+    }
+    cout << "- alpha=" << shifts[s] << ", relative residual: "
+	 << (sqrt(res) < 1e-8*sqrt(fnorm) ? "< 1e-8" : "too large") << endl;
+  }
+
+  return 0;
+}
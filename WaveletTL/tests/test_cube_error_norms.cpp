@@ -0,0 +1,180 @@
+#include <iostream>
+#include <cmath>
+#include <time.h>
+#include <vector>
+
+#include <algebra/infinite_vector.h>
+#include <algebra/vector.h>
+#include <utils/function.h>
+#include <geometry/point.h>
+#include <numerics/gauss_data.h>
+#include <interval/p_basis.h>
+#include <cube/cube_basis.h>
+#include <cube/cube_error_norms.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+/*
+  u(x,y) = x(1-x)y(1-y)
+*/
+class Solution : public Function<2>
+{
+public:
+  double value(const Point<2>& p, const unsigned int component = 0) const {
+    return p[0]*(1-p[0])*p[1]*(1-p[1]);
+  }
+  void vector_value(const Point<2>& p, Vector<double>& values) const {
+    values.resize(1, false);
+    values[0] = value(p);
+  }
+};
+
+/*
+  gradient of u
+*/
+class SolutionGradient : public Function<2>
+{
+public:
+  SolutionGradient() : Function<2>(2) {}
+  double value(const Point<2>& p, const unsigned int component = 0) const {
+    return component == 0
+      ? (1-2*p[0])*p[1]*(1-p[1])
+      : p[0]*(1-p[0])*(1-2*p[1]);
+  }
+  void vector_value(const Point<2>& p, Vector<double>& values) const {
+    values.resize(2, false);
+    values[0] = value(p, 0);
+    values[1] = value(p, 1);
+  }
+};
+
+typedef PBasis<2,2> Basis1D;
+typedef CubeBasis<Basis1D,2> Basis;
+typedef Basis::Index Index;
+
+/*
+  brute force: Gauss rule on the uniform grid of level J,
+  each coefficient is only evaluated on the cells in its support
+*/
+void reference_norms(const Basis& basis, const InfiniteVector<double,Index>& u_epsilon,
+		     const Function<2>& u, const Function<2>& du,
+		     const int J, const int N, const double p,
+		     double& Lp, double& Lp_deriv_x, double& L_infty)
+{
+  // Gauss points of the grid in one direction, ordered cell by cell
+  const double h = ldexp(1.0, -J);
+  const int M = (1<<J)*N;
+  Array1D<double> points(M);
+  for (int k = 0; k < (1<<J); k++)
+    for (int n = 0; n < N; n++)
+      points[k*N+n] = h*(2*k+1+GaussPoints[N-1][n])/2.;
+
+  // values and x derivatives of u_epsilon at the tensor product points
+  std::vector<double> values(M*M, 0.0), derivs_x(M*M, 0.0);
+  Array1D<double> psi_x, dpsi_x, psi_y;
+  Basis::Support supp;
+  for (InfiniteVector<double,Index>::const_iterator it(u_epsilon.begin()); it != u_epsilon.end(); ++it) {
+    const Index& lambda(it.index());
+    evaluate(*basis.bases()[0], 0, lambda.j(), lambda.e()[0], lambda.k()[0], points, psi_x);
+    evaluate(*basis.bases()[0], 1, lambda.j(), lambda.e()[0], lambda.k()[0], points, dpsi_x);
+    evaluate(*basis.bases()[1], 0, lambda.j(), lambda.e()[1], lambda.k()[1], points, psi_y);
+    basis.support(lambda, supp);
+    const int m0 = N*(supp.a[0]<<(J-supp.j)), m1 = N*(supp.b[0]<<(J-supp.j));
+    const int n0 = N*(supp.a[1]<<(J-supp.j)), n1 = N*(supp.b[1]<<(J-supp.j));
+    for (int m = m0; m < m1; m++)
+      for (int n = n0; n < n1; n++) {
+	values[m*M+n] += *it * psi_x[m] * psi_y[n];
+	derivs_x[m*M+n] += *it * dpsi_x[m] * psi_y[n];
+      }
+  }
+
+  Lp = Lp_deriv_x = L_infty = 0;
+  Point<2> x;
+  Vector<double> grad(2);
+  for (int m = 0; m < M; m++)
+    for (int n = 0; n < M; n++) {
+      x[0] = points[m];
+      x[1] = points[n];
+      const double weight = h*GaussWeights[N-1][m%N] * h*GaussWeights[N-1][n%N];
+      du.vector_value(x, grad);
+      const double error = fabs(u.value(x) - values[m*M+n]);
+      Lp += weight * pow(error, p);
+      Lp_deriv_x += weight * pow(fabs(grad[0] - derivs_x[m*M+n]), p);
+      L_infty = std::max(L_infty, error);
+    }
+  Lp = pow(Lp, 1.0/p);
+  Lp_deriv_x = pow(Lp_deriv_x, 1.0/p);
+}
+
+int main()
+{
+  cout << "Testing the streamed error norm evaluation on the cube..." << endl;
+
+  FixedArray1D<bool,4> bc;
+  bc[0] = bc[1] = bc[2] = bc[3] = true;
+  Basis basis(bc);
+  const int j0 = basis.j0();
+
+  Solution u;
+  SolutionGradient du;
+
+  // u_epsilon = 0: the norms of u itself, with a 13 point Gauss rule (beyond gauss_data.h)
+  {
+    CubeErrorNorms<Basis1D,2> norms(basis, &u, &du, 25);
+    norms.compute(InfiniteVector<double,Index>(), 2.0);
+    cout << "* u_epsilon=0, p=2:" << endl
+	 << "  ||u||_L2 = " << norms.error_Lp << " (exact: " << sqrt(1./900.) << ")" << endl
+	 << "  ||u_x||_L2 = " << norms.error_Lp_deriv[0] << " (exact: " << sqrt(1./90.) << ")" << endl
+	 << "  ||u||_Linfty = " << norms.error_L_infty << " (exact: " << 1./16. << ")" << endl
+	 << "  " << norms.indicators.size() << " leaves" << endl;
+  }
+
+  // an adaptive expansion
+  InfiniteVector<double,Index> u_epsilon;
+  int id = 0;
+  for (Index lambda(basis.first_generator(j0));; ++lambda, ++id) {
+    if (lambda.j() == j0 || id % 5 == 0)
+      u_epsilon.set_coefficient(lambda, sin(0.7*id) / (1 << (2*lambda.j())));
+    if (lambda == basis.last_wavelet(j0+1)) break;
+  }
+  cout << "* u_epsilon with " << u_epsilon.size() << " active coefficients" << endl;
+
+  CubeErrorNorms<Basis1D,2> norms(basis, &u, &du, 5, 1e-8, 2);
+  const int J = j0+3; // finer than the singular supports of all active coefficients
+
+  // p=2: the Gauss rule is exact on each leaf, so both have to agree up to roundoff
+  clock_t tstart = clock();
+  norms.compute(u_epsilon, 2.0);
+  const double time_streamed = double(clock() - tstart) / CLOCKS_PER_SEC;
+  tstart = clock();
+  double Lp, Lp_deriv_x, L_infty;
+  reference_norms(basis, u_epsilon, u, du, J, 3, 2.0, Lp, Lp_deriv_x, L_infty);
+  const double time_reference = double(clock() - tstart) / CLOCKS_PER_SEC;
+  cout << "* p=2, " << norms.indicators.size() << " leaves:" << endl
+       << "  L2 error: deviation from the uniform grid "
+       << (fabs(norms.error_Lp - Lp) < 1e-12 ? "< 1e-12" : "too large") << endl
+       << "  L2 error of d/dx: deviation from the uniform grid "
+       << (fabs(norms.error_Lp_deriv[0] - Lp_deriv_x) < 1e-12 ? "< 1e-12" : "too large") << endl
+       << "  (streamed: " << time_streamed << "s, uniform grid: " << time_reference << "s)" << endl;
+
+  // p=1.5: |e|^p is not polynomial, the adaptive quadrature has to bisect
+  norms.compute(u_epsilon, 1.5);
+  reference_norms(basis, u_epsilon, u, du, J+1, 3, 1.5, Lp, Lp_deriv_x, L_infty);
+  int max_depth = 0;
+  for (unsigned int i = 0; i < norms.indicators.size(); i++)
+    max_depth = std::max(max_depth, norms.indicators[i].depth);
+  cout << "* p=1.5:" << endl
+       << "  L_p error: relative deviation from a fine uniform grid "
+       << (fabs(norms.error_Lp - Lp) < 1e-4 * Lp ? "< 1e-4" : "too large") << endl
+       << "  L_p error of d/dx: relative deviation from a fine uniform grid "
+       << (fabs(norms.error_Lp_deriv[0] - Lp_deriv_x) < 1e-4 * Lp_deriv_x ? "< 1e-4" : "too large") << endl
+       << "  maximal bisection depth: " << max_depth << endl;
+
+  cout << "* W^1_p error: " << norms.error_W1p
+       << ", L_infty error: " << norms.error_L_infty
+       << ", relative L_infty error: " << norms.rel_error_L_infty << endl;
+
+  return 0;
+}
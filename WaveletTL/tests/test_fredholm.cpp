@@ -0,0 +1,121 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include <algebra/vector.h>
+#include <numerics/gauss_data.h>
+#include <interval/spline_basis.h>
+#include <galerkin/fredholm.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+/*
+  reference: the entry a(lambda,mu) by a direct composite Gauss rule
+*/
+template <class PROBLEM>
+double reference_entry(const PROBLEM& P,
+		       const typename PROBLEM::Index& lambda,
+		       const typename PROBLEM::Index& mu)
+{
+  const int j_lambda = lambda.j()+lambda.e();
+  const int j_mu = mu.j()+mu.e();
+  int k1_lambda, k2_lambda, k1_mu, k2_mu;
+  P.basis().support(lambda, k1_lambda, k2_lambda);
+  P.basis().support(mu, k1_mu, k2_mu);
+
+  const unsigned int N_Gauss = P.basis().primal_polynomial_degree()+1;
+  const double h_lambda = ldexp(1.0, -j_lambda);
+  const double h_mu = ldexp(1.0, -j_mu);
+  Array1D<double> gp_lambda(N_Gauss*(k2_lambda-k1_lambda)),
+    gp_mu(N_Gauss*(k2_mu-k1_mu)),
+    psi_lambda_values, psi_mu_values;
+  for (int patch = k1_lambda, id = 0; patch < k2_lambda; patch++)
+    for (unsigned int n = 0; n < N_Gauss; n++, id++)
+      gp_lambda[id] = h_lambda*(2*patch+1+GaussPoints[N_Gauss-1][n])/2.;
+  for (int patch = k1_mu, id = 0; patch < k2_mu; patch++)
+    for (unsigned int n = 0; n < N_Gauss; n++, id++)
+      gp_mu[id] = h_mu*(2*patch+1+GaussPoints[N_Gauss-1][n])/2.;
+  P.basis().evaluate(0, lambda, gp_lambda, psi_lambda_values);
+  P.basis().evaluate(0, mu, gp_mu, psi_mu_values);
+
+  double entry = 0;
+  for (unsigned int m = 0; m < gp_lambda.size(); m++)
+    for (unsigned int n = 0; n < gp_mu.size(); n++)
+      entry += psi_lambda_values[m] * GaussWeights[N_Gauss-1][m%N_Gauss] * h_lambda
+	* psi_mu_values[n] * GaussWeights[N_Gauss-1][n%N_Gauss] * h_mu
+	* P.g(gp_lambda[m], gp_mu[n]);
+  return entry;
+}
+
+int main()
+{
+  cout << "Testing FredholmIntegralOperator..." << endl;
+
+  const int d = 2;
+  const int dT = 2;
+  typedef VolterraIntegralOperator<d,dT,SplineBasisData_j0<d,dT,P_construction,0,0,0,0>::j0> Problem;
+  typedef Problem::WaveletBasis Basis;
+  typedef Problem::Index Index;
+
+  const int jmax = 6;
+  Basis basis;
+  basis.set_jmax(jmax);
+  const int j0 = basis.j0();
+  const int dof = basis.Deltasize(jmax+1);
+
+  InfiniteVector<double,Index> y;
+  Problem P(basis, y);
+
+  // single entries, near field and far field
+  double err(0), maxentry(0);
+  for (Index lambda(basis.first_generator(j0));; ++lambda) {
+    for (Index mu(basis.first_generator(j0));; ++mu) {
+      const double entry = reference_entry(P, lambda, mu);
+      err = std::max(err, fabs(P.a(lambda, mu) - entry));
+      maxentry = std::max(maxentry, fabs(entry));
+      if (mu == basis.last_wavelet(jmax)) break;
+    }
+    if (lambda == basis.last_wavelet(jmax)) break;
+  }
+  cout << "* entries a(lambda,mu) up to level " << jmax << ", max. relative deviation: "
+       << (err < 1e-10*maxentry ? "< 1e-10" : "too large") << endl;
+
+  // uncompressed columns via add_level()
+  P.set_compression(0, 1, 1e-10);
+  err = 0;
+  for (Index lambda(basis.first_generator(j0));; ++lambda) {
+    Vector<double> w(dof), wref(dof);
+    for (int j = j0-1; j <= jmax; j++)
+      P.add_level(lambda, w, j, 1.0, 99);
+    for (Index nu(basis.first_generator(j0));; ++nu) {
+      wref[nu.number()] = reference_entry(P, nu, lambda)
+	/ sqrt(reference_entry(P, nu, nu) * reference_entry(P, lambda, lambda));
+      if (nu == basis.last_wavelet(jmax)) break;
+    }
+    w -= wref;
+    err = std::max(err, linfty_norm(w));
+    if (lambda == basis.last_wavelet(jmax)) break;
+  }
+  cout << "* uncompressed columns via add_level(), max. deviation: "
+       << (err < 1e-10 ? "< 1e-10" : "too large") << endl;
+
+  // a priori compression
+  P.set_compression(2, 1, 1e-10);
+  for (int J = 2; J <= 8; J += 2) {
+    unsigned int nonzeros = 0;
+    for (Index lambda(basis.first_generator(j0));; ++lambda) {
+      Vector<double> w(dof);
+      for (int j = j0-1; j <= jmax; j++)
+	P.add_level(lambda, w, j, 1.0, J);
+      for (unsigned int i = 0; i < w.size(); i++)
+	if (w[i] != 0) nonzeros++;
+      if (lambda == basis.last_wavelet(jmax)) break;
+    }
+    cout << "* compressed matrix for J=" << J << ": " << nonzeros
+	 << " of " << dof*dof << " entries" << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <time.h>
+
+#define _WAVELETTL_GALERKINUTILS_VERBOSITY 0
+
+#include <algebra/infinite_vector.h>
+#include <numerics/sturm_bvp.h>
+#include <interval/p_basis.h>
+#include <galerkin/sturm_equation.h>
+#include <galerkin/cached_problem.h>
+#include <adaptive/apply.h>
+#include <adaptive/incremental_residual.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+/*
+  -u''=1 with homogeneous Dirichlet b.c.'s
+*/
+class PoissonProblem
+  : public SimpleSturmBVP
+{
+public:
+  double p(const double t) const { return 1; }
+  double p_prime(const double t) const { return 0; }
+  double q(const double t) const { return 0; }
+  double g(const double t) const { return 1; }
+  bool bc_left() const { return true; }
+  bool bc_right() const { return true; }
+};
+
+int main()
+{
+  cout << "Testing the incremental residual engine..." << endl;
+
+  typedef PBasis<3,3> Basis;
+  typedef SturmEquation<Basis> Equation;
+  typedef CachedProblem<Equation> Problem;
+  typedef Problem::Index Index;
+
+  const int jmax = 10;
+  PoissonProblem poisson;
+  Basis basis(1, 1);
+  basis.set_jmax(jmax);
+  Equation eq(poisson, basis);
+  Problem P(&eq, 1.0, 1.0);
+
+  // iterates with accurate residuals: some steepest descent steps, then
+  // greedy relaxation steps, which change only the coefficients of the largest
+  // residual entries (this also fills the entries cache of P, so that the
+  // timings below are comparable)
+  const unsigned int descent_steps = 5, steps = 40, changed = 10;
+  std::vector<InfiniteVector<double,Index> > iterates(steps+1), residuals(steps+1);
+  InfiniteVector<double,Index> w, r, Ar, f, Aw;
+  for (unsigned int k = 0; k <= steps; k++) {
+    iterates[k] = w;
+    P.RHS(1e-10, f);
+    APPLY(P, w, 1e-10, Aw, jmax);
+    residuals[k] = f - Aw;
+    if (k < descent_steps) {
+      APPLY(P, residuals[k], 1e-10, Ar, jmax);
+      w.add((residuals[k]*residuals[k])/(residuals[k]*Ar), residuals[k]);
+    } else {
+      // the diagonal of the preconditioned matrix is one
+      std::vector<std::pair<double,Index> > entries;
+      for (InfiniteVector<double,Index>::const_iterator it(residuals[k].begin());
+	   it != residuals[k].end(); ++it)
+	entries.push_back(std::make_pair(-fabs(*it), it.index()));
+      std::sort(entries.begin(), entries.end());
+      for (unsigned int i = 0; i < changed && i < entries.size(); i++)
+	w.add_coefficient(entries[i].second, residuals[k].get_coefficient(entries[i].second));
+    }
+  }
+
+  // the residuals of the iterates with the fixed accuracy eta
+  const double eta = 1e-4;
+  IncrementalResidual<Problem> R(P, jmax);
+  double max_deviation = 0, time_incremental = 0, time_full = 0;
+  for (unsigned int k = 0; k <= steps; k++) {
+    clock_t tstart = clock();
+    R.residual(iterates[k], eta, r);
+    time_incremental += double(clock() - tstart) / CLOCKS_PER_SEC;
+    max_deviation = std::max(max_deviation, l2_norm(r - residuals[k]) / eta);
+
+    // the same accuracy from scratch, as in RES
+    tstart = clock();
+    P.RHS(eta/2, f);
+    APPLY(P, iterates[k], eta/2, Aw, jmax);
+    r = f - Aw;
+    time_full += double(clock() - tstart) / CLOCKS_PER_SEC;
+  }
+
+  cout << "* " << descent_steps << " steepest descent steps, then "
+       << steps-descent_steps << " greedy steps changing " << changed << " coefficients, eta=" << eta
+       << ", final residual: " << l2_norm(r) << endl
+       << "  max. ||r-(F-Aw)||/eta: " << max_deviation
+       << (max_deviation <= 1 ? " (ok)" : " (too large)") << endl
+       << "  APPLY calls for the whole iterate: " << R.full_updates
+       << ", for updates: " << R.incremental_updates
+       << ", RHS calls: " << R.rhs_updates << endl
+       << "  (incremental: " << time_incremental << "s, from scratch: " << time_full << "s)" << endl;
+
+  // RES with the engine, the tolerances tighten within the loop
+  IncrementalResidual<Problem> R2(P, jmax);
+  double nu;
+  unsigned int niter = 0;
+  RES(R2, iterates[steps], 1e-2, 0.1, 1e-8, r, nu, niter);
+  cout << "* RES with the engine: nu=" << nu << " after " << niter << " loops" << endl
+       << "  APPLY calls for the whole iterate: " << R2.full_updates
+       << ", for updates: " << R2.incremental_updates
+       << ", RHS calls: " << R2.rhs_updates << endl;
+
+  return 0;
+}
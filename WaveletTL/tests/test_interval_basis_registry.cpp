@@ -0,0 +1,90 @@
+#include <iostream>
+#include <vector>
+
+#define _WAVELETTL_SHARED_INTERVAL_BASES 1
+
+#include <utils/fixed_array1d.h>
+#include <utils/array1d.h>
+#include <interval/p_basis.h>
+#include <interval/p_evaluate.h>
+#include <interval/interval_basis_registry.h>
+#include <cube/tbasis.h>
+
+using namespace std;
+using namespace WaveletTL;
+
+using MathTL::FixedArray1D;
+using MathTL::Array1D;
+
+int main()
+{
+  cout << "Testing the registry of shared interval bases..." << endl;
+
+  typedef PBasis<3,3> Basis1D;
+  typedef IntervalBasisRegistry<Basis1D> Registry;
+  const unsigned int DIM = 2;
+  typedef TensorBasis<Basis1D,DIM> Basis;
+
+  cout << "- constructing 8 tensor product bases with mixed b.c.'s..." << endl;
+  FixedArray1D<bool,2*DIM> bc;
+  Array1D<Basis*> bases(8);
+  for (unsigned int p = 0; p < bases.size(); p++) {
+    for (unsigned int i = 0; i < 2*DIM; i++)
+      bc[i] = ((p >> (i%3)) & 1) == 1;
+    bases[p] = new Basis(bc);
+  }
+  cout << "  number of constructed interval bases: " << Registry::size()
+       << " (expected at most 4)" << endl;
+
+  cout << "- shared instances:" << endl;
+  Basis1D* b1 = Registry::instance(true, false);
+  cout << "  same pointer for identical b.c.'s: "
+       << (b1 == Registry::instance(true, false) ? "yes" : "no") << endl;
+  Basis1D* b2 = Registry::instance(true, false, 6);
+  cout << "  same pointer for identical b.c.'s and jmax: "
+       << (b2 == Registry::instance(true, false, 6) ? "yes" : "no") << endl;
+  const int dof = b2->degrees_of_freedom();
+  cout << "  degrees of freedom up to jmax=6: " << dof << endl;
+  Basis1D* b3 = Registry::instance(true, false, 4);
+  cout << "  jmax=4 yields another basis: " << (b3 != b2 ? "yes" : "no")
+       << ", with " << b3->degrees_of_freedom() << " degrees of freedom" << endl
+       << "  the basis with jmax=6 is unchanged: "
+       << (b2->degrees_of_freedom() == dof ? "yes" : "no") << endl;
+
+  cout << "- copying a tensor product basis shares the 1D bases: ";
+  Basis copy(*bases[0]);
+  cout << (copy.bases()[0] == bases[0]->bases()[0] ? "yes" : "no") << endl;
+
+  cout << "- lazy piecewise polynomial expansion of the wavelets:" << endl;
+  Basis1D::Index lambda(b2->first_wavelet(b2->j0()+1));
+  const double x = 0.05;
+  cout << "  psi_lambda(" << x << ") without expansion: "
+       << evaluate(*b2, 0, lambda, x) << endl;
+  b2->pre_compute_wavelets();
+  cout << "  psi_lambda(" << x << ") with expansion:    "
+       << evaluate(*b2, 0, lambda, x) << endl;
+
+  // concurrent first accesses to the same levels, each level is expanded once
+  const int levels = b2->get_jmax_()-b2->j0()+1;
+  std::vector<const Array1D<Piecewise<double> >*> expansions(4*levels);
+#pragma omp parallel for
+  for (int n = 0; n < 4*levels; n++)
+    expansions[n] = &b2->wavelets_on_level(b2->j0() + n%levels);
+  bool same = true;
+  for (int n = levels; n < 4*levels; n++)
+    same = same && expansions[n] == expansions[n%levels] && expansions[n]->size() > 0;
+  cout << "  concurrent first access to the levels " << b2->j0() << ".." << b2->get_jmax_()
+       << " yields the same expansions: " << (same ? "yes" : "no") << endl;
+
+  // a second call keeps the expansions computed so far
+  b2->pre_compute_wavelets();
+  cout << "  pre_compute_wavelets() again keeps the expansions: "
+       << (&b2->wavelets_on_level(b2->j0()) == expansions[0] && expansions[0]->size() > 0 ? "yes" : "no")
+       << endl;
+
+  for (unsigned int p = 0; p < bases.size(); p++)
+    delete bases[p];
+  Registry::clear();
+
+  return 0;
+}
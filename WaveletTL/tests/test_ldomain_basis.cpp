@@ -48,6 +48,24 @@ int main()
     cout << (*ind) << endl;
   }
 
+  cout << "- checking the precomputed support table:" << endl;
+  Basis basis_notable(basis1d);
+  int mismatches = 0;
+  for (int i = 0; i < basis.degrees_of_freedom(); i++) {
+    const Index* ind = basis.get_wavelet(i);
+    Basis::Support supp;
+    basis_notable.support(Index(ind->j(), ind->e(), ind->p(), ind->k(), &basis_notable), supp);
+    const Basis::Support& supp_table = basis.get_support(i);
+    if (supp.j != supp_table.j) mismatches++;
+    for (int p = 0; p < 3; p++)
+      if (supp.xmin[p] != supp_table.xmin[p]
+	  || (supp.xmin[p] != -1 && (supp.xmax[p] != supp_table.xmax[p]
+				     || supp.ymin[p] != supp_table.ymin[p]
+				     || supp.ymax[p] != supp_table.ymax[p])))
+	mismatches++;
+  }
+  cout << "  " << mismatches << " mismatches" << endl;
+
 
 #if 0
   // only for IBASIS != SplineBasis
@@ -690,7 +690,7 @@ double epsilon_CDD1 = 0.1; // bad accuracy for testing (speedup)
 #endif
 
     cproblem.clear_cache();                    // clear the entries cache for A
-    problem.clear_coeff_cache();               // clear cache for the coefficient function
+    problem.set_iterate(u_epsilon, epsilon_stabilization, 1.0/epsilon_stabilization);  // coefficient from the cell tree of u_epsilon (clears the coefficient cache)
 
   clock_t begin_compute_rhs = clock();
 
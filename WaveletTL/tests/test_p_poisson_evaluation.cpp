@@ -0,0 +1,105 @@
+#define P_POISSON
+
+#include <iostream>
+#include <cmath>
+#include <set>
+#include <time.h>
+
+#include <algebra/infinite_vector.h>
+#include <utils/function.h>
+#include <numerics/bvp.h>
+#include <interval/p_basis.h>
+#include <cube/cube_basis.h>
+#include <cube/cube_evaluate.h>
+#include <galerkin/cube_equation_pPoisson.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+double time_consumption_of_a;
+
+int main()
+{
+  cout << "Testing the tree-based evaluation of the p-Poisson nonlinearity..." << endl;
+
+  typedef PBasis<2,2> Basis1D;
+  typedef CubeBasis<Basis1D,2> Basis;
+  typedef Basis::Index Index;
+  typedef CubeEquationpPoisson<Basis1D,2,Basis> Problem;
+
+  FixedArray1D<bool,4> bc;
+  bc[0] = bc[1] = bc[2] = bc[3] = true;
+
+  ConstantFunction<2> one(Vector<double>(1, "1"));
+  PoissonBVP_Coeff<2> bvp(&one, &one);
+
+  const double p = 1.5;
+  const double epsilon = 0.01;
+  Problem problem(&bvp, bc, p, 5, 3, 3);
+
+  // an adaptive iterate: all coefficients up to level j0, some on the two finer levels
+  const int j0 = problem.basis().j0();
+  InfiniteVector<double,Index> u;
+  int id = 0;
+  for (Index lambda(problem.basis().first_generator(j0));; ++lambda, ++id) {
+    if (lambda.j() == j0 || id % 7 == 0)
+      u.set_coefficient(lambda, cos(0.3*id) / (1 << lambda.j()));
+    if (lambda == problem.basis().last_wavelet(j0+2)) break;
+  }
+  cout << "* iterate with " << u.size() << " active coefficients" << endl;
+
+  problem.set_iterate(u, epsilon, 1.0/epsilon);
+  problem.min_res_quadrature_a = j0+3;
+
+  // the coefficient from the cell tree against ( min{ max{epsilon, |grad u(x)|}, 1/epsilon} )^{p-2},
+  // with grad u(x) evaluated directly from the wavelet expansion, at points off the dyadic grid
+  double err_coeff = 0, max_coeff = 0;
+  for (int n = 0; n < 50; n++) {
+    Point<2> x(fmod(0.1234 + n*0.61803398875, 1.0), fmod(0.5678 + n*0.41421356237, 1.0));
+    FixedArray1D<double,2> grad;
+    evaluate(problem.basis(), u, x, grad);
+    const double r = std::min(std::max(epsilon, sqrt(grad[0]*grad[0]+grad[1]*grad[1])), 1.0/epsilon);
+    const double coeff = pow(r, p-2.0);
+    err_coeff = std::max(err_coeff, fabs(problem.iterate_coeff_a(x) - coeff));
+    max_coeff = std::max(max_coeff, coeff);
+  }
+  cout << "* coefficient a(x) at 50 points, max. relative deviation from the direct evaluation: "
+       << (err_coeff < 1e-10 * max_coeff ? "< 1e-10" : "too large") << endl;
+
+  // test indices
+  std::set<Index> Lambda;
+  for (Index lambda(problem.basis().first_generator(j0));; ++lambda) {
+    Lambda.insert(lambda);
+    if (lambda == problem.basis().last_wavelet(j0+1)) break;
+  }
+
+  clock_t tstart = clock();
+  InfiniteVector<double,Index> w;
+  problem.evaluate_nonlinear(Lambda, w);
+  const double time_tree = double(clock() - tstart) / CLOCKS_PER_SEC;
+
+  // reference: the same forms, entry by entry
+  tstart = clock();
+  InfiniteVector<double,Index> wref;
+  for (std::set<Index>::const_iterator it(Lambda.begin()); it != Lambda.end(); ++it) {
+    double r = 0;
+    for (InfiniteVector<double,Index>::const_iterator uit(u.begin()); uit != u.end(); ++uit)
+      r += problem.a(*it, uit.index()) * *uit;
+    if (r != 0)
+      wref.set_coefficient(*it, r);
+  }
+  const double time_entries = double(clock() - tstart) / CLOCKS_PER_SEC;
+
+  const double err = linfty_norm(w - wref);
+  cout << "* nonlinear form on " << Lambda.size() << " indices, max. relative deviation: "
+       << (err < 1e-10 * linfty_norm(wref) ? "< 1e-10" : "too large") << endl;
+  cout << "  (tree-based: " << time_tree << "s, entry by entry: " << time_entries << "s)" << endl;
+
+  // without an iterate, a() uses bvp.a again
+  problem.clear_iterate();
+  const Index lambda(problem.basis().first_generator(j0));
+  cout << "* after clear_iterate(), a(lambda,lambda)=" << problem.a(lambda, lambda) << endl;
+
+  return 0;
+}
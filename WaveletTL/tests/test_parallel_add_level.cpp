@@ -0,0 +1,121 @@
+/*
+ * Test the concurrent use of CachedQTProblem::add_ball()/add_level() and of the
+ * parallel APPLY_TENSOR (PARALLEL==1) against their serial results,
+ * on an L-shaped domain with 3 patches. Each run starts with an empty cache,
+ * so that the threads set up the one-dimensional cache blocks concurrently.
+ */
+#define PARALLEL 1
+#define _WAVELETTL_GALERKINUTILS_VERBOSITY 0
+
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <omp.h>
+#include <utils/function.h>
+#include <interval/p_basis.h>
+#include <cube/tbasis.h>
+#include <general_domain/qtbasis.h>
+#include <galerkin/cached_qtproblem.h>
+#include <galerkin/galerkin_utils.h>
+#include <adaptive/apply.h>
+#include <adaptive/apply_tensor.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+int main()
+{
+  cout << "Testing the parallel add_level() of CachedQTProblem..." << endl;
+
+  const unsigned int DIM = 2;
+  typedef PBasis<2,2> Basis1d;
+  typedef QTBasis<Basis1d,DIM> Basis;
+  typedef CachedQTProblem<Basis,1> Problem;
+
+  // L-shaped domain, patch 0 is extended to the south to patch 1,
+  // patch 2 is extended to the left to patch 1
+  const unsigned int num_of_patches = 3;
+  Array1D<Point<DIM,int> > corners(num_of_patches);
+  Array1D<FixedArray1D<int,2*DIM> > neighbours(num_of_patches);
+  Array1D<FixedArray1D<bool,2*DIM> > bc(num_of_patches);
+  for (unsigned int p = 0; p < num_of_patches; ++p)
+    for (unsigned int i = 0; i < 2*DIM; ++i) {
+      neighbours[p][i] = -1;
+      bc[p][i] = true;
+    }
+  corners[0][0] = 0; corners[0][1] = 1;
+  corners[1][0] = 0; corners[1][1] = 0;
+  corners[2][0] = 1; corners[2][1] = 0;
+  neighbours[0][2] = 1;
+  neighbours[1][3] = 0;
+  neighbours[1][1] = 2;
+  neighbours[2][0] = 1;
+  bc[0][2] = false;
+  bc[2][0] = false;
+
+  Basis basis(corners, neighbours, bc);
+  basis.set_jmax(multi_degree(basis.j0()[0])+2);
+  const int dof = basis.degrees_of_freedom();
+
+  Array1D<FixedMatrix<double,1> > acoeffs(num_of_patches), qcoeffs(num_of_patches);
+  for (unsigned int p = 0; p < num_of_patches; ++p) {
+    acoeffs[p] = FixedMatrix<double,1>(1.0);
+    qcoeffs[p] = FixedMatrix<double,1>(1.0);
+  }
+  ConstantFunction<DIM> f(Vector<double>(1, "1.0"));
+  const char* rhs_filename = "test_parallel_add_level_rhs";
+
+  omp_set_num_threads(4);
+  const int radius = 2;
+
+  // add_ball for all columns, serially and concurrently, with empty caches
+  double maxdiff_ball = 0;
+  {
+    Problem serial(&basis, acoeffs, qcoeffs, &f, rhs_filename, 5.0, 10.0);
+    Problem parallel(&basis, acoeffs, qcoeffs, &f, rhs_filename, 5.0, 10.0);
+    Array1D<Vector<double> > w_serial(dof), w_parallel(dof);
+    for (int n = 0; n < dof; n++) {
+      w_serial[n].resize(dof);
+      w_parallel[n].resize(dof);
+      serial.add_ball(n, w_serial[n], radius, 1.0);
+    }
+#pragma omp parallel for schedule(dynamic)
+    for (int n = 0; n < dof; n++)
+      parallel.add_ball(n, w_parallel[n], radius, 1.0);
+    for (int n = 0; n < dof; n++)
+      for (int m = 0; m < dof; m++)
+        maxdiff_ball = std::max(maxdiff_ball, fabs(w_serial[n][m]-w_parallel[n][m]));
+  }
+  cout << "* add_ball() for all " << dof << " columns, max. difference serial/parallel: "
+       << maxdiff_ball << (maxdiff_ball == 0 ? " (ok)" : " (wrong)") << endl;
+
+  // APPLY_TENSOR with one and with several threads, with empty caches
+  double maxdiff_apply = 0, norm_apply = 0;
+  {
+    Problem P(&basis, acoeffs, qcoeffs, &f, rhs_filename, 5.0, 10.0);
+    InfiniteVector<double,int> v;
+    P.RHS(1e-6, v);
+
+    InfiniteVector<double,int> w_serial, w_parallel;
+    omp_set_num_threads(1);
+    {
+      Problem serial(&basis, acoeffs, qcoeffs, &f, rhs_filename, 5.0, 10.0);
+      APPLY_TENSOR(serial, v, 1e-4, w_serial, 99, tensor_simple, true);
+    }
+    omp_set_num_threads(4);
+    {
+      Problem parallel(&basis, acoeffs, qcoeffs, &f, rhs_filename, 5.0, 10.0);
+      APPLY_TENSOR(parallel, v, 1e-4, w_parallel, 99, tensor_simple, true);
+    }
+    maxdiff_apply = linfty_norm(w_serial - w_parallel);
+    norm_apply = linfty_norm(w_serial);
+  }
+  cout << "* APPLY_TENSOR, max. difference 1 thread/4 threads: " << maxdiff_apply
+       << " (max. entry " << norm_apply << ")"
+       << (maxdiff_apply <= 1e-12*norm_apply ? " (ok)" : " (wrong)") << endl;
+
+  std::remove(rhs_filename);
+
+  return 0;
+}
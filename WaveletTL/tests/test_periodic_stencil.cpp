@@ -0,0 +1,132 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <algebra/vector.h>
+#include <Rd/cdf_basis.h>
+#include <interval/periodic.h>
+#include <numerics/periodicgr.h>
+#include <galerkin/periodic_laplacian.h>
+#include <galerkin/periodic_gramian.h>
+#include <galerkin/Periodic_TestProblem.h>
+#include <galerkin/cached_periodic_problem.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+/*
+  compare the stencil based cache layer with the uncached problem,
+  up to the level jmax
+*/
+template <class PROBLEM>
+void check(const PROBLEM& P, const int jmax)
+{
+  typedef typename PROBLEM::Index Index;
+  CachedPeriodicProblem<PROBLEM> cP(&P);
+  const int j0 = P.basis().j0();
+
+  // single entries
+  double err(0), maxentry(0);
+  for (Index lambda(P.basis().first_generator(j0));; ++lambda) {
+    for (Index nu(P.basis().first_generator(j0));; ++nu) {
+      err = std::max(err, fabs(cP.a(lambda, nu) - P.a(lambda, nu)));
+      maxentry = std::max(maxentry, fabs(P.a(lambda, nu)));
+      if (nu == P.basis().last_wavelet(jmax)) break;
+    }
+    if (lambda == P.basis().last_wavelet(jmax)) break;
+  }
+  cout << "- entries a(lambda,nu) up to level " << jmax << ", max. relative deviation: "
+       << (err < 1e-12*maxentry ? "< 1e-12" : "too large") << endl;
+  cout << "- number of stencils: " << cP.stencil_count() << endl;
+
+  // preconditioned columns
+  const int dof = P.basis().Deltasize(jmax+1);
+  err = 0;
+  for (Index lambda(P.basis().first_generator(j0));; ++lambda) {
+    Vector<double> w(dof), wref(dof);
+    for (int j = j0-1; j <= jmax; j++)
+      cP.add_level(lambda, w, j, 1.0, 99, CDD1);
+    for (Index nu(P.basis().first_generator(j0));; ++nu) {
+      wref[nu.number()] = P.a(nu, lambda) / (sqrt(P.a(nu, nu)) * sqrt(P.a(lambda, lambda)));
+      if (nu == P.basis().last_wavelet(jmax)) break;
+    }
+    w -= wref;
+    err = std::max(err, linfty_norm(w));
+    if (lambda == P.basis().last_wavelet(jmax)) break;
+  }
+  cout << "- columns via add_level(), max. deviation: "
+       << (err < 1e-12 ? "< 1e-12" : "too large") << endl;
+
+  // full level blocks, direct summation and FFT
+  double err_direct(0), err_fft(0);
+  for (int j = j0-1; j <= jmax; j++)
+    for (int jprime = j0-1; jprime <= jmax; jprime++) {
+      const int jr = std::max(j, j0), jc = std::max(jprime, j0);
+      const int er = (j < j0 ? 0 : 1), ec = (jprime < j0 ? 0 : 1);
+      Vector<double> x(1<<jc), y(1<<jr), yfft(1<<jr), yref(1<<jr);
+      for (int m = 0; m < (1<<jc); m++)
+	x[m] = cos(1.0+m*m);
+      for (int i = 0; i < (1<<jr); i++) {
+	const Index row(jr, er, i);
+	for (int m = 0; m < (1<<jc); m++) {
+	  const Index col(jc, ec, m);
+	  yref[i] += P.a(row, col) / (cP.D(row)*cP.D(col)) * x[m];
+	}
+      }
+      cP.set_fft_density(1.0);
+      cP.apply_level(j, jprime, x, y);
+      cP.set_fft_density(0.0);
+      cP.apply_level(j, jprime, x, yfft);
+      y -= yref;
+      yfft -= yref;
+      err_direct = std::max(err_direct, linfty_norm(y));
+      err_fft = std::max(err_fft, linfty_norm(yfft));
+    }
+  cout << "- level blocks via apply_level(), max. deviation: "
+       << (err_direct < 1e-12 ? "< 1e-12" : "too large") << " (direct), "
+       << (err_fft < 1e-12 ? "< 1e-12" : "too large") << " (FFT)" << endl;
+
+  // APPLY with the dense levels applied level-wise against the column path,
+  // v is dense up to level j0 and sparse on the finer levels
+  InfiniteVector<double,Index> v;
+  int id = 0;
+  for (Index lambda(P.basis().first_generator(j0));; ++lambda, ++id) {
+    if (lambda.j() == j0 || id % 5 == 0)
+      v.set_coefficient(lambda, cos(1.0+id*id) / (1 << lambda.j()));
+    if (lambda == P.basis().last_wavelet(jmax)) break;
+  }
+  for (int strategy = 0; strategy < 2; strategy++) {
+    const CompressionStrategy s = (strategy == 0 ? CDD1 : St04a);
+    InfiniteVector<double,Index> w, wref;
+    cP.set_apply_density(0.5);
+    APPLY(cP, v, 1e-3, w, jmax, s);
+    cP.set_apply_density(2.0);
+    APPLY(cP, v, 1e-3, wref, jmax, s);
+    err = linfty_norm(w - wref);
+    cout << "- APPLY (" << (s == CDD1 ? "CDD1" : "St04a") << ") level-wise against column-wise, max. relative deviation: "
+	 << (err < 1e-12*linfty_norm(wref) ? "< 1e-12" : "too large") << endl;
+  }
+}
+
+int main()
+{
+  cout << "Testing the stencil cache for periodic operators ..." << endl;
+
+  typedef CDFBasis<3,3> RBasis;
+  typedef PeriodicBasis<RBasis> Basis;
+  Basis basis;
+  const int jmax = basis.j0()+2;
+  basis.set_jmax(jmax);
+
+  cout << "* Gramian:" << endl;
+  PeriodicTestProblem<1> gproblem;
+  PeriodicIntervalGramian<RBasis> G(gproblem, basis);
+  check(G, jmax);
+
+  cout << "* Laplacian:" << endl;
+  PeriodicTestProblem2<4> lproblem;
+  PeriodicIntervalLaplacian<RBasis> L(lproblem, basis);
+  check(L, jmax);
+
+  return 0;
+}
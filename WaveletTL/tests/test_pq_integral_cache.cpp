@@ -0,0 +1,131 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <utils/array1d.h>
+#include <utils/fixed_array1d.h>
+#include <numerics/gauss_quadrature.h>
+#include <interval/pq_frame.h>
+#include <interval/pq_evaluate.h>
+#include <interval/pq_integral_cache.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+/*
+  reference integrals of two quarklets by the single p evaluate() routines,
+  with a composite Gauss rule on a finer grid than the one of QuarkletIntegralCache
+*/
+template <int d, int dT>
+void reference_integrals(const PQFrame<d,dT>& frame,
+			 const int p1, const int j1, const int e1, const int k1,
+			 const int p2, const int j2, const int e2, const int k2,
+			 double& integral, double& der_integral)
+{
+  const int J = std::max(j1+e1, j2+e2)+1;
+  DyadicGaussRule rule;
+  rule.setup(J, 0, 1<<J, d+std::max(p1, p2)+2);
+
+  Array1D<double> values1, dervalues1, values2, dervalues2;
+  evaluate(frame, p1, j1, e1, k1, rule.points(), values1, dervalues1);
+  evaluate(frame, p2, j2, e2, k2, rule.points(), values2, dervalues2);
+
+  integral = der_integral = 0;
+  for (unsigned int m = 0; m < rule.size(); m++) {
+    integral += values1[m] * values2[m] * rule.weights()[m];
+    der_integral += dervalues1[m] * dervalues2[m] * rule.weights()[m];
+  }
+}
+
+int main()
+{
+  cout << "Testing the p-blocked quarklet integral cache..." << endl;
+
+  typedef PQFrame<3,3> Frame;
+  Frame frame(true, true);
+  const int pmax = 4;
+  const int j0 = frame.j0();
+  frame.set_jpmax(j0+2, pmax);
+
+  // the spline indices (j,e,k) under test: all generators on j0, all wavelets on j0 and j0+1
+  std::vector<FixedArray1D<int,3> > indices;
+  for (int k = frame.DeltaLmin(); k <= frame.DeltaRmax(j0); k++) {
+    FixedArray1D<int,3> jek; jek[0] = j0; jek[1] = 0; jek[2] = k;
+    indices.push_back(jek);
+  }
+  for (int j = j0; j <= j0+1; j++)
+    for (int k = frame.Nablamin(); k <= frame.Nablamax(j); k++) {
+      FixedArray1D<int,3> jek; jek[0] = j; jek[1] = 1; jek[2] = k;
+      indices.push_back(jek);
+    }
+
+  // p-blocked point evaluation against the single p evaluation
+  Array1D<double> points(101);
+  for (unsigned int m = 0; m < points.size(); m++)
+    points[m] = (m+0.5*sin((double)m)) / (points.size()-1.0);
+  points[0] = 0.0;
+  points[points.size()-1] = 1.0;
+  double err_eval = 0, max_eval = 0;
+  for (unsigned int n = 0; n < indices.size(); n++) {
+    const int j = indices[n][0], e = indices[n][1], k = indices[n][2];
+    Array1D<Array1D<double> > values, dervalues;
+    evaluate(frame, pmax, j, e, k, points, values, dervalues);
+    for (int p = 0; p <= pmax; p++) {
+      Array1D<double> valuesp, dervaluesp;
+      evaluate(frame, p, j, e, k, points, valuesp, dervaluesp);
+      for (unsigned int m = 0; m < points.size(); m++) {
+	err_eval = std::max(err_eval, std::max(fabs(values[p][m]-valuesp[m]), fabs(dervalues[p][m]-dervaluesp[m])));
+	max_eval = std::max(max_eval, std::max(fabs(valuesp[m]), fabs(dervaluesp[m])));
+      }
+    }
+  }
+  cout << "* evaluation of all p <= " << pmax << " at once, max. relative deviation from single p: "
+       << (err_eval < 1e-10*max_eval ? "< 1e-10" : "too large") << endl;
+
+  // cached integrals against the single p quadrature, for all pairs of indices and p1,p2 <= pmax;
+  // the cache starts with pmax=0 and grows with the requested degrees
+  QuarkletIntegralCache<Frame> cache(&frame);
+  double err_int = 0, max_int = 0;
+  for (int p = 0; p <= pmax; p++)
+    for (unsigned int n1 = 0; n1 < indices.size(); n1++)
+      for (unsigned int n2 = 0; n2 < indices.size(); n2++) {
+	const int p1 = p, p2 = (p+n1+n2) % (pmax+1);
+	double integral, der_integral, integral_ref, der_integral_ref;
+	cache.integrals(p1, indices[n1][0], indices[n1][1], indices[n1][2],
+			p2, indices[n2][0], indices[n2][1], indices[n2][2],
+			integral, der_integral);
+	reference_integrals(frame,
+			    p1, indices[n1][0], indices[n1][1], indices[n1][2],
+			    p2, indices[n2][0], indices[n2][1], indices[n2][2],
+			    integral_ref, der_integral_ref);
+	err_int = std::max(err_int, std::max(fabs(integral-integral_ref), fabs(der_integral-der_integral_ref)));
+	max_int = std::max(max_int, std::max(fabs(integral_ref), fabs(der_integral_ref)));
+      }
+  cout << "* cached integrals for p1,p2 <= " << cache.pmax() << ", max. relative deviation from single p quadrature: "
+       << (err_int < 1e-10*max_int ? "< 1e-10" : "too large") << endl;
+  cout << "  (" << cache.size() << " p-blocks stored)" << endl;
+
+  // a bounded cache gives the same values and never exceeds its bound
+  QuarkletIntegralCache<Frame> bounded(&frame, pmax, 10);
+  double err_bounded = 0;
+  unsigned int max_size = 0;
+  for (unsigned int n1 = 0; n1 < indices.size(); n1++)
+    for (unsigned int n2 = 0; n2 < indices.size(); n2++) {
+      double integral, der_integral, integral_ref, der_integral_ref;
+      bounded.integrals(pmax, indices[n1][0], indices[n1][1], indices[n1][2],
+			1, indices[n2][0], indices[n2][1], indices[n2][2],
+			integral, der_integral);
+      cache.integrals(pmax, indices[n1][0], indices[n1][1], indices[n1][2],
+		      1, indices[n2][0], indices[n2][1], indices[n2][2],
+		      integral_ref, der_integral_ref);
+      err_bounded = std::max(err_bounded, std::max(fabs(integral-integral_ref), fabs(der_integral-der_integral_ref)));
+      max_size = std::max(max_size, bounded.size());
+    }
+  bounded.clear();
+  cout << "* cache bounded to " << bounded.max_blocks() << " p-blocks: max. size " << max_size
+       << ", max. deviation " << err_bounded << ", size after clear(): " << bounded.size()
+       << (max_size <= bounded.max_blocks() && err_bounded == 0 && bounded.size() == 0 ? " (ok)" : " (wrong)") << endl;
+
+  return 0;
+}
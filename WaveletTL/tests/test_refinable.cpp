@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cmath>
+
+#include <algebra/infinite_vector.h>
+#include <utils/multiindex.h>
+#include <Rd/cdf_mask.h>
+#include <Rd/refinable.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+// maximal deviation of two sets of point values
+template <class I>
+double deviation(const InfiniteVector<double,I>& v, const InfiniteVector<double,I>& w)
+{
+  InfiniteVector<double,I> diff(v);
+  diff -= w;
+  return linfty_norm(diff);
+}
+
+int main()
+{
+  cout << "Testing the cached evaluation of refinable functions ..." << endl;
+
+  const int jmax = 6;
+
+  cout << "* a 1D CDF mask (RRefinementMask), d=3:" << endl;
+  CDFRefinementMask_primal<3> mask;
+  for (int mu = 0; mu <= 1; mu++) {
+    // reference values, each of them computed from scratch
+    InfiniteVector<double,int> reference[jmax+1];
+    for (int j = 0; j <= jmax; j++) {
+      CDFRefinementMask_primal<3>::clear_values_cache();
+      reference[j] = mask.evaluate(mu, j);
+    }
+    CDFRefinementMask_primal<3>::clear_values_cache();
+
+    // ascending resolutions, each one refining the previous one
+    double err(0);
+    for (int j = 0; j <= jmax; j++)
+      err = std::max(err, deviation(mask.evaluate(mu, j), reference[j]));
+    cout << "  mu=" << mu << ", ascending resolutions, max. deviation: " << err << endl;
+
+    // descending resolutions, all of them available in the cache
+    err = 0;
+    for (int j = jmax; j >= 0; j--)
+      err = std::max(err, deviation(mask.evaluate(mu, j), reference[j]));
+    cout << "  mu=" << mu << ", descending resolutions, max. deviation: " << err << endl;
+
+    // a finer resolution, computed from the finest cached one
+    InfiniteVector<double,int> fine(mask.evaluate(mu, jmax+2));
+    CDFRefinementMask_primal<3>::clear_values_cache();
+    cout << "  mu=" << mu << ", incremental refinement to j=" << jmax+2 << ", max. deviation: "
+	 << deviation(fine, mask.evaluate(mu, jmax+2)) << endl;
+  }
+
+  cout << "* a 1D CDF mask (MultivariateRefinableFunction), d=2:" << endl;
+  typedef MultivariateRefinableFunction<CDFMask_primal<2>,1> RefFunc;
+  RefFunc phi;
+  MultiIndex<int,1> mu;
+  InfiniteVector<double,MultiIndex<int,1> > reference[jmax+1];
+  for (int j = 0; j <= jmax; j++) {
+    RefFunc::clear_values_cache();
+    reference[j] = phi.evaluate(mu, j);
+  }
+  RefFunc::clear_values_cache();
+  double err(0);
+  for (int j = jmax; j >= 0; j -= 2)
+    err = std::max(err, deviation(phi.evaluate(mu, j), reference[j]));
+  for (int j = 0; j <= jmax; j++)
+    err = std::max(err, deviation(phi.evaluate(mu, j), reference[j]));
+  cout << "  mixed resolutions, max. deviation: " << err << endl;
+  cout << "  phi(0)=" << phi.evaluate(mu, jmax).get_coefficient(mu)
+       << ", phi(1/2)=" << phi.evaluate(mu, 1).get_coefficient(MultiIndex<int,1>(1)) << endl;
+
+  return 0;
+}
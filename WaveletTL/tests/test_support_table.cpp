@@ -0,0 +1,205 @@
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <geometry/point.h>
+#include <generic/support_table.h>
+
+using namespace std;
+using namespace MathTL;
+using namespace WaveletTL;
+
+// random number in [a,b)
+double random_double(const double a, const double b)
+{
+  return a + (b-a) * (rand() / (RAND_MAX+1.0));
+}
+
+/*
+  the supports of the table, levelwise, for the brute force search
+*/
+template <unsigned int DIM>
+struct Supports
+{
+  std::vector<std::vector<int> > key;
+  std::vector<std::vector<Point<DIM> > > a, b;
+
+  void insert(SupportTable<DIM>& table, const int j, const int k,
+	      const Point<DIM>& aa, const Point<DIM>& bb)
+  {
+    if (j >= (int)key.size()) {
+      key.resize(j+1);
+      a.resize(j+1);
+      b.resize(j+1);
+    }
+    key[j].push_back(k);
+    a[j].push_back(aa);
+    b[j].push_back(bb);
+    table.insert(j, k, aa, bb);
+  }
+
+  // all keys on level j whose support intersects the open box (aa,bb), sorted
+  void intersecting(const int j, const Point<DIM>& aa, const Point<DIM>& bb,
+		    std::vector<int>& keys) const
+  {
+    keys.clear();
+    if (j >= (int)key.size()) return;
+    for (unsigned int s = 0; s < key[j].size(); s++) {
+      bool hit = true;
+      for (unsigned int i = 0; i < DIM && hit; i++)
+	hit = a[j][s][i] < bb[i] && b[j][s][i] > aa[i];
+      if (hit)
+	keys.push_back(key[j][s]);
+    }
+    sort(keys.begin(), keys.end());
+  }
+};
+
+/*
+  compare SupportTable::intersecting() with the brute force search for the given query,
+  returns the number of found keys or -1 on a mismatch
+*/
+template <unsigned int DIM>
+int compare(const SupportTable<DIM>& table, const Supports<DIM>& supports,
+	    const int j, const Point<DIM>& a, const Point<DIM>& b)
+{
+  std::vector<int> keys, keysref;
+  keys.push_back(-1); // intersecting() has to append
+  table.intersecting(j, a, b, keys);
+  supports.intersecting(j, a, b, keysref);
+  if (keys[0] != -1) return -1;
+  keys.erase(keys.begin());
+  return (keys == keysref ? (int)keys.size() : -1);
+}
+
+template <unsigned int DIM>
+void check()
+{
+  SupportTable<DIM> table;
+  Supports<DIM> supports;
+  int key = 0;
+
+  // level 0: random rectangles of moderate size in [0,1]^DIM
+  for (int n = 0; n < 200; n++, key++) {
+    Point<DIM> a, b;
+    for (unsigned int i = 0; i < DIM; i++) {
+      a[i] = random_double(0, 0.9);
+      b[i] = a[i] + random_double(0.01, 0.1);
+    }
+    supports.insert(table, 0, key, a, b);
+  }
+
+  // level 1: mixed extents, many small supports and a few huge ones
+  for (int n = 0; n < 300; n++, key++) {
+    Point<DIM> a, b;
+    const double size = (n % 50 == 0 ? random_double(0.5, 2.0) : random_double(0.001, 0.01));
+    for (unsigned int i = 0; i < DIM; i++) {
+      a[i] = random_double(-0.5, 1.0);
+      b[i] = a[i] + (i == 0 ? size : random_double(0.001, 0.01));
+    }
+    supports.insert(table, 1, key, a, b);
+  }
+
+  // level 2: dyadic boxes [k,k+2]*2^{-3} (in each direction), which touch each other
+  const int N = 1<<3;
+  int ncells = 1;
+  for (unsigned int i = 0; i < DIM; i++)
+    ncells *= N;
+  for (int k = 0; k < ncells; k++, key++) {
+    Point<DIM> a, b;
+    int m = k;
+    for (unsigned int i = 0; i < DIM; i++, m /= N) {
+      a[i] = (m % N) / (double)N;
+      b[i] = a[i] + 2.0/N;
+    }
+    supports.insert(table, 2, key, a, b);
+  }
+
+  // level 3 stays empty, level 4 has a single support
+  {
+    Point<DIM> a, b;
+    for (unsigned int i = 0; i < DIM; i++) {
+      a[i] = 0.25;
+      b[i] = 0.5;
+    }
+    supports.insert(table, 4, key++, a, b);
+  }
+
+  table.compress();
+
+  // random queries on all levels, including levels without supports
+  bool ok = true;
+  int found = 0, empty = 0;
+  for (int n = 0; n < 2000 && ok; n++) {
+    const int j = n % 6;
+    Point<DIM> a, b;
+    for (unsigned int i = 0; i < DIM; i++) {
+      a[i] = random_double(-1.0, 1.5);
+      b[i] = a[i] + random_double(0.0, n % 3 == 0 ? 1.0 : 0.05);
+    }
+    const int r = compare(table, supports, j, a, b);
+    ok = (r >= 0);
+    found += r;
+    if (r == 0) empty++;
+  }
+  cout << "- random queries: " << (ok ? "ok" : "mismatch") << " (" << found << " keys found, "
+       << empty << " empty results)" << endl;
+
+  // queries outside of the bounding box and inverted queries have empty results,
+  // a point query finds the supports containing the point in their interior
+  ok = true;
+  for (int j = 0; j <= 5 && ok; j++) {
+    Point<DIM> a, b, c;
+    for (unsigned int i = 0; i < DIM; i++) {
+      a[i] = 3.0;
+      b[i] = 4.0;
+      c[i] = 0.3;
+    }
+    ok = compare(table, supports, j, a, b) == 0
+      && compare(table, supports, j, b, a) == 0
+      && compare(table, supports, j, c, c) >= 0;
+  }
+  cout << "- queries outside of the supports, inverted and point queries: "
+       << (ok ? "ok" : "mismatch") << endl;
+
+  // dyadic queries on level 2, touching the supports only at their boundaries
+  ok = true;
+  int touching = 0;
+  for (int k = 0; k < ncells && ok; k++) {
+    Point<DIM> a, b;
+    int m = k;
+    for (unsigned int i = 0; i < DIM; i++, m /= N) {
+      a[i] = (m % N) / (double)N;
+      b[i] = a[i] + 1.0/N;
+    }
+    const int r = compare(table, supports, 2, a, b);
+    ok = (r >= 0);
+    // the cell [a,b] lies in the supports starting at a and (in each direction) one cell before,
+    // and touches the ones starting at b
+    int expected = 1;
+    for (unsigned int i = 0; i < DIM; i++)
+      expected *= (a[i] > 0 ? 2 : 1);
+    ok = ok && r == expected;
+    touching++;
+  }
+  cout << "- dyadic cells touching supports at the boundary: " << (ok ? "ok" : "mismatch")
+       << " (" << touching << " queries)" << endl;
+}
+
+int main()
+{
+  cout << "Testing SupportTable against a brute force search..." << endl;
+
+  srand(2718);
+
+  cout << "* DIM=1:" << endl;
+  check<1>();
+
+  cout << "* DIM=2:" << endl;
+  check<2>();
+
+  cout << "* DIM=3:" << endl;
+  check<3>();
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <cmath>
+#include <ctime>
+
+#include <algebra/infinite_vector.h>
+#include <geometry/sampled_mapping.h>
+#include <utils/random.h>
+
+#include <interval/p_basis.h>
+#include <interval/p_evaluate.h>
+#include <cube/tbasis.h>
+#include <cube/tbasis_evaluate.h>
+
+#include <interval/ds_basis.h>
+#include <interval/ds_evaluate.h>
+#include <Ldomain/ldomain_basis.h>
+
+#include <generic/tensor_sampler.h>
+
+using namespace std;
+using namespace WaveletTL;
+using namespace MathTL;
+
+// maximal pointwise difference of two sampled mappings on the same grid
+double difference(const SampledMapping<2>& s1, const SampledMapping<2>& s2)
+{
+  double r = 0;
+  for (unsigned int m = 0; m < s1.values().row_dimension(); m++)
+    for (unsigned int n = 0; n < s1.values().column_dimension(); n++)
+      r = max(r, fabs(s1.values()(m,n) - s2.values()(m,n)));
+  return r;
+}
+
+int main()
+{
+  cout << "Testing the support-local evaluation of expansions on grids..." << endl;
+
+  const int resolution = 7;
+
+  {
+    typedef PBasis<3,3> Basis1D;
+    typedef TensorBasis<Basis1D,2> Basis;
+    typedef Basis::Index Index;
+    Basis basis;
+    basis.set_jmax(8);
+
+    cout << "- TensorBasis<PBasis<3,3>,2>, all " << basis.degrees_of_freedom()
+	 << " indices up to |j|=8 with random coefficients:" << endl;
+    InfiniteVector<double,Index> coeffs;
+    for (int i = 0; i < basis.degrees_of_freedom(); i++)
+      coeffs.set_coefficient(*basis.get_wavelet(i), random_double()-0.5);
+
+    clock_t tstart = clock();
+    SampledMapping<2> reference(Grid<2>(Point<2>(0), Point<2>(1), 1<<resolution));
+    for (InfiniteVector<double,Index>::const_iterator it(coeffs.begin()), itend(coeffs.end());
+	 it != itend; ++it)
+      reference.add(*it, evaluate(basis, it.index(), true, resolution));
+    clock_t tend = clock();
+    cout << "  per coefficient: " << (double)(tend-tstart)/CLOCKS_PER_SEC << "s" << endl;
+
+    tstart = clock();
+    SampledMapping<2> result(evaluate(basis, coeffs, true, resolution));
+    tend = clock();
+    cout << "  TensorSampler:   " << (double)(tend-tstart)/CLOCKS_PER_SEC << "s" << endl;
+    cout << "  maximal difference: " << difference(reference, result) << endl;
+  }
+
+  {
+    typedef DSBasis<2,2,BernsteinSVD> Basis1D;
+    Basis1D basis1d;
+    typedef LDomainBasis<Basis1D> Basis;
+    typedef Basis::Index Index;
+    Basis basis(basis1d);
+
+    // the wavelets on the higher levels are composed of several refined
+    // generators across the interfaces; there, every fifth index is taken
+    // (all types e and patches p occur), otherwise the reference takes minutes
+    const int jmax = basis.j0()+2;
+    cout << "- LDomainBasis<DSBasis<2,2> >, all indices on level j=" << basis.j0()
+	 << ", every fifth one up to j=" << jmax << ", with random coefficients:" << endl;
+    InfiniteVector<double,Index> coeffs;
+    int n = 0;
+    for (Index lambda(first_generator<Basis1D>(&basis, basis.j0()));; ++lambda, ++n) {
+      if (lambda.j() == basis.j0() || n%5 == 0)
+	coeffs.set_coefficient(lambda, random_double()-0.5);
+      if (lambda == last_wavelet<Basis1D>(&basis, jmax)) break;
+    }
+
+    clock_t tstart = clock();
+    Array1D<SampledMapping<2> > reference(3);
+    reference[0] = SampledMapping<2>(Grid<2>(Point<2>(-1, 0), Point<2>(0,1), 1<<resolution));
+    reference[1] = SampledMapping<2>(Grid<2>(Point<2>(-1,-1), Point<2>(0,0), 1<<resolution));
+    reference[2] = SampledMapping<2>(Grid<2>(Point<2>( 0,-1), Point<2>(1,0), 1<<resolution));
+    for (InfiniteVector<double,Index>::const_iterator it(coeffs.begin()), itend(coeffs.end());
+	 it != itend; ++it) {
+      Array1D<SampledMapping<2> > temp(basis.evaluate(it.index(), resolution));
+      for (int p = 0; p < 3; p++)
+	reference[p].add(*it, temp[p]);
+    }
+    clock_t tend = clock();
+    cout << "  per coefficient: " << (double)(tend-tstart)/CLOCKS_PER_SEC << "s" << endl;
+
+    tstart = clock();
+    Array1D<SampledMapping<2> > result(basis.evaluate(coeffs, resolution));
+    tend = clock();
+    cout << "  TensorSampler:   " << (double)(tend-tstart)/CLOCKS_PER_SEC << "s" << endl;
+    double diff = 0;
+    for (int p = 0; p < 3; p++)
+      diff = max(diff, difference(reference[p], result[p]));
+    cout << "  maximal difference: " << diff << endl;
+  }
+
+  return 0;
+}